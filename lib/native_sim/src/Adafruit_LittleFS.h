@@ -0,0 +1,80 @@
+/**
+ * @file Adafruit_LittleFS.h
+ * @brief Host stand-in for the Adafruit LittleFS wrapper of the nRF52 core.
+ *        Files live in RAM; bytes programmed and files removed are counted
+ *        so flash traffic can be reported per event.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_ADAFRUIT_LITTLEFS_H
+#define SIM_ADAFRUIT_LITTLEFS_H
+
+#include <Arduino.h>
+
+class Adafruit_LittleFS;
+
+namespace Adafruit_LittleFS_Namespace
+{
+	enum
+	{
+		FILE_O_READ = 0,
+		FILE_O_WRITE = 1,
+	};
+
+	class File : public Print
+	{
+	public:
+		File(Adafruit_LittleFS &fs);
+		File(char const *filename, uint8_t mode, Adafruit_LittleFS &fs);
+		File(const File &other);
+		File &operator=(const File &other);
+		~File();
+
+		bool open(char const *filename, uint8_t mode);
+		size_t write(uint8_t ch);
+		size_t write(uint8_t const *buf, size_t size);
+		using Print::write;
+		int read(void);
+		int read(void *buf, uint16_t nbyte);
+		int peek(void);
+		int available(void);
+		void flush(void);
+		bool seek(uint32_t pos);
+		uint32_t position(void);
+		uint32_t size(void);
+		bool truncate(uint32_t pos);
+		bool truncate(void);
+		void close(void);
+		operator bool(void);
+		bool isOpen(void);
+		char const *name(void);
+		bool isDirectory(void) { return false; }
+
+	private:
+		Adafruit_LittleFS *_fs;
+		char _name[64];
+		bool _is_open;
+		uint8_t _mode;
+		uint32_t _pos;
+	};
+}
+
+class Adafruit_LittleFS
+{
+public:
+	bool begin(void) { return true; }
+	void end(void) {}
+	Adafruit_LittleFS_Namespace::File open(char const *filename, uint8_t mode = Adafruit_LittleFS_Namespace::FILE_O_READ);
+	bool exists(char const *filepath);
+	bool mkdir(char const *filepath) { (void)filepath; return true; }
+	bool remove(char const *filepath);
+	bool rename(char const *pathFrom, char const *pathTo);
+	bool rmdir(char const *filepath) { (void)filepath; return true; }
+	bool rmdir_r(char const *filepath) { (void)filepath; return true; }
+	bool format(void);
+};
+
+#endif
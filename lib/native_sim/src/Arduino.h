@@ -0,0 +1,128 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino core used by the native environment.
+ *        Time is virtual: delay() advances the simulation clock and runs
+ *        whatever hardware models are due, so busy-waits on EPD_BUSY cost
+ *        no host time but still show up in the latency report.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+
+#define ARDUINO 10819
+#define ARDUINO_NATIVE_SIM 1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+#define CHANGE 2
+#define FALLING 3
+#define RISING 4
+
+enum BitOrder
+{
+	LSBFIRST = 0,
+	MSBFIRST = 1
+};
+
+/** RAK4631 pin map as seen by the application */
+#define WB_IO1 17
+#define WB_IO2 34
+#define WB_IO3 21
+#define WB_IO4 4
+#define WB_IO5 9
+#define WB_IO6 10
+#define WB_A0 5
+#define WB_A1 31
+#define PIN_SPI_MISO 45
+#define PIN_SPI_MOSI 44
+#define PIN_SPI_SCK 43
+#define PIN_SPI_SS 26
+static const uint8_t MISO = PIN_SPI_MISO;
+static const uint8_t MOSI = PIN_SPI_MOSI;
+static const uint8_t SCK = PIN_SPI_SCK;
+static const uint8_t SS = PIN_SPI_SS;
+#define LED_GREEN 35
+#define LED_BLUE 36
+#define SIM_NUM_PINS 64
+/** Arduino pin to GPIO, the RAK4631 variant maps them 1:1 */
+extern const uint32_t g_ADigitalPinMap[SIM_NUM_PINS];
+
+#define PROGMEM
+#define PGM_P const char *
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_pointer(addr) ((void *)*(void *const *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define digitalPinToInterrupt(p) (p)
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+#include "WString.h"
+#include "Print.h"
+#include "rtos.h"
+
+typedef void (*voidFuncPtr)(void);
+
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t val);
+int digitalRead(uint32_t pin);
+uint32_t analogRead(uint32_t pin);
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode);
+void detachInterrupt(uint32_t pin);
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void noInterrupts(void);
+void interrupts(void);
+#define __disable_irq() noInterrupts()
+#define __enable_irq() interrupts()
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class SimSerial : public Print
+{
+public:
+	void begin(uint32_t baud) { (void)baud; }
+	void end(void) {}
+	int available(void) { return 0; }
+	int read(void) { return -1; }
+	operator bool() { return true; }
+	size_t write(uint8_t c);
+	using Print::write;
+};
+extern SimSerial Serial;
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * @file InternalFileSystem.h
+ * @brief Host stand-in for the nRF52 internal flash file system
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_INTERNALFILESYSTEM_H
+#define SIM_INTERNALFILESYSTEM_H
+
+#include "Adafruit_LittleFS.h"
+
+class InternalFileSystem : public Adafruit_LittleFS
+{
+public:
+	bool begin(void) { return true; }
+};
+
+extern InternalFileSystem InternalFS;
+
+#endif
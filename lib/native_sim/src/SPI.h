@@ -0,0 +1,61 @@
+/**
+ * @file SPI.h
+ * @brief Host stand-in for the Arduino SPI class. Every byte clocked out is
+ *        handed to the simulated bus so the attached models (SSD1680) see
+ *        the same traffic as on the board.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x02
+#define SPI_MODE1 0x00
+#define SPI_MODE2 0x03
+#define SPI_MODE3 0x01
+
+#define SPI_CLOCK_DIV2 2
+#define SPI_CLOCK_DIV4 4
+#define SPI_CLOCK_DIV8 8
+#define SPI_CLOCK_DIV16 16
+
+#define SPI_INTERFACES_COUNT 1
+
+class SPISettings
+{
+public:
+	SPISettings(uint32_t clock = 4000000, BitOrder bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+		: clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+	uint32_t clock;
+	BitOrder bitOrder;
+	uint8_t dataMode;
+};
+
+class SPIClass
+{
+public:
+	void begin(void) {}
+	void end(void) {}
+	void beginTransaction(SPISettings settings) { _settings = settings; }
+	void endTransaction(void) {}
+	void usingInterrupt(int interruptNumber) { (void)interruptNumber; }
+	uint8_t transfer(uint8_t data);
+	void transfer(void *buf, size_t count);
+	uint16_t transfer16(uint16_t data);
+	void setBitOrder(BitOrder order) { _settings.bitOrder = order; }
+	void setDataMode(uint8_t mode) { _settings.dataMode = mode; }
+	void setClockDivider(uint32_t div) { (void)div; }
+	uint32_t clock(void) const { return _settings.clock; }
+
+private:
+	SPISettings _settings;
+};
+
+extern SPIClass SPI;
+
+#endif
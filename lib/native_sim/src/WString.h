@@ -0,0 +1,39 @@
+/**
+ * @file WString.h
+ * @brief Host stand-in for the Arduino String class, reduced to what the
+ *        application and the Adafruit libraries touch
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_WSTRING_H
+#define SIM_WSTRING_H
+
+#include <string>
+#include <string.h>
+
+class __FlashStringHelper;
+
+class String
+{
+public:
+	String(const char *str = "") : _str(str == NULL ? "" : str) {}
+	String(const __FlashStringHelper *str) : _str((const char *)str) {}
+	String(const std::string &str) : _str(str) {}
+	unsigned int length(void) const { return _str.length(); }
+	const char *c_str(void) const { return _str.c_str(); }
+	char operator[](unsigned int index) const { return _str[index]; }
+	String &operator+=(const String &rhs)
+	{
+		_str += rhs._str;
+		return *this;
+	}
+	bool operator==(const String &rhs) const { return _str == rhs._str; }
+
+private:
+	std::string _str;
+};
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino TwoWire class. Transactions are
+ *        routed to the simulated I2C devices (LIS3DH) and counted.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include <Arduino.h>
+
+#define WIRE_BUFFER_SIZE 256
+
+class TwoWire : public Print
+{
+public:
+	void begin(void) {}
+	void end(void) {}
+	void setClock(uint32_t clock) { (void)clock; }
+	void beginTransmission(uint8_t address);
+	uint8_t endTransmission(bool stopBit = true);
+	uint8_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true);
+	size_t write(uint8_t data);
+	size_t write(const uint8_t *data, size_t quantity);
+	int available(void) { return _rx_len - _rx_idx; }
+	int read(void) { return _rx_idx < _rx_len ? _rx_buf[_rx_idx++] : -1; }
+	int peek(void) { return _rx_idx < _rx_len ? _rx_buf[_rx_idx] : -1; }
+
+private:
+	uint8_t _address = 0;
+	uint8_t _tx_buf[WIRE_BUFFER_SIZE];
+	size_t _tx_len = 0;
+	uint8_t _rx_buf[WIRE_BUFFER_SIZE];
+	size_t _rx_len = 0;
+	size_t _rx_idx = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
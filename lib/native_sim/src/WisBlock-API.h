@@ -0,0 +1,236 @@
+/**
+ * @file WisBlock-API.h
+ * @brief Host stand-in for the WisBlock-API. Provides the globals, event
+ *        flags and LoRaWAN/BLE entry points the application uses, backed by
+ *        a fake LoRaMAC and the simulated main loop in sim_wisblock.cpp.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_WISBLOCK_API_H
+#define SIM_WISBLOCK_API_H
+
+#include <Arduino.h>
+#include "sim.h"
+
+#ifndef API_DEBUG
+#define API_DEBUG 0
+#endif
+
+#define PRINTF(...) sim_log(__VA_ARGS__)
+
+#if API_DEBUG > 0
+#define API_LOG(tag, ...)           \
+	do                              \
+	{                               \
+		if (tag)                    \
+			PRINTF("[%s] ", tag);   \
+		PRINTF(__VA_ARGS__);        \
+		PRINTF("\n");               \
+	} while (0)
+#else
+#define API_LOG(...)
+#endif
+
+/** Wake up events, the application owns the bits above LORA_JOIN_FIN */
+#define NO_EVENT 0
+#define STATUS 0b0000000000000001
+#define N_STATUS 0b1111111111111110
+#define BLE_CONFIG 0b0000000000000010
+#define N_BLE_CONFIG 0b1111111111111101
+#define BLE_DATA 0b0000000000000100
+#define N_BLE_DATA 0b1111111111111011
+#define LORA_DATA 0b0000000000001000
+#define N_LORA_DATA 0b1111111111110111
+#define LORA_TX_FIN 0b0000000000010000
+#define N_LORA_TX_FIN 0b1111111111101111
+#define AT_CMD 0b0000000000100000
+#define N_AT_CMD 0b1111111111011111
+#define LORA_JOIN_FIN 0b0000000001000000
+#define N_LORA_JOIN_FIN 0b1111111110111111
+
+extern SemaphoreHandle_t g_task_sem;
+extern volatile uint16_t g_task_event_type;
+extern SoftwareTimer g_task_wakeup_timer;
+
+/** LoRaMAC handler types */
+typedef enum
+{
+	LMH_SUCCESS = 0,
+	LMH_BUSY = -1,
+	LMH_ERROR = -2,
+} lmh_error_status;
+
+typedef enum
+{
+	LMH_UNCONFIRMED_MSG = 0,
+	LMH_CONFIRMED_MSG = !LMH_UNCONFIRMED_MSG
+} lmh_confirm;
+
+typedef enum
+{
+	LMH_RESET = 0,
+	LMH_SET = 1,
+	LMH_ONGOING = 2,
+	LMH_FAILED = 3,
+} lmh_join_status;
+
+#define LORAMAC_REGION_AS923 0
+#define LORAMAC_REGION_AU915 1
+#define LORAMAC_REGION_CN470 2
+#define LORAMAC_REGION_CN779 3
+#define LORAMAC_REGION_EU433 4
+#define LORAMAC_REGION_EU868 5
+#define LORAMAC_REGION_KR920 6
+#define LORAMAC_REGION_IN865 7
+#define LORAMAC_REGION_US915 8
+
+void lmh_join(void);
+lmh_join_status lmh_join_status_get(void);
+void lmh_datarate_set(uint8_t data_rate, bool enable_adr);
+
+/** LoRaMAC query of the payload that fits the current data rate */
+typedef enum
+{
+	LORAMAC_STATUS_OK = 0,
+	LORAMAC_STATUS_PARAMETER_INVALID = 3,
+	LORAMAC_STATUS_LENGTH_ERROR = 8,
+} LoRaMacStatus_t;
+
+typedef struct sLoRaMacTxInfo
+{
+	uint8_t MaxPossiblePayload;
+	uint8_t CurrentPayloadSize;
+} LoRaMacTxInfo_t;
+
+LoRaMacStatus_t LoRaMacQueryTxPossible(uint8_t size, LoRaMacTxInfo_t *txInfo);
+
+/** LoRaMAC query of the current data rate, the only MIB the application reads */
+typedef enum
+{
+	MIB_CHANNELS_DATARATE = 19,
+} Mib_t;
+
+typedef union uMibParam
+{
+	int8_t ChannelsDatarate;
+} MibParam_t;
+
+typedef struct sMibRequestConfirm
+{
+	Mib_t Type;
+	MibParam_t Param;
+} MibRequestConfirm_t;
+
+LoRaMacStatus_t LoRaMacMibGetRequestConfirm(MibRequestConfirm_t *mibGet);
+
+/** LoRaWAN settings as stored by the API */
+#define LORAWAN_DATA_MARKER 0x57
+struct s_lorawan_settings
+{
+	uint8_t valid_mark_1 = 0xAA;
+	uint8_t valid_mark_2 = LORAWAN_DATA_MARKER;
+	uint8_t node_device_eui[8] = {0};
+	uint8_t node_app_eui[8] = {0};
+	uint8_t node_app_key[16] = {0};
+	uint32_t node_dev_addr = 0;
+	uint8_t node_nws_key[16] = {0};
+	uint8_t node_apps_key[16] = {0};
+	bool otaa_enabled = true;
+	bool adr_enabled = false;
+	bool public_network = true;
+	bool duty_cycle_enabled = false;
+	uint32_t send_repeat_time = 120000;
+	uint8_t join_trials = 5;
+	uint8_t tx_power = 0;
+	uint8_t data_rate = 3;
+	uint8_t lora_class = 0;
+	uint8_t subband_channels = 1;
+	bool auto_join = true;
+	uint8_t app_port = 2;
+	lmh_confirm confirmed_msg_enabled = LMH_UNCONFIRMED_MSG;
+	uint8_t resetRequest = true;
+	uint8_t lora_region = LORAMAC_REGION_EU868;
+};
+extern s_lorawan_settings g_lorawan_settings;
+
+extern uint8_t g_rx_lora_data[256];
+extern uint8_t g_rx_data_len;
+extern bool g_rx_fin_result;
+extern bool g_join_result;
+extern int16_t g_last_rssi;
+extern int8_t g_last_snr;
+extern bool g_lpwan_has_joined;
+extern bool g_lorawan_initialized;
+
+int8_t init_lorawan(void);
+lmh_error_status send_lora_packet(uint8_t *data, uint8_t size);
+
+/** BLE */
+class BLEUart : public Print
+{
+public:
+	int available(void);
+	int read(void);
+	size_t write(uint8_t c);
+	using Print::write;
+};
+extern BLEUart g_ble_uart;
+extern bool g_ble_uart_is_connected;
+extern char g_ble_dev_name[];
+extern bool g_enable_ble;
+void restart_advertising(uint16_t timeout);
+
+/** AT command interpreter */
+#define AT_ERRNO_NOSUPP (1)
+#define AT_ERRNO_NOALLOW (2)
+#define AT_ERRNO_PARA_VAL (5)
+#define AT_ERRNO_PARA_NUM (6)
+#define AT_ERRNO_EXEC_FAIL (7)
+#define AT_ERRNO_SYS (8)
+#define AT_CB_PRINT (0xFF)
+#define ATQUERY_SIZE 128
+
+/** Output of AT commands that don't fit g_at_query_buf */
+#define AT_PRINTF(...)                  \
+	do                                  \
+	{                                   \
+		Serial.printf(__VA_ARGS__);     \
+		if (g_ble_uart_is_connected)    \
+		{                               \
+			g_ble_uart.printf(__VA_ARGS__); \
+		}                               \
+	} while (0)
+
+typedef struct atcmd_s
+{
+	const char *cmd_name;
+	const char *cmd_desc;
+	int (*query_cmd)(void);
+	int (*exec_cmd)(char *str);
+	int (*exec_cmd_no_para)(void);
+} atcmd_t;
+
+extern char g_at_query_buf[ATQUERY_SIZE];
+void at_serial_input(uint8_t cmd);
+
+/** Battery */
+float read_batt(void);
+uint8_t mv_to_percent(float mvolts);
+uint8_t get_lora_batt(void);
+
+void api_set_version(uint16_t sw_1 = 1, uint16_t sw_2 = 0, uint16_t sw_3 = 0);
+
+/** SoftDevice */
+void sd_nvic_SystemReset(void);
+
+/** Application hooks the API calls */
+void setup_app(void);
+bool init_app(void);
+void app_event_handler(void);
+void ble_data_handler(void) __attribute__((weak));
+void lora_data_handler(void);
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file nrfx_spim.h
+ * @brief Host stand-in for the nrfx SPIM driver of the nRF52 core. A
+ *        transfer hands its bytes to the simulated SPI bus at once and
+ *        reports the end after the time it takes on the bus, the handler
+ *        runs like the SPIM interrupt.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_NRFX_SPIM_H
+#define SIM_NRFX_SPIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int nrfx_err_t;
+#define NRFX_SUCCESS 0
+#define NRFX_ERROR_BUSY 1
+#define NRFX_ERROR_INVALID_STATE 2
+
+/** Clock in Hz, the core has the register values */
+typedef enum
+{
+	NRF_SPIM_FREQ_125K = 125000,
+	NRF_SPIM_FREQ_250K = 250000,
+	NRF_SPIM_FREQ_500K = 500000,
+	NRF_SPIM_FREQ_1M = 1000000,
+	NRF_SPIM_FREQ_2M = 2000000,
+	NRF_SPIM_FREQ_4M = 4000000,
+	NRF_SPIM_FREQ_8M = 8000000,
+	NRF_SPIM_FREQ_16M = 16000000,
+	NRF_SPIM_FREQ_32M = 32000000
+} nrf_spim_frequency_t;
+
+typedef enum
+{
+	NRF_SPIM_MODE_0,
+	NRF_SPIM_MODE_1,
+	NRF_SPIM_MODE_2,
+	NRF_SPIM_MODE_3
+} nrf_spim_mode_t;
+
+typedef enum
+{
+	NRF_SPIM_BIT_ORDER_MSB_FIRST,
+	NRF_SPIM_BIT_ORDER_LSB_FIRST
+} nrf_spim_bit_order_t;
+
+typedef struct
+{
+	void *p_reg;
+	uint8_t drv_inst_idx;
+} nrfx_spim_t;
+#define NRFX_SPIM_INSTANCE(id) {NULL, id}
+
+#define NRFX_SPIM_PIN_NOT_USED 0xFF
+
+typedef struct
+{
+	uint8_t sck_pin;
+	uint8_t mosi_pin;
+	uint8_t miso_pin;
+	uint8_t ss_pin;
+	bool ss_active_high;
+	uint8_t irq_priority;
+	uint8_t orc;
+	nrf_spim_frequency_t frequency;
+	nrf_spim_mode_t mode;
+	nrf_spim_bit_order_t bit_order;
+} nrfx_spim_config_t;
+
+#define NRFX_SPIM_DEFAULT_CONFIG                                                                        \
+	{                                                                                                   \
+		NRFX_SPIM_PIN_NOT_USED, NRFX_SPIM_PIN_NOT_USED, NRFX_SPIM_PIN_NOT_USED, NRFX_SPIM_PIN_NOT_USED, \
+			false, 7, 0xFF, NRF_SPIM_FREQ_4M, NRF_SPIM_MODE_0, NRF_SPIM_BIT_ORDER_MSB_FIRST             \
+	}
+
+typedef struct
+{
+	uint8_t const *p_tx_buffer;
+	size_t tx_length;
+	uint8_t *p_rx_buffer;
+	size_t rx_length;
+} nrfx_spim_xfer_desc_t;
+
+#define NRFX_SPIM_XFER_TX(p_buf, length) {(uint8_t const *)(p_buf), (length), NULL, 0}
+
+typedef enum
+{
+	NRFX_SPIM_EVENT_DONE
+} nrfx_spim_evt_type_t;
+
+typedef struct
+{
+	nrfx_spim_evt_type_t type;
+	nrfx_spim_xfer_desc_t xfer_desc;
+} nrfx_spim_evt_t;
+
+typedef void (*nrfx_spim_evt_handler_t)(nrfx_spim_evt_t const *p_event, void *p_context);
+
+nrfx_err_t nrfx_spim_init(nrfx_spim_t const *p_instance, nrfx_spim_config_t const *p_config,
+						  nrfx_spim_evt_handler_t handler, void *p_context);
+void nrfx_spim_uninit(nrfx_spim_t const *p_instance);
+nrfx_err_t nrfx_spim_xfer(nrfx_spim_t const *p_instance, nrfx_spim_xfer_desc_t const *p_xfer_desc, uint32_t flags);
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file rtos.h
+ * @brief Host stand-in for the FreeRTOS pieces and the SoftwareTimer class
+ *        the nRF52 Arduino core exposes through Arduino.h. Timers run on the
+ *        simulation clock.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_RTOS_H
+#define SIM_RTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *SemaphoreHandle_t;
+typedef void *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *parameters);
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+
+/** Task priorities of the nRF52 core */
+#define TASK_PRIO_LOWEST 0
+#define TASK_PRIO_LOW 1
+#define TASK_PRIO_NORMAL 2
+#define TASK_PRIO_HIGH 3
+
+/** Tasks don't run in the simulation, the main loop calls their work instead */
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint16_t stack_depth, void *parameters,
+					   UBaseType_t priority, TaskHandle_t *created_task);
+
+void taskENTER_CRITICAL(void);
+void taskEXIT_CRITICAL(void);
+UBaseType_t taskENTER_CRITICAL_FROM_ISR(void);
+void taskEXIT_CRITICAL_FROM_ISR(UBaseType_t saved);
+
+/** Simulation hooks driving the software timers from the simulation clock */
+void sim_timers_run(uint64_t now_us);
+uint64_t sim_timers_next_us(void);
+
+class SoftwareTimer
+{
+public:
+	SoftwareTimer() {}
+	void begin(uint32_t ms, TimerCallbackFunction_t callback, void *timerID = NULL, bool repeating = true);
+	TimerHandle_t getHandle(void) { return (TimerHandle_t)this; }
+	void setID(void *id) { _id = id; }
+	void *getID(void) { return _id; }
+	void start(void);
+	void stop(void);
+	void reset(void) { start(); }
+	void setPeriod(uint32_t ms);
+	bool isActive(void) const { return _active; }
+
+	/** Simulation hooks */
+	uint64_t due_us(void) const { return _due_us; }
+	void fire(void);
+
+private:
+	uint32_t _period_ms = 0;
+	TimerCallbackFunction_t _callback = NULL;
+	void *_id = NULL;
+	bool _repeating = true;
+	bool _active = false;
+	uint64_t _due_us = 0;
+	SoftwareTimer *_next = NULL;
+	friend void sim_timers_run(uint64_t now_us);
+	friend uint64_t sim_timers_next_us(void);
+};
+
+/** Reads the timer ID stored with SoftwareTimer::setID() */
+void *pvTimerGetTimerID(TimerHandle_t xTimer);
+
+#endif
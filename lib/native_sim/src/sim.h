@@ -0,0 +1,119 @@
+/**
+ * @file sim.h
+ * @brief Simulation clock, bus counters and hardware model registry shared
+ *        by the host stand-ins of the native environment
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** Bus and storage traffic, reset never; the report works on deltas */
+struct s_sim_counters
+{
+	uint32_t spi_bytes = 0;
+	uint32_t spi_dma_transfers = 0;
+	uint32_t spi_dma_bytes = 0;
+	uint64_t spi_dma_us = 0;
+	uint32_t i2c_transactions = 0;
+	uint32_t i2c_bytes = 0;
+	uint32_t flash_bytes_written = 0;
+	uint32_t flash_bytes_read = 0;
+	uint32_t flash_files_removed = 0;
+	uint32_t epd_ram_bytes = 0;
+	uint32_t epd_full_refreshes = 0;
+	uint32_t epd_partial_refreshes = 0;
+	uint32_t lora_tx = 0;
+	uint32_t lora_tx_bytes = 0;
+	uint32_t lora_tx_rejected = 0;
+	uint64_t lora_tx_airtime_us = 0;
+	uint32_t lora_rx = 0;
+	uint32_t lora_joins = 0;
+	uint32_t resets = 0;
+};
+extern s_sim_counters g_sim;
+
+/** Verbose output of MYLOG/API_LOG on stdout */
+extern bool g_sim_verbose;
+void sim_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief A hardware model that wants to run at a point of simulated time
+ */
+class SimModel
+{
+public:
+	virtual ~SimModel() {}
+	/** Absolute time of the next thing the model has to do, UINT64_MAX if idle */
+	virtual uint64_t next_event_us(void) = 0;
+	/** Called with the clock set to next_event_us() */
+	virtual void run(uint64_t now_us) = 0;
+};
+void sim_register_model(SimModel *model);
+
+/** Simulation clock */
+uint64_t sim_now_us(void);
+void sim_advance_to(uint64_t until_us);
+uint64_t sim_next_event_us(void);
+
+/** Pin level driven by a model (inputs of the MCU), fires attached ISRs */
+void sim_set_input(uint32_t pin, int level);
+/** Observe MCU driven pins */
+typedef void (*sim_pin_hook_t)(uint32_t pin, int level);
+void sim_add_pin_hook(sim_pin_hook_t hook);
+/** Hardware SPI bytes are forwarded here */
+typedef uint8_t (*sim_spi_hook_t)(uint8_t data);
+void sim_set_spi_hook(sim_spi_hook_t hook);
+
+/** I2C device on the simulated Wire bus */
+class SimI2CDevice
+{
+public:
+	virtual ~SimI2CDevice() {}
+	virtual void i2c_write(const uint8_t *data, size_t len) = 0;
+	virtual size_t i2c_read(uint8_t *data, size_t len) = 0;
+};
+void sim_add_i2c_device(uint8_t address, SimI2CDevice *device);
+
+/** Models */
+/** SSD1680 controller RAM is 176 sources x 296 gates */
+#define SSD1680_RAM_X_BYTES 22
+#define SSD1680_RAM_Y 296
+void sim_ssd1680_attach(uint32_t cs, uint32_t dc, uint32_t sck, uint32_t mosi, uint32_t busy);
+const uint8_t *sim_ssd1680_bw_ram(uint16_t *row_bytes, uint16_t *rows);
+const uint8_t *sim_ssd1680_red_ram(uint16_t *row_bytes, uint16_t *rows);
+void sim_lis3dh_attach(void);
+bool sim_lis3dh_load_trace(const char *path);
+void sim_lis3dh_synthetic_trace(uint32_t duration_ms);
+void sim_lorawan_queue_downlink(const uint8_t *data, uint8_t len);
+void sim_lorawan_set_tx_fail_rate(uint8_t percent);
+/** Uplinks as the fake LoRaMAC puts them on air */
+typedef void (*sim_uplink_hook_t)(const uint8_t *data, uint8_t size);
+void sim_lorawan_set_uplink_hook(sim_uplink_hook_t hook);
+
+/** Boot the firmware and run it, main() of the simulation does the same
+ *  with the script and trace of its command line */
+void sim_start(void);
+void sim_run(uint32_t duration_ms);
+
+/**
+ * @brief Mark a stretch of the scenario where the device is expected to do
+ *        expensive work (gesture, AT command, downlink). Refreshes and
+ *        uplinks outside of all labels are reported as false wakeups.
+ */
+void sim_label(uint32_t start_ms, uint32_t end_ms, const char *label);
+/** Time after a label in which the work still counts as expected, -l of main() */
+void sim_label_slack(uint32_t slack_ms);
+/** False wakeups since the start */
+uint32_t sim_false_wakes(void);
+
+/** RAM backed file system */
+void sim_fs_dump(void);
+
+#endif
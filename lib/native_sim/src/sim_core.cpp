@@ -0,0 +1,561 @@
+/**
+ * @file sim_core.cpp
+ * @brief Simulation clock, GPIO/interrupt, SPI, I2C and RTOS stand-ins
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <vector>
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#include "sim.h"
+
+s_sim_counters g_sim;
+bool g_sim_verbose = false;
+
+SimSerial Serial;
+SPIClass SPI;
+
+const uint32_t g_ADigitalPinMap[SIM_NUM_PINS] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+	32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63};
+TwoWire Wire;
+
+/** Simulation clock in microseconds */
+static uint64_t s_now_us = 0;
+static std::vector<SimModel *> s_models;
+
+/** GPIO */
+static int s_pin_level[SIM_NUM_PINS];
+static voidFuncPtr s_pin_isr[SIM_NUM_PINS];
+static uint32_t s_pin_isr_mode[SIM_NUM_PINS];
+static std::vector<sim_pin_hook_t> s_pin_hooks;
+static sim_spi_hook_t s_spi_hook = NULL;
+
+/** Interrupts masked by noInterrupts(), ISRs raised meanwhile are deferred */
+static int s_irq_masked = 0;
+static std::vector<voidFuncPtr> s_irq_pending;
+
+/** I2C devices */
+static SimI2CDevice *s_i2c_devices[128];
+
+void sim_log(const char *format, ...)
+{
+	if (!g_sim_verbose)
+	{
+		return;
+	}
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
+
+void sim_register_model(SimModel *model)
+{
+	s_models.push_back(model);
+}
+
+uint64_t sim_now_us(void)
+{
+	return s_now_us;
+}
+
+uint64_t sim_next_event_us(void)
+{
+	uint64_t next = sim_timers_next_us();
+	for (size_t idx = 0; idx < s_models.size(); idx++)
+	{
+		uint64_t due = s_models[idx]->next_event_us();
+		if (due < next)
+		{
+			next = due;
+		}
+	}
+	return next;
+}
+
+/**
+ * @brief Move the clock forward, running every model and timer that
+ *        becomes due on the way
+ *
+ * @param until_us absolute time to stop at
+ */
+void sim_advance_to(uint64_t until_us)
+{
+	while (true)
+	{
+		uint64_t next = sim_next_event_us();
+		if ((next > until_us) || (next == UINT64_MAX))
+		{
+			break;
+		}
+		if (next > s_now_us)
+		{
+			s_now_us = next;
+		}
+		sim_timers_run(s_now_us);
+		for (size_t idx = 0; idx < s_models.size(); idx++)
+		{
+			if (s_models[idx]->next_event_us() <= s_now_us)
+			{
+				s_models[idx]->run(s_now_us);
+			}
+		}
+	}
+	if (until_us > s_now_us)
+	{
+		s_now_us = until_us;
+	}
+}
+
+uint32_t millis(void)
+{
+	return (uint32_t)(s_now_us / 1000);
+}
+
+uint32_t micros(void)
+{
+	return (uint32_t)s_now_us;
+}
+
+void delay(uint32_t ms)
+{
+	sim_advance_to(s_now_us + (uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+	sim_advance_to(s_now_us + us);
+}
+
+void yield(void)
+{
+}
+
+static void raise_isr(voidFuncPtr isr)
+{
+	if (s_irq_masked)
+	{
+		s_irq_pending.push_back(isr);
+		return;
+	}
+	isr();
+}
+
+void noInterrupts(void)
+{
+	s_irq_masked++;
+}
+
+void interrupts(void)
+{
+	if (s_irq_masked > 0)
+	{
+		s_irq_masked--;
+	}
+	while ((s_irq_masked == 0) && !s_irq_pending.empty())
+	{
+		voidFuncPtr isr = s_irq_pending.front();
+		s_irq_pending.erase(s_irq_pending.begin());
+		isr();
+	}
+}
+
+void pinMode(uint32_t pin, uint32_t mode)
+{
+	if ((pin < SIM_NUM_PINS) && (mode == INPUT_PULLUP))
+	{
+		s_pin_level[pin] = HIGH;
+	}
+}
+
+void digitalWrite(uint32_t pin, uint32_t val)
+{
+	if (pin >= SIM_NUM_PINS)
+	{
+		return;
+	}
+	s_pin_level[pin] = val ? HIGH : LOW;
+	for (size_t idx = 0; idx < s_pin_hooks.size(); idx++)
+	{
+		s_pin_hooks[idx](pin, s_pin_level[pin]);
+	}
+}
+
+int digitalRead(uint32_t pin)
+{
+	return (pin < SIM_NUM_PINS) ? s_pin_level[pin] : LOW;
+}
+
+uint32_t analogRead(uint32_t pin)
+{
+	(void)pin;
+	return 0;
+}
+
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode)
+{
+	if (pin < SIM_NUM_PINS)
+	{
+		s_pin_isr[pin] = callback;
+		s_pin_isr_mode[pin] = mode;
+	}
+}
+
+void detachInterrupt(uint32_t pin)
+{
+	if (pin < SIM_NUM_PINS)
+	{
+		s_pin_isr[pin] = NULL;
+	}
+}
+
+void sim_set_input(uint32_t pin, int level)
+{
+	if (pin >= SIM_NUM_PINS)
+	{
+		return;
+	}
+	int old_level = s_pin_level[pin];
+	s_pin_level[pin] = level ? HIGH : LOW;
+	if ((s_pin_isr[pin] == NULL) || (old_level == s_pin_level[pin]))
+	{
+		return;
+	}
+	uint32_t mode = s_pin_isr_mode[pin];
+	if ((mode == CHANGE) || ((mode == RISING) && s_pin_level[pin]) || ((mode == FALLING) && !s_pin_level[pin]))
+	{
+		raise_isr(s_pin_isr[pin]);
+	}
+}
+
+void sim_add_pin_hook(sim_pin_hook_t hook)
+{
+	s_pin_hooks.push_back(hook);
+}
+
+void sim_set_spi_hook(sim_spi_hook_t hook)
+{
+	s_spi_hook = hook;
+}
+
+long random(long max)
+{
+	return (max <= 0) ? 0 : (rand() % max);
+}
+
+long random(long min, long max)
+{
+	return (max <= min) ? min : (min + rand() % (max - min));
+}
+
+void randomSeed(unsigned long seed)
+{
+	srand(seed);
+}
+
+/** Print */
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--)
+	{
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::print(long n, int base)
+{
+	char buf[34];
+	if (base == DEC)
+	{
+		snprintf(buf, sizeof(buf), "%ld", n);
+	}
+	else
+	{
+		return print((unsigned long)n, base);
+	}
+	return write(buf);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+	char buf[34];
+	snprintf(buf, sizeof(buf), (base == HEX) ? "%lX" : (base == OCT) ? "%lo" : "%lu", n);
+	return write(buf);
+}
+
+size_t Print::print(double n, int digits)
+{
+	char buf[40];
+	snprintf(buf, sizeof(buf), "%.*f", digits, n);
+	return write(buf);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+	char buf[256];
+	va_list args;
+	va_start(args, format);
+	int len = vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+	if (len < 0)
+	{
+		return 0;
+	}
+	return write((const uint8_t *)buf, (len < (int)sizeof(buf)) ? len : sizeof(buf) - 1);
+}
+
+size_t SimSerial::write(uint8_t c)
+{
+	if (g_sim_verbose)
+	{
+		putchar(c);
+	}
+	return 1;
+}
+
+/** SPI */
+uint8_t SPIClass::transfer(uint8_t data)
+{
+	g_sim.spi_bytes++;
+	return (s_spi_hook != NULL) ? s_spi_hook(data) : 0xFF;
+}
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+	uint8_t *data = (uint8_t *)buf;
+	for (size_t idx = 0; idx < count; idx++)
+	{
+		data[idx] = transfer(data[idx]);
+	}
+}
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+	uint16_t high = transfer(data >> 8);
+	return (high << 8) | transfer(data & 0xFF);
+}
+
+/** I2C */
+void TwoWire::beginTransmission(uint8_t address)
+{
+	_address = address & 0x7F;
+	_tx_len = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool stopBit)
+{
+	(void)stopBit;
+	SimI2CDevice *device = s_i2c_devices[_address];
+	g_sim.i2c_transactions++;
+	g_sim.i2c_bytes += _tx_len + 1;
+	if (device == NULL)
+	{
+		// NACK on address
+		return 2;
+	}
+	device->i2c_write(_tx_buf, _tx_len);
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+{
+	(void)stopBit;
+	SimI2CDevice *device = s_i2c_devices[address & 0x7F];
+	g_sim.i2c_transactions++;
+	if (quantity > WIRE_BUFFER_SIZE)
+	{
+		quantity = WIRE_BUFFER_SIZE;
+	}
+	_rx_idx = 0;
+	_rx_len = (device == NULL) ? 0 : device->i2c_read(_rx_buf, quantity);
+	g_sim.i2c_bytes += _rx_len + 1;
+	return _rx_len;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+	if (_tx_len >= WIRE_BUFFER_SIZE)
+	{
+		return 0;
+	}
+	_tx_buf[_tx_len++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+	size_t n = 0;
+	while (quantity--)
+	{
+		n += write(*data++);
+	}
+	return n;
+}
+
+void sim_add_i2c_device(uint8_t address, SimI2CDevice *device)
+{
+	s_i2c_devices[address & 0x7F] = device;
+}
+
+/** RTOS */
+static int s_sem_count[8];
+static int s_sem_num = 0;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+	return (SemaphoreHandle_t)&s_sem_count[s_sem_num++ & 7];
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+	*(int *)sem = 1;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken)
+{
+	if (higher_priority_task_woken != NULL)
+	{
+		*higher_priority_task_woken = pdTRUE;
+	}
+	return xSemaphoreGive(sem);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+	(void)ticks;
+	if (*(int *)sem == 0)
+	{
+		return pdFALSE;
+	}
+	*(int *)sem = 0;
+	return pdTRUE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint16_t stack_depth, void *parameters,
+					   UBaseType_t priority, TaskHandle_t *created_task)
+{
+	(void)code;
+	(void)name;
+	(void)stack_depth;
+	(void)parameters;
+	(void)priority;
+	if (created_task != NULL)
+	{
+		*created_task = NULL;
+	}
+	return pdPASS;
+}
+
+void taskENTER_CRITICAL(void)
+{
+	noInterrupts();
+}
+
+void taskEXIT_CRITICAL(void)
+{
+	interrupts();
+}
+
+UBaseType_t taskENTER_CRITICAL_FROM_ISR(void)
+{
+	noInterrupts();
+	return 0;
+}
+
+void taskEXIT_CRITICAL_FROM_ISR(UBaseType_t saved)
+{
+	(void)saved;
+	interrupts();
+}
+
+static SoftwareTimer *s_timers = NULL;
+
+void SoftwareTimer::begin(uint32_t ms, TimerCallbackFunction_t callback, void *timerID, bool repeating)
+{
+	_period_ms = ms;
+	_callback = callback;
+	_id = timerID;
+	_repeating = repeating;
+	for (SoftwareTimer *timer = s_timers; timer != NULL; timer = timer->_next)
+	{
+		if (timer == this)
+		{
+			return;
+		}
+	}
+	_next = s_timers;
+	s_timers = this;
+}
+
+void SoftwareTimer::start(void)
+{
+	_active = true;
+	_due_us = s_now_us + (uint64_t)_period_ms * 1000;
+}
+
+void SoftwareTimer::stop(void)
+{
+	_active = false;
+}
+
+void SoftwareTimer::setPeriod(uint32_t ms)
+{
+	_period_ms = ms;
+	// FreeRTOS xTimerChangePeriod() also starts the timer
+	start();
+}
+
+void SoftwareTimer::fire(void)
+{
+	if (_repeating)
+	{
+		_due_us += (uint64_t)_period_ms * 1000;
+	}
+	else
+	{
+		_active = false;
+	}
+	if (_callback != NULL)
+	{
+		_callback(getHandle());
+	}
+}
+
+void *pvTimerGetTimerID(TimerHandle_t xTimer)
+{
+	return ((SoftwareTimer *)xTimer)->getID();
+}
+
+uint64_t sim_timers_next_us(void)
+{
+	uint64_t next = UINT64_MAX;
+	for (SoftwareTimer *timer = s_timers; timer != NULL; timer = timer->_next)
+	{
+		if (timer->_active && (timer->_due_us < next))
+		{
+			next = timer->_due_us;
+		}
+	}
+	return next;
+}
+
+void sim_timers_run(uint64_t now_us)
+{
+	for (SoftwareTimer *timer = s_timers; timer != NULL; timer = timer->_next)
+	{
+		if (timer->_active && (timer->_due_us <= now_us))
+		{
+			timer->fire();
+		}
+	}
+}
@@ -0,0 +1,645 @@
+/**
+ * @file sim_lis3dh.cpp
+ * @brief Scripted LIS3DH on the simulated I2C bus. Replays an accelerometer
+ *        trace (CSV of t_ms,x_mg,y_mg,z_mg or a built-in synthetic one) at
+ *        the configured ODR and models the output registers, the 32 level
+ *        FIFO, the AOI1 generator, the click engine and the INT1 pin.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <vector>
+
+#include <Arduino.h>
+
+#include "sim.h"
+
+#define LIS3DH_ADDRESS 0x18
+#define LIS3DH_INT1 WB_IO3
+#define LIS3DH_FIFO_DEPTH 32
+
+struct s_trace_point
+{
+	uint32_t t_ms;
+	int16_t mg[3];
+};
+
+class SimLIS3DH : public SimModel, public SimI2CDevice
+{
+public:
+	std::vector<s_trace_point> trace;
+
+	SimLIS3DH()
+	{
+		memset(_reg, 0, sizeof(_reg));
+		_reg[0x0F] = 0x33;
+		_reg[0x20] = 0x07;
+	}
+
+	/** Drop the trace, the next one starts from its first point */
+	void clear_trace(void)
+	{
+		trace.clear();
+		_trace_idx = 0;
+	}
+
+	uint64_t next_event_us(void)
+	{
+		uint32_t period = period_us();
+		if (period == 0)
+		{
+			return UINT64_MAX;
+		}
+		if (_next_sample_us == 0)
+		{
+			_next_sample_us = sim_now_us() + period;
+		}
+		return _next_sample_us;
+	}
+
+	void run(uint64_t now_us)
+	{
+		uint32_t period = period_us();
+		_next_sample_us = (period == 0) ? 0 : now_us + period;
+		sample(now_us);
+	}
+
+	void i2c_write(const uint8_t *data, size_t len)
+	{
+		if (len == 0)
+		{
+			return;
+		}
+		_ptr = data[0] & 0x7F;
+		_auto_inc = data[0] & 0x80;
+		for (size_t idx = 1; idx < len; idx++)
+		{
+			write_reg(_ptr, data[idx]);
+			next_ptr();
+		}
+	}
+
+	size_t i2c_read(uint8_t *data, size_t len)
+	{
+		for (size_t idx = 0; idx < len; idx++)
+		{
+			data[idx] = read_reg(_ptr);
+			next_ptr();
+		}
+		update_int1();
+		return len;
+	}
+
+private:
+	uint8_t _reg[0x40];
+	uint8_t _ptr = 0;
+	bool _auto_inc = false;
+	uint64_t _next_sample_us = 0;
+	size_t _trace_idx = 0;
+
+	int16_t _fifo[LIS3DH_FIFO_DEPTH][3];
+	uint8_t _fifo_count = 0;
+	bool _fifo_overrun = false;
+	int16_t _out[3] = {0, 0, 0};
+
+	/** High pass filter state in mg */
+	int32_t _lp[3] = {0, 0, 0};
+	bool _lp_valid = false;
+
+	bool _ia1 = false;
+	uint8_t _ia1_src = 0;
+	uint8_t _ia1_count = 0;
+
+	uint8_t _click_src = 0;
+	uint8_t _click_state = 0;
+	uint16_t _click_count = 0;
+	uint16_t _click_gap = 0;
+
+	uint32_t period_us(void)
+	{
+		static const uint16_t odr_hz[] = {0, 1, 10, 25, 50, 100, 200, 400, 1600, 1344};
+		uint8_t odr = _reg[0x20] >> 4;
+		if ((odr == 0) || (odr > 9))
+		{
+			return 0;
+		}
+		return 1000000UL / odr_hz[odr];
+	}
+
+	/** mg per LSB of the threshold registers */
+	uint16_t ths_lsb_mg(void)
+	{
+		static const uint16_t lsb[] = {16, 32, 62, 186};
+		return lsb[(_reg[0x23] >> 4) & 0x03];
+	}
+
+	/** mg per digit of the 10 bit normal mode output */
+	uint16_t out_lsb_mg(void)
+	{
+		static const uint16_t lsb[] = {4, 8, 16, 48};
+		return lsb[(_reg[0x23] >> 4) & 0x03];
+	}
+
+	bool fifo_enabled(void)
+	{
+		return (_reg[0x24] & 0x40) && ((_reg[0x2E] >> 6) != 0);
+	}
+
+	void next_ptr(void)
+	{
+		if (!_auto_inc)
+		{
+			return;
+		}
+		// With the FIFO enabled a burst rolls back from OUT_Z_H to OUT_X_L
+		if ((_ptr == 0x2D) && fifo_enabled())
+		{
+			_ptr = 0x28;
+			return;
+		}
+		_ptr = (_ptr + 1) & 0x3F;
+	}
+
+	void write_reg(uint8_t reg, uint8_t value)
+	{
+		if ((reg == 0x0F) || (reg == 0x2F) || (reg == 0x31) || (reg == 0x39) || ((reg >= 0x28) && (reg <= 0x2D)))
+		{
+			return;
+		}
+		_reg[reg] = value;
+		if (reg == 0x2E)
+		{
+			// Changing the FIFO mode through bypass empties it
+			if ((value >> 6) == 0)
+			{
+				_fifo_count = 0;
+				_fifo_overrun = false;
+			}
+		}
+		update_int1();
+	}
+
+	uint8_t read_reg(uint8_t reg)
+	{
+		if ((reg >= 0x28) && (reg <= 0x2D))
+		{
+			int16_t raw = _out[(reg - 0x28) / 2];
+			uint8_t value = (reg & 0x01) ? (uint8_t)(raw >> 8) : (uint8_t)(raw & 0xFF);
+			if ((reg == 0x2D) && fifo_enabled())
+			{
+				fifo_pop();
+			}
+			return value;
+		}
+		switch (reg)
+		{
+		case 0x27:
+			return 0x0F;
+		case 0x2F:
+		{
+			uint8_t fth = _reg[0x2E] & 0x1F;
+			uint8_t src = (_fifo_count >= LIS3DH_FIFO_DEPTH) ? 0x1F : _fifo_count;
+			if (_fifo_count == 0)
+			{
+				src |= 0x20;
+			}
+			if (_fifo_overrun)
+			{
+				src |= 0x40;
+			}
+			if ((fth != 0) && (_fifo_count > fth))
+			{
+				src |= 0x80;
+			}
+			return src;
+		}
+		case 0x31:
+		{
+			uint8_t src = _ia1_src | (_ia1 ? 0x40 : 0x00);
+			if (_reg[0x24] & 0x08)
+			{
+				// Latched, cleared by reading INT1_SRC
+				_ia1 = false;
+				_ia1_src = 0;
+			}
+			return src;
+		}
+		case 0x39:
+		{
+			uint8_t src = _click_src;
+			_click_src = 0;
+			return src;
+		}
+		default:
+			return _reg[reg];
+		}
+	}
+
+	void fifo_pop(void)
+	{
+		if (_fifo_count == 0)
+		{
+			return;
+		}
+		memmove(&_fifo[0], &_fifo[1], sizeof(_fifo[0]) * (_fifo_count - 1));
+		_fifo_count--;
+		_fifo_overrun = false;
+		if (_fifo_count > 0)
+		{
+			memcpy(_out, _fifo[0], sizeof(_out));
+		}
+	}
+
+	void trace_at(uint64_t now_us, int16_t mg[3])
+	{
+		uint32_t now_ms = (uint32_t)(now_us / 1000);
+		if (trace.empty())
+		{
+			mg[0] = 0;
+			mg[1] = 0;
+			mg[2] = 1000;
+			return;
+		}
+		while ((_trace_idx + 1 < trace.size()) && (trace[_trace_idx + 1].t_ms <= now_ms))
+		{
+			_trace_idx++;
+		}
+		memcpy(mg, trace[_trace_idx].mg, sizeof(trace[_trace_idx].mg));
+	}
+
+	void sample(uint64_t now_us)
+	{
+		int16_t mg[3];
+		trace_at(now_us, mg);
+
+		int16_t raw[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			int32_t digits = mg[axis] / out_lsb_mg();
+			if (digits > 511)
+			{
+				digits = 511;
+			}
+			if (digits < -512)
+			{
+				digits = -512;
+			}
+			raw[axis] = (int16_t)(digits * 64);
+		}
+
+		if (fifo_enabled())
+		{
+			if (_fifo_count < LIS3DH_FIFO_DEPTH)
+			{
+				memcpy(_fifo[_fifo_count++], raw, sizeof(raw));
+			}
+			else if ((_reg[0x2E] >> 6) >= 2)
+			{
+				// Stream mode drops the oldest sample
+				memmove(&_fifo[0], &_fifo[1], sizeof(_fifo[0]) * (LIS3DH_FIFO_DEPTH - 1));
+				memcpy(_fifo[LIS3DH_FIFO_DEPTH - 1], raw, sizeof(raw));
+				_fifo_overrun = true;
+			}
+			else
+			{
+				_fifo_overrun = true;
+			}
+			memcpy(_out, _fifo[0], sizeof(_out));
+		}
+		else
+		{
+			memcpy(_out, raw, sizeof(_out));
+		}
+
+		// High pass filtered values for the interrupt generators
+		int32_t hp[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (!_lp_valid)
+			{
+				_lp[axis] = mg[axis];
+			}
+			hp[axis] = mg[axis] - _lp[axis];
+			_lp[axis] += (mg[axis] - _lp[axis]) / 8;
+		}
+		_lp_valid = true;
+
+		aoi1(mg, hp);
+		click(hp);
+		update_int1();
+	}
+
+	void aoi1(const int16_t mg[3], const int32_t hp[3])
+	{
+		uint8_t cfg = _reg[0x30];
+		int32_t ths = (int32_t)(_reg[0x32] & 0x7F) * ths_lsb_mg();
+		uint8_t src = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			int32_t value = (_reg[0x21] & 0x01) ? hp[axis] : mg[axis];
+			if ((cfg & (0x02 << (axis * 2))) && (abs(value) > ths))
+			{
+				src |= 0x02 << (axis * 2);
+			}
+			if ((cfg & (0x01 << (axis * 2))) && (abs(value) <= ths))
+			{
+				src |= 0x01 << (axis * 2);
+			}
+		}
+		bool event = (cfg & 0x80) ? (src == (cfg & 0x3F)) && (src != 0) : (src != 0);
+		if (event)
+		{
+			if (_ia1_count <= (_reg[0x33] & 0x7F))
+			{
+				_ia1_count++;
+			}
+			if (_ia1_count > (_reg[0x33] & 0x7F))
+			{
+				_ia1 = true;
+				_ia1_src |= src;
+			}
+		}
+		else
+		{
+			_ia1_count = 0;
+			if (!(_reg[0x24] & 0x08))
+			{
+				_ia1 = false;
+				_ia1_src = 0;
+			}
+		}
+	}
+
+	void click(const int32_t hp[3])
+	{
+		uint8_t cfg = _reg[0x38];
+		if ((cfg & 0x3F) == 0)
+		{
+			return;
+		}
+		int32_t ths = (int32_t)(_reg[0x3A] & 0x7F) * ths_lsb_mg();
+		int32_t peak = 0;
+		uint8_t axes = 0;
+		int sign = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if ((cfg & (0x03 << (axis * 2))) && (abs(hp[axis]) > peak))
+			{
+				peak = abs(hp[axis]);
+				axes = 0x01 << axis;
+				sign = hp[axis] < 0;
+			}
+		}
+		bool above = peak > ths;
+		uint8_t limit = _reg[0x3B] & 0x7F;
+		uint8_t latency = _reg[0x3C];
+		uint8_t window = _reg[0x3D];
+
+		if (!(_reg[0x3A] & 0x80))
+		{
+			// Not latched, the source only lasts one sample
+			_click_src = 0;
+		}
+
+		switch (_click_state)
+		{
+		case 0:
+			// Idle
+			if (above)
+			{
+				_click_state = 1;
+				_click_count = 1;
+			}
+			break;
+		case 1:
+			// First pulse
+			if (above)
+			{
+				if (++_click_count > limit)
+				{
+					_click_state = 4;
+				}
+			}
+			else
+			{
+				if (cfg & 0x15)
+				{
+					_click_src = 0x40 | 0x10 | axes | (sign ? 0x08 : 0);
+				}
+				_click_state = (cfg & 0x2A) ? 2 : 0;
+				_click_gap = 0;
+			}
+			break;
+		case 2:
+			// Latency, then waiting for the second pulse inside the window
+			_click_gap++;
+			if ((_click_gap > latency) && above)
+			{
+				_click_state = 3;
+				_click_count = 1;
+			}
+			else if (_click_gap > (uint16_t)latency + window)
+			{
+				_click_state = 0;
+			}
+			break;
+		case 3:
+			// Second pulse
+			if (above)
+			{
+				if (++_click_count > limit)
+				{
+					_click_state = 4;
+				}
+			}
+			else
+			{
+				_click_src = 0x40 | 0x20 | axes | (sign ? 0x08 : 0);
+				_click_state = 0;
+			}
+			break;
+		default:
+			// Pulse too long, wait until it is over
+			if (!above)
+			{
+				_click_state = 0;
+			}
+			break;
+		}
+	}
+
+	void update_int1(void)
+	{
+		uint8_t ctrl3 = _reg[0x22];
+		uint8_t fth = _reg[0x2E] & 0x1F;
+		bool level = false;
+		level |= (ctrl3 & 0x80) && (_click_src & 0x40);
+		level |= (ctrl3 & 0x40) && _ia1;
+		level |= (ctrl3 & 0x04) && (fth != 0) && (_fifo_count > fth);
+		level |= (ctrl3 & 0x02) && _fifo_overrun;
+		sim_set_input(LIS3DH_INT1, level ? HIGH : LOW);
+	}
+};
+
+static SimLIS3DH s_lis3dh;
+static bool s_lis3dh_registered = false;
+
+/**
+ * @brief Put the LIS3DH on the I2C bus, loading a trace does it as well.
+ *        Without a trace it reports the badge lying still face up.
+ */
+void sim_lis3dh_attach(void)
+{
+	if (!s_lis3dh_registered)
+	{
+		s_lis3dh_registered = true;
+		sim_add_i2c_device(LIS3DH_ADDRESS, &s_lis3dh);
+		sim_register_model(&s_lis3dh);
+	}
+}
+
+/**
+ * @brief Load a CSV trace, one "t_ms,x_mg,y_mg,z_mg[,label]" line per
+ *        sample. The optional label names the intended gesture. t_ms
+ *        counts from the time the trace is loaded, and the trace replaces
+ *        the one before.
+ *
+ * @param path file to read
+ * @return true if at least one sample was read
+ */
+bool sim_lis3dh_load_trace(const char *path)
+{
+	sim_lis3dh_attach();
+	FILE *file = fopen(path, "r");
+	if (file == NULL)
+	{
+		return false;
+	}
+	uint32_t start_ms = sim_now_us() / 1000;
+	s_lis3dh.clear_trace();
+	char line[128];
+	// Consecutive samples with the same label form one labelled stretch
+	char label[32] = "";
+	uint32_t label_start = 0;
+	uint32_t last_t = 0;
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		s_trace_point point;
+		int x, y, z;
+		unsigned long t;
+		char sample_label[32] = "";
+		if ((line[0] == '#') || (sscanf(line, "%lu,%d,%d,%d,%31[^,\r\n]", &t, &x, &y, &z, sample_label) < 4))
+		{
+			continue;
+		}
+		t += start_ms;
+		if (strcmp(sample_label, label) != 0)
+		{
+			if (label[0] != 0)
+			{
+				sim_label(label_start, last_t, label);
+			}
+			strcpy(label, sample_label);
+			label_start = t;
+		}
+		last_t = t;
+		point.t_ms = t;
+		point.mg[0] = x;
+		point.mg[1] = y;
+		point.mg[2] = z;
+		s_lis3dh.trace.push_back(point);
+	}
+	if (label[0] != 0)
+	{
+		sim_label(label_start, last_t, label);
+	}
+	fclose(file);
+	return !s_lis3dh.trace.empty();
+}
+
+static void add_point(uint32_t t_ms, int x, int y, int z)
+{
+	s_trace_point point = {t_ms, {(int16_t)x, (int16_t)y, (int16_t)z}};
+	s_lis3dh.trace.push_back(point);
+}
+
+/**
+ * @brief A badge worn on a jacket: walking sway with pocket bumps, plus
+ *        every 45 s one intentional gesture in turn: tap, double tap,
+ *        shake and flip
+ *
+ * @param duration_ms length of the trace
+ */
+void sim_lis3dh_synthetic_trace(uint32_t duration_ms)
+{
+	sim_lis3dh_attach();
+	srand(1);
+	for (uint32_t t = 0; t < duration_ms; t += 5)
+	{
+		int x = (int)(120.0 * sin(t * 2.0 * M_PI / 900.0));
+		int y = (int)(60.0 * sin(t * 2.0 * M_PI / 450.0));
+		int z = 1000;
+		uint32_t phase = t % 45000;
+		uint32_t gesture = (t / 45000) % 4;
+
+		// Random bumps, roughly one every 7 s, 60 ms long
+		if ((t % 7000) < 60 && ((t / 7000) % 3 != 0))
+		{
+			z += 650;
+			x += 300;
+		}
+
+		if ((phase >= 20000) && (phase < 22000))
+		{
+			uint32_t g = phase - 20000;
+			switch (gesture)
+			{
+			case 0:
+				// Single tap, 15 ms spike
+				if (g < 15)
+				{
+					z += 1500;
+				}
+				break;
+			case 1:
+				// Double tap, 250 ms apart
+				if ((g < 15) || ((g >= 250) && (g < 265)))
+				{
+					z += 1500;
+				}
+				break;
+			case 2:
+				// Shake, 6 Hz +-1.6 g for 1.5 s
+				if (g < 1500)
+				{
+					x += (int)(1600.0 * sin(g * 2.0 * M_PI / 166.0));
+				}
+				break;
+			default:
+				// Flip face down over 400 ms and stay there
+				if (g < 400)
+				{
+					z = (int)(1000.0 * cos(g * M_PI / 400.0));
+				}
+				else
+				{
+					z = -1000;
+				}
+				break;
+			}
+		}
+		else if ((gesture == 3) && (phase >= 22000) && (phase < 30000))
+		{
+			z = -1000;
+		}
+		add_point(t, x, y, z);
+	}
+
+	static const char *gesture_labels[] = {"tap", "double_tap", "shake", "flip"};
+	for (uint32_t start = 20000; start < duration_ms; start += 45000)
+	{
+		sim_label(start, start + 2000, gesture_labels[(start / 45000) % 4]);
+	}
+}
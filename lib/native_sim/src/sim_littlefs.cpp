@@ -0,0 +1,252 @@
+/**
+ * @file sim_littlefs.cpp
+ * @brief RAM backed LittleFS stand-in. Mirrors the Adafruit wrapper semantics
+ *        the application relies on: FILE_O_WRITE creates the file and appends.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <map>
+#include <string>
+#include <vector>
+
+#include "InternalFileSystem.h"
+#include "sim.h"
+
+using namespace Adafruit_LittleFS_Namespace;
+
+InternalFileSystem InternalFS;
+
+static std::map<std::string, std::vector<uint8_t>> s_files;
+
+File::File(Adafruit_LittleFS &fs) : _fs(&fs), _is_open(false), _mode(FILE_O_READ), _pos(0)
+{
+	_name[0] = 0;
+}
+
+File::File(char const *filename, uint8_t mode, Adafruit_LittleFS &fs) : File(fs)
+{
+	open(filename, mode);
+}
+
+File::File(const File &other)
+{
+	*this = other;
+}
+
+File &File::operator=(const File &other)
+{
+	_fs = other._fs;
+	memcpy(_name, other._name, sizeof(_name));
+	_is_open = other._is_open;
+	_mode = other._mode;
+	_pos = other._pos;
+	return *this;
+}
+
+File::~File()
+{
+}
+
+bool File::open(char const *filename, uint8_t mode)
+{
+	close();
+	if (strlen(filename) >= sizeof(_name))
+	{
+		return false;
+	}
+	std::map<std::string, std::vector<uint8_t>>::iterator file = s_files.find(filename);
+	if (file == s_files.end())
+	{
+		if (mode == FILE_O_READ)
+		{
+			return false;
+		}
+		file = s_files.insert(std::make_pair(std::string(filename), std::vector<uint8_t>())).first;
+	}
+	strcpy(_name, filename);
+	_mode = mode;
+	_is_open = true;
+	// The Adafruit wrapper seeks to the end of the file for writing
+	_pos = (mode == FILE_O_WRITE) ? file->second.size() : 0;
+	return true;
+}
+
+size_t File::write(uint8_t ch)
+{
+	return write(&ch, 1);
+}
+
+size_t File::write(uint8_t const *buf, size_t size)
+{
+	if (!_is_open || (_mode != FILE_O_WRITE))
+	{
+		return 0;
+	}
+	std::vector<uint8_t> &data = s_files[_name];
+	if (data.size() < _pos + size)
+	{
+		data.resize(_pos + size);
+	}
+	memcpy(&data[_pos], buf, size);
+	_pos += size;
+	g_sim.flash_bytes_written += size;
+	return size;
+}
+
+int File::read(void)
+{
+	uint8_t ch;
+	return (read(&ch, 1) == 1) ? ch : -1;
+}
+
+int File::read(void *buf, uint16_t nbyte)
+{
+	if (!_is_open)
+	{
+		return -1;
+	}
+	std::vector<uint8_t> &data = s_files[_name];
+	if (_pos >= data.size())
+	{
+		return 0;
+	}
+	uint32_t count = data.size() - _pos;
+	if (count > nbyte)
+	{
+		count = nbyte;
+	}
+	memcpy(buf, &data[_pos], count);
+	_pos += count;
+	g_sim.flash_bytes_read += count;
+	return count;
+}
+
+int File::peek(void)
+{
+	if (!_is_open || (_pos >= s_files[_name].size()))
+	{
+		return -1;
+	}
+	return s_files[_name][_pos];
+}
+
+int File::available(void)
+{
+	return _is_open ? (int)(s_files[_name].size() - _pos) : 0;
+}
+
+void File::flush(void)
+{
+}
+
+bool File::seek(uint32_t pos)
+{
+	if (!_is_open || (pos > s_files[_name].size()))
+	{
+		return false;
+	}
+	_pos = pos;
+	return true;
+}
+
+uint32_t File::position(void)
+{
+	return _pos;
+}
+
+uint32_t File::size(void)
+{
+	return _is_open ? s_files[_name].size() : 0;
+}
+
+bool File::truncate(uint32_t pos)
+{
+	if (!_is_open || (_mode != FILE_O_WRITE))
+	{
+		return false;
+	}
+	s_files[_name].resize(pos);
+	if (_pos > pos)
+	{
+		_pos = pos;
+	}
+	return true;
+}
+
+bool File::truncate(void)
+{
+	return truncate(_pos);
+}
+
+void File::close(void)
+{
+	_is_open = false;
+}
+
+File::operator bool(void)
+{
+	return _is_open;
+}
+
+bool File::isOpen(void)
+{
+	return _is_open;
+}
+
+char const *File::name(void)
+{
+	return _name;
+}
+
+File Adafruit_LittleFS::open(char const *filename, uint8_t mode)
+{
+	return File(filename, mode, *this);
+}
+
+bool Adafruit_LittleFS::exists(char const *filepath)
+{
+	return s_files.count(filepath) != 0;
+}
+
+bool Adafruit_LittleFS::remove(char const *filepath)
+{
+	if (s_files.erase(filepath) == 0)
+	{
+		return false;
+	}
+	g_sim.flash_files_removed++;
+	return true;
+}
+
+bool Adafruit_LittleFS::rename(char const *pathFrom, char const *pathTo)
+{
+	std::map<std::string, std::vector<uint8_t>>::iterator file = s_files.find(pathFrom);
+	if (file == s_files.end())
+	{
+		return false;
+	}
+	s_files[pathTo].swap(file->second);
+	s_files.erase(pathFrom);
+	return true;
+}
+
+bool Adafruit_LittleFS::format(void)
+{
+	s_files.clear();
+	return true;
+}
+
+/**
+ * @brief List the files and their sizes
+ *
+ */
+void sim_fs_dump(void)
+{
+	for (std::map<std::string, std::vector<uint8_t>>::iterator file = s_files.begin(); file != s_files.end(); file++)
+	{
+		printf("  %-24s %6u bytes\n", file->first.c_str(), (unsigned)file->second.size());
+	}
+}
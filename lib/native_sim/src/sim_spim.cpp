@@ -0,0 +1,113 @@
+/**
+ * @file sim_spim.cpp
+ * @brief Mock SPIM with EasyDMA. The bytes of a transfer go to the SPI bus
+ *        models when it starts, the end comes after the bytes took their
+ *        time on the bus. Transfers, bytes and bus time are counted.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <nrfx_spim.h>
+
+#include "sim.h"
+
+/** Time from the END event to the handler and the next START */
+#define SIM_SPIM_IRQ_US 2
+
+class SimSPIM : public SimModel
+{
+public:
+	bool ready = false;
+	uint32_t frequency = NRF_SPIM_FREQ_4M;
+	nrfx_spim_evt_handler_t handler = NULL;
+	void *context = NULL;
+	nrfx_spim_xfer_desc_t xfer;
+
+	uint64_t next_event_us(void)
+	{
+		return _done_us;
+	}
+
+	void run(uint64_t now_us)
+	{
+		(void)now_us;
+		_done_us = UINT64_MAX;
+		nrfx_spim_evt_t event = {NRFX_SPIM_EVENT_DONE, xfer};
+		if (handler != NULL)
+		{
+			handler(&event, context);
+		}
+	}
+
+	bool busy(void)
+	{
+		return _done_us != UINT64_MAX;
+	}
+
+	void start(void)
+	{
+		for (size_t idx = 0; idx < xfer.tx_length; idx++)
+		{
+			SPI.transfer(xfer.p_tx_buffer[idx]);
+		}
+		uint64_t bus_us = ((uint64_t)xfer.tx_length * 8 * 1000000 + frequency - 1) / frequency;
+		g_sim.spi_dma_transfers++;
+		g_sim.spi_dma_bytes += xfer.tx_length;
+		g_sim.spi_dma_us += bus_us;
+		_done_us = sim_now_us() + bus_us + SIM_SPIM_IRQ_US;
+	}
+
+private:
+	uint64_t _done_us = UINT64_MAX;
+};
+
+static SimSPIM s_spim;
+static bool s_spim_registered = false;
+
+nrfx_err_t nrfx_spim_init(nrfx_spim_t const *p_instance, nrfx_spim_config_t const *p_config,
+						  nrfx_spim_evt_handler_t handler, void *p_context)
+{
+	(void)p_instance;
+	if (s_spim.ready)
+	{
+		return NRFX_ERROR_INVALID_STATE;
+	}
+	if (!s_spim_registered)
+	{
+		sim_register_model(&s_spim);
+		s_spim_registered = true;
+	}
+	s_spim.ready = true;
+	s_spim.frequency = p_config->frequency;
+	s_spim.handler = handler;
+	s_spim.context = p_context;
+	return NRFX_SUCCESS;
+}
+
+void nrfx_spim_uninit(nrfx_spim_t const *p_instance)
+{
+	(void)p_instance;
+	s_spim.ready = false;
+}
+
+nrfx_err_t nrfx_spim_xfer(nrfx_spim_t const *p_instance, nrfx_spim_xfer_desc_t const *p_xfer_desc, uint32_t flags)
+{
+	(void)p_instance;
+	(void)flags;
+	if (!s_spim.ready)
+	{
+		return NRFX_ERROR_INVALID_STATE;
+	}
+	if (s_spim.busy())
+	{
+		return NRFX_ERROR_BUSY;
+	}
+	s_spim.xfer = *p_xfer_desc;
+	s_spim.start();
+	return NRFX_SUCCESS;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file sim_ssd1680.cpp
+ * @brief In-memory SSD1680 controller. Decodes the 4-wire SPI traffic, either
+ *        bit-banged on the GPIO pins or through the SPI class, keeps the
+ *        black/white and red RAM and drives BUSY for the length of a refresh.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <Arduino.h>
+
+#include "sim.h"
+
+/** Refresh times of the 2.13" panel, OTP waveforms at room temperature */
+#define SSD1680_FULL_REFRESH_US 2000000ULL
+#define SSD1680_PARTIAL_REFRESH_US 320000ULL
+#define SSD1680_RESET_US 10000ULL
+
+class SimSSD1680 : public SimModel
+{
+public:
+	uint32_t cs_pin = 0;
+	uint32_t dc_pin = 0;
+	uint32_t sck_pin = 0;
+	uint32_t mosi_pin = 0;
+	uint32_t busy_pin = 0;
+
+	uint8_t bw_ram[SSD1680_RAM_Y][SSD1680_RAM_X_BYTES];
+	uint8_t red_ram[SSD1680_RAM_Y][SSD1680_RAM_X_BYTES];
+
+	uint64_t next_event_us(void)
+	{
+		return _busy_until;
+	}
+
+	void run(uint64_t now_us)
+	{
+		(void)now_us;
+		_busy_until = UINT64_MAX;
+		sim_set_input(busy_pin, LOW);
+	}
+
+	void pin_changed(uint32_t pin, int level)
+	{
+		if (pin == cs_pin)
+		{
+			_bit_count = 0;
+		}
+		else if ((pin == sck_pin) && level && !digitalRead(cs_pin))
+		{
+			// Bit-banged SPI, mode 0, MSB first
+			_shift = (_shift << 1) | (digitalRead(mosi_pin) ? 1 : 0);
+			if (++_bit_count == 8)
+			{
+				_bit_count = 0;
+				g_sim.spi_bytes++;
+				byte_in(_shift);
+			}
+		}
+	}
+
+	void byte_in(uint8_t data)
+	{
+		if (digitalRead(dc_pin))
+		{
+			data_in(data);
+		}
+		else
+		{
+			command_in(data);
+		}
+	}
+
+private:
+	uint64_t _busy_until = UINT64_MAX;
+	uint8_t _shift = 0;
+	uint8_t _bit_count = 0;
+
+	uint8_t _cmd = 0;
+	uint8_t _param[8];
+	uint8_t _param_num = 0;
+
+	uint8_t _entry_mode = 0x03;
+	uint8_t _x_start = 0;
+	uint8_t _x_end = SSD1680_RAM_X_BYTES - 1;
+	uint16_t _y_start = 0;
+	uint16_t _y_end = SSD1680_RAM_Y - 1;
+	uint8_t _x = 0;
+	uint16_t _y = 0;
+	uint8_t _update_ctrl = 0xF7;
+
+	void busy_for(uint64_t duration_us)
+	{
+		_busy_until = sim_now_us() + duration_us;
+		sim_set_input(busy_pin, HIGH);
+	}
+
+	void command_in(uint8_t cmd)
+	{
+		_cmd = cmd;
+		_param_num = 0;
+		switch (cmd)
+		{
+		case 0x12:
+			// Software reset
+			_entry_mode = 0x03;
+			busy_for(SSD1680_RESET_US);
+			break;
+		case 0x20:
+			// Master activation
+			if (_update_ctrl & 0x08)
+			{
+				g_sim.epd_partial_refreshes++;
+				busy_for(SSD1680_PARTIAL_REFRESH_US);
+			}
+			else
+			{
+				g_sim.epd_full_refreshes++;
+				busy_for(SSD1680_FULL_REFRESH_US);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void data_in(uint8_t data)
+	{
+		if ((_cmd == 0x24) || (_cmd == 0x26))
+		{
+			ram_write(_cmd == 0x24 ? bw_ram : red_ram, data);
+			return;
+		}
+		if (_param_num < sizeof(_param))
+		{
+			_param[_param_num++] = data;
+		}
+		switch (_cmd)
+		{
+		case 0x11:
+			_entry_mode = _param[0];
+			break;
+		case 0x22:
+			_update_ctrl = _param[0];
+			break;
+		case 0x44:
+			if (_param_num == 2)
+			{
+				_x_start = _param[0] % SSD1680_RAM_X_BYTES;
+				_x_end = _param[1] % SSD1680_RAM_X_BYTES;
+			}
+			break;
+		case 0x45:
+			if (_param_num == 4)
+			{
+				_y_start = (_param[0] | (_param[1] << 8)) % SSD1680_RAM_Y;
+				_y_end = (_param[2] | (_param[3] << 8)) % SSD1680_RAM_Y;
+			}
+			break;
+		case 0x4E:
+			_x = _param[0] % SSD1680_RAM_X_BYTES;
+			break;
+		case 0x4F:
+			if (_param_num == 2)
+			{
+				_y = (_param[0] | (_param[1] << 8)) % SSD1680_RAM_Y;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void ram_write(uint8_t ram[SSD1680_RAM_Y][SSD1680_RAM_X_BYTES], uint8_t data)
+	{
+		ram[_y][_x] = data;
+		g_sim.epd_ram_bytes++;
+		// Address counters wrap inside the window, X first (AM = 0)
+		bool x_inc = _entry_mode & 0x01;
+		bool y_inc = _entry_mode & 0x02;
+		if (_x == (x_inc ? _x_end : _x_start))
+		{
+			_x = x_inc ? _x_start : _x_end;
+			if (_y == (y_inc ? _y_end : _y_start))
+			{
+				_y = y_inc ? _y_start : _y_end;
+			}
+			else
+			{
+				_y = y_inc ? _y + 1 : _y - 1;
+			}
+		}
+		else
+		{
+			_x = x_inc ? _x + 1 : _x - 1;
+		}
+	}
+};
+
+static SimSSD1680 s_ssd1680;
+
+static void ssd1680_pin_hook(uint32_t pin, int level)
+{
+	s_ssd1680.pin_changed(pin, level);
+}
+
+static uint8_t ssd1680_spi_hook(uint8_t data)
+{
+	if (!digitalRead(s_ssd1680.cs_pin))
+	{
+		s_ssd1680.byte_in(data);
+	}
+	return 0xFF;
+}
+
+/**
+ * @brief Wire the controller to the MCU pins
+ */
+void sim_ssd1680_attach(uint32_t cs, uint32_t dc, uint32_t sck, uint32_t mosi, uint32_t busy)
+{
+	s_ssd1680.cs_pin = cs;
+	s_ssd1680.dc_pin = dc;
+	s_ssd1680.sck_pin = sck;
+	s_ssd1680.mosi_pin = mosi;
+	s_ssd1680.busy_pin = busy;
+	sim_set_input(cs, HIGH);
+	sim_add_pin_hook(ssd1680_pin_hook);
+	sim_set_spi_hook(ssd1680_spi_hook);
+	sim_register_model(&s_ssd1680);
+}
+
+/**
+ * @brief Black/white RAM as the panel shows it after the last refresh
+ */
+const uint8_t *sim_ssd1680_bw_ram(uint16_t *row_bytes, uint16_t *rows)
+{
+	*row_bytes = SSD1680_RAM_X_BYTES;
+	*rows = SSD1680_RAM_Y;
+	return &s_ssd1680.bw_ram[0][0];
+}
+
+/**
+ * @brief Red RAM, the reference of the next partial refresh
+ */
+const uint8_t *sim_ssd1680_red_ram(uint16_t *row_bytes, uint16_t *rows)
+{
+	*row_bytes = SSD1680_RAM_X_BYTES;
+	*rows = SSD1680_RAM_Y;
+	return &s_ssd1680.red_ram[0][0];
+}
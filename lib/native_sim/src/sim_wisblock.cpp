@@ -0,0 +1,937 @@
+/**
+ * @file sim_wisblock.cpp
+ * @brief WisBlock-API stand-in: fake LoRaMAC, BLE UART, AT interpreter and
+ *        the main loop of the API, plus the scenario driver and the report
+ *        of latency and bus/flash traffic per handled event.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <WisBlock-API.h>
+
+/** API globals */
+SemaphoreHandle_t g_task_sem = NULL;
+volatile uint16_t g_task_event_type = NO_EVENT;
+SoftwareTimer g_task_wakeup_timer;
+s_lorawan_settings g_lorawan_settings;
+uint8_t g_rx_lora_data[256];
+uint8_t g_rx_data_len = 0;
+bool g_rx_fin_result = false;
+bool g_join_result = false;
+int16_t g_last_rssi = 0;
+int8_t g_last_snr = 0;
+bool g_lpwan_has_joined = false;
+bool g_lorawan_initialized = false;
+BLEUart g_ble_uart;
+bool g_ble_uart_is_connected = false;
+bool g_enable_ble = false;
+char g_at_query_buf[ATQUERY_SIZE];
+
+extern atcmd_t g_user_at_cmd_list[] __attribute__((weak));
+extern uint8_t g_user_at_cmd_num __attribute__((weak));
+/** Work of the low priority log task, it runs while the loop waits */
+extern void log_drain(void) __attribute__((weak));
+
+static uint16_t s_sw_version[3];
+static float s_batt_mv = 4000.0;
+
+/** Time until the RX2 window closed after the end of a transmission */
+#define LORA_RX_WINDOWS_US 2100000ULL
+/** Join request + JoinAccept in RX1 */
+#define LORA_JOIN_US 6000000ULL
+
+/**
+ * @brief Class A end device MAC with a network that answers per script
+ */
+class SimLoRaMAC : public SimModel
+{
+public:
+	uint8_t tx_fail_rate = 0;
+	uint8_t join_fail_rate = 0;
+	/** Confirmed uplinks above this data rate are never answered, the gateway is too far away */
+	uint8_t max_data_rate = 15;
+	uint8_t data_rate = 3;
+	std::vector<std::vector<uint8_t>> downlinks;
+	/** Sees every uplink that goes on air */
+	sim_uplink_hook_t uplink_hook = NULL;
+
+	uint64_t next_event_us(void)
+	{
+		return _done_us;
+	}
+
+	void run(uint64_t now_us)
+	{
+		_done_us = UINT64_MAX;
+		if (_joining)
+		{
+			_joining = false;
+			g_join_result = (uint8_t)random(100) >= join_fail_rate;
+			g_lpwan_has_joined = g_join_result;
+			g_task_event_type |= LORA_JOIN_FIN;
+			xSemaphoreGiveFromISR(g_task_sem, NULL);
+			return;
+		}
+		if (_sending)
+		{
+			_sending = false;
+			if (!downlinks.empty())
+			{
+				std::vector<uint8_t> &downlink = downlinks.front();
+				g_rx_data_len = downlink.size();
+				memcpy(g_rx_lora_data, downlink.data(), downlink.size());
+				g_last_rssi = -97;
+				g_last_snr = 6;
+				downlinks.erase(downlinks.begin());
+				g_sim.lora_rx++;
+				sim_label(now_us / 1000, now_us / 1000 + 1000, "downlink");
+				g_task_event_type |= LORA_DATA;
+			}
+			g_rx_fin_result = _confirmed ? ((data_rate <= max_data_rate) && ((uint8_t)random(100) >= tx_fail_rate)) : true;
+			g_task_event_type |= LORA_TX_FIN;
+			xSemaphoreGiveFromISR(g_task_sem, NULL);
+		}
+	}
+
+	void join(void)
+	{
+		if (_joining || _sending)
+		{
+			return;
+		}
+		g_sim.lora_joins++;
+		g_lpwan_has_joined = false;
+		data_rate = g_lorawan_settings.data_rate;
+		_joining = true;
+		_done_us = sim_now_us() + LORA_JOIN_US;
+	}
+
+	lmh_join_status join_status(void)
+	{
+		return _joining ? LMH_ONGOING : (g_lpwan_has_joined ? LMH_SET : LMH_RESET);
+	}
+
+	lmh_error_status send(uint8_t *data, uint8_t size, bool confirmed)
+	{
+		if (!g_lpwan_has_joined || _joining || _sending)
+		{
+			return LMH_BUSY;
+		}
+		if (size > max_payload())
+		{
+			g_sim.lora_tx_rejected++;
+			return LMH_ERROR;
+		}
+		g_sim.lora_tx++;
+		g_sim.lora_tx_bytes += size;
+		if (uplink_hook != NULL)
+		{
+			uplink_hook(data, size);
+		}
+		_sending = true;
+		_confirmed = confirmed;
+		g_sim.lora_tx_airtime_us += time_on_air_us(size);
+		_done_us = sim_now_us() + time_on_air_us(size) + LORA_RX_WINDOWS_US;
+		return LMH_SUCCESS;
+	}
+
+	uint8_t max_payload(void)
+	{
+		static const uint8_t eu868[] = {51, 51, 51, 115, 222, 222, 222, 222};
+		static const uint8_t us915[] = {11, 53, 125, 242, 242};
+		if (g_lorawan_settings.lora_region == LORAMAC_REGION_US915)
+		{
+			return us915[data_rate > 4 ? 4 : data_rate];
+		}
+		return eu868[data_rate > 7 ? 7 : data_rate];
+	}
+
+	/** LoRa time on air for 125 kHz, CR 4/5, 8 symbol preamble, 13 bytes MAC overhead */
+	uint64_t time_on_air_us(uint8_t size)
+	{
+		int sf = (g_lorawan_settings.lora_region == LORAMAC_REGION_US915) ? 10 - data_rate : 12 - data_rate;
+		if (sf < 7)
+		{
+			sf = 7;
+		}
+		double t_sym = (double)(1 << sf) / 125000.0;
+		int de = (sf >= 11) ? 1 : 0;
+		double num = 8.0 * (size + 13) - 4.0 * sf + 28 + 16;
+		double payload_symbols = 8 + fmax(ceil(num / (4.0 * (sf - 2 * de))) * 5, 0);
+		return (uint64_t)(((8 + 4.25) + payload_symbols) * t_sym * 1000000.0);
+	}
+
+private:
+	uint64_t _done_us = UINT64_MAX;
+	bool _joining = false;
+	bool _sending = false;
+	bool _confirmed = false;
+};
+
+static SimLoRaMAC s_mac;
+
+void lmh_join(void)
+{
+	s_mac.join();
+}
+
+lmh_join_status lmh_join_status_get(void)
+{
+	return s_mac.join_status();
+}
+
+void lmh_datarate_set(uint8_t data_rate, bool enable_adr)
+{
+	(void)enable_adr;
+	s_mac.data_rate = data_rate;
+}
+
+LoRaMacStatus_t LoRaMacQueryTxPossible(uint8_t size, LoRaMacTxInfo_t *txInfo)
+{
+	txInfo->MaxPossiblePayload = s_mac.max_payload();
+	txInfo->CurrentPayloadSize = size;
+	return (size > txInfo->MaxPossiblePayload) ? LORAMAC_STATUS_LENGTH_ERROR : LORAMAC_STATUS_OK;
+}
+
+LoRaMacStatus_t LoRaMacMibGetRequestConfirm(MibRequestConfirm_t *mibGet)
+{
+	if (mibGet->Type != MIB_CHANNELS_DATARATE)
+	{
+		return LORAMAC_STATUS_PARAMETER_INVALID;
+	}
+	mibGet->Param.ChannelsDatarate = s_mac.data_rate;
+	return LORAMAC_STATUS_OK;
+}
+
+int8_t init_lorawan(void)
+{
+	s_mac.data_rate = g_lorawan_settings.data_rate;
+	g_lorawan_initialized = true;
+	if (g_lorawan_settings.auto_join)
+	{
+		lmh_join();
+	}
+	return 0;
+}
+
+lmh_error_status send_lora_packet(uint8_t *data, uint8_t size)
+{
+	return s_mac.send(data, size, g_lorawan_settings.confirmed_msg_enabled == LMH_CONFIRMED_MSG);
+}
+
+void sim_lorawan_queue_downlink(const uint8_t *data, uint8_t len)
+{
+	s_mac.downlinks.push_back(std::vector<uint8_t>(data, data + len));
+}
+
+void sim_lorawan_set_tx_fail_rate(uint8_t percent)
+{
+	s_mac.tx_fail_rate = percent;
+}
+
+void sim_lorawan_set_uplink_hook(sim_uplink_hook_t hook)
+{
+	s_mac.uplink_hook = hook;
+}
+
+/** BLE UART */
+static std::string s_ble_rx;
+
+int BLEUart::available(void)
+{
+	return s_ble_rx.size();
+}
+
+int BLEUart::read(void)
+{
+	if (s_ble_rx.empty())
+	{
+		return -1;
+	}
+	uint8_t c = s_ble_rx[0];
+	s_ble_rx.erase(0, 1);
+	return c;
+}
+
+size_t BLEUart::write(uint8_t c)
+{
+	if (g_sim_verbose)
+	{
+		putchar(c);
+	}
+	return 1;
+}
+
+void restart_advertising(uint16_t timeout)
+{
+	(void)timeout;
+}
+
+/** AT command interpreter, user commands only */
+static std::string s_at_line;
+/** Line buffer of the interpreter, as in at_cmd.cpp of WisBlock-API 1.1.7 */
+#define ATCMD_SIZE 160
+
+static void at_exec(std::string line)
+{
+	if ((line.size() < 2) || (strncasecmp(line.c_str(), "AT", 2) != 0))
+	{
+		return;
+	}
+	if (line.size() == 2)
+	{
+		Serial.printf("OK\n");
+		return;
+	}
+	std::string cmd = line.substr(2);
+	std::string param;
+	char mode = 0;
+	size_t split = cmd.find_first_of("=?");
+	if (split != std::string::npos)
+	{
+		mode = cmd[split];
+		param = cmd.substr(split + 1);
+		cmd = cmd.substr(0, split);
+	}
+	for (uint8_t idx = 0; (&g_user_at_cmd_num != NULL) && (idx < g_user_at_cmd_num); idx++)
+	{
+		atcmd_t *at = &g_user_at_cmd_list[idx];
+		if (strcasecmp(cmd.c_str(), at->cmd_name) != 0)
+		{
+			continue;
+		}
+		int result = AT_ERRNO_NOSUPP;
+		if ((mode == '?') && (at->query_cmd != NULL))
+		{
+			result = at->query_cmd();
+			if (result == 0)
+			{
+				Serial.printf("%s:%s\n", at->cmd_name, g_at_query_buf);
+			}
+		}
+		else if ((mode == '=') && (param == "?"))
+		{
+			Serial.printf("%s:\"%s\"\n", at->cmd_name, at->cmd_desc);
+			result = 0;
+		}
+		else if ((mode == '=') && (at->exec_cmd != NULL))
+		{
+			char buf[256];
+			snprintf(buf, sizeof(buf), "%s", param.c_str());
+			result = at->exec_cmd(buf);
+		}
+		else if ((mode == 0) && (at->exec_cmd_no_para != NULL))
+		{
+			result = at->exec_cmd_no_para();
+		}
+		if (result == 0)
+		{
+			Serial.printf("OK\n");
+		}
+		else
+		{
+			Serial.printf("+CME ERROR:%d\n", result);
+		}
+		return;
+	}
+	Serial.printf("+CME ERROR:%d\n", AT_ERRNO_NOSUPP);
+}
+
+void at_serial_input(uint8_t cmd)
+{
+	if ((cmd == '\n') || (cmd == '\r'))
+	{
+		if (s_at_line.size() >= ATCMD_SIZE)
+		{
+			printf("[SIM] AT command of %u characters does not fit ATCMD_SIZE, dropped\n", (unsigned)s_at_line.size());
+		}
+		else if (!s_at_line.empty())
+		{
+			at_exec(s_at_line);
+		}
+		s_at_line.clear();
+		return;
+	}
+	s_at_line += (char)cmd;
+}
+
+/** Battery */
+float read_batt(void)
+{
+	return s_batt_mv;
+}
+
+uint8_t mv_to_percent(float mvolts)
+{
+	if (mvolts < 3300)
+	{
+		return 0;
+	}
+	if (mvolts < 3600)
+	{
+		return (uint8_t)((mvolts - 3300) / 30);
+	}
+	if (mvolts > 4200)
+	{
+		return 100;
+	}
+	return (uint8_t)(10 + (mvolts - 3600) * 0.15F);
+}
+
+uint8_t get_lora_batt(void)
+{
+	return (uint8_t)(mv_to_percent(read_batt()) * 2.54);
+}
+
+void api_set_version(uint16_t sw_1, uint16_t sw_2, uint16_t sw_3)
+{
+	s_sw_version[0] = sw_1;
+	s_sw_version[1] = sw_2;
+	s_sw_version[2] = sw_3;
+}
+
+void sd_nvic_SystemReset(void)
+{
+	g_sim.resets++;
+	printf("[SIM] %8.3f s: sd_nvic_SystemReset() requested\n", sim_now_us() / 1000000.0);
+}
+
+/** Scenario */
+struct s_script_item
+{
+	uint32_t t_ms;
+	std::string kind;
+	std::string arg;
+};
+static std::vector<s_script_item> s_script;
+
+#ifndef UNIT_TEST
+static bool load_script(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	if (file == NULL)
+	{
+		return false;
+	}
+	char line[512];
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		char kind[16];
+		unsigned long t;
+		int consumed = 0;
+		if ((line[0] == '#') || (sscanf(line, "%lu %15s %n", &t, kind, &consumed) < 2))
+		{
+			continue;
+		}
+		std::string arg(line + consumed);
+		while (!arg.empty() && ((arg.back() == '\n') || (arg.back() == '\r')))
+		{
+			arg.pop_back();
+		}
+		s_script.push_back({(uint32_t)t, kind, arg});
+	}
+	fclose(file);
+	return true;
+}
+
+static void default_script(void)
+{
+	s_script.push_back({30000, "at", "AT+SETMSG=2:Hello from the native environment"});
+	s_script.push_back({60000, "downlink", "333A" "4D6573736167652074687265652C2073656E74206F766572204C6F526157414E"});
+	s_script.push_back({200000, "ble", "AT+SETMSG=4:Set over BLE UART"});
+	s_script.push_back({260000, "downlink", "313A" "4869212049206A7573742061727269766564"});
+}
+#endif
+
+/** Labelled stretches of the scenario */
+struct s_label
+{
+	uint32_t start_ms;
+	uint32_t end_ms;
+	std::string name;
+	uint32_t expensive_runs;
+};
+static std::vector<s_label> s_labels;
+
+/** Detection latency allowed after the end of a label, -l on the command line */
+static uint32_t s_label_slack_ms = 2000;
+
+/** Handler runs that refreshed the EPD or sent an uplink */
+static uint32_t s_expensive_runs = 0;
+static uint32_t s_false_wakes = 0;
+/** Times the main loop was woken up */
+static uint32_t s_wakeups = 0;
+/** Refreshes already booked, and the last handler run that started a DMA transfer, none for the setup */
+static uint32_t s_refreshes_booked = 0;
+static uint64_t s_dma_run_start_us = UINT64_MAX;
+
+void sim_label(uint32_t start_ms, uint32_t end_ms, const char *label)
+{
+	s_labels.push_back({start_ms, end_ms, label, 0});
+}
+
+void sim_label_slack(uint32_t slack_ms)
+{
+	s_label_slack_ms = slack_ms;
+}
+
+uint32_t sim_false_wakes(void)
+{
+	return s_false_wakes;
+}
+
+static void label_expensive_run(uint64_t start_us);
+
+/**
+ * @brief Book refreshes that a DMA transfer started after its handler
+ *        returned against the handler run that started the transfer
+ */
+static void book_background_refreshes(void)
+{
+	uint32_t refreshes = g_sim.epd_full_refreshes + g_sim.epd_partial_refreshes;
+	if (refreshes != s_refreshes_booked)
+	{
+		s_refreshes_booked = refreshes;
+		if (s_dma_run_start_us != UINT64_MAX)
+		{
+			label_expensive_run(s_dma_run_start_us);
+		}
+	}
+}
+
+/**
+ * @brief Book a handler run that did expensive work against the labels
+ */
+static void label_expensive_run(uint64_t start_us)
+{
+	uint32_t t_ms = (uint32_t)(start_us / 1000);
+	bool labelled = false;
+	s_expensive_runs++;
+	for (size_t idx = 0; idx < s_labels.size(); idx++)
+	{
+		if ((t_ms >= s_labels[idx].start_ms) && (t_ms <= s_labels[idx].end_ms + s_label_slack_ms))
+		{
+			s_labels[idx].expensive_runs++;
+			labelled = true;
+		}
+	}
+	if (!labelled)
+	{
+		s_false_wakes++;
+	}
+}
+
+/** Statistics per handled event */
+struct s_event_stats
+{
+	uint32_t count = 0;
+	double host_us = 0;
+	double host_us_max = 0;
+	uint64_t sim_us = 0;
+	uint64_t sim_us_max = 0;
+	uint64_t spi_bytes = 0;
+	uint64_t i2c_transactions = 0;
+	uint64_t i2c_bytes = 0;
+	uint64_t flash_bytes = 0;
+};
+static std::map<std::string, s_event_stats> s_stats;
+
+static std::string event_name(const char *handler, uint16_t events)
+{
+	static const char *names[] = {"STATUS", "BLE_CONFIG", "BLE_DATA", "LORA_DATA", "LORA_TX_FIN", "AT_CMD", "LORA_JOIN_FIN"};
+	std::string name(handler);
+	name += ":";
+	bool first = true;
+	for (int bit = 0; bit < 16; bit++)
+	{
+		if (!(events & (1 << bit)))
+		{
+			continue;
+		}
+		if (!first)
+		{
+			name += "|";
+		}
+		first = false;
+		if (bit < 7)
+		{
+			name += names[bit];
+		}
+		else
+		{
+			char buf[16];
+			snprintf(buf, sizeof(buf), "APP_%04X", 1 << bit);
+			name += buf;
+		}
+	}
+	return name;
+}
+
+/** Snapshot taken before a measured piece of firmware runs */
+struct s_measure_start
+{
+	s_sim_counters counters;
+	uint64_t sim_us;
+	std::chrono::steady_clock::time_point host;
+};
+
+static s_measure_start measure_begin(void)
+{
+	book_background_refreshes();
+	s_measure_start start;
+	start.counters = g_sim;
+	start.sim_us = sim_now_us();
+	start.host = std::chrono::steady_clock::now();
+	return start;
+}
+
+static void measure_end(const std::string &name, const s_measure_start &start)
+{
+	double host_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start.host).count();
+	uint64_t sim_us = sim_now_us() - start.sim_us;
+	s_event_stats &stats = s_stats[name];
+	stats.count++;
+	stats.host_us += host_us;
+	stats.host_us_max = fmax(stats.host_us_max, host_us);
+	stats.sim_us += sim_us;
+	if (sim_us > stats.sim_us_max)
+	{
+		stats.sim_us_max = sim_us;
+	}
+	stats.spi_bytes += g_sim.spi_bytes - start.counters.spi_bytes;
+	stats.i2c_transactions += g_sim.i2c_transactions - start.counters.i2c_transactions;
+	stats.i2c_bytes += g_sim.i2c_bytes - start.counters.i2c_bytes;
+	stats.flash_bytes += g_sim.flash_bytes_written - start.counters.flash_bytes_written;
+
+	if ((g_sim.epd_full_refreshes != start.counters.epd_full_refreshes) ||
+		(g_sim.epd_partial_refreshes != start.counters.epd_partial_refreshes) ||
+		(g_sim.lora_tx != start.counters.lora_tx))
+	{
+		label_expensive_run(start.sim_us);
+	}
+	s_refreshes_booked = g_sim.epd_full_refreshes + g_sim.epd_partial_refreshes;
+	if (g_sim.spi_dma_transfers != start.counters.spi_dma_transfers)
+	{
+		s_dma_run_start_us = start.sim_us;
+	}
+}
+
+static void measure(const char *handler, void (*handler_fn)(void), uint16_t relevant)
+{
+	uint16_t events = g_task_event_type & relevant;
+	if (events == 0)
+	{
+		return;
+	}
+	s_measure_start start = measure_begin();
+	handler_fn();
+	measure_end(event_name(handler, events), start);
+}
+
+static void run_script_item(const s_script_item &item)
+{
+	// Downlinks are labelled when the MAC delivers them
+	if ((item.kind == "at") || (item.kind == "ble"))
+	{
+		sim_label(item.t_ms, item.t_ms + 1000, item.kind.c_str());
+	}
+	if (item.kind == "at")
+	{
+		// The API runs AT commands from its loop, measure them like an event
+		s_measure_start start = measure_begin();
+		for (size_t idx = 0; idx < item.arg.size(); idx++)
+		{
+			at_serial_input(item.arg[idx]);
+		}
+		at_serial_input('\n');
+		size_t end = item.arg.find_first_of("=?");
+		measure_end("at_serial_input:" + item.arg.substr(0, end), start);
+	}
+	else if (item.kind == "ble")
+	{
+		s_ble_rx += item.arg;
+		g_task_event_type |= BLE_DATA;
+		xSemaphoreGive(g_task_sem);
+	}
+	else if (item.kind == "downlink")
+	{
+		uint8_t data[256];
+		size_t len = 0;
+		for (size_t idx = 0; (idx + 1 < item.arg.size()) && (len < sizeof(data)); idx += 2)
+		{
+			data[len++] = (uint8_t)strtoul(item.arg.substr(idx, 2).c_str(), NULL, 16);
+		}
+		sim_lorawan_queue_downlink(data, len);
+	}
+	else if (item.kind == "batt")
+	{
+		s_batt_mv = atof(item.arg.c_str());
+	}
+	else if (item.kind == "link")
+	{
+		// join_fail%:tx_fail%[:max_dr]
+		unsigned int join_fail = 0, tx_fail = 0, max_dr = 15;
+		sscanf(item.arg.c_str(), "%u:%u:%u", &join_fail, &tx_fail, &max_dr);
+		s_mac.join_fail_rate = join_fail;
+		s_mac.tx_fail_rate = tx_fail;
+		s_mac.max_data_rate = max_dr;
+	}
+}
+
+#ifndef UNIT_TEST
+static void report(void)
+{
+	book_background_refreshes();
+	printf("\n%-40s %6s %10s %10s %10s %10s %9s %8s %9s\n", "event", "count", "host avg", "host max", "sim avg", "sim max", "SPI avg", "I2C avg", "flash avg");
+	printf("%-40s %6s %10s %10s %10s %10s %9s %8s %9s\n", "", "", "[us]", "[us]", "[ms]", "[ms]", "[bytes]", "[xfers]", "[bytes]");
+	for (std::map<std::string, s_event_stats>::iterator it = s_stats.begin(); it != s_stats.end(); it++)
+	{
+		s_event_stats &stats = it->second;
+		printf("%-40s %6u %10.1f %10.1f %10.1f %10.1f %9.0f %8.1f %9.0f\n", it->first.c_str(), stats.count,
+			   stats.host_us / stats.count, stats.host_us_max,
+			   stats.sim_us / 1000.0 / stats.count, stats.sim_us_max / 1000.0,
+			   (double)stats.spi_bytes / stats.count, (double)stats.i2c_transactions / stats.count,
+			   (double)stats.flash_bytes / stats.count);
+	}
+	printf("\nTotals after %.1f s simulated\n", sim_now_us() / 1000000.0);
+	printf("  SPI bytes            %10u  EPD RAM bytes %u, full refreshes %u, partial refreshes %u\n",
+		   g_sim.spi_bytes, g_sim.epd_ram_bytes, g_sim.epd_full_refreshes, g_sim.epd_partial_refreshes);
+	printf("  SPI DMA transfers    %10u  (%u bytes, %.1f ms on the bus)\n", g_sim.spi_dma_transfers, g_sim.spi_dma_bytes,
+		   g_sim.spi_dma_us / 1000.0);
+	printf("  I2C transactions     %10u  (%u bytes)\n", g_sim.i2c_transactions, g_sim.i2c_bytes);
+	printf("  Flash bytes written  %10u  read %u, files removed %u\n", g_sim.flash_bytes_written, g_sim.flash_bytes_read, g_sim.flash_files_removed);
+	printf("  LoRa uplinks         %10u  (%u bytes, %u rejected, %.1f s on air), downlinks %u, joins %u\n",
+		   g_sim.lora_tx, g_sim.lora_tx_bytes, g_sim.lora_tx_rejected, g_sim.lora_tx_airtime_us / 1000000.0, g_sim.lora_rx,
+		   g_sim.lora_joins);
+	printf("  System resets        %10u\n", g_sim.resets);
+
+	double hours = sim_now_us() / 3600000000.0;
+	printf("\nWakeups (labels + %u ms)\n", s_label_slack_ms);
+	printf("  MCU wakeups          %10u  (%.0f per hour)\n", s_wakeups, s_wakeups / hours);
+	printf("  Expensive runs       %10u  (EPD refresh or uplink)\n", s_expensive_runs);
+	printf("  False wakes          %10u  (%.1f per hour)\n", s_false_wakes, s_false_wakes / hours);
+	std::map<std::string, std::pair<uint32_t, uint32_t>> per_label;
+	for (size_t idx = 0; idx < s_labels.size(); idx++)
+	{
+		per_label[s_labels[idx].name].first++;
+		if (s_labels[idx].expensive_runs != 0)
+		{
+			per_label[s_labels[idx].name].second++;
+		}
+	}
+	for (std::map<std::string, std::pair<uint32_t, uint32_t>>::iterator it = per_label.begin(); it != per_label.end(); it++)
+	{
+		printf("  %-20s %10u  labelled, %u woke up the expensive paths\n", it->first.c_str(), it->second.first, it->second.second);
+	}
+	printf("\nFiles\n");
+	sim_fs_dump();
+}
+#endif
+
+static void periodic_wakeup(TimerHandle_t unused)
+{
+	(void)unused;
+	sim_label(millis(), millis() + 1000, "timer");
+	g_task_event_type |= STATUS;
+	xSemaphoreGiveFromISR(g_task_sem, NULL);
+}
+
+/**
+ * @brief Boot the firmware like the API does in setup()
+ */
+void sim_start(void)
+{
+	randomSeed(1);
+	sim_ssd1680_attach(SS, WB_IO1, SCK, MOSI, WB_IO4);
+	sim_register_model(&s_mac);
+
+	g_task_sem = xSemaphoreCreateBinary();
+	setup_app();
+	init_app();
+	init_lorawan();
+	g_task_wakeup_timer.begin(g_lorawan_settings.send_repeat_time, periodic_wakeup);
+	g_task_wakeup_timer.start();
+}
+
+/** Next item of the script */
+static size_t s_script_idx = 0;
+
+/**
+ * @brief Run the loop of the API, the models and the script
+ *
+ * @param end_us simulated time to stop at
+ */
+static void run_until(uint64_t end_us)
+{
+	while (sim_now_us() < end_us)
+	{
+		// What the API does in loop()
+		if (xSemaphoreTake(g_task_sem, portMAX_DELAY) == pdTRUE)
+		{
+			s_wakeups++;
+			uint8_t rounds = 0;
+			while (g_task_event_type != NO_EVENT)
+			{
+				if (g_lorawan_initialized)
+				{
+					measure("lora_data_handler", lora_data_handler, LORA_DATA | LORA_TX_FIN | LORA_JOIN_FIN);
+				}
+				if (g_enable_ble && (ble_data_handler != NULL))
+				{
+					measure("ble_data_handler", ble_data_handler, BLE_DATA);
+				}
+				measure("app_event_handler", app_event_handler, (uint16_t)~(LORA_DATA | LORA_TX_FIN | LORA_JOIN_FIN | BLE_DATA));
+				if (++rounds == 100)
+				{
+					printf("[SIM] events 0x%04X are never cleared\n", g_task_event_type);
+					g_task_event_type = NO_EVENT;
+				}
+			}
+			continue;
+		}
+
+		if (log_drain != NULL)
+		{
+			log_drain();
+		}
+		uint64_t next = sim_next_event_us();
+		if ((s_script_idx < s_script.size()) && ((uint64_t)s_script[s_script_idx].t_ms * 1000 <= next))
+		{
+			sim_advance_to((uint64_t)s_script[s_script_idx].t_ms * 1000);
+			run_script_item(s_script[s_script_idx++]);
+			continue;
+		}
+		sim_advance_to(next < end_us ? next : end_us);
+	}
+
+	if (log_drain != NULL)
+	{
+		log_drain();
+	}
+}
+
+/**
+ * @brief Run the firmware for a while
+ *
+ * @param duration_ms simulated time from now on
+ */
+void sim_run(uint32_t duration_ms)
+{
+	run_until(sim_now_us() + (uint64_t)duration_ms * 1000);
+}
+
+#ifndef UNIT_TEST
+static void usage(const char *name)
+{
+	printf("Usage: %s [-t trace.csv] [-s script.txt] [-d seconds] [-f tx_fail_%%] [-c] [-j join_fail_%%] [-l slack_ms] [-r eu868|us915[:dr]] [-v]\n", name);
+	printf("  trace   t_ms,x_mg,y_mg,z_mg per line, default is a synthetic badge trace\n");
+	printf("  script  \"t_ms at|ble|downlink|batt|link <arg>\" per line, downlinks are hex, link is join_fail%%:tx_fail%%[:max_dr]\n");
+	printf("  slack   time after a labelled stretch in which refreshes and uplinks still count as intended\n");
+	printf("  -c      uplinks are confirmed, -f applies to them\n");
+	printf("  region  LoRaWAN region and data rate of the uplinks, default eu868:3\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *trace = NULL;
+	const char *script = NULL;
+	uint32_t duration_s = 600;
+
+	for (int idx = 1; idx < argc; idx++)
+	{
+		if ((strcmp(argv[idx], "-t") == 0) && (idx + 1 < argc))
+		{
+			trace = argv[++idx];
+		}
+		else if ((strcmp(argv[idx], "-s") == 0) && (idx + 1 < argc))
+		{
+			script = argv[++idx];
+		}
+		else if ((strcmp(argv[idx], "-d") == 0) && (idx + 1 < argc))
+		{
+			duration_s = atoi(argv[++idx]);
+		}
+		else if ((strcmp(argv[idx], "-f") == 0) && (idx + 1 < argc))
+		{
+			s_mac.tx_fail_rate = atoi(argv[++idx]);
+		}
+		else if (strcmp(argv[idx], "-c") == 0)
+		{
+			g_lorawan_settings.confirmed_msg_enabled = LMH_CONFIRMED_MSG;
+		}
+		else if ((strcmp(argv[idx], "-j") == 0) && (idx + 1 < argc))
+		{
+			s_mac.join_fail_rate = atoi(argv[++idx]);
+		}
+		else if ((strcmp(argv[idx], "-l") == 0) && (idx + 1 < argc))
+		{
+			s_label_slack_ms = atoi(argv[++idx]);
+		}
+		else if ((strcmp(argv[idx], "-r") == 0) && (idx + 1 < argc))
+		{
+			const char *region = argv[++idx];
+			if (strncmp(region, "us915", 5) == 0)
+			{
+				g_lorawan_settings.lora_region = LORAMAC_REGION_US915;
+			}
+			else if (strncmp(region, "eu868", 5) != 0)
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			if (region[5] == ':')
+			{
+				g_lorawan_settings.data_rate = atoi(&region[6]);
+			}
+		}
+		else if (strcmp(argv[idx], "-v") == 0)
+		{
+			g_sim_verbose = true;
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (trace != NULL)
+	{
+		if (!sim_lis3dh_load_trace(trace))
+		{
+			printf("Could not read trace %s\n", trace);
+			return 1;
+		}
+	}
+	else
+	{
+		sim_lis3dh_synthetic_trace(duration_s * 1000);
+	}
+	if (script != NULL)
+	{
+		if (!load_script(script))
+		{
+			printf("Could not read script %s\n", script);
+			return 1;
+		}
+	}
+	else
+	{
+		default_script();
+	}
+
+	sim_start();
+	run_until((uint64_t)duration_s * 1000000);
+
+	printf("WisBlock-Heart native simulation, firmware %d.%d.%d\n", s_sw_version[0], s_sw_version[1], s_sw_version[2]);
+	report();
+	return 0;
+}
+#endif
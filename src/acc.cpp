@@ -15,6 +15,22 @@ void acc_int_callback(void);
 /** The LIS3DH sensor */
 LIS3DH acc_sensor(I2C_MODE, 0x18);
 
+/** Samples per burst read, 30 bytes fit into the 32 byte I2C buffer */
+#define ACC_BURST_SAMPLES 5
+
+/** Samples read from the FIFO, oldest are overwritten when nobody reads them */
+static s_acc_sample acc_ring[ACC_RING_SIZE];
+static uint16_t acc_ring_head = 0;
+static uint16_t acc_ring_tail = 0;
+/** Samples lost because the ring was full */
+uint32_t g_acc_ring_dropped = 0;
+
+/** mg per digit of the 10 bit normal mode output for +/-2, 4, 8 and 16 g */
+static uint8_t acc_lsb_mg = 4;
+
+/** Click threshold, a tap on the badge peaks far above a bump in the pocket */
+#define ACC_CLICK_THS_MG 1200
+
 /**
  * @brief Initialize LIS3DH 3-axis 
  * acceleration sensor
@@ -29,7 +45,7 @@ bool init_acc(void)
 
 	Wire.begin();
 
-	acc_sensor.settings.accelSampleRate = 10; //Hz.  Can be: 0,1,10,25,50,100,200,400,1600,5000 Hz
+	acc_sensor.settings.accelSampleRate = ACC_SAMPLE_RATE; //Hz.  Can be: 0,1,10,25,50,100,200,400,1600,5000 Hz
 	acc_sensor.settings.accelRange = 2;		  //Max G force readable.  Can be: 2, 4, 8, 16
 
 	acc_sensor.settings.adcEnabled = 0;
@@ -44,6 +60,22 @@ bool init_acc(void)
 		return false;
 	}
 
+	switch (acc_sensor.settings.accelRange)
+	{
+	case 4:
+		acc_lsb_mg = 8;
+		break;
+	case 8:
+		acc_lsb_mg = 16;
+		break;
+	case 16:
+		acc_lsb_mg = 48;
+		break;
+	default:
+		acc_lsb_mg = 4;
+		break;
+	}
+
 	uint8_t data_to_write = 0;
 	// Enable interrupts
 	data_to_write |= 0x20;									  //Z high
@@ -62,25 +94,40 @@ bool init_acc(void)
 
 	// Set interrupt signal length
 	data_to_write = 0;
-	data_to_write |= 0x01; // 1 * 1/50 s = 20ms
+	data_to_write |= ACC_SAMPLE_RATE / 10; // About 100 ms as with the former 10 Hz and one sample
 	acc_sensor.writeRegister(LIS3DH_INT1_DURATION, data_to_write);
 
 	acc_sensor.readRegister(&data_to_write, LIS3DH_CTRL_REG5);
-	data_to_write &= 0xF3;									   //Clear bits of interest
+	data_to_write &= 0xB3;									   //Clear bits of interest
+	data_to_write |= 0x40;									   //FIFO enable
 	data_to_write |= 0x08;									   //Latch interrupt (Cleared by reading int1_src)
 	acc_sensor.writeRegister(LIS3DH_CTRL_REG5, data_to_write); // Set interrupt to latching
 
-	// Select interrupt pin 1
+	// FIFO in stream mode, the oldest sample is dropped when it is full
+	acc_sensor.writeRegister(LIS3DH_FIFO_CTRL_REG, 0x00); // Bypass mode empties the FIFO
 	data_to_write = 0;
-	data_to_write |= 0x40; //AOI1 event (Generator 1 interrupt on pin 1)
-	data_to_write |= 0x20; //AOI2 event ()
-	acc_sensor.writeRegister(LIS3DH_CTRL_REG3, data_to_write);
+	data_to_write |= 0x80;					  // Stream mode
+	data_to_write |= ACC_FIFO_WATERMARK & 0x1F; // Watermark level
+	acc_sensor.writeRegister(LIS3DH_FIFO_CTRL_REG, data_to_write);
+
+	// Single and double click on all axes
+	acc_sensor.writeRegister(LIS3DH_CLICK_CFG, 0x3F);
+	data_to_write = 0;
+	data_to_write |= 0x80;						 // Latch click interrupt (Cleared by reading click_src)
+	data_to_write |= (ACC_CLICK_THS_MG / 16) & 0x7F; // 16 mg per LSB at +/-2 g
+	acc_sensor.writeRegister(LIS3DH_CLICK_THS, data_to_write);
+	acc_sensor.writeRegister(LIS3DH_TIME_LIMIT, ACC_SAMPLE_RATE * 30 / 1000);	 // Taps are shorter than 30 ms, pocket bumps longer
+	acc_sensor.writeRegister(LIS3DH_TIME_LATENCY, ACC_SAMPLE_RATE * 100 / 1000); // 100 ms dead time after the first tap
+	acc_sensor.writeRegister(LIS3DH_TIME_WINDOW, ACC_SAMPLE_RATE * 300 / 1000);	 // Second tap within 300 ms
+
+	// Select interrupt pin 1, the FIFO watermark is only enabled while a gesture is ongoing
+	set_acc_fifo_wakeup(false);
 
 	// No interrupt on pin 2
 	acc_sensor.writeRegister(LIS3DH_CTRL_REG6, 0x00); 
 
-	// Enable high pass filter
-	acc_sensor.writeRegister(LIS3DH_CTRL_REG2, 0x01); 
+	// Enable high pass filter for AOI1 and click
+	acc_sensor.writeRegister(LIS3DH_CTRL_REG2, 0x05); 
 
 	clear_acc_int();
 
@@ -90,38 +137,142 @@ bool init_acc(void)
 	return true;
 }
 
-void read_acc(void)
+/**
+ * @brief Drain the FIFO into the sample ring with burst reads.
+ *        With the FIFO enabled the register address rolls back from
+ *        OUT_Z_H to OUT_X_L, so one auto-increment read returns
+ *        several samples.
+ *
+ * @return uint16_t number of samples read
+ */
+uint16_t read_acc(void)
 {
-	int16_t acc_x = (int16_t)(acc_sensor.readFloatAccelX() * 1000.0);
-	int16_t acc_y = (int16_t)(acc_sensor.readFloatAccelY() * 1000.0);
-	int16_t acc_z = (int16_t)(acc_sensor.readFloatAccelZ() * 1000.0);
+	uint8_t fifo_src = 0;
+	acc_sensor.readRegister(&fifo_src, LIS3DH_FIFO_SRC_REG);
+	if (fifo_src & 0x20)
+	{
+		// FIFO empty
+		return 0;
+	}
+	// FSS counts up to 31, an overrun means all 32 levels are filled
+	uint8_t available = (fifo_src & 0x40) ? 32 : (fifo_src & 0x1F);
+
+	uint8_t raw[ACC_BURST_SAMPLES * 6];
+	uint16_t samples = 0;
+	while (samples < available)
+	{
+		uint8_t chunk = available - samples;
+		if (chunk > ACC_BURST_SAMPLES)
+		{
+			chunk = ACC_BURST_SAMPLES;
+		}
+		if (acc_sensor.readRegisterRegion(raw, LIS3DH_OUT_X_L, chunk * 6) != IMU_SUCCESS)
+		{
+			MYLOG("ACC", "FIFO read failed");
+			break;
+		}
+		for (uint8_t idx = 0; idx < chunk; idx++)
+		{
+			// 10 bit left justified two's complement
+			uint8_t *data = &raw[idx * 6];
+			acc_ring[acc_ring_head].x = ((int16_t)(data[0] | (data[1] << 8)) >> 6) * acc_lsb_mg;
+			acc_ring[acc_ring_head].y = ((int16_t)(data[2] | (data[3] << 8)) >> 6) * acc_lsb_mg;
+			acc_ring[acc_ring_head].z = ((int16_t)(data[4] | (data[5] << 8)) >> 6) * acc_lsb_mg;
+			acc_ring_head = (acc_ring_head + 1) % ACC_RING_SIZE;
+			if (acc_ring_head == acc_ring_tail)
+			{
+				acc_ring_tail = (acc_ring_tail + 1) % ACC_RING_SIZE;
+				g_acc_ring_dropped++;
+			}
+		}
+		samples += chunk;
+	}
+	return samples;
+}
 
-	MYLOG("ACC", "X %.3f %.3f %d", acc_sensor.readFloatAccelX(), acc_sensor.readFloatAccelX() * 1000.0, acc_x);
-	MYLOG("ACC", "Y %.3f %.3f %d", acc_sensor.readFloatAccelY(), acc_sensor.readFloatAccelY() * 1000.0, acc_y);
-	MYLOG("ACC", "Z %.3f %.3f %d", acc_sensor.readFloatAccelZ(), acc_sensor.readFloatAccelZ() * 1000.0, acc_z);
+/**
+ * @brief Number of samples waiting in the ring
+ */
+uint16_t acc_samples_available(void)
+{
+	return (acc_ring_head + ACC_RING_SIZE - acc_ring_tail) % ACC_RING_SIZE;
+}
 
+/**
+ * @brief Take the oldest sample from the ring
+ *
+ * @param sample receives the sample
+ * @return true if there was a sample
+ */
+bool acc_get_sample(s_acc_sample *sample)
+{
+	if (acc_ring_head == acc_ring_tail)
+	{
+		return false;
+	}
+	*sample = acc_ring[acc_ring_tail];
+	acc_ring_tail = (acc_ring_tail + 1) % ACC_RING_SIZE;
+	return true;
 }
 
 /**
  * @brief ACC interrupt handler
- * @note gives semaphore to wake up main loop
+ * @note posts the interrupt and gives semaphore to wake up main loop
  * 
  */
 void acc_int_callback(void)
 {
-	g_task_event_type |= ACC_TRIGGER;
-    MYLOG("ACC", "Interrupt callback");
-	xSemaphoreGiveFromISR(g_task_sem, pdFALSE);
+	post_event(EVENT_SOURCE_ACC, ACC_TRIGGER);
+}
+
+/**
+ * @brief Route the FIFO watermark to INT1 or not. Without it only a
+ *        movement or a click wakes up the MCU, the FIFO keeps the last
+ *        samples before the event.
+ *
+ * @param enable true to wake up on every full batch
+ */
+void set_acc_fifo_wakeup(bool enable)
+{
+	uint8_t data_to_write = 0;
+	data_to_write |= 0x80; //Click event
+	data_to_write |= 0x40; //AOI1 event (Generator 1 interrupt on pin 1)
+	data_to_write |= 0x20; //AOI2 event ()
+	if (enable)
+	{
+		data_to_write |= 0x04; //FIFO watermark
+	}
+	acc_sensor.writeRegister(LIS3DH_CTRL_REG3, data_to_write);
 }
 
 /**
  * @brief Clear ACC interrupt register to enable next wakeup
  * 
+ * @return uint8_t ACC_INT_MOVE, ACC_INT_TAP and ACC_INT_DOUBLE_TAP for
+ *         the sources that were active
  */
-void clear_acc_int(void)
+uint8_t clear_acc_int(void)
 {
+	uint8_t sources = 0;
 	uint8_t data_read;
 	acc_sensor.readRegister(&data_read, LIS3DH_INT1_SRC);
 	if (data_read & 0x40)
-		MYLOG("ACC", "Interrupt Active 0x%X", data_read);
+	{
+		MYLOG_DEBUG("ACC", "Interrupt Active 0x%X", data_read);
+		sources |= ACC_INT_MOVE;
+	}
+	acc_sensor.readRegister(&data_read, LIS3DH_CLICK_SRC);
+	if (data_read & 0x40)
+	{
+		MYLOG_DEBUG("ACC", "Click Active 0x%X", data_read);
+		if (data_read & 0x20)
+		{
+			sources |= ACC_INT_DOUBLE_TAP;
+		}
+		else if (data_read & 0x10)
+		{
+			sources |= ACC_INT_TAP;
+		}
+	}
+	return sources;
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
  */
 
 #include "app.h"
+#include "msg_codec.h"
 
 /** Set the device name, max length is 10 characters */
 char g_ble_dev_name[10] = "WB-Love";
@@ -52,14 +53,32 @@ bool init_app(void)
 {
     bool init_result = true;
 
+	// Task that prints the debug output
+	init_log();
+
 	MYLOG("APP", "Application initialization");
 
     // Initialize ACC sensor
 	init_result |= init_acc();
 
+	// Timers for the coalesced display refresh and uplinks
+	init_coalesce();
+
+	// Timer for the requests of missing downlink fragments
+	init_frag();
+
+	// Timer for busy retries and the airtime budget of the uplinks
+	init_uplink_queue();
+
+	// Timer for the join backoff
+	init_link();
+
 	// Initialize EPD
 	init_result |= init_epd();
 
+	// Images of the messages and an upload that was interrupted by a reset
+	init_message_images();
+
 	// Initialize User Data File
 	init_user_flash_data();
 
@@ -76,11 +95,23 @@ bool init_app(void)
  */
 void app_event_handler(void)
 {
+	// Interrupts and timers since the last round are handled as one batch
+	uint16_t events = take_events(APP_EVENTS);
+	s_event_record record;
+
+	// Quiet windows, retries and timeouts, a type runs once however often its timer fired
+	event_batch(EVENT_SOURCE_TIMER);
+	while (event_take(EVENT_SOURCE_TIMER, &record))
+	{
+		MYLOG_DEBUG("APP", "Timer event 0x%04X after %lu ms", record.type, (unsigned long)(millis() - record.time));
+		events |= record.type;
+	}
+
 	// Timer triggered event
-	if ((g_task_event_type & STATUS) == STATUS)
+	if ((events & STATUS) == STATUS)
 	{
-		g_task_event_type &= N_STATUS;
 		MYLOG("APP", "Timer wakeup");
+		log_event_stats();
 
 		// If BLE is enabled, restart Advertising
 		if (g_enable_ble)
@@ -88,41 +119,119 @@ void app_event_handler(void)
 			restart_advertising(15);
 		}
 
-        // Dummy packet
-        uint8_t dummy_packet[] = {0x10, 0x00, 0x00};
-
-        lmh_error_status result = send_lora_packet(dummy_packet, 3);
-        switch (result)
-        {
-            case LMH_SUCCESS:
-                    MYLOG("APP", "Packet enqueued");
-                    break;
-            case LMH_BUSY:
-                    MYLOG("APP", "LoRa transceiver is busy");
-                    break;
-            case LMH_ERROR:
-                    MYLOG("APP", "Packet error, too big to send with current DR");
-                    break;
-		}
+		// Pending gesture reasons go out with the timer packet
+		request_uplink(UPLINK_REASON_TIMER);
+		send_uplink();
 	}
 
     // ACC trigger event
-	if ((g_task_event_type & ACC_TRIGGER) == ACC_TRIGGER &&  (g_lpwan_has_joined || !g_lorawan_settings.auto_join))
+	if ((events & ACC_TRIGGER) == ACC_TRIGGER)
 	{
-		g_task_event_type &= N_ACC_TRIGGER;
-		MYLOG("APP", "ACC triggered");
-		clear_acc_int();
-		// Switch EPD message
-		gMsgNum++;
-		switch_epd_message();
+		// One round per INT1 edge, a bit raised without an edge gets one as well
+		event_batch(EVENT_SOURCE_ACC);
+		event_take(EVENT_SOURCE_ACC, &record);
+		do
+		{
+			// INT1 is shared by the FIFO watermark, the movement and the click detection
+			uint16_t samples = read_acc();
+			if (samples != 0)
+			{
+				MYLOG_DEBUG("APP", "ACC FIFO %d samples", samples);
+			}
+			uint8_t sources = clear_acc_int();
+			if (sources != 0)
+			{
+				// Another gesture may follow, keep the display still
+				postpone_display();
+			}
+			events |= classify_gestures(sources);
+		} while (event_take(EVENT_SOURCE_ACC, &record));
+		// A source that came up while reading keeps INT1 high without a new edge
+		if (digitalRead(INT1_PIN) == HIGH)
+		{
+			raise_event(ACC_TRIGGER);
+		}
+	}
+
+	// Gestures are ignored while the device is still joining
+	if ((events & (TAP_EVENT | DOUBLE_TAP_EVENT | SHAKE_EVENT | FLIP_EVENT)) &&
+		!(g_lpwan_has_joined || !g_lorawan_settings.auto_join))
+	{
+		events &= N_TAP_EVENT & N_DOUBLE_TAP_EVENT & N_SHAKE_EVENT & N_FLIP_EVENT;
+	}
 
-		if (g_lpwan_has_joined) 
+	// Single tap shows the next message
+	if ((events & TAP_EVENT) == TAP_EVENT)
+	{
+		MYLOG("APP", "Tap");
+		// After the RAK logo comes message 1 again
+		gMsgNum = step_epd_message(gMsgNum, true);
+		request_display();
+		request_uplink(UPLINK_REASON_TAP);
+	}
+
+	// Double tap goes back to the previous message
+	if ((events & DOUBLE_TAP_EVENT) == DOUBLE_TAP_EVENT)
+	{
+		MYLOG("APP", "Double tap");
+		// Before message 1 comes the RAK logo
+		gMsgNum = step_epd_message(gMsgNum, false);
+		request_display();
+		request_uplink(UPLINK_REASON_DOUBLE_TAP);
+	}
+
+	// Shake only sends a packet, the display stays as it is
+	if ((events & SHAKE_EVENT) == SHAKE_EVENT)
+	{
+		MYLOG("APP", "Shake");
+		request_uplink(UPLINK_REASON_SHAKE);
+	}
+
+	// Turning the display away shows the RAK logo instead of the message
+	if ((events & FLIP_EVENT) == FLIP_EVENT)
+	{
+		MYLOG("APP", "Flip");
+		gMsgNum = MSG_LOGO;
+		request_display();
+		request_uplink(UPLINK_REASON_FLIP);
+	}
+
+	// EPD refresh is over or gestures stopped long enough, show the last selected message
+	if ((events & DISPLAY_EVENT) == DISPLAY_EVENT)
+	{
+		// Every BUSY edge ends a refresh
+		event_batch(EVENT_SOURCE_EPD);
+		while (event_take(EVENT_SOURCE_EPD, &record))
 		{
-			// Trigger a packet sending
-        	g_task_event_type |= STATUS;
+			MYLOG_DEBUG("APP", "EPD BUSY after %lu ms", (unsigned long)(millis() - record.time));
+			handle_epd_event();
 		}
+		// The refresh timeout comes as a timer event
+		handle_epd_event();
+		handle_display_event();
+	}
+
+	// Uplink quiet window or queue retry time is over, send the collected reasons and what waits
+	if ((events & UPLINK_EVENT) == UPLINK_EVENT)
+	{
+		handle_link_event();
+		send_uplink();
+		service_uplink_queue();
+		log_coalesce_stats();
+		log_uplink_stats();
 	}
 
+	// Request missing downlink fragments or acknowledge a complete payload
+	if ((events & FRAG_EVENT) == FRAG_EVENT)
+	{
+		send_frag_request();
+	}
+
+	// Commit changed messages or compact the user data log
+	if ((events & STORE_EVENT) == STORE_EVENT)
+	{
+		handle_store_event();
+	}
 }
 
 /**
@@ -139,7 +248,7 @@ void ble_data_handler(void)
 			MYLOG("AT", "RECEIVED BLE");
 			// BLE UART data arrived
 			// in this example we forward it to the AT command interpreter
-			g_task_event_type &= N_BLE_DATA;
+			clear_event(BLE_DATA);
 
 			while (g_ble_uart.available() > 0)
 			{
@@ -151,6 +260,82 @@ void ble_data_handler(void)
 	}
 }
 
+/**
+ * @brief Handle the payload of a downlink or of a reassembled
+ *        fragmented downlink
+ *
+ * @param data payload
+ * @param len size of data
+ */
+static void handle_downlink(const uint8_t *data, uint16_t len)
+{
+	if ((len > 0) && ((data[0] == MSG_PATCH_DOWNLINK) || (data[0] == MSG_COPY_DOWNLINK)))
+	{
+		// Only the changed bytes of a message
+		uint8_t changed = apply_message_delta(data, len);
+		if (changed != 0)
+		{
+			gMsgNum = changed;
+			switch_epd_message();
+		}
+		return;
+	}
+
+	if ((len > 0) && ((data[0] == IMG_BEGIN_DOWNLINK) || (data[0] == IMG_CHUNK_DOWNLINK)))
+	{
+		// A piece of an image upload
+		uint8_t done = apply_image_downlink(data, len);
+		if (done != 0)
+		{
+			gMsgNum = done;
+			switch_epd_message();
+		}
+		return;
+	}
+
+	// Message downlinks are "<slot>:<text>" or MSG_CODEC_DOWNLINK, slot and the packed text
+	uint16_t slot = 0;
+	const char *text = NULL;
+	int16_t text_len = -1;
+	char unpacked[MSG_MAX_LEN + 1];
+	if ((len > 2) && (data[0] == MSG_CODEC_DOWNLINK))
+	{
+		slot = data[1];
+		text_len = msg_decode(&data[2], len - 2, unpacked, sizeof(unpacked));
+		text = unpacked;
+	}
+	else
+	{
+		uint8_t pos = 0;
+		while ((pos < 3) && (pos < len) && isdigit(data[pos]))
+		{
+			slot = slot * 10 + (data[pos] - '0');
+			pos++;
+		}
+		if ((pos > 0) && (pos < len) && (data[pos] == ':'))
+		{
+			text = (const char *)&data[pos + 1];
+			text_len = len - pos - 1;
+		}
+	}
+	if (text == NULL)
+	{
+		return;
+	}
+
+	MYLOG("APP", "The downlink was for setting a new EDP message");
+	// The message is written to User Flash Data with the next commit
+	if ((text_len < 0) || (slot == 0) || (slot > MSG_SLOTS) || !set_message(slot, text, text_len))
+	{
+		MYLOG("APP", "Message downlink rejected");
+		return;
+	}
+	gMsgNum = slot;
+
+	// Show the message
+	switch_epd_message();
+}
+
 /**
  * @brief Handle received LoRa Data
  * 
@@ -160,16 +345,17 @@ void lora_data_handler(void)
 	// LoRa Join finished handling
 	if ((g_task_event_type & LORA_JOIN_FIN) == LORA_JOIN_FIN)
 	{
-		g_task_event_type &= N_LORA_JOIN_FIN;
+		clear_event(LORA_JOIN_FIN);
 		if (g_join_result)
 		{
 			MYLOG("APP", "Successfully joined network");
+			link_join_result(true);
 		}
 		else
 		{
 			MYLOG("APP", "Join network failed");
-			/// \todo here join could be restarted.
-			lmh_join();
+			// Joined again after a backoff
+			link_join_result(false);
 
 			// If BLE is enabled, restart Advertising
 			if (g_enable_ble)
@@ -182,71 +368,43 @@ void lora_data_handler(void)
 	// LoRa data handling
 	if ((g_task_event_type & LORA_DATA) == LORA_DATA)
 	{
-		g_task_event_type &= N_LORA_DATA;
-		MYLOG("APP", "Received package over LoRa");
-		char log_buff[g_rx_data_len * 3] = {0};
-		uint8_t log_idx = 0;
-		for (int idx = 0; idx < g_rx_data_len; idx++)
-		{
-			sprintf(&log_buff[log_idx], "%02X ", g_rx_lora_data[idx]);
-			log_idx += 3;
-		}
-		MYLOG("APP", "%s", log_buff);
+		clear_event(LORA_DATA);
+		MYLOG("APP", "Received package over LoRa, %d bytes, RSSI %d, SNR %d", g_rx_data_len, g_last_rssi, g_last_snr);
+		link_downlink();
+		rx_capture(g_rx_lora_data, g_rx_data_len, g_last_rssi, g_last_snr);
+		MYLOG_HEX("APP", g_rx_lora_data, g_rx_data_len);
 
-		if (g_rx_lora_data[1] == ':') 
+		if ((g_rx_data_len > FRAG_HEADER_SIZE) && (g_rx_lora_data[0] == FRAG_DOWNLINK))
 		{
-			MYLOG("APP", "The downlink was for setting a new EDP message");
-			switch (g_rx_lora_data[0])
+			// One piece of a larger payload
+			if (frag_add(g_rx_lora_data, g_rx_data_len))
 			{
-				case '1':
-					memcpy(g_user_flash_data.epd_msg_1, &g_rx_lora_data[2], 80);
-					gMsgNum = 1;
-					break;
-				case '2':
-					memcpy(g_user_flash_data.epd_msg_2, &g_rx_lora_data[2], 80);
-					gMsgNum = 2;
-					break;
-				case '3':
-					memcpy(g_user_flash_data.epd_msg_3, &g_rx_lora_data[2], 80);
-					gMsgNum = 3;
-					break;
-				case '4':
-					memcpy(g_user_flash_data.epd_msg_4, &g_rx_lora_data[2], 80);
-					gMsgNum = 4;
-					break;
-				default:
-					break;
+				uint16_t payload_len;
+				const uint8_t *payload = frag_payload(&payload_len);
+				handle_downlink(payload, payload_len);
 			}
-
-			// Clear g_rx_lora_data to avoid future messages overlapping
-			memset(g_rx_lora_data, 0, 256);
-			
-			// Save message to User Flash Data
-			save_user_flash_data();
-			// Show the message
-			switch_epd_message();
+		}
+		else
+		{
+			handle_downlink(g_rx_lora_data, g_rx_data_len);
 		}
 
+		// Clear g_rx_lora_data to avoid future messages overlapping
+		memset(g_rx_lora_data, 0, 256);
 	}
 
 	// LoRa TX finished handling
 	if ((g_task_event_type & LORA_TX_FIN) == LORA_TX_FIN)
 	{
-		g_task_event_type &= N_LORA_TX_FIN;
+		clear_event(LORA_TX_FIN);
 
 		MYLOG("APP", "LPWAN TX cycle %s", g_rx_fin_result ? "finished ACK" : "failed NAK");
 
-		if (!g_rx_fin_result)
-		{
-			// Increase fail send counter
-			send_fail++;
+		// Missing ACKs step the data rate down and finally join again
+		link_tx_result(g_rx_fin_result);
+		log_link_stats();
 
-			if (send_fail == 10)
-			{
-				// Too many failed sendings, reset node and try to rejoin
-				delay(100);
-				sd_nvic_SystemReset();
-			}
-		}
+		// The LoRaMAC is free again for what waits in the uplink queue
+		service_uplink_queue();
 	}
 }
\ No newline at end of file
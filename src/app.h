@@ -28,21 +28,35 @@
 #define MY_DEBUG 0
 #endif
 
+/** Deferred debug output, see log.h */
+#include "log.h"
+
 #if MY_DEBUG > 0
-#define MYLOG(tag, ...)                     \
-	do                                      \
-	{                                       \
-		if (tag)                            \
-			PRINTF("[%s] ", tag);           \
-		PRINTF(__VA_ARGS__);                \
-		PRINTF("\n");                       \
-		if (g_ble_uart_is_connected)        \
-		{                                   \
-			g_ble_uart.printf(__VA_ARGS__); \
-		}                                   \
+#define MYLOG(tag, ...) LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define MYLOG_DEBUG(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+/** Hex dump in lines of LOG_HEX_BYTES, the stack it needs doesn't grow with len */
+#define MYLOG_HEX(tag, data, len)                                              \
+	do                                                                         \
+	{                                                                          \
+		if (log_tag_level(tag) >= LOG_LEVEL_INFO)                              \
+		{                                                                      \
+			char log_line[3 * LOG_HEX_BYTES];                                  \
+			for (uint16_t log_pos = 0; log_pos < (len); log_pos += LOG_HEX_BYTES) \
+			{                                                                  \
+				uint16_t log_num = (len) - log_pos;                            \
+				if (log_num > LOG_HEX_BYTES)                                   \
+				{                                                              \
+					log_num = LOG_HEX_BYTES;                                   \
+				}                                                              \
+				hex_string(log_line, &(data)[log_pos], log_num, ' ');          \
+				MYLOG(tag, "%02X: %s", log_pos, log_line);                     \
+			}                                                                  \
+		}                                                                      \
 	} while (0)
 #else
 #define MYLOG(...)
+#define MYLOG_DEBUG(...)
+#define MYLOG_HEX(...)
 #endif
 
 /** Application function definitions */
@@ -55,6 +69,57 @@ void lora_data_handler(void);
 /** Application events */
 #define ACC_TRIGGER 0b1000000000000000
 #define N_ACC_TRIGGER 0b0111111111111111
+#define TAP_EVENT 0b0100000000000000
+#define N_TAP_EVENT 0b1011111111111111
+#define DOUBLE_TAP_EVENT 0b0010000000000000
+#define N_DOUBLE_TAP_EVENT 0b1101111111111111
+#define SHAKE_EVENT 0b0001000000000000
+#define N_SHAKE_EVENT 0b1110111111111111
+#define FLIP_EVENT 0b0000100000000000
+#define N_FLIP_EVENT 0b1111011111111111
+#define DISPLAY_EVENT 0b0000010000000000
+#define N_DISPLAY_EVENT 0b1111101111111111
+#define UPLINK_EVENT 0b0000001000000000
+#define N_UPLINK_EVENT 0b1111110111111111
+#define STORE_EVENT 0b0000000100000000
+#define N_STORE_EVENT 0b1111111011111111
+#define FRAG_EVENT 0b0000000010000000
+#define N_FRAG_EVENT 0b1111111101111111
+/** Bits the application handler takes as one batch, the LoRa and BLE handlers take their own */
+#define APP_EVENTS (STATUS | ACC_TRIGGER | TAP_EVENT | DOUBLE_TAP_EVENT | SHAKE_EVENT | FLIP_EVENT | DISPLAY_EVENT | \
+					UPLINK_EVENT | STORE_EVENT | FRAG_EVENT)
+
+/** Event queue stuff */
+/** Records per ring, a power of two */
+#define EVENT_RING_SIZE 32
+/** Producers, each one posts from a single context */
+#define EVENT_SOURCE_ACC 0
+#define EVENT_SOURCE_TIMER 1
+#define EVENT_SOURCE_EPD 2
+#define EVENT_SOURCE_NUM 3
+struct s_event_record
+{
+	uint32_t time;
+	uint16_t type;
+};
+struct s_event_stats
+{
+	uint32_t posted[EVENT_SOURCE_NUM] = {0};
+	uint32_t overflows[EVENT_SOURCE_NUM] = {0};
+	uint32_t coalesced[EVENT_SOURCE_NUM] = {0};
+	uint32_t drained = 0;
+	uint32_t batches = 0;
+	uint16_t max_batch = 0;
+	uint32_t max_latency_ms = 0;
+};
+extern s_event_stats g_event_stats;
+void post_event(uint8_t source, uint16_t type);
+void raise_event(uint16_t type);
+void clear_event(uint16_t type);
+uint16_t take_events(uint16_t mask);
+uint16_t event_batch(uint8_t source);
+bool event_take(uint8_t source, s_event_record *record);
+void log_event_stats(void);
 
 /** Application stuff */
 extern BaseType_t g_higher_priority_task_woken;
@@ -62,54 +127,309 @@ extern BaseType_t g_higher_priority_task_woken;
 /** Accelerometer stuff */
 #include <SparkFunLIS3DH.h>
 #define INT1_PIN WB_IO3
+/** Output data rate in Hz, the click engine needs 100 Hz for short taps */
+#define ACC_SAMPLE_RATE 100
+/** FIFO level that wakes up the MCU while a gesture is being classified */
+#define ACC_FIFO_WATERMARK 24
+/** Size of the sample ring, a few FIFO batches */
+#define ACC_RING_SIZE 64
+/** Acceleration in milli-g */
+struct s_acc_sample
+{
+	int16_t x;
+	int16_t y;
+	int16_t z;
+};
+/** Interrupt sources returned by clear_acc_int() */
+#define ACC_INT_MOVE 0x01
+#define ACC_INT_TAP 0x02
+#define ACC_INT_DOUBLE_TAP 0x04
 bool init_acc(void);
-void clear_acc_int(void);
-void read_acc(void);
+uint8_t clear_acc_int(void);
+uint16_t read_acc(void);
+void set_acc_fifo_wakeup(bool enable);
+uint16_t acc_samples_available(void);
+bool acc_get_sample(s_acc_sample *sample);
+extern uint32_t g_acc_ring_dropped;
+
+/** Gesture stuff */
+uint16_t classify_gestures(uint8_t int_sources);
 
 /** EPD stuff */
 bool init_epd(void);
 void switch_epd_message(void);
+void handle_epd_event(void);
+void benchmark_epd_message(uint16_t rounds);
+uint8_t step_epd_message(uint8_t msg_num, bool forward);
 extern uint8_t gMsgNum;
+extern uint8_t g_shown_msg;
 
-/** User flash data stuff */
-#define MY_APP_DATA_MARKER 0x65
-struct s_user_flash_data
+/** Number of cached screens, all messages and the RAK logo */
+#define EPD_CACHE_SLOTS MSG_LOGO
+bool epd_cache_load(uint8_t msg_num, uint8_t *frame, uint32_t frame_size);
+void epd_cache_store(uint8_t msg_num, const uint8_t *frame, uint32_t frame_size);
+void epd_cache_invalidate(uint8_t msg_num);
+void epd_layout_invalidate(uint8_t msg_num);
+
+/** Event coalescing stuff */
+/** Default quiet windows before the EPD is refreshed and before an uplink is sent */
+#define DISPLAY_QUIET_MS 600
+#define UPLINK_QUIET_MS 30000
+/** Uplink reasons, sent as a bit mask in the telemetry frame */
+#define UPLINK_REASON_TIMER 0x01
+#define UPLINK_REASON_TAP 0x02
+#define UPLINK_REASON_DOUBLE_TAP 0x04
+#define UPLINK_REASON_SHAKE 0x08
+#define UPLINK_REASON_FLIP 0x10
+#define UPLINK_REASON_NUM 5
+struct s_coalesce_stats
+{
+	uint32_t display_requests = 0;
+	uint32_t display_refreshes = 0;
+	uint32_t uplink_requests[UPLINK_REASON_NUM] = {0};
+	uint32_t uplinks_sent = 0;
+};
+extern s_coalesce_stats g_coalesce_stats;
+extern uint32_t g_display_quiet_ms;
+extern uint32_t g_uplink_quiet_ms;
+void init_coalesce(void);
+void request_display(void);
+void postpone_display(void);
+void handle_display_event(void);
+void request_uplink(uint8_t reason);
+void send_uplink(void);
+void log_coalesce_stats(void);
+
+/** Fragmented downlink stuff */
+/** First byte of a fragment, followed by session, index, count and the piece */
+#define FRAG_DOWNLINK 0xE1
+#define FRAG_HEADER_SIZE 4
+/** First byte of the uplink with the missing fragments */
+#define FRAG_REQUEST_UPLINK 0x11
+#define FRAG_MAX_COUNT 64
+#define FRAG_BUFFER_SIZE 4096
+/** Pause after a fragment before the missing ones are requested */
+#define FRAG_REQUEST_DELAY_MS 3000
+/** A request without answer is repeated after this time, a session is given up after FRAG_MAX_REQUESTS */
+#define FRAG_RETRY_MS 30000
+#define FRAG_MAX_REQUESTS 8
+struct s_frag_stats
+{
+	uint32_t fragments = 0;
+	uint32_t duplicates = 0;
+	uint32_t sessions = 0;
+	uint32_t completed = 0;
+	uint32_t dropped = 0;
+	uint32_t requests = 0;
+};
+extern s_frag_stats g_frag_stats;
+void init_frag(void);
+bool frag_add(const uint8_t *data, uint16_t len);
+const uint8_t *frag_payload(uint16_t *len);
+void send_frag_request(void);
+
+/** Telemetry stuff */
+/** First byte of the telemetry uplink, followed by version and sections */
+#define TELEMETRY_UPLINK 0x12
+#define TELEMETRY_VERSION 1
+/** Optional sections of the frame */
+#define TELEMETRY_HAS_STATUS 0x01
+#define TELEMETRY_HAS_EVENTS 0x02
+#define TELEMETRY_HAS_DIGESTS 0x04
+/** Gesture times kept between two uplinks, a full ring sends the frame right away */
+#define TELEMETRY_MAX_EVENTS 16
+/** Largest frame, the data rate usually allows less */
+#define TELEMETRY_MAX_SIZE 64
+/** Battery is sent in 10 mV steps above this voltage */
+#define TELEMETRY_BATT_BASE_MV 2500
+extern uint8_t send_fail;
+void telemetry_event(uint8_t reason);
+bool telemetry_events_full(void);
+uint8_t build_telemetry(uint8_t *frame, uint8_t max_size, uint8_t reasons);
+void telemetry_sent(void);
+
+/** Uplink queue stuff */
+/** Payload kinds, a kind is queued once and built when it is sent */
+#define UPLINK_KIND_TELEMETRY 0
+#define UPLINK_KIND_FRAG_REQUEST 1
+#define UPLINK_KIND_IMG_STATUS 2
+#define UPLINK_KIND_NUM 3
+/** Priorities, lower ones leave part of the airtime budget to the higher ones */
+#define UPLINK_PRIO_LOW 0
+#define UPLINK_PRIO_NORMAL 1
+#define UPLINK_PRIO_HIGH 2
+/** Default airtime budget per hour and the burst the token bucket allows, 1% duty cycle */
+#ifndef UPLINK_AIRTIME_BUDGET_MS
+#define UPLINK_AIRTIME_BUDGET_MS 36000
+#endif
+#ifndef UPLINK_AIRTIME_BURST_MS
+#define UPLINK_AIRTIME_BURST_MS 6000
+#endif
+/** Payload that fits every region at DR0, used when the LoRaMAC can't tell the size */
+#define UPLINK_SAFE_SIZE 11
+/** A busy LoRaMAC is tried again after this time or after the running TX cycle */
+#define UPLINK_RETRY_MS 10000
+#define UPLINK_MAX_ATTEMPTS 12
+struct s_uplink_stats
 {
-	uint8_t valid_mark_1 = 0xBA;			   // Just a marker for the Flash
-	uint8_t valid_mark_2 = MY_APP_DATA_MARKER; // Just a marker for the Flash
-
-	uint8_t epd_msg_1[80] = 
-	{
-		' ', ' ', 'H', 'i', '!', ' ', 'I', ' ', 'a', 'm', ' ', 't', 'h', 'i', 'n', 'k', 'i', 'n', 'g', ' ',
-		'a', 'b', 'o', 'u', 't', ' ', 'y', 'o', 'u', '.', ' ', 'L', 'o', 'v', 'e', ' ', 'y', 'o', 'u', ' ',
-		' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-		' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-	};
-	uint8_t epd_msg_2[80] = 
-	{
-		'I', 'f', ' ', 'I', ' ', 'k', 'n', 'o', 'w', ' ', 'w', 'h', 'a', 't', ' ', 'l', 'o', 'v', 'e', ' ',
-		'i', 's', ',', ' ', 'i', 't', ' ', 'i', 's', ' ', 'b', 'e', 'c', 'a', 'u', 's', 'e', ' ', 'o', 'f',
-		'y', 'o', 'u', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-		' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-	};
-	uint8_t epd_msg_3[80] = 
-	{
-		' ', ' ', ' ', 'W', 'h', 'i', 'l', 'e', ' ', '(', 't', 'r', 'u', 'e', ')', ' ', '{', ' ', ' ', ' ',
-		' ', ' ', ' ', ' ', ' ', ' ', 'I', ' ', 'l', 'o', 'v', 'e', ' ', 'y', 'o', 'u', ' ', ' ', ' ', ' ',
-		' ', ' ', ' ', '}', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-		' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-	};
-	uint8_t epd_msg_4[80] = 
-	{
-		'E', 'v', 'e', 'n', ' ', 'w', 'h', 'e', 'n', ' ', 'I', ' ', 'a', 'm', ' ', 'n', 'o', 't', ' ', ' ',
-		'w', 'i', 't', 'h', ' ', 'y', 'o', 'u', ',', ' ', 'a', 'l', 'l', ' ', 'I', ' ', 'c', 'a', 'n', ' ',
-		't', 'h', 'i', 'n', 'k', ' ', 'o', 'f', ' ', 'i', 's', ' ', 'y', 'o', 'u', 'r', ' ', ' ', ' ', ' ',
-		's', 'm', 'i', 'l', 'e', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
-	};
+	uint32_t queued = 0;
+	uint32_t sent = 0;
+	uint32_t merged = 0;
+	uint32_t dropped = 0;
+	uint32_t busy = 0;
+	uint32_t throttled = 0;
+	uint32_t airtime_ms = 0;
 };
-extern s_user_flash_data g_user_flash_data;
+extern s_uplink_stats g_uplink_stats;
+extern uint32_t g_airtime_budget_ms;
+extern uint32_t g_airtime_burst_ms;
+void init_uplink_queue(void);
+void queue_uplink(uint8_t kind, uint8_t priority);
+bool uplink_queued(uint8_t kind);
+void service_uplink_queue(void);
+uint32_t uplink_time_on_air(uint8_t size);
+uint32_t uplink_airtime_tokens(void);
+void log_uplink_stats(void);
+/** Payload builders of the kinds and what happens after the send */
+uint8_t build_telemetry_uplink(uint8_t *frame, uint8_t max_size);
+void telemetry_uplink_done(bool sent);
+uint8_t build_frag_request(uint8_t *frame, uint8_t max_size);
+void frag_request_done(bool sent);
+uint8_t build_image_status(uint8_t *frame, uint8_t max_size);
+void image_status_done(bool sent);
+
+/** Connection stuff */
+/** Failed joins are repeated after JOIN_BACKOFF_MIN_MS, doubled up to JOIN_BACKOFF_MAX_MS, +-25% jitter */
+#ifndef JOIN_BACKOFF_MIN_MS
+#define JOIN_BACKOFF_MIN_MS 15000
+#endif
+#ifndef JOIN_BACKOFF_MAX_MS
+#define JOIN_BACKOFF_MAX_MS 3600000
+#endif
+/** Every LINK_CHECK_UPLINKS unconfirmed uplinks one is sent confirmed */
+#define LINK_CHECK_UPLINKS 8
+/** Unanswered confirmed uplinks before the data rate steps down, below LINK_MIN_DR the badge joins again */
+#define LINK_MISSES_PER_DR 2
+#define LINK_MIN_DR 0
+struct s_link_stats
+{
+	uint32_t joins = 0;
+	uint32_t join_fails = 0;
+	uint32_t rejoins = 0;
+	uint32_t checks = 0;
+	uint32_t acks = 0;
+	uint32_t misses = 0;
+	uint32_t dr_steps = 0;
+};
+extern s_link_stats g_link_stats;
+void init_link(void);
+void link_join_result(bool joined);
+void handle_link_event(void);
+void link_prepare_uplink(void);
+void link_uplink_sent(bool sent);
+void link_tx_result(bool ack);
+void link_downlink(void);
+void log_link_stats(void);
+
+/** RX capture stuff */
+/** Bytes of the capture ring, the oldest frames are overwritten */
+#ifndef RX_CAPTURE_SIZE
+#define RX_CAPTURE_SIZE 1024
+#endif
+/** Bytes per line when the frames are read out */
+#define RX_CAPTURE_LINE_BYTES 32
+struct s_rx_capture_stats
+{
+	uint32_t frames = 0;
+	uint32_t overwritten = 0;
+};
+extern s_rx_capture_stats g_rx_capture_stats;
+extern bool g_rx_capture_enabled;
+void rx_capture(const uint8_t *data, uint8_t len, int16_t rssi, int8_t snr);
+uint16_t rx_capture_frames(uint16_t *used);
+void rx_capture_offload(void);
+
+/** Delta sync stuff */
+/** Replace byte ranges of a message: slot, CRC16 of the current text, then offset, deleted and inserted length and the inserted bytes per range */
+#define MSG_PATCH_DOWNLINK 0xE2
+/** Copy a message: destination slot, source slot and CRC16 of the source text */
+#define MSG_COPY_DOWNLINK 0xE3
+/** Message digests per timer uplink, more slots are sent in turns */
+#ifndef DIGEST_SLOTS_PER_UPLINK
+#define DIGEST_SLOTS_PER_UPLINK 8
+#endif
+/** Unchanged digests are repeated after this many timer uplinks */
+#ifndef DIGEST_REFRESH_UPLINKS
+#define DIGEST_REFRESH_UPLINKS 24
+#endif
+uint16_t message_digest(uint8_t slot);
+uint8_t add_message_digests(uint8_t *dst, uint8_t room);
+void next_message_digests(void);
+uint8_t apply_message_delta(const uint8_t *data, uint16_t len);
+
+/** User flash data stuff */
+#define MY_APP_DATA_MARKER 0x65
+/** Number of stored messages, the RAK logo is the screen after the last one */
+#ifndef MSG_SLOTS
+#define MSG_SLOTS 4
+#endif
+#if MSG_SLOTS > 254
+#error "MSG_SLOTS has to fit into a byte together with the logo screen"
+#endif
+#define MSG_LOGO (MSG_SLOTS + 1)
+/** Longest message, one record of the user data log */
+#define MSG_MAX_LEN 255
+/** RAM for the texts of all messages, they are packed without padding. By default
+ *  one message can have the maximum length next to messages of 80 characters. */
+#ifndef MSG_POOL_SIZE
+#define MSG_POOL_SIZE (MSG_SLOTS * 80 + MSG_MAX_LEN)
+#endif
+/** The log is compacted in the background once it grows beyond this size */
+#define USER_DATA_COMPACT_SIZE 2048
+/** Delay between the save that filled the log and its compaction */
+#define USER_DATA_COMPACT_DELAY_MS 10000
+/** Changed messages are written after this quiet time, but not later than USER_DATA_COMMIT_MAX_MS */
+#define USER_DATA_COMMIT_QUIET_MS 5000
+#define USER_DATA_COMMIT_MAX_MS 30000
+/** Below this battery voltage changes are written right away */
+#define USER_DATA_LOW_BATT_MV 3400
+/** Records written since boot, reported in the telemetry */
+extern uint16_t g_user_data_writes;
 void init_user_flash_data(void);
 void log_user_flash_data(void);
+const char *get_message(uint8_t slot, uint16_t *len);
+bool set_message(uint8_t slot, const char *text, uint16_t len);
+bool user_flash_data_dirty(void);
 boolean save_user_flash_data(void);
+bool compact_user_flash_data(void);
+void handle_store_event(void);
+
+/** Message image stuff */
+#include "rle.h"
+/** Start of an upload: slot, width, height and size of the compressed image (tools/imgconv.py) and its CRC32 */
+#define IMG_BEGIN_DOWNLINK 0xE4
+#define IMG_BEGIN_SIZE 12
+/** Piece of the upload: offset in the compressed image and the bytes */
+#define IMG_CHUNK_DOWNLINK 0xE5
+#define IMG_CHUNK_HEADER_SIZE 3
+/** Answer to every upload downlink: slot, state and the offset the upload continues at */
+#define IMG_STATUS_UPLINK 0x13
+#define IMG_STATE_IDLE 0
+#define IMG_STATE_RECEIVING 1
+#define IMG_STATE_DONE 2
+#define IMG_STATE_FAILED 3
+/** Bytes of the image file read at a time while it is drawn */
+#ifndef IMG_READ_SIZE
+#define IMG_READ_SIZE 64
+#endif
+void init_message_images(void);
+bool message_image(uint8_t slot, uint16_t *width, uint16_t *height);
+bool remove_message_image(uint8_t slot);
+bool open_message_image(uint8_t slot, s_rle_stream *stream, uint8_t *buf, uint16_t buf_size);
+void close_message_image(void);
+bool image_upload_begin(uint8_t slot, uint16_t width, uint16_t height, uint16_t size, uint32_t crc);
+uint8_t image_upload_chunk(uint16_t offset, const uint8_t *data, uint16_t len);
+uint8_t image_upload_state(uint8_t *slot, uint16_t *offset, uint16_t *size);
+uint8_t apply_image_downlink(const uint8_t *data, uint16_t len);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+/**
+ * @file coalesce.cpp
+ * @author agent (agent@local)
+ * @brief Coalescing of the expensive work triggered by gestures. A burst of
+ *        gestures only moves the target message, the EPD is refreshed once
+ *        the gestures stopped for a quiet window. Uplink requests collect
+ *        their reasons and gestures and go out as one telemetry frame
+ *        after their own quiet window, through the uplink queue.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** An uplink is never delayed longer than this many quiet windows */
+#define UPLINK_MAX_QUIET_WINDOWS 4
+
+/** Quiet windows, can be changed with AT+QUIET */
+uint32_t g_display_quiet_ms = DISPLAY_QUIET_MS;
+uint32_t g_uplink_quiet_ms = UPLINK_QUIET_MS;
+
+/** Counters of requested and done work */
+s_coalesce_stats g_coalesce_stats;
+
+static SoftwareTimer display_timer;
+static SoftwareTimer uplink_timer;
+
+static bool display_pending = false;
+static uint8_t uplink_reasons = 0;
+static uint8_t uplink_merged = 0;
+static uint32_t uplink_first_request = 0;
+
+/**
+ * @brief Display quiet window is over
+ */
+static void display_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, DISPLAY_EVENT);
+}
+
+/**
+ * @brief Uplink quiet window is over
+ */
+static void uplink_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, UPLINK_EVENT);
+}
+
+/**
+ * @brief Create the one-shot timers of the quiet windows
+ */
+void init_coalesce(void)
+{
+	display_timer.begin(g_display_quiet_ms, display_timer_cb, NULL, false);
+	uplink_timer.begin(g_uplink_quiet_ms, uplink_timer_cb, NULL, false);
+}
+
+/**
+ * @brief Ask for the EPD to show gMsgNum. Every request restarts the quiet
+ *        window, only the last target of a burst is rendered.
+ */
+void request_display(void)
+{
+	g_coalesce_stats.display_requests++;
+	display_pending = true;
+	display_timer.stop();
+	display_timer.setPeriod(g_display_quiet_ms);
+}
+
+/**
+ * @brief Restart the quiet window of a pending display request, another
+ *        gesture is on its way
+ */
+void postpone_display(void)
+{
+	if (display_pending)
+	{
+		display_timer.stop();
+		display_timer.setPeriod(g_display_quiet_ms);
+	}
+}
+
+/**
+ * @brief Show gMsgNum if a display request is pending
+ */
+void handle_display_event(void)
+{
+	if (!display_pending)
+	{
+		return;
+	}
+	display_pending = false;
+	g_coalesce_stats.display_refreshes++;
+	switch_epd_message();
+}
+
+/**
+ * @brief Ask for an uplink. Reasons collect until the quiet window is over,
+ *        a steady stream of requests is sent after at most
+ *        UPLINK_MAX_QUIET_WINDOWS windows.
+ *
+ * @param reason UPLINK_REASON_xxx
+ */
+void request_uplink(uint8_t reason)
+{
+	for (uint8_t idx = 0; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (reason & (1 << idx))
+		{
+			g_coalesce_stats.uplink_requests[idx]++;
+		}
+	}
+	if (!g_lpwan_has_joined)
+	{
+		return;
+	}
+	if (uplink_merged == 0)
+	{
+		uplink_first_request = millis();
+	}
+	uplink_reasons |= reason;
+	if (uplink_merged < 0xFF)
+	{
+		uplink_merged++;
+	}
+	telemetry_event(reason);
+	if (uplink_queued(UPLINK_KIND_TELEMETRY))
+	{
+		// The frame is built when it goes out, the new gesture is part of it
+		queue_uplink(UPLINK_KIND_TELEMETRY, (reason & ~UPLINK_REASON_TIMER) ? UPLINK_PRIO_NORMAL : UPLINK_PRIO_LOW);
+		return;
+	}
+	if (telemetry_events_full())
+	{
+		// More gestures would push out times that were not sent yet
+		uplink_timer.stop();
+		raise_event(UPLINK_EVENT);
+		return;
+	}
+	if ((millis() - uplink_first_request) < (g_uplink_quiet_ms * UPLINK_MAX_QUIET_WINDOWS))
+	{
+		uplink_timer.stop();
+		uplink_timer.setPeriod(g_uplink_quiet_ms);
+	}
+}
+
+/**
+ * @brief Queue the pending uplink reasons and gestures as one telemetry
+ *        frame. Gestures have priority over the timer, requests that come
+ *        while the frame waits in the uplink queue are merged into it.
+ */
+void send_uplink(void)
+{
+	if ((uplink_merged == 0) || uplink_queued(UPLINK_KIND_TELEMETRY))
+	{
+		return;
+	}
+	uplink_timer.stop();
+	queue_uplink(UPLINK_KIND_TELEMETRY, (uplink_reasons & ~UPLINK_REASON_TIMER) ? UPLINK_PRIO_NORMAL : UPLINK_PRIO_LOW);
+}
+
+/**
+ * @brief Build the telemetry frame when the uplink queue sends it
+ */
+uint8_t build_telemetry_uplink(uint8_t *frame, uint8_t max_size)
+{
+	return build_telemetry(frame, max_size, uplink_reasons);
+}
+
+/**
+ * @brief The uplink queue is done with the telemetry frame
+ *
+ * @param sent true if the LoRaMAC took it, otherwise the reasons and the
+ *        gesture counts stay and the frame is tried again after the next
+ *        quiet window
+ */
+void telemetry_uplink_done(bool sent)
+{
+	if (!sent)
+	{
+		MYLOG("APP", "Telemetry not sent, reasons 0x%02X kept", uplink_reasons);
+		uplink_timer.stop();
+		uplink_timer.setPeriod(g_uplink_quiet_ms);
+		return;
+	}
+	MYLOG("APP", "Telemetry enqueued, reasons 0x%02X from %d requests", uplink_reasons, uplink_merged);
+	g_coalesce_stats.uplinks_sent++;
+	telemetry_sent();
+	if (uplink_reasons & UPLINK_REASON_TIMER)
+	{
+		next_message_digests();
+	}
+	uplink_reasons = 0;
+	uplink_merged = 0;
+}
+
+/**
+ * @brief Printout of the coalescing counters
+ */
+void log_coalesce_stats(void)
+{
+	MYLOG("APP", "Display %lu requests, %lu refreshes", (unsigned long)g_coalesce_stats.display_requests,
+		  (unsigned long)g_coalesce_stats.display_refreshes);
+	MYLOG("APP", "Uplink requests timer %lu tap %lu double tap %lu shake %lu flip %lu",
+		  (unsigned long)g_coalesce_stats.uplink_requests[0], (unsigned long)g_coalesce_stats.uplink_requests[1],
+		  (unsigned long)g_coalesce_stats.uplink_requests[2], (unsigned long)g_coalesce_stats.uplink_requests[3],
+		  (unsigned long)g_coalesce_stats.uplink_requests[4]);
+	MYLOG("APP", "Uplinks sent %lu", (unsigned long)g_coalesce_stats.uplinks_sent);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file crc.cpp
+ * @author agent (agent@local)
+ * @brief CRC32 (IEEE 802.3, reflected 0xEDB88320) with a 16 entry nibble
+ *        table, small enough for flash and fast enough for a few hundred
+ *        bytes per record. CRC16 (CCITT-FALSE, 0x1021) for the message
+ *        digests that go over the air.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "crc.h"
+
+static const uint32_t crc32_nibble[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+static const uint16_t crc16_nibble[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+/**
+ * @brief Continue a CRC32 over more data
+ *
+ * @param crc CRC32_INIT or the result of the previous piece
+ * @param data data to add
+ * @param len size of data
+ * @return uint32_t CRC32 including data
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+	crc = ~crc;
+	for (uint32_t idx = 0; idx < len; idx++)
+	{
+		crc ^= data[idx];
+		crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+		crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+	}
+	return ~crc;
+}
+
+/**
+ * @brief Continue a CRC16 over more data
+ *
+ * @param crc CRC16_INIT or the result of the previous piece
+ * @param data data to add
+ * @param len size of data
+ * @return uint16_t CRC16 including data
+ */
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+	for (uint32_t idx = 0; idx < len; idx++)
+	{
+		crc ^= (uint16_t)data[idx] << 8;
+		crc = (crc << 4) ^ crc16_nibble[crc >> 12];
+		crc = (crc << 4) ^ crc16_nibble[crc >> 12];
+	}
+	return crc;
+}
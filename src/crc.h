@@ -0,0 +1,24 @@
+/**
+ * @file crc.h
+ * @author agent (agent@local)
+ * @brief Checksums of records and payloads
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include <Arduino.h>
+
+/** Start value of a CRC32 that is computed in pieces */
+#define CRC32_INIT 0x00000000
+/** Start value of a CRC16 that is computed in pieces */
+#define CRC16_INIT 0xFFFF
+
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, uint32_t len);
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint32_t len);
+
+#endif
@@ -0,0 +1,246 @@
+/**
+ * @file delta.cpp
+ * @author agent (agent@local)
+ * @brief Delta sync of the messages. The timer uplink carries a CRC16 of
+ *        every message after a change and every DIGEST_REFRESH_UPLINKS
+ *        uplinks, so the network server knows what a badge shows and
+ *        sends changes only to badges that are out of date. A change
+ *        is a patch of byte ranges or a copy of another slot; both name
+ *        the CRC16 of the text they apply to, a badge that has something
+ *        else ignores them and shows its real digests with the next
+ *        timer uplink.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "crc.h"
+
+/** Size of one patched range without the inserted bytes */
+#define PATCH_RANGE_HEADER 3
+
+/** First slot of the digests in the next timer uplink */
+static uint8_t digest_first = 1;
+/** Digests were added to the pending timer uplink */
+static bool digest_added = false;
+static uint8_t digest_num = 0;
+/** Checksum over all digests of the last complete round, the first round after boot is always sent */
+static uint16_t digest_sum = 0;
+static bool digest_sum_valid = false;
+/** Checksum at the start of the round that is being sent */
+static uint16_t digest_round_sum = 0;
+static uint16_t digest_skipped = 0;
+
+/**
+ * @brief CRC16 of the text of a message, an empty message has CRC16_INIT
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @return uint16_t digest
+ */
+uint16_t message_digest(uint8_t slot)
+{
+	uint16_t len;
+	const char *text = get_message(slot, &len);
+	return crc16_update(CRC16_INIT, (const uint8_t *)text, len);
+}
+
+/**
+ * @brief Checksum over the digests of all messages
+ */
+static uint16_t all_digests(void)
+{
+	uint16_t sum = CRC16_INIT;
+	for (uint16_t slot = 1; slot <= MSG_SLOTS; slot++)
+	{
+		uint16_t digest = message_digest(slot);
+		uint8_t bytes[2] = {(uint8_t)(digest >> 8), (uint8_t)(digest & 0xFF)};
+		sum = crc16_update(sum, bytes, 2);
+	}
+	return sum;
+}
+
+/**
+ * @brief Append the digests for a timer uplink, the first slot followed
+ *        by up to DIGEST_SLOTS_PER_UPLINK CRC16, most significant byte first.
+ *        Nothing is added while the server knows the current digests.
+ *
+ * @param dst receives the digests
+ * @param room bytes left in the uplink
+ * @return uint8_t bytes added
+ */
+uint8_t add_message_digests(uint8_t *dst, uint8_t room)
+{
+	digest_added = false;
+	if (digest_first == 1)
+	{
+		digest_round_sum = all_digests();
+		if (digest_sum_valid && (digest_skipped < DIGEST_REFRESH_UPLINKS) && (digest_round_sum == digest_sum))
+		{
+			return 0;
+		}
+	}
+	digest_num = (room < 3) ? 0 : (room - 1) / 2;
+	if (digest_num > DIGEST_SLOTS_PER_UPLINK)
+	{
+		digest_num = DIGEST_SLOTS_PER_UPLINK;
+	}
+	if (digest_num > (MSG_SLOTS + 1 - digest_first))
+	{
+		digest_num = MSG_SLOTS + 1 - digest_first;
+	}
+	if (digest_num == 0)
+	{
+		return 0;
+	}
+	digest_added = true;
+	uint8_t len = 0;
+	dst[len++] = digest_first;
+	for (uint16_t slot = digest_first; slot < digest_first + digest_num; slot++)
+	{
+		uint16_t digest = message_digest(slot);
+		dst[len++] = digest >> 8;
+		dst[len++] = digest & 0xFF;
+	}
+	return len;
+}
+
+/**
+ * @brief The timer uplink went out, the next one continues with the
+ *        following slots
+ */
+void next_message_digests(void)
+{
+	if (!digest_added)
+	{
+		digest_skipped++;
+		return;
+	}
+	digest_added = false;
+	if ((uint16_t)digest_first + digest_num > MSG_SLOTS)
+	{
+		// Round complete, a message that changed while paging is sent again with the next round
+		digest_first = 1;
+		digest_sum = digest_round_sum;
+		digest_sum_valid = true;
+		digest_skipped = 0;
+	}
+	else
+	{
+		digest_first += digest_num;
+	}
+}
+
+/**
+ * @brief Replace byte ranges of a message. The ranges refer to the
+ *        current text and have to be in ascending order.
+ *
+ * @param data MSG_PATCH_DOWNLINK, slot, digest and the ranges
+ * @param len size of data
+ * @return uint8_t patched slot, 0 if the patch was rejected
+ */
+static uint8_t apply_patch(const uint8_t *data, uint16_t len)
+{
+	uint8_t slot = data[1];
+	uint16_t digest = (data[2] << 8) | data[3];
+	if ((slot == 0) || (slot > MSG_SLOTS) || (message_digest(slot) != digest))
+	{
+		MYLOG("DELTA", "Patch for message %d doesn't match", slot);
+		return 0;
+	}
+
+	uint16_t old_len;
+	const char *old_text = get_message(slot, &old_len);
+	char text[MSG_MAX_LEN + 1];
+	uint16_t text_len = 0;
+	uint16_t copied = 0;
+	uint16_t pos = 4;
+	while (pos < len)
+	{
+		if ((len - pos) < PATCH_RANGE_HEADER)
+		{
+			return 0;
+		}
+		uint16_t offset = data[pos];
+		uint16_t deleted = data[pos + 1];
+		uint16_t inserted = data[pos + 2];
+		pos += PATCH_RANGE_HEADER;
+		if ((offset < copied) || ((offset + deleted) > old_len) || ((len - pos) < inserted) ||
+			((text_len + (offset - copied) + inserted) > MSG_MAX_LEN))
+		{
+			MYLOG("DELTA", "Patch for message %d is invalid", slot);
+			return 0;
+		}
+		// Unchanged part before the range, then the new bytes
+		memcpy(&text[text_len], &old_text[copied], offset - copied);
+		text_len += offset - copied;
+		memcpy(&text[text_len], &data[pos], inserted);
+		text_len += inserted;
+		copied = offset + deleted;
+		pos += inserted;
+	}
+	if ((text_len + (old_len - copied)) > MSG_MAX_LEN)
+	{
+		return 0;
+	}
+	memcpy(&text[text_len], &old_text[copied], old_len - copied);
+	text_len += old_len - copied;
+
+	if (!set_message(slot, text, text_len))
+	{
+		return 0;
+	}
+	MYLOG("DELTA", "Message %d patched, %d bytes", slot, text_len);
+	return slot;
+}
+
+/**
+ * @brief Copy a message into another slot
+ *
+ * @param data MSG_COPY_DOWNLINK, destination, source and digest of the source
+ * @return uint8_t destination slot, 0 if the copy was rejected
+ */
+static uint8_t apply_copy(const uint8_t *data)
+{
+	uint8_t dst = data[1];
+	uint8_t src = data[2];
+	uint16_t digest = (data[3] << 8) | data[4];
+	if ((dst == 0) || (dst > MSG_SLOTS) || (src == 0) || (src > MSG_SLOTS) || (message_digest(src) != digest))
+	{
+		MYLOG("DELTA", "Copy of message %d to %d doesn't match", src, dst);
+		return 0;
+	}
+
+	// The pool moves while the destination is replaced
+	uint16_t text_len;
+	char text[MSG_MAX_LEN + 1];
+	const char *src_text = get_message(src, &text_len);
+	memcpy(text, src_text, text_len);
+	if (!set_message(dst, text, text_len))
+	{
+		return 0;
+	}
+	MYLOG("DELTA", "Message %d copied to %d", src, dst);
+	return dst;
+}
+
+/**
+ * @brief Handle a patch or copy downlink
+ *
+ * @param data downlink starting with MSG_PATCH_DOWNLINK or MSG_COPY_DOWNLINK
+ * @param len size of data
+ * @return uint8_t changed slot, 0 if nothing was changed
+ */
+uint8_t apply_message_delta(const uint8_t *data, uint16_t len)
+{
+	if ((len >= 4) && (data[0] == MSG_PATCH_DOWNLINK))
+	{
+		return apply_patch(data, len);
+	}
+	if ((len == 5) && (data[0] == MSG_COPY_DOWNLINK))
+	{
+		return apply_copy(data);
+	}
+	return 0;
+}
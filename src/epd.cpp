@@ -21,6 +21,9 @@
 #include <Adafruit_EPD.h>
 
 #include "images.h"
+#include "epd_driver.h"
+#include "epd_panel.h"
+#include "epd_layout.h"
 
 #include "app.h"
 
@@ -38,44 +41,92 @@
 #define MIDDLE_BUTTON  WB_IO5
 #define RIGHT_BUTTON   WB_IO6
 
-void testdrawtext(int16_t x, int16_t y, char *text, uint16_t text_color, uint32_t text_size);
+/** GFX font of the messages, e.g. -DEPD_TEXT_FONT=FreeSans9pt7b
+ *  -DEPD_TEXT_FONT_HEADER="<Fonts/FreeSans9pt7b.h>", the classic 6x8 font without */
+#ifdef EPD_TEXT_FONT
+#include EPD_TEXT_FONT_HEADER
+#define MSG_FONT (&EPD_TEXT_FONT)
+#else
+#define MSG_FONT NULL
+#endif
 
-/*****************************************************/
-/*****************************************************/
-/* Select the correct display from the defines below */
-/* The display type is printed on the back of the    */
-/* display.                                          */
-/* If you use a different display than the one      */
-/* provided by RAKwireless you have to adjust the    */
-/* the values matching with your custom display      */
-/*****************************************************/
-/*****************************************************/
-typedef struct  DEPG {
-   int  width;
-   int  height;
-   int  position1_x;
-   int  position1_y;  
-   int  position2_x;
-   int  position2_y;  
-   int  position3_x;
-   int  position3_y; 
-   int  position4_x;
-   int  position4_y;   
-} DEPG;
-
-DEPG  DEPG_HP = {250,122,40,20,40,30,40,50,90,40};  //use DEPG0213BNS800F41HP as default
-//DEPG  DEPG_HP = {212,104,30,15,30,25,30,45,80,30};  //  this is for DEPG0213BNS800F42HP
+void testdrawtext(int16_t x, int16_t y, char *text, uint16_t text_color, uint32_t text_size);
 
 uint8_t gMsgNum = 0; // which message to show
+/** Screen on the panel or on its way there, gMsgNum is reset after the logo */
+uint8_t g_shown_msg = 0;
 
-// 2.13" EPD with SSD1680
-Adafruit_SSD1680 display(DEPG_HP.width, DEPG_HP.height, EPD_MOSI,
+// 2.13" EPD with SSD1680, only changed areas are refreshed. The panel is
+// selected with EPD_PANEL, see epd_panel.h
+EPD_SSD1680 display(epd_panel::width, epd_panel::height, EPD_MOSI,
                          EPD_SCK, EPD_DC, EPD_RESET,
                          EPD_CS, SRAM_CS, EPD_MISO,
                          EPD_BUSY);
 
 void testdrawtext(int16_t x, int16_t y, char *text, uint16_t color);
 
+/** A frame is in the framebuffer and waits for the running refresh */
+static bool frame_waiting = false;
+/** Screen of the waiting frame, drawn again band by band with EPD_BAND_ROWS */
+static uint8_t waiting_msg = 0;
+
+/** Catches a refresh whose BUSY edge got lost */
+static SoftwareTimer refresh_timer;
+
+/**
+ * @brief BUSY went low, the refresh is over
+ */
+static void epd_busy_cb(void)
+{
+  display.busy_fell();
+  post_event(EVENT_SOURCE_EPD, DISPLAY_EVENT);
+}
+
+/**
+ * @brief The refresh takes longer than it can
+ */
+static void refresh_timer_cb(TimerHandle_t unused)
+{
+  (void)unused;
+  post_event(EVENT_SOURCE_TIMER, DISPLAY_EVENT);
+}
+
+/**
+ * @brief Start the refresh of the framebuffer and listen for its end
+ * @param render draws the screen, only used with EPD_BAND_ROWS
+ * @param arg passed to render
+ */
+static void start_epd_refresh(epd_render_t render, uint8_t arg)
+{
+#if EPD_BAND_ROWS > 0
+  bool running = display.start_commit_banded(render, arg, true);
+#else
+  (void)render;
+  (void)arg;
+  bool running = display.start_commit(true);
+#endif
+  if(running)
+  {
+    // Attached only now, the BUSY pulses of the power up are of no interest
+    attachInterrupt(EPD_BUSY, epd_busy_cb, FALLING);
+    refresh_timer.stop();
+    refresh_timer.setPeriod(EPD_REFRESH_TIMEOUT_MS);
+  }
+}
+
+/**
+ * @brief Draw the boot screen
+ */
+static void render_boot_screen(uint8_t unused)
+{
+  (void)unused;
+  // large block of text
+  display.clearBuffer();
+
+  display.draw_image(epd_panel::position1_x, epd_panel::position1_y, rak_img);
+  testdrawtext(epd_panel::position3_x, epd_panel::position3_y, "   IoT Made Easy!", (uint16_t)EPD_BLACK, 2);
+}
+
 /**
  * @brief Initialize RAK11200 EPD
  * 
@@ -91,13 +142,12 @@ bool init_epd(void)
 
     display.begin();
 
-    // large block of text
-    display.clearBuffer();
-
-    display.drawBitmap(45, 10, rak_img, 150, 56, EPD_BLACK);
-    testdrawtext(0, 80, "   IoT Made Easy!", (uint16_t)EPD_BLACK, 2);
+#if EPD_BAND_ROWS == 0
+    render_boot_screen(0);
+#endif
 
-    display.display(true);
+    refresh_timer.begin(EPD_REFRESH_TIMEOUT_MS, refresh_timer_cb, NULL, false);
+    start_epd_refresh(render_boot_screen, 0);
 
 	return true;
 }
@@ -119,52 +169,200 @@ void testdrawtext(int16_t x, int16_t y, char *text, uint16_t text_color, uint32_
   display.print(text);
 }
 
-void switch_epd_message()
+/**
+ * @brief Draw the uploaded image of a message centered, it is decoded
+ *        from its file through a buffer of IMG_READ_SIZE bytes
+ * @param msg_num 1 to MSG_SLOTS
+ * @return true if the message has an image
+ */
+static bool render_message_image(uint8_t msg_num)
+{
+  uint16_t width;
+  uint16_t height;
+  uint8_t buf[IMG_READ_SIZE];
+  s_rle_stream stream;
+  if(!message_image(msg_num, &width, &height) || !open_message_image(msg_num, &stream, buf, sizeof(buf)))
+  {
+    return false;
+  }
+  display.draw_image((epd_panel::width - width) / 2, (epd_panel::height - height) / 2, width, height, &stream);
+  close_message_image();
+  return true;
+}
+
+/**
+ * @brief Draw a screen into the framebuffer
+ * @param msg_num 1 to MSG_SLOTS for the stored messages, MSG_LOGO for the RAK logo
+ */
+static void render_epd_message(uint8_t msg_num)
+{
+  display.clearBuffer();
+
+  if(msg_num == MSG_LOGO)
+  {
+    display.draw_image(epd_panel::position2_x, epd_panel::position2_y, rak_img);
+  }
+  else if(!render_message_image(msg_num))
+  {
+    const s_epd_layout *layout = epd_layout_message(msg_num, MSG_FONT, epd_panel::width, epd_panel::height);
+    if(layout != NULL)
+    {
+      epd_layout_draw(display, get_message(msg_num, NULL), MSG_FONT, *layout, EPD_BLACK);
+      // The boot screen uses the classic font
+      display.setFont(NULL);
+    }
+  }
+}
+
+/**
+ * @brief Screen before or after a screen, empty messages are skipped
+ * @param msg_num current screen, 0 if none is selected
+ * @param forward true for the next screen, false for the previous one
+ * @return uint8_t 1 to MSG_SLOTS or MSG_LOGO
+ */
+uint8_t step_epd_message(uint8_t msg_num, bool forward)
 {
-  char str[80];
-  if(gMsgNum == 1)
+  if(!forward && (msg_num == 0))
+  {
+    // Going back from nothing starts at the last message
+    msg_num = MSG_LOGO;
+  }
+  for(uint16_t step = 0; step < MSG_LOGO; step++)
   {
-    MYLOG("EPD", "Message #%d", gMsgNum);
-    display.clearBuffer();
-    //testdrawtext(0, 30, "If I know what love1If I know what love2If I know what love3If I know what love4", (uint16_t)EPD_BLACK, 2);
-    sprintf(str, "%.80s", g_user_flash_data.epd_msg_1);
-    testdrawtext(0, 40, (char*)str, (uint16_t)EPD_BLACK, 2);
-    display.display(true);
+    if(forward)
+    {
+      msg_num = (msg_num % MSG_LOGO) + 1;
+    }
+    else
+    {
+      msg_num = (msg_num <= 1) ? MSG_LOGO : msg_num - 1;
+    }
+    uint16_t len;
+    get_message(msg_num, &len);
+    if((msg_num == MSG_LOGO) || (len != 0) || message_image(msg_num, NULL, NULL))
+    {
+      break;
+    }
   }
+  return msg_num;
+}
 
-  if(gMsgNum == 2)
+/**
+ * @brief Show the screen selected by gMsgNum. The frame comes from the
+ *        cache if possible, otherwise it is rendered and cached. While a
+ *        refresh runs the frame waits in the framebuffer, a later one
+ *        takes its place. With EPD_BAND_ROWS there is no framebuffer, the
+ *        screen is drawn band by band when its refresh starts.
+ */
+void switch_epd_message()
+{
+  if((gMsgNum == 0) || (gMsgNum > EPD_CACHE_SLOTS))
   {
-    MYLOG("EPD", "Message #%d", gMsgNum);
-    display.clearBuffer();
-    sprintf(str, "%.80s", g_user_flash_data.epd_msg_2);
-    testdrawtext(0, 40, (char*)str, (uint16_t)EPD_BLACK, 2);
-    display.display(true);
+    return;
   }
 
-  if(gMsgNum == 3)
+  MYLOG("EPD", "Message #%d", gMsgNum);
+#if EPD_BAND_ROWS == 0
+  uint32_t start = micros();
+  if(epd_cache_load(gMsgNum, display.frame(), display.frame_size()))
+  {
+    MYLOG("EPD", "Frame from cache in %lu us", (unsigned long)(micros() - start));
+  }
+  else
   {
-    MYLOG("EPD", "Message #%d", gMsgNum);
-    display.clearBuffer();
-    sprintf(str, "%.80s", g_user_flash_data.epd_msg_3);
-    testdrawtext(0, 40, (char*)str, (uint16_t)EPD_BLACK, 2);
-    display.display(true);
+    render_epd_message(gMsgNum);
+    MYLOG("EPD", "Frame rendered in %lu us", (unsigned long)(micros() - start));
+    epd_cache_store(gMsgNum, display.frame(), display.frame_size());
   }
+#endif
 
-  if(gMsgNum == 4)
+  waiting_msg = gMsgNum;
+  g_shown_msg = gMsgNum;
+  if(display.refreshing())
   {
-    MYLOG("EPD", "Message #%d", gMsgNum);
-    display.clearBuffer();
-    sprintf(str, "%.80s", g_user_flash_data.epd_msg_4);
-    testdrawtext(0, 40, (char*)str, (uint16_t)EPD_BLACK, 2);
-    display.display(true);
+    if(frame_waiting)
+    {
+      MYLOG("EPD", "Message #%d replaces the waiting frame", gMsgNum);
+    }
+    else
+    {
+      MYLOG("EPD", "Message #%d waits for the refresh", gMsgNum);
+    }
+    frame_waiting = true;
+  }
+  else
+  {
+    start_epd_refresh(render_epd_message, waiting_msg);
   }
 
-  if(gMsgNum == 5)
+  if(gMsgNum == MSG_LOGO)
   {
-    MYLOG("EPD", "Message #%d", gMsgNum);
-    display.clearBuffer();
-    display.drawBitmap(DEPG_HP.position2_x, DEPG_HP.position2_y, rak_img, 150, 56, EPD_BLACK);
-    display.display(true);
     gMsgNum = 0;
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Finish the refresh when BUSY went low or the timeout is over,
+ *        then start the frame that waited for it
+ */
+void handle_epd_event(void)
+{
+  if(!display.refresh_done())
+  {
+    return;
+  }
+  detachInterrupt(EPD_BUSY);
+  refresh_timer.stop();
+  display.finish_commit();
+  if(frame_waiting)
+  {
+    frame_waiting = false;
+    start_epd_refresh(render_epd_message, waiting_msg);
+  }
+}
+
+/**
+ * @brief Compare the time to get each screen into the framebuffer from
+ *        the cache and by rendering it. The panel is not touched, the
+ *        framebuffer is restored to the shown screen afterwards.
+ * @param rounds number of repetitions per screen
+ */
+void benchmark_epd_message(uint16_t rounds)
+{
+#if EPD_BAND_ROWS > 0
+  (void)rounds;
+  MYLOG("EPD", "No framebuffer to benchmark with bands");
+#else
+  uint8_t *shown = (uint8_t *)malloc(display.frame_size());
+  if(shown == NULL)
+  {
+    MYLOG("EPD", "No memory for the benchmark");
+    return;
+  }
+  memcpy(shown, display.frame(), display.frame_size());
+
+  for(uint8_t msg_num = 1; msg_num <= EPD_CACHE_SLOTS; msg_num++)
+  {
+    uint32_t start = micros();
+    for(uint16_t round = 0; round < rounds; round++)
+    {
+      render_epd_message(msg_num);
+    }
+    uint32_t render_us = micros() - start;
+    epd_cache_store(msg_num, display.frame(), display.frame_size());
+
+    start = micros();
+    for(uint16_t round = 0; round < rounds; round++)
+    {
+      epd_cache_load(msg_num, display.frame(), display.frame_size());
+    }
+    uint32_t cache_us = micros() - start;
+
+    MYLOG("EPD", "Screen %d: rendered %lu us, cached %lu us", msg_num,
+          (unsigned long)(render_us / rounds), (unsigned long)(cache_us / rounds));
+  }
+
+  memcpy(display.frame(), shown, display.frame_size());
+  free(shown);
+#endif
+}
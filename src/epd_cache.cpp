@@ -0,0 +1,102 @@
+/**
+ * @file epd_cache.cpp
+ * @author agent (agent@local)
+ * @brief Cache of the rendered EPD frames. Every message slot and the RAK
+ *        logo screen is rendered once, RLE compressed and kept in RAM, so
+ *        switching messages is a decode into the framebuffer instead of
+ *        drawing the text again glyph by glyph. An entry is dropped when
+ *        mark_user_flash_data() changes the message of its slot.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "rle.h"
+
+/** Compressed frame of one screen */
+struct s_epd_cache_entry
+{
+	uint8_t *data = NULL;
+	uint16_t size = 0;
+};
+
+static s_epd_cache_entry epd_cache[EPD_CACHE_SLOTS];
+
+/**
+ * @brief Restore a cached frame into the framebuffer
+ *
+ * @param msg_num screen number as in gMsgNum, 1 to EPD_CACHE_SLOTS
+ * @param frame framebuffer
+ * @param frame_size size of the framebuffer
+ * @return true if the frame was cached
+ */
+bool epd_cache_load(uint8_t msg_num, uint8_t *frame, uint32_t frame_size)
+{
+	if ((msg_num == 0) || (msg_num > EPD_CACHE_SLOTS))
+	{
+		return false;
+	}
+	s_epd_cache_entry *entry = &epd_cache[msg_num - 1];
+	if (entry->data == NULL)
+	{
+		return false;
+	}
+	if (!rle_decode(entry->data, entry->size, frame, frame_size))
+	{
+		MYLOG("EPD", "Cached frame %d is corrupt", msg_num);
+		epd_cache_invalidate(msg_num);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Compress the framebuffer into the cache
+ *
+ * @param msg_num screen number as in gMsgNum, 1 to EPD_CACHE_SLOTS
+ * @param frame framebuffer
+ * @param frame_size size of the framebuffer
+ */
+void epd_cache_store(uint8_t msg_num, const uint8_t *frame, uint32_t frame_size)
+{
+	if ((msg_num == 0) || (msg_num > EPD_CACHE_SLOTS))
+	{
+		return;
+	}
+	epd_cache_invalidate(msg_num);
+
+	uint32_t size = rle_encode(frame, frame_size, NULL, 0);
+	uint8_t *data = (uint8_t *)malloc(size);
+	if (data == NULL)
+	{
+		MYLOG("EPD", "No memory to cache frame %d", msg_num);
+		return;
+	}
+	rle_encode(frame, frame_size, data, size);
+
+	epd_cache[msg_num - 1].data = data;
+	epd_cache[msg_num - 1].size = size;
+	MYLOG("EPD", "Cached frame %d, %lu bytes", msg_num, (unsigned long)size);
+}
+
+/**
+ * @brief Drop the cached frame of a screen
+ *
+ * @param msg_num screen number as in gMsgNum, 1 to EPD_CACHE_SLOTS
+ */
+void epd_cache_invalidate(uint8_t msg_num)
+{
+	if ((msg_num == 0) || (msg_num > EPD_CACHE_SLOTS))
+	{
+		return;
+	}
+	s_epd_cache_entry *entry = &epd_cache[msg_num - 1];
+	if (entry->data != NULL)
+	{
+		free(entry->data);
+		entry->data = NULL;
+		entry->size = 0;
+	}
+}
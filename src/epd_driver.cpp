@@ -0,0 +1,747 @@
+/**
+ * @file epd_driver.cpp
+ * @author agent (agent@local)
+ * @brief SSD1680 driver that only pushes the changed parts of a frame.
+ *        The last committed frame is kept as a shadow copy. On commit the
+ *        framebuffer is compared gate line by gate line, the changed lines
+ *        are grouped into a few RAM windows and only those windows are sent
+ *        before a refresh with the partial update (display mode 2) waveform.
+ *        Every EPD_FULL_REFRESH_EVERY partial refreshes a full refresh is
+ *        done to clear the ghosting. The driver does not wait for the
+ *        refresh, the 0.3 to 2 s of BUSY belong to the caller. The frame
+ *        is streamed from the shadow copy by the EasyDMA transport in
+ *        epd_spi.cpp. With EPD_BAND_ROWS there is neither a framebuffer
+ *        nor a shadow copy, the screen is drawn band by band and a hash
+ *        per band tells which bands changed.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "epd_driver.h"
+#include "epd_spi.h"
+#include "rle.h"
+
+/** SSD1680 commands used on top of the Adafruit driver */
+#define SSD1680_BORDER_CTRL 0x3C
+#define SSD1680_DEEP_SLEEP 0x10
+#define SSD1680_DISP_CTRL2 0x22
+#define SSD1680_MASTER_ACTIVATE 0x20
+#define SSD1680_WRITE_BWRAM 0x24
+#define SSD1680_WRITE_REDRAM 0x26
+#define SSD1680_SET_RAMXPOS 0x44
+#define SSD1680_SET_RAMYPOS 0x45
+#define SSD1680_SET_RAMXCOUNT 0x4E
+#define SSD1680_SET_RAMYCOUNT 0x4F
+
+/** Display update sequences with the display mode 1 and mode 2 waveforms from OTP */
+#define SSD1680_UPDATE_FULL 0xF4
+#define SSD1680_UPDATE_PARTIAL 0xFC
+
+/** Command bytes needed to open a RAM window, worth about one gate line of data */
+#define EPD_WINDOW_COST 14
+
+/**
+ * @brief The frame layout is that of epd_panel, width and height have to be its size
+ */
+EPD_SSD1680::EPD_SSD1680(int width, int height, int16_t SID, int16_t SCLK, int16_t DC, int16_t RST,
+						 int16_t CS, int16_t SRCS, int16_t MISO, int16_t BUSY)
+	: Adafruit_SSD1680(width, height, SID, SCLK, DC, RST, CS, SRCS, MISO, BUSY)
+{
+	epd_spi_begin(CS, DC, SCLK, SID);
+}
+
+/**
+ * @brief Initialize the controller and the shadow of the committed frame
+ *
+ * @param reset passed to Adafruit_SSD1680::begin()
+ */
+void EPD_SSD1680::begin(bool reset)
+{
+	Adafruit_SSD1680::begin(reset);
+#if EPD_BAND_ROWS > 0
+	if (_band_buf[0] == NULL)
+	{
+		uint8_t band_num = (epd_panel::rows + EPD_BAND_ROWS - 1) / EPD_BAND_ROWS;
+		uint8_t *band_buf[2];
+		band_buf[0] = (uint8_t *)malloc(EPD_BAND_ROWS * epd_panel::row_bytes);
+		band_buf[1] = (uint8_t *)malloc(EPD_BAND_ROWS * epd_panel::row_bytes);
+		uint32_t *band_shown = (uint32_t *)malloc(band_num * sizeof(uint32_t));
+		uint32_t *band_sent = (uint32_t *)malloc(band_num * sizeof(uint32_t));
+		if ((band_buf[0] == NULL) || (band_buf[1] == NULL) || (band_shown == NULL) || (band_sent == NULL))
+		{
+			MYLOG("EPD", "No RAM for the bands, nothing is shown");
+			free(band_buf[0]);
+			free(band_buf[1]);
+			free(band_shown);
+			free(band_sent);
+		}
+		else
+		{
+			// Only bands are drawn, the planes of Adafruit_EPD are given back
+			free(buffer1);
+			free(buffer2);
+			buffer1 = buffer2 = black_buffer = color_buffer = NULL;
+			_band_num = band_num;
+			_band_buf[0] = band_buf[0];
+			_band_buf[1] = band_buf[1];
+			_band_shown = band_shown;
+			_band_sent = band_sent;
+		}
+	}
+#else
+	if (_committed == NULL)
+	{
+		_committed = (uint8_t *)malloc(epd_panel::frame_size);
+		if (_committed == NULL)
+		{
+			MYLOG("EPD", "No RAM for the committed frame, only full refreshes");
+		}
+	}
+#endif
+	_committed_valid = false;
+	_partials = 0;
+}
+
+/**
+ * @brief Find the changed areas between the framebuffer and the last
+ *        committed frame. Changed gate lines close to each other are
+ *        merged into one window as long as the lines in between cost
+ *        less than opening another window.
+ *
+ * @param rects array to receive the windows
+ * @param max_rects size of rects
+ * @return uint8_t number of windows, 0 if nothing changed or there is
+ *         no committed frame
+ */
+uint8_t EPD_SSD1680::dirty_rects(s_epd_rect *rects, uint8_t max_rects)
+{
+	uint8_t rect_num = 0;
+	s_epd_rect *rect = NULL;
+
+	if (_committed == NULL)
+	{
+		return 0;
+	}
+
+	for (uint16_t row = 0; row < epd_panel::rows; row++)
+	{
+		uint8_t *new_line = &buffer1[row * epd_panel::row_bytes];
+		uint8_t *old_line = &_committed[row * epd_panel::row_bytes];
+		if (memcmp(new_line, old_line, epd_panel::row_bytes) == 0)
+		{
+			continue;
+		}
+
+		uint8_t first = 0;
+		while (new_line[first] == old_line[first])
+		{
+			first++;
+		}
+		uint8_t last = epd_panel::row_bytes - 1;
+		while (new_line[last] == old_line[last])
+		{
+			last--;
+		}
+
+		if ((rect != NULL) && ((uint32_t)(row - rect->row_end - 1) * epd_panel::row_bytes <= EPD_WINDOW_COST))
+		{
+			rect->row_end = row;
+			if (first < rect->byte_start)
+			{
+				rect->byte_start = first;
+			}
+			if (last > rect->byte_end)
+			{
+				rect->byte_end = last;
+			}
+			continue;
+		}
+
+		if (rect_num == max_rects)
+		{
+			// Out of windows, merge the pair with the smallest gap to make room
+			uint8_t merge = 0;
+			for (uint8_t idx = 1; idx < rect_num - 1; idx++)
+			{
+				if ((rects[idx + 1].row_start - rects[idx].row_end) < (rects[merge + 1].row_start - rects[merge].row_end))
+				{
+					merge = idx;
+				}
+			}
+			rects[merge].row_end = rects[merge + 1].row_end;
+			if (rects[merge + 1].byte_start < rects[merge].byte_start)
+			{
+				rects[merge].byte_start = rects[merge + 1].byte_start;
+			}
+			if (rects[merge + 1].byte_end > rects[merge].byte_end)
+			{
+				rects[merge].byte_end = rects[merge + 1].byte_end;
+			}
+			memmove(&rects[merge + 1], &rects[merge + 2], (rect_num - merge - 2) * sizeof(s_epd_rect));
+			rect_num--;
+		}
+
+		rect = &rects[rect_num++];
+		rect->row_start = row;
+		rect->row_end = row;
+		rect->byte_start = first;
+		rect->byte_end = last;
+	}
+	return rect_num;
+}
+
+/**
+ * @brief Draw a compressed image in black, like drawBitmap() with
+ *        EPD_BLACK. The image is decoded column by column straight into
+ *        the gate lines of the framebuffer or of the band, 8 pixels per
+ *        write. Only the rotated display takes the path over drawPixel().
+ *
+ * @param x left edge
+ * @param y top edge
+ * @param image made by tools/imgconv.py
+ */
+void EPD_SSD1680::draw_image(int16_t x, int16_t y, const s_epd_image &image)
+{
+	s_rle_stream stream;
+	rle_stream_begin(&stream, image.data, image.size);
+	draw_image(x, y, image.width, image.height, &stream);
+}
+
+/**
+ * @brief Draw a compressed image that is decoded from a stream, e.g. one
+ *        that reads the image from a file through a small buffer
+ *
+ * @param x left edge
+ * @param y top edge
+ * @param width columns of the image
+ * @param height rows of the image, up to EPD_IMAGE_MAX_HEIGHT
+ * @param stream decoder at the start of the image data
+ */
+void EPD_SSD1680::draw_image(int16_t x, int16_t y, uint16_t width, uint16_t height, s_rle_stream *stream)
+{
+	uint8_t col_bytes = (height + 7) / 8;
+	if (col_bytes > EPD_IMAGE_MAX_HEIGHT / 8)
+	{
+		return;
+	}
+	uint8_t column[EPD_IMAGE_MAX_HEIGHT / 8] = {0};
+
+#if EPD_BAND_ROWS > 0
+	uint8_t *frame = _band;
+	uint16_t first_row = _band_start;
+	uint16_t rows = _band_rows;
+#else
+	uint8_t *frame = buffer1;
+	uint16_t first_row = 0;
+	uint16_t rows = epd_panel::rows;
+#endif
+	bool direct = (getRotation() == 0) && (y >= 0) && (frame != NULL);
+	uint8_t shift = y & 7;
+
+	for (uint16_t col = 0; col < width; col++)
+	{
+		for (uint8_t idx = 0; idx < col_bytes; idx++)
+		{
+			column[idx] ^= rle_stream_next(stream);
+		}
+
+		int16_t px = x + col;
+		if (!direct)
+		{
+			for (uint16_t py = 0; py < height; py++)
+			{
+				if (column[py / 8] & (0x80 >> (py % 8)))
+				{
+					drawPixel(px, y + py, EPD_BLACK);
+				}
+			}
+			continue;
+		}
+
+		// Columns run from the last gate line to the first one
+		int16_t row = WIDTH - 1 - px - first_row;
+		if (row < 0)
+		{
+			break;
+		}
+		if ((px < 0) || (row >= rows))
+		{
+			continue;
+		}
+		uint8_t *line = &frame[row * epd_panel::row_bytes];
+		for (uint8_t idx = 0; idx < col_bytes; idx++)
+		{
+			if (column[idx] == 0)
+			{
+				continue;
+			}
+			ink_byte(line, (y >> 3) + idx, column[idx] >> shift);
+			if (shift != 0)
+			{
+				ink_byte(line, (y >> 3) + idx + 1, column[idx] << (8 - shift));
+			}
+		}
+	}
+}
+
+/**
+ * @brief Blacken the pixels of a byte of a gate line, the black plane is
+ *        inverted. Sources below the panel height stay as they are.
+ *
+ * @param line gate line
+ * @param byte byte in the gate line
+ * @param ink set bits are black
+ */
+void EPD_SSD1680::ink_byte(uint8_t *line, int16_t byte, uint8_t ink)
+{
+	if (byte >= epd_panel::row_bytes)
+	{
+		return;
+	}
+	int16_t sources = HEIGHT - byte * 8;
+	if (sources < 8)
+	{
+		ink &= 0xFF << (8 - sources);
+	}
+	line[byte] &= ~ink;
+}
+
+/**
+ * @brief Start to show the framebuffer on the panel. Only the changed
+ *        windows are sent and refreshed with the partial waveform, unless
+ *        a full refresh is due. The function returns once the frame is
+ *        streaming, finish_commit() completes the refresh after BUSY went
+ *        low. The windows are copied to the shadow frame and sent from
+ *        there, the framebuffer is free for the next frame right away.
+ *        Without the shadow frame every commit is a full refresh that is
+ *        sent from the framebuffer, and the function waits until it is out.
+ *
+ * @param sleep put the controller into deep sleep when the refresh is done
+ * @return true if a refresh is running, false if the frame was unchanged
+ *         or the refresh was done without a BUSY pin
+ */
+bool EPD_SSD1680::start_commit(bool sleep)
+{
+	// The shadow frame may still stream, and the power up bit-bangs
+	epd_spi_release();
+
+	_spi_bytes = 0;
+	_sleep = sleep;
+	if (!_committed_valid || (_partials >= _full_every))
+	{
+		start_full();
+	}
+	else
+	{
+		_rect_num = dirty_rects(_rects, EPD_MAX_DIRTY_RECTS);
+		if (_rect_num == 0)
+		{
+			MYLOG("EPD", "Frame unchanged, no refresh");
+			return false;
+		}
+
+		powerUp();
+
+		// Keep the border as it is, a partial refresh must not flash it
+		uint8_t border = 0x80;
+		write_cmd(SSD1680_BORDER_CTRL, &border, 1);
+
+		for (uint8_t idx = 0; idx < _rect_num; idx++)
+		{
+			// Whole gate lines, so a window is one block of the shadow frame
+			_rects[idx].byte_start = 0;
+			_rects[idx].byte_end = epd_panel::row_bytes - 1;
+			uint32_t offset = _rects[idx].row_start * epd_panel::row_bytes;
+			memcpy(&_committed[offset], &buffer1[offset], (_rects[idx].row_end - _rects[idx].row_start + 1) * epd_panel::row_bytes);
+			write_window(_rects[idx], SSD1680_WRITE_BWRAM, &_committed[offset]);
+		}
+
+		uint8_t ctrl = SSD1680_UPDATE_PARTIAL;
+		write_cmd(SSD1680_DISP_CTRL2, &ctrl, 1);
+		write_cmd(SSD1680_MASTER_ACTIVATE, NULL, 0);
+		_partials++;
+		MYLOG("EPD", "Partial refresh %d/%d, %d windows, %lu bytes", _partials, _full_every, _rect_num, (unsigned long)_spi_bytes);
+	}
+	bool running = start_refresh();
+	if (_committed == NULL)
+	{
+		// The frame streams from the framebuffer, it must not be drawn over yet
+		while (epd_spi_busy())
+		{
+			delay(1);
+		}
+	}
+	return running;
+}
+
+/**
+ * @brief Stream the queued job, the refresh runs from its end on
+ *
+ * @return true if a refresh is running, false if it was done without a BUSY pin
+ */
+bool EPD_SSD1680::start_refresh(void)
+{
+	_refreshing = true;
+	_busy_fell = false;
+	_refresh_start = millis();
+	epd_spi_start();
+	if (_busy_pin < 0)
+	{
+		// Nothing tells when the refresh is done, wait like Adafruit_EPD does
+		epd_spi_release();
+		busy_wait();
+		_busy_fell = true;
+		finish_commit();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Queue the whole frame and a full refresh
+ */
+void EPD_SSD1680::start_full(void)
+{
+	s_epd_rect all = {0, (uint16_t)(epd_panel::rows - 1), 0, (uint8_t)(epd_panel::row_bytes - 1)};
+
+	const uint8_t *frame = buffer1;
+
+	_rect_num = 0;
+	_partials = 0;
+	if (_committed != NULL)
+	{
+		memcpy(_committed, buffer1, epd_panel::frame_size);
+		frame = _committed;
+		_committed_valid = true;
+	}
+
+	powerUp();
+	// Both RAMs get the frame, the red RAM is the reference for the next
+	// partial refresh and is ignored by the full refresh waveform
+	write_window(all, SSD1680_WRITE_REDRAM, frame);
+	write_window(all, SSD1680_WRITE_BWRAM, frame);
+	uint8_t ctrl = SSD1680_UPDATE_FULL;
+	write_cmd(SSD1680_DISP_CTRL2, &ctrl, 1);
+	write_cmd(SSD1680_MASTER_ACTIVATE, NULL, 0);
+	MYLOG("EPD", "Full refresh, %lu bytes", (unsigned long)_spi_bytes);
+}
+
+/**
+ * @brief Check if the running refresh can be finished
+ *
+ * @return true if BUSY fell after the frame was sent, or the refresh took too long
+ */
+bool EPD_SSD1680::refresh_done(void)
+{
+	if (!_refreshing || epd_spi_busy())
+	{
+		return false;
+	}
+	return _busy_fell || ((millis() - _refresh_start) >= EPD_REFRESH_TIMEOUT_MS);
+}
+
+/**
+ * @brief Complete the running refresh. After a partial refresh the red RAM
+ *        gets the new frame: the controller compares against it in
+ *        display mode 2, so it has to hold what the panel shows now.
+ */
+void EPD_SSD1680::finish_commit(void)
+{
+	if (!_refreshing)
+	{
+		return;
+	}
+	_refreshing = false;
+	uint32_t refresh_ms = millis() - _refresh_start;
+	if (!_busy_fell)
+	{
+		MYLOG("EPD", "BUSY still high after %lu ms", (unsigned long)refresh_ms);
+	}
+
+#if EPD_BAND_ROWS > 0
+	finish_banded();
+#else
+	for (uint8_t idx = 0; idx < _rect_num; idx++)
+	{
+		write_window(_rects[idx], SSD1680_WRITE_REDRAM, &_committed[_rects[idx].row_start * epd_panel::row_bytes]);
+	}
+#endif
+	if (_sleep)
+	{
+		// Same as Adafruit_SSD1680::powerDown() without its delay
+		uint8_t mode = 0x01;
+		write_cmd(SSD1680_DEEP_SLEEP, &mode, 1);
+	}
+	epd_spi_start();
+	MYLOG("EPD", "Refresh done in %lu ms", (unsigned long)refresh_ms);
+}
+
+/**
+ * @brief Queue one window for the controller RAM. Windows are whole gate
+ *        lines, the block goes out as one DMA transfer.
+ *
+ * @param rect window in RAM coordinates
+ * @param ram_cmd SSD1680_WRITE_BWRAM or SSD1680_WRITE_REDRAM
+ * @param data gate lines of the window, in the shadow frame or a band
+ */
+void EPD_SSD1680::write_window(const s_epd_rect &rect, uint8_t ram_cmd, const uint8_t *data)
+{
+	uint8_t buf[4];
+
+	buf[0] = rect.byte_start + EPD_RAM_X_OFFSET;
+	buf[1] = rect.byte_end + EPD_RAM_X_OFFSET;
+	write_cmd(SSD1680_SET_RAMXPOS, buf, 2);
+
+	buf[0] = rect.row_start & 0xFF;
+	buf[1] = rect.row_start >> 8;
+	buf[2] = rect.row_end & 0xFF;
+	buf[3] = rect.row_end >> 8;
+	write_cmd(SSD1680_SET_RAMYPOS, buf, 4);
+
+	buf[0] = rect.byte_start + EPD_RAM_X_OFFSET;
+	write_cmd(SSD1680_SET_RAMXCOUNT, buf, 1);
+	buf[0] = rect.row_start & 0xFF;
+	buf[1] = rect.row_start >> 8;
+	write_cmd(SSD1680_SET_RAMYCOUNT, buf, 2);
+
+	// Data entry mode is X increment first, so the window goes line by line
+	uint32_t len = (rect.row_end - rect.row_start + 1) * epd_panel::row_bytes;
+	write_cmd(ram_cmd, NULL, 0);
+	epd_spi_data(data, len);
+	_spi_bytes += len;
+}
+
+/**
+ * @brief Queue a command with its parameters and count the bytes
+ */
+void EPD_SSD1680::write_cmd(uint8_t cmd, const uint8_t *buf, uint16_t len)
+{
+	epd_spi_command(cmd, buf, len);
+	_spi_bytes += 1 + len;
+}
+
+#if EPD_BAND_ROWS > 0
+/**
+ * @brief Wait for the SPI job of the previous band
+ */
+static void band_wait(void)
+{
+	while (epd_spi_busy())
+	{
+		delay(1);
+	}
+}
+
+/**
+ * @brief Same rotation and layout as Adafruit_EPD::drawPixel(), but only
+ *        the gate lines of the current band are kept. The panel has no
+ *        red plane, red and gray are dropped.
+ */
+void EPD_SSD1680::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+	if ((_band == NULL) || (x < 0) || (x >= width()) || (y < 0) || (y >= height()) || (color == EPD_RED) || (color == EPD_GRAY))
+	{
+		return;
+	}
+	switch (getRotation())
+	{
+	case 1:
+		EPD_swap(x, y);
+		x = WIDTH - x - 1;
+		break;
+	case 2:
+		x = WIDTH - x - 1;
+		y = HEIGHT - y - 1;
+		break;
+	case 3:
+		EPD_swap(x, y);
+		y = HEIGHT - y - 1;
+		break;
+	}
+	int16_t row = WIDTH - 1 - x - _band_start;
+	if ((row < 0) || (row >= _band_rows))
+	{
+		return;
+	}
+	// The black plane is inverted, a set bit is white
+	uint8_t *pixel = &_band[row * epd_panel::row_bytes + y / 8];
+	if (color == EPD_WHITE)
+	{
+		*pixel |= 1 << (7 - y % 8);
+	}
+	else
+	{
+		*pixel &= ~(1 << (7 - y % 8));
+	}
+}
+
+/**
+ * @brief Clear the current band to white
+ */
+void EPD_SSD1680::clearBuffer(void)
+{
+	if (_band != NULL)
+	{
+		memset(_band, 0xFF, _band_rows * epd_panel::row_bytes);
+	}
+}
+
+/**
+ * @brief Draw the whole screen and keep one band of it
+ *
+ * @param band band number
+ * @param buf band buffer
+ * @return uint32_t FNV-1a hash of the band
+ */
+uint32_t EPD_SSD1680::render_band(uint8_t band, uint8_t *buf)
+{
+	uint32_t start = micros();
+	_band = buf;
+	_band_start = band * EPD_BAND_ROWS;
+	_band_rows = ((epd_panel::rows - _band_start) < EPD_BAND_ROWS) ? (epd_panel::rows - _band_start) : EPD_BAND_ROWS;
+	clearBuffer();
+	_render(_render_arg);
+	_band = NULL;
+
+	uint32_t hash = 2166136261UL;
+	for (uint16_t idx = 0; idx < _band_rows * epd_panel::row_bytes; idx++)
+	{
+		hash = (hash ^ buf[idx]) * 16777619UL;
+	}
+	_render_us += micros() - start;
+	return hash;
+}
+
+/**
+ * @brief RAM window of the band render_band() drew last
+ */
+s_epd_rect EPD_SSD1680::band_rect(void) const
+{
+	s_epd_rect rect = {_band_start, (uint16_t)(_band_start + _band_rows - 1), 0, (uint8_t)(epd_panel::row_bytes - 1)};
+	return rect;
+}
+
+/**
+ * @brief Start to show a screen without a framebuffer. The screen is drawn
+ *        once per band into one of two band buffers, and a band streams to
+ *        the controller RAM while the next one is drawn. For a partial
+ *        refresh only the bands whose hash differs from the shown one are
+ *        sent. finish_commit() draws the changed bands again for the red
+ *        RAM, so render has to draw the same screen until then.
+ *
+ * @param render draws the screen with the Adafruit_GFX functions
+ * @param arg passed to render
+ * @param sleep put the controller into deep sleep when the refresh is done
+ * @return true if a refresh is running, false if the screen was unchanged,
+ *         the refresh was done without a BUSY pin or there are no bands
+ */
+bool EPD_SSD1680::start_commit_banded(epd_render_t render, uint8_t arg, bool sleep)
+{
+	if (_band_buf[0] == NULL)
+	{
+		return false;
+	}
+	epd_spi_release();
+
+	_render = render;
+	_render_arg = arg;
+	_render_us = 0;
+	_spi_bytes = 0;
+	_sleep = sleep;
+	bool full = !_committed_valid || (_partials >= _full_every);
+
+	uint8_t sent = 0;
+	for (uint8_t band = 0; band < _band_num; band++)
+	{
+		// The buffer of the last sent band may still stream, draw into the other one
+		uint8_t *buf = _band_buf[sent & 1];
+		_band_sent[band] = render_band(band, buf);
+		if (!full && (_band_sent[band] == _band_shown[band]))
+		{
+			continue;
+		}
+
+		if (sent == 0)
+		{
+			powerUp();
+			if (!full)
+			{
+				// Keep the border as it is, a partial refresh must not flash it
+				uint8_t border = 0x80;
+				write_cmd(SSD1680_BORDER_CTRL, &border, 1);
+			}
+		}
+		else
+		{
+			band_wait();
+		}
+		if (full)
+		{
+			// The red RAM is the reference for the next partial refresh
+			write_window(band_rect(), SSD1680_WRITE_REDRAM, buf);
+		}
+		write_window(band_rect(), SSD1680_WRITE_BWRAM, buf);
+		epd_spi_start();
+		sent++;
+	}
+
+	if (sent == 0)
+	{
+		MYLOG("EPD", "Frame unchanged, no refresh");
+		return false;
+	}
+
+	band_wait();
+	uint8_t ctrl = full ? SSD1680_UPDATE_FULL : SSD1680_UPDATE_PARTIAL;
+	write_cmd(SSD1680_DISP_CTRL2, &ctrl, 1);
+	write_cmd(SSD1680_MASTER_ACTIVATE, NULL, 0);
+	if (full)
+	{
+		_rect_num = 0;
+		_committed_valid = true;
+		_partials = 0;
+		memcpy(_band_shown, _band_sent, _band_num * sizeof(uint32_t));
+		MYLOG("EPD", "Full refresh, %d bands drawn in %lu us, %lu bytes", _band_num, (unsigned long)_render_us, (unsigned long)_spi_bytes);
+	}
+	else
+	{
+		_rect_num = sent;
+		_partials++;
+		MYLOG("EPD", "Partial refresh %d/%d, %d of %d bands drawn in %lu us, %lu bytes", _partials, _full_every, sent, _band_num,
+			  (unsigned long)_render_us, (unsigned long)_spi_bytes);
+	}
+	return start_refresh();
+}
+
+/**
+ * @brief Write the bands of the finished partial refresh to the red RAM.
+ *        A screen that changed since it was sent leaves the red RAM
+ *        different from the panel, the next refresh is a full one then.
+ */
+void EPD_SSD1680::finish_banded(void)
+{
+	uint8_t sent = 0;
+	for (uint8_t band = 0; band < _band_num; band++)
+	{
+		if (_band_sent[band] == _band_shown[band])
+		{
+			continue;
+		}
+		uint8_t *buf = _band_buf[sent & 1];
+		if (render_band(band, buf) != _band_sent[band])
+		{
+			MYLOG("EPD", "Band %d changed during the refresh", band);
+			_partials = _full_every;
+		}
+		band_wait();
+		write_window(band_rect(), SSD1680_WRITE_REDRAM, buf);
+		epd_spi_start();
+		_band_shown[band] = _band_sent[band];
+		sent++;
+	}
+	band_wait();
+}
+#endif
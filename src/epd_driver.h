@@ -0,0 +1,150 @@
+/**
+ * @file epd_driver.h
+ * @author agent (agent@local)
+ * @brief SSD1680 driver that only pushes the changed parts of a frame and
+ *        refreshes them with the partial update waveform. The refresh runs
+ *        on its own, the caller finishes it when BUSY goes low.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef EPD_DRIVER_H
+#define EPD_DRIVER_H
+
+#include <Arduino.h>
+#include <Adafruit_EPD.h>
+
+#include "epd_panel.h"
+#include "rle.h"
+
+/** Number of partial refreshes before a full refresh clears the ghosting */
+#ifndef EPD_FULL_REFRESH_EVERY
+#define EPD_FULL_REFRESH_EVERY 10
+#endif
+
+/** A refresh without a falling BUSY edge after this time is finished anyway */
+#ifndef EPD_REFRESH_TIMEOUT_MS
+#define EPD_REFRESH_TIMEOUT_MS 5000
+#endif
+
+/** Gate lines per band, 0 keeps the whole frame in RAM. With bands the
+ *  screen is drawn again for every band and only two bands are in RAM. */
+#ifndef EPD_BAND_ROWS
+#define EPD_BAND_ROWS 0
+#endif
+
+/** Maximum number of RAM windows pushed for one partial refresh */
+#define EPD_MAX_DIRTY_RECTS 4
+
+/** First RAM byte of a gate line, must match the window Adafruit_SSD1680::powerUp() sets */
+#define EPD_RAM_X_OFFSET 1
+
+/**
+ * @brief Changed area of the framebuffer in controller RAM coordinates.
+ *        Rows are gate lines, bytes are 8 source pixels each.
+ */
+struct s_epd_rect
+{
+	uint16_t row_start;
+	uint16_t row_end;
+	uint8_t byte_start;
+	uint8_t byte_end;
+};
+
+/** Highest image, the SSD1680 has 176 sources */
+#define EPD_IMAGE_MAX_HEIGHT 176
+
+/**
+ * @brief Compressed 1bpp image made by tools/imgconv.py. Column by column,
+ *        8 pixels per byte from the top, a set bit is ink. Each column is
+ *        XORed with the one before it and the whole is PackBits encoded.
+ */
+struct s_epd_image
+{
+	uint16_t width;
+	uint16_t height;
+	uint32_t size;
+	const uint8_t *data;
+};
+
+/** Draws a screen on the display, called once for every band */
+typedef void (*epd_render_t)(uint8_t arg);
+
+class EPD_SSD1680 : public Adafruit_SSD1680
+{
+public:
+	EPD_SSD1680(int width, int height, int16_t SID, int16_t SCLK, int16_t DC, int16_t RST,
+				int16_t CS, int16_t SRCS, int16_t MISO, int16_t BUSY = -1);
+
+	void begin(bool reset = true);
+	bool start_commit(bool sleep = false);
+	bool refresh_done(void);
+	void finish_commit(void);
+	/** Called by the falling edge interrupt of BUSY */
+	void busy_fell(void) { _busy_fell = true; }
+	uint8_t dirty_rects(s_epd_rect *rects, uint8_t max_rects);
+	void draw_image(int16_t x, int16_t y, const s_epd_image &image);
+	void draw_image(int16_t x, int16_t y, uint16_t width, uint16_t height, s_rle_stream *stream);
+#if EPD_BAND_ROWS > 0
+	bool start_commit_banded(epd_render_t render, uint8_t arg, bool sleep = false);
+	void drawPixel(int16_t x, int16_t y, uint16_t color);
+	void clearBuffer(void);
+#endif
+	void set_full_refresh_interval(uint8_t partials) { _full_every = partials; }
+
+	/** A refresh was started and is not finished yet */
+	bool refreshing(void) const { return _refreshing; }
+
+	/** Framebuffer in controller RAM layout, black plane only, NULL with bands */
+	uint8_t *frame(void) { return buffer1; }
+	uint32_t frame_size(void) const { return epd_panel::frame_size; }
+
+	/** Framebuffer and command bytes sent by the last commit */
+	uint32_t last_spi_bytes(void) const { return _spi_bytes; }
+	/** Number of windows pushed by the last commit, 0 for a full refresh */
+	uint8_t last_rect_num(void) const { return _rect_num; }
+
+private:
+	uint8_t *_committed = NULL;
+	bool _committed_valid = false;
+	uint8_t _partials = 0;
+	uint8_t _full_every = EPD_FULL_REFRESH_EVERY;
+	uint32_t _spi_bytes = 0;
+	uint8_t _rect_num = 0;
+	/** Windows of the running partial refresh, their red RAM is written when it is done */
+	s_epd_rect _rects[EPD_MAX_DIRTY_RECTS];
+	bool _refreshing = false;
+	volatile bool _busy_fell = false;
+	bool _sleep = false;
+	uint32_t _refresh_start = 0;
+
+#if EPD_BAND_ROWS > 0
+	/** Two band buffers, one is drawn while the other one is sent */
+	uint8_t *_band_buf[2] = {NULL, NULL};
+	/** Band that drawPixel() draws into, NULL outside of render_band() */
+	uint8_t *_band = NULL;
+	uint16_t _band_start = 0;
+	uint16_t _band_rows = 0;
+	uint8_t _band_num = 0;
+	/** Hash of every band on the panel and of the bands sent by the running refresh */
+	uint32_t *_band_shown = NULL;
+	uint32_t *_band_sent = NULL;
+	uint32_t _render_us = 0;
+	epd_render_t _render = NULL;
+	uint8_t _render_arg = 0;
+
+	uint32_t render_band(uint8_t band, uint8_t *buf);
+	s_epd_rect band_rect(void) const;
+	void finish_banded(void);
+#endif
+
+	void start_full(void);
+	bool start_refresh(void);
+	void ink_byte(uint8_t *line, int16_t byte, uint8_t ink);
+	void write_window(const s_epd_rect &rect, uint8_t ram_cmd, const uint8_t *data);
+	void write_cmd(uint8_t cmd, const uint8_t *buf, uint16_t len);
+};
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * @file epd_layout.cpp
+ * @author agent (agent@local)
+ * @brief Layout of the message text. Adafruit_GFX wraps at the character
+ *        that does not fit and keeps the padding of the message, here the
+ *        text is trimmed and broken at spaces and hyphens, and a word is
+ *        only cut if it is longer than a line at every size. The text
+ *        sizes are tried from EPD_TEXT_MAX_SIZE down until the text fits,
+ *        and the block is centered. The classic
+ *        6x8 font and proportional GFX fonts are measured the same way.
+ *        Measuring walks every glyph for every size, so the layout of a
+ *        message is cached until set_message() changes the slot, the
+ *        cache is dropped in mark_user_flash_data() before the flash is
+ *        written.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "epd_layout.h"
+
+/** Metrics of the whole font, they take a pass over all glyphs */
+struct s_font_metrics
+{
+	const GFXfont *font;
+	bool valid;
+	/** Rows above and below the cursor line */
+	uint8_t ascent;
+	uint8_t descent;
+	uint8_t line_height;
+};
+
+static s_font_metrics metrics = {NULL, false, 0, 0, 0};
+
+/** Layout per message slot */
+static s_epd_layout layout_cache[MSG_SLOTS];
+static bool layout_valid[MSG_SLOTS];
+
+/**
+ * @brief Get the metrics of a font, measured on first use
+ *
+ * @param font GFX font, NULL for the classic 6x8 font
+ */
+static const s_font_metrics &font_metrics(const GFXfont *font)
+{
+	if (metrics.valid && (metrics.font == font))
+	{
+		return metrics;
+	}
+	metrics.font = font;
+	metrics.valid = true;
+	if (font == NULL)
+	{
+		// The cursor is the top left corner of the 8 rows of a glyph
+		metrics.ascent = 0;
+		metrics.descent = 8;
+		metrics.line_height = 8;
+		return metrics;
+	}
+
+	// The cursor is on the baseline, glyphs reach above and below it.
+	// Fonts are in flash, which is memory mapped on the nRF52.
+	int16_t top = 0;
+	int16_t bottom = 0;
+	for (uint16_t c = font->first; c <= font->last; c++)
+	{
+		const GFXglyph *glyph = &font->glyph[c - font->first];
+		if (glyph->height == 0)
+		{
+			continue;
+		}
+		if (glyph->yOffset < top)
+		{
+			top = glyph->yOffset;
+		}
+		if ((glyph->yOffset + glyph->height) > bottom)
+		{
+			bottom = glyph->yOffset + glyph->height;
+		}
+	}
+	metrics.ascent = -top;
+	metrics.descent = bottom;
+	metrics.line_height = font->yAdvance;
+	return metrics;
+}
+
+/**
+ * @brief Horizontal size of a character at text size 1
+ *
+ * @param font GFX font, NULL for the classic 6x8 font
+ * @param c character
+ * @param ink receives the width up to the last pixel, for the end of a line
+ * @return int16_t distance to the next character
+ */
+static int16_t char_advance(const GFXfont *font, uint8_t c, int16_t *ink)
+{
+	if (font == NULL)
+	{
+		*ink = 5;
+		return 6;
+	}
+	if ((c < font->first) || (c > font->last))
+	{
+		// Adafruit_GFX skips characters the font does not have
+		*ink = 0;
+		return 0;
+	}
+	const GFXglyph *glyph = &font->glyph[c - font->first];
+	*ink = (glyph->width == 0) ? 0 : glyph->xOffset + glyph->width;
+	return glyph->xAdvance;
+}
+
+/**
+ * @brief Break the text into lines at a text size
+ *
+ * @param text message
+ * @param start first character after trimming
+ * @param end end of the text after trimming
+ * @param font GFX font, NULL for the classic 6x8 font
+ * @param size text size
+ * @param max_width width of a line in pixels
+ * @param max_lines lines that fit
+ * @param cut allow to cut a word that is longer than a line
+ * @param layout receives the lines, without their positions
+ * @return true if all of the text is in the lines
+ */
+static bool wrap_text(const char *text, uint8_t start, uint8_t end, const GFXfont *font, uint8_t size,
+					  int16_t max_width, uint8_t max_lines, bool cut, s_epd_layout *layout)
+{
+	uint8_t pos = start;
+	layout->line_num = 0;
+	while (pos < end)
+	{
+		if (layout->line_num == max_lines)
+		{
+			return false;
+		}
+
+		// line_end is behind the last word that fits, scan behind the last character seen
+		uint8_t line_end = pos;
+		uint8_t scan = pos;
+		int16_t x = 0;
+		bool full = false;
+		while ((scan < end) && (text[scan] != '\n'))
+		{
+			int16_t ink;
+			int16_t advance = char_advance(font, text[scan], &ink);
+			if (text[scan] == ' ')
+			{
+				if ((scan > pos) && (text[scan - 1] != ' '))
+				{
+					line_end = scan;
+				}
+			}
+			else if ((x + ink * size) > max_width)
+			{
+				full = true;
+				break;
+			}
+			else if (text[scan] == '-')
+			{
+				// A line may end after a hyphen
+				line_end = scan + 1;
+			}
+			x += advance * size;
+			scan++;
+		}
+
+		if (!full)
+		{
+			// End of the text or of a paragraph
+			line_end = scan;
+			while ((line_end > pos) && (text[line_end - 1] == ' '))
+			{
+				line_end--;
+			}
+		}
+		else if (line_end == pos)
+		{
+			if (!cut)
+			{
+				return false;
+			}
+			// A line has at least one character
+			line_end = (scan > pos) ? scan : scan + 1;
+		}
+
+		s_epd_line *line = &layout->lines[layout->line_num++];
+		line->start = pos;
+		line->len = line_end - pos;
+
+		pos = (!full && (scan < end)) ? scan + 1 : line_end;
+		while ((pos < end) && (text[pos] == ' '))
+		{
+			pos++;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Find the largest text size at which the text fits
+ *
+ * @param text message
+ * @param start first character after trimming
+ * @param end end of the text after trimming
+ * @param font GFX font, NULL for the classic 6x8 font
+ * @param max_width width of a line in pixels
+ * @param max_height height of the text block in pixels
+ * @param cut allow to cut words that are longer than a line
+ * @param layout receives the size and the lines, without their positions
+ * @return true if the text fits, otherwise the layout is the one of size 1
+ */
+static bool fit_text(const char *text, uint8_t start, uint8_t end, const GFXfont *font,
+					 int16_t max_width, int16_t max_height, bool cut, s_epd_layout *layout)
+{
+	const s_font_metrics &font_info = font_metrics(font);
+	for (uint8_t size = EPD_TEXT_MAX_SIZE; size > 0; size--)
+	{
+		// Lines that fit: the first one needs the glyph height, every other one the line height
+		int16_t text_height = (font_info.ascent + font_info.descent) * size;
+		int16_t max_lines = (max_height < text_height) ? 0 : 1 + (max_height - text_height) / (font_info.line_height * size);
+		if (max_lines > EPD_LAYOUT_MAX_LINES)
+		{
+			max_lines = EPD_LAYOUT_MAX_LINES;
+		}
+		layout->size = size;
+		if (wrap_text(text, start, end, font, size, max_width, max_lines, cut, layout))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Lay out a text to fill the panel. The largest text size at which
+ *        no word has to be cut is used, then the largest one with cut
+ *        words. If not even size 1 fits, the lines that do not fit are
+ *        left out.
+ *
+ * @param text message, need not be terminated
+ * @param len length of the text, up to 255
+ * @param font GFX font, NULL for the classic 6x8 font
+ * @param width width of the panel
+ * @param height height of the panel
+ * @param layout receives the size, the lines and their positions
+ */
+void epd_layout_text(const char *text, uint16_t len, const GFXfont *font, int16_t width, int16_t height, s_epd_layout *layout)
+{
+	const s_font_metrics &font_info = font_metrics(font);
+	int16_t max_width = width - 2 * EPD_TEXT_MARGIN;
+	int16_t max_height = height - 2 * EPD_TEXT_MARGIN;
+
+	uint8_t start = 0;
+	uint8_t end = (len > 255) ? 255 : len;
+	while ((start < end) && isspace((uint8_t)text[start]))
+	{
+		start++;
+	}
+	while ((end > start) && isspace((uint8_t)text[end - 1]))
+	{
+		end--;
+	}
+
+	if (!fit_text(text, start, end, font, max_width, max_height, false, layout))
+	{
+		fit_text(text, start, end, font, max_width, max_height, true, layout);
+	}
+
+	uint8_t size = layout->size;
+	int16_t block_height = 0;
+	if (layout->line_num != 0)
+	{
+		block_height = ((layout->line_num - 1) * font_info.line_height + font_info.ascent + font_info.descent) * size;
+	}
+	int16_t top = (height - block_height) / 2;
+	for (uint8_t idx = 0; idx < layout->line_num; idx++)
+	{
+		s_epd_line *line = &layout->lines[idx];
+		int16_t line_width = 0;
+		for (uint8_t pos = 0; pos < line->len; pos++)
+		{
+			int16_t ink;
+			int16_t advance = char_advance(font, text[line->start + pos], &ink);
+			line_width += ((pos + 1) == line->len) ? ink * size : advance * size;
+		}
+		line->x = (width - line_width) / 2;
+		line->y = top + (idx * font_info.line_height + font_info.ascent) * size;
+	}
+}
+
+/**
+ * @brief Draw a text as laid out by epd_layout_text()
+ *
+ * @param gfx display or canvas
+ * @param text the text that was laid out
+ * @param font same font as for the layout
+ * @param layout lines and positions
+ * @param color text color
+ */
+void epd_layout_draw(Adafruit_GFX &gfx, const char *text, const GFXfont *font, const s_epd_layout &layout, uint16_t color)
+{
+	gfx.setFont(font);
+	gfx.setTextSize(layout.size);
+	gfx.setTextColor(color);
+	gfx.setTextWrap(false);
+	for (uint8_t idx = 0; idx < layout.line_num; idx++)
+	{
+		const s_epd_line &line = layout.lines[idx];
+		gfx.setCursor(line.x, line.y);
+		gfx.write((const uint8_t *)&text[line.start], line.len);
+	}
+}
+
+/**
+ * @brief Get the layout of a message, from the cache if it did not change
+ *
+ * @param msg_num 1 to MSG_SLOTS
+ * @param font GFX font, NULL for the classic 6x8 font
+ * @param width width of the panel
+ * @param height height of the panel
+ * @return const s_epd_layout* layout, NULL for an invalid slot
+ */
+const s_epd_layout *epd_layout_message(uint8_t msg_num, const GFXfont *font, int16_t width, int16_t height)
+{
+	if ((msg_num == 0) || (msg_num > MSG_SLOTS))
+	{
+		return NULL;
+	}
+	s_epd_layout *layout = &layout_cache[msg_num - 1];
+	if (!layout_valid[msg_num - 1])
+	{
+		uint16_t len;
+		const char *text = get_message(msg_num, &len);
+		uint32_t start = micros();
+		epd_layout_text(text, len, font, width, height, layout);
+		layout_valid[msg_num - 1] = true;
+		MYLOG("EPD", "Layout of message %d: size %d, %d lines in %lu us", msg_num, layout->size, layout->line_num,
+			  (unsigned long)(micros() - start));
+	}
+	return layout;
+}
+
+/**
+ * @brief Drop the layout of a message after it changed
+ *
+ * @param msg_num 1 to MSG_SLOTS
+ */
+void epd_layout_invalidate(uint8_t msg_num)
+{
+	if ((msg_num == 0) || (msg_num > MSG_SLOTS))
+	{
+		return;
+	}
+	layout_valid[msg_num - 1] = false;
+}
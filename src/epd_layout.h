@@ -0,0 +1,53 @@
+/**
+ * @file epd_layout.h
+ * @author agent (agent@local)
+ * @brief Layout of the message text: trimmed, broken into lines at word
+ *        boundaries, in the largest text size that fits and centered on
+ *        the panel. The layout of a message is kept until it changes.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef EPD_LAYOUT_H
+#define EPD_LAYOUT_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/** Largest text size tried, the font is scaled by it */
+#ifndef EPD_TEXT_MAX_SIZE
+#define EPD_TEXT_MAX_SIZE 4
+#endif
+
+/** Free pixels at each edge of the panel */
+#ifndef EPD_TEXT_MARGIN
+#define EPD_TEXT_MARGIN 4
+#endif
+
+/** Lines of one message, 15 lines of the 6x8 font fill the 122 pixels of the panel */
+#define EPD_LAYOUT_MAX_LINES 16
+
+/** One line of text and its cursor position */
+struct s_epd_line
+{
+	/** Offset of the first character in the message, messages have up to 255 */
+	uint8_t start;
+	uint8_t len;
+	int16_t x;
+	int16_t y;
+};
+
+struct s_epd_layout
+{
+	uint8_t size;
+	uint8_t line_num;
+	s_epd_line lines[EPD_LAYOUT_MAX_LINES];
+};
+
+void epd_layout_text(const char *text, uint16_t len, const GFXfont *font, int16_t width, int16_t height, s_epd_layout *layout);
+void epd_layout_draw(Adafruit_GFX &gfx, const char *text, const GFXfont *font, const s_epd_layout &layout, uint16_t color);
+const s_epd_layout *epd_layout_message(uint8_t msg_num, const GFXfont *font, int16_t width, int16_t height);
+
+#endif
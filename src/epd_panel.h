@@ -0,0 +1,85 @@
+/**
+ * @file epd_panel.h
+ * @author agent (agent@local)
+ * @brief Geometry of the supported EPD panels as compile time constants.
+ *        The panel is selected with a build flag, e.g.
+ *        -DEPD_PANEL=EPD_PANEL_DEPG0213BNS800F42HP, and every size and
+ *        position of the screens is a constant of that panel.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef EPD_PANEL_H
+#define EPD_PANEL_H
+
+#include <stdint.h>
+
+/** Panels, the type is printed on the back of the display */
+#define EPD_PANEL_DEPG0213BNS800F41HP 1
+#define EPD_PANEL_DEPG0213BNS800F42HP 2
+
+/** DEPG0213BNS800F41HP is the one provided by RAKwireless */
+#ifndef EPD_PANEL
+#define EPD_PANEL EPD_PANEL_DEPG0213BNS800F41HP
+#endif
+
+/** Limits of the SSD1680: 296 gate lines and 176 sources */
+#define EPD_MAX_GATES 296
+#define EPD_MAX_SOURCES 176
+
+/**
+ * @brief Size of a panel and the anchors of the screens. Width and height
+ *        are in the orientation Adafruit_EPD draws in, the gate lines run
+ *        along the width. Anchors are top left corners:
+ *        - position1: RAK logo of the boot screen
+ *        - position2: RAK logo of the logo screen
+ *        - position3: text of the boot screen
+ */
+template <uint16_t W, uint16_t H,
+		  int16_t X1, int16_t Y1, int16_t X2, int16_t Y2, int16_t X3, int16_t Y3>
+struct s_epd_panel
+{
+	static constexpr uint16_t width = W;
+	static constexpr uint16_t height = H;
+	static constexpr int16_t position1_x = X1;
+	static constexpr int16_t position1_y = Y1;
+	static constexpr int16_t position2_x = X2;
+	static constexpr int16_t position2_y = Y2;
+	static constexpr int16_t position3_x = X3;
+	static constexpr int16_t position3_y = Y3;
+
+	/** Framebuffer layout of Adafruit_EPD: a gate line per column, padded to full bytes */
+	static constexpr uint16_t rows = W;
+	static constexpr uint8_t row_bytes = (H + 7) / 8;
+	static constexpr uint32_t frame_size = (uint32_t)W * row_bytes;
+
+	/** True if the point is on the panel */
+	static constexpr bool contains(int16_t x, int16_t y)
+	{
+		return (x >= 0) && (x < W) && (y >= 0) && (y < H);
+	}
+
+	/** True if the panel fits the controller and all anchors are on it */
+	static constexpr bool valid(void)
+	{
+		return (W <= EPD_MAX_GATES) && (H <= EPD_MAX_SOURCES) &&
+			   contains(X1, Y1) && contains(X2, Y2) && contains(X3, Y3);
+	}
+};
+
+/** Every panel is checked by test/test_epd_panel, not only the selected one */
+typedef s_epd_panel<250, 122, 45, 10, 40, 30, 0, 80> DEPG0213BNS800F41HP;
+typedef s_epd_panel<212, 104, 31, 8, 30, 25, 0, 80> DEPG0213BNS800F42HP;
+
+#if EPD_PANEL == EPD_PANEL_DEPG0213BNS800F41HP
+typedef DEPG0213BNS800F41HP epd_panel;
+#elif EPD_PANEL == EPD_PANEL_DEPG0213BNS800F42HP
+typedef DEPG0213BNS800F42HP epd_panel;
+#else
+#error "Unknown EPD_PANEL"
+#endif
+static_assert(epd_panel::valid(), "EPD panel is larger than the SSD1680 or has an anchor off the panel");
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file epd_spi.cpp
+ * @author agent (agent@local)
+ * @brief SPIM EasyDMA transport of the SSD1680. Adafruit_EPD clocks every
+ *        byte out on the CPU; here a job of commands and RAM blocks is
+ *        queued, the first piece is started and the SPIM interrupt starts
+ *        the next one with D/C set for it. A block of the framebuffer goes
+ *        out as one EasyDMA transfer, the CPU is free until the job ends.
+ *        The SPIM only owns the pins while a job runs, the power up of
+ *        Adafruit_SSD1680 bit-bangs on the same pins after
+ *        epd_spi_release(). The native environment has a mock SPIM that
+ *        counts and times the transfers.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "epd_spi.h"
+
+#include <nrfx_spim.h>
+
+/** Command or data for the controller, D/C is set before it is sent */
+struct s_epd_spi_piece
+{
+	const uint8_t *data;
+	uint16_t len;
+	bool is_data;
+};
+
+static s_epd_spi_piece pieces[EPD_SPI_MAX_PIECES];
+static uint8_t piece_num = 0;
+static uint8_t piece_next = 0;
+/** EasyDMA reads from RAM only, the command bytes are copied here */
+static uint8_t param_pool[EPD_SPI_PARAM_POOL];
+static uint8_t param_used = 0;
+static bool job_overflow = false;
+static volatile bool job_running = false;
+
+static const nrfx_spim_t spim = NRFX_SPIM_INSTANCE(EPD_SPIM_INSTANCE);
+static bool spim_ready = false;
+static int16_t cs_pin = -1;
+static int16_t dc_pin = -1;
+static int16_t sck_pin = -1;
+static int16_t mosi_pin = -1;
+
+/**
+ * @brief Set the pins of the transport
+ */
+void epd_spi_begin(int16_t cs, int16_t dc, int16_t sck, int16_t mosi)
+{
+	cs_pin = cs;
+	dc_pin = dc;
+	sck_pin = sck;
+	mosi_pin = mosi;
+}
+
+/**
+ * @brief Add a piece to the job
+ */
+static void add_piece(const uint8_t *data, uint16_t len, bool is_data)
+{
+	if (piece_num == EPD_SPI_MAX_PIECES)
+	{
+		job_overflow = true;
+		return;
+	}
+	pieces[piece_num].data = data;
+	pieces[piece_num].len = len;
+	pieces[piece_num].is_data = is_data;
+	piece_num++;
+}
+
+/**
+ * @brief Queue a command with its parameters
+ *
+ * @param cmd SSD1680 command
+ * @param param parameters, copied
+ * @param len number of parameters
+ */
+void epd_spi_command(uint8_t cmd, const uint8_t *param, uint8_t len)
+{
+	if (param_used + 1 + len > EPD_SPI_PARAM_POOL)
+	{
+		job_overflow = true;
+		return;
+	}
+	uint8_t *pool = &param_pool[param_used];
+	pool[0] = cmd;
+	if (len != 0)
+	{
+		memcpy(&pool[1], param, len);
+	}
+	param_used += 1 + len;
+	add_piece(pool, 1, false);
+	if (len != 0)
+	{
+		add_piece(&pool[1], len, true);
+	}
+}
+
+/**
+ * @brief Queue a block of RAM data. It is not copied, it has to stay as
+ *        it is until the job is done.
+ *
+ * @param data block in RAM
+ * @param len bytes, split into EasyDMA transfers of EPD_SPI_MAX_CHUNK
+ */
+void epd_spi_data(const uint8_t *data, uint32_t len)
+{
+	while (len != 0)
+	{
+		uint16_t chunk = (len > EPD_SPI_MAX_CHUNK) ? EPD_SPI_MAX_CHUNK : len;
+		add_piece(data, chunk, true);
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+/**
+ * @brief Clear the queued job
+ */
+static void clear_job(void)
+{
+	piece_num = 0;
+	piece_next = 0;
+	param_used = 0;
+	job_overflow = false;
+}
+
+/**
+ * @brief Send the next piece of the job
+ */
+static void start_piece(void)
+{
+	const s_epd_spi_piece *piece = &pieces[piece_next++];
+	digitalWrite(dc_pin, piece->is_data ? HIGH : LOW);
+	nrfx_spim_xfer_desc_t xfer = NRFX_SPIM_XFER_TX(piece->data, piece->len);
+	if (nrfx_spim_xfer(&spim, &xfer, 0) != NRFX_SUCCESS)
+	{
+		// Nothing else uses the SPIM, the job ends here
+		digitalWrite(cs_pin, HIGH);
+		clear_job();
+		job_running = false;
+	}
+}
+
+/**
+ * @brief SPIM interrupt, a piece is sent
+ */
+static void spim_handler(nrfx_spim_evt_t const *event, void *context)
+{
+	(void)event;
+	(void)context;
+	if (piece_next < piece_num)
+	{
+		start_piece();
+		return;
+	}
+	digitalWrite(cs_pin, HIGH);
+	clear_job();
+	job_running = false;
+}
+
+/**
+ * @brief Start to stream the queued job
+ *
+ * @return true if the job runs, false if it was empty or did not fit
+ */
+bool epd_spi_start(void)
+{
+	if (job_running)
+	{
+		return false;
+	}
+	if (job_overflow || (piece_num == 0))
+	{
+		if (job_overflow)
+		{
+			MYLOG("EPD", "SPI job too large, dropped");
+		}
+		clear_job();
+		return false;
+	}
+	if (!spim_ready)
+	{
+		nrfx_spim_config_t config = NRFX_SPIM_DEFAULT_CONFIG;
+		config.sck_pin = g_ADigitalPinMap[sck_pin];
+		config.mosi_pin = g_ADigitalPinMap[mosi_pin];
+		config.miso_pin = NRFX_SPIM_PIN_NOT_USED;
+		config.ss_pin = NRFX_SPIM_PIN_NOT_USED;
+		config.frequency = EPD_SPI_FREQ;
+		config.mode = NRF_SPIM_MODE_0;
+		config.bit_order = NRF_SPIM_BIT_ORDER_MSB_FIRST;
+		if (nrfx_spim_init(&spim, &config, spim_handler, NULL) != NRFX_SUCCESS)
+		{
+			MYLOG("EPD", "SPIM init failed");
+			clear_job();
+			return false;
+		}
+		spim_ready = true;
+	}
+	piece_next = 0;
+	job_running = true;
+	digitalWrite(cs_pin, LOW);
+	start_piece();
+	return true;
+}
+
+/**
+ * @brief Check if a job is still streaming
+ */
+bool epd_spi_busy(void)
+{
+	return job_running;
+}
+
+/**
+ * @brief Wait for the running job and give the pins back to GPIO for
+ *        the bit-banged commands of Adafruit_EPD
+ */
+void epd_spi_release(void)
+{
+	while (job_running)
+	{
+		delay(1);
+	}
+	if (spim_ready)
+	{
+		nrfx_spim_uninit(&spim);
+		spim_ready = false;
+		pinMode(sck_pin, OUTPUT);
+		pinMode(mosi_pin, OUTPUT);
+		digitalWrite(sck_pin, LOW);
+	}
+}
@@ -0,0 +1,42 @@
+/**
+ * @file epd_spi.h
+ * @author agent (agent@local)
+ * @brief SPIM EasyDMA transport of the SSD1680. The driver queues commands
+ *        and blocks of RAM data as one job, the job is streamed in the
+ *        background and the SPIM interrupt moves from one piece to the next.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef EPD_SPI_H
+#define EPD_SPI_H
+
+#include <Arduino.h>
+
+/** SPIM instance, SPIM3 is the only one up to 32 MHz and the LoRa transceiver has SPIM2 */
+#ifndef EPD_SPIM_INSTANCE
+#define EPD_SPIM_INSTANCE 3
+#endif
+/** Clock of the SSD1680, it takes up to 20 MHz for writes */
+#ifndef EPD_SPI_FREQ
+#define EPD_SPI_FREQ NRF_SPIM_FREQ_8M
+#endif
+/** Largest EasyDMA transfer, TXD.MAXCNT of SPIM3 has 16 bits */
+#ifndef EPD_SPI_MAX_CHUNK
+#define EPD_SPI_MAX_CHUNK 0xFFFF
+#endif
+/** Pieces of one job: 4 windows with 5 commands and their data, and a few commands around them */
+#define EPD_SPI_MAX_PIECES 48
+/** Command bytes and parameters of one job */
+#define EPD_SPI_PARAM_POOL 96
+
+void epd_spi_begin(int16_t cs, int16_t dc, int16_t sck, int16_t mosi);
+void epd_spi_command(uint8_t cmd, const uint8_t *param, uint8_t len);
+void epd_spi_data(const uint8_t *data, uint32_t len);
+bool epd_spi_start(void);
+bool epd_spi_busy(void);
+void epd_spi_release(void);
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file event_queue.cpp
+ * @author agent (agent@local)
+ * @brief Lock-free event rings between the interrupt sources and the
+ *        application task. Every source has its own single-producer
+ *        single-consumer ring of timestamped records: the ACC interrupt
+ *        is one producer, the EPD BUSY interrupt another, and the software
+ *        timers share a third, they all run in the timer task. A producer
+ *        stores the record before it moves the head. The task takes the
+ *        event bits atomically, then every handler drains the ring of its
+ *        source record by record, so a burst of interrupts is handled and
+ *        counted instead of collapsing into one bit. g_task_event_type
+ *        stays as the doorbell of the API loop, its bits are only changed
+ *        with atomic operations.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+struct s_event_ring
+{
+	s_event_record records[EVENT_RING_SIZE];
+	/** Moved by the producer only */
+	volatile uint16_t head;
+	/** Moved by the consumer only */
+	volatile uint16_t tail;
+};
+
+static s_event_ring rings[EVENT_SOURCE_NUM];
+
+/** Batch in progress per source: its end and the types taken so far */
+static uint16_t batch_end[EVENT_SOURCE_NUM] = {0};
+static uint16_t batch_seen[EVENT_SOURCE_NUM] = {0};
+
+/** Counters of the rings */
+s_event_stats g_event_stats;
+
+/**
+ * @brief Post an event from an interrupt or a timer callback and wake
+ *        up the application task. A full ring drops the record, the
+ *        event bit is still set.
+ *
+ * @param source EVENT_SOURCE_xxx, only one context may post to a source
+ * @param type event bit
+ */
+void post_event(uint8_t source, uint16_t type)
+{
+	s_event_ring *ring = &rings[source];
+	uint16_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+	uint16_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	if ((uint16_t)(head - tail) >= EVENT_RING_SIZE)
+	{
+		g_event_stats.overflows[source]++;
+	}
+	else
+	{
+		s_event_record *record = &ring->records[head & (EVENT_RING_SIZE - 1)];
+		record->time = millis();
+		record->type = type;
+		__atomic_store_n(&ring->head, (uint16_t)(head + 1), __ATOMIC_RELEASE);
+		g_event_stats.posted[source]++;
+	}
+	raise_event(type);
+	xSemaphoreGiveFromISR(g_task_sem, pdFALSE);
+}
+
+/**
+ * @brief Set event bits without losing bits set at the same time
+ */
+void raise_event(uint16_t type)
+{
+	__atomic_fetch_or(&g_task_event_type, type, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Clear event bits without losing bits set at the same time
+ */
+void clear_event(uint16_t type)
+{
+	__atomic_fetch_and(&g_task_event_type, (uint16_t)~type, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Take the pending event bits. The rings are drained by the
+ *        handlers with event_batch() and event_take(), a record that
+ *        comes later sets its bit again.
+ *
+ * @param mask event bits the caller handles
+ * @return uint16_t taken event bits
+ */
+uint16_t take_events(uint16_t mask)
+{
+	return __atomic_fetch_and(&g_task_event_type, (uint16_t)~mask, __ATOMIC_ACQUIRE) & mask;
+}
+
+/**
+ * @brief Start a batch of a ring. It holds the records posted so far,
+ *        later ones wait for the next batch, so a busy source can't keep
+ *        the handler in its loop.
+ *
+ * @param source EVENT_SOURCE_xxx
+ * @return uint16_t records in the batch
+ */
+uint16_t event_batch(uint8_t source)
+{
+	s_event_ring *ring = &rings[source];
+	uint16_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+	batch_end[source] = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	batch_seen[source] = 0;
+	uint16_t batch = batch_end[source] - tail;
+	if (batch != 0)
+	{
+		g_event_stats.batches++;
+		if (batch > g_event_stats.max_batch)
+		{
+			g_event_stats.max_batch = batch;
+		}
+	}
+	return batch;
+}
+
+/**
+ * @brief Take the oldest record of the batch started with event_batch()
+ *
+ * @param source EVENT_SOURCE_xxx
+ * @param record the taken record
+ * @return true if there was a record left in the batch
+ */
+bool event_take(uint8_t source, s_event_record *record)
+{
+	s_event_ring *ring = &rings[source];
+	uint16_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+	if (tail == batch_end[source])
+	{
+		return false;
+	}
+	*record = ring->records[tail & (EVENT_RING_SIZE - 1)];
+	__atomic_store_n(&ring->tail, (uint16_t)(tail + 1), __ATOMIC_RELEASE);
+
+	// Records of a type that is already in the batch are handled by the same run
+	if (batch_seen[source] & record->type)
+	{
+		g_event_stats.coalesced[source]++;
+	}
+	batch_seen[source] |= record->type;
+	uint32_t latency = millis() - record->time;
+	if (latency > g_event_stats.max_latency_ms)
+	{
+		g_event_stats.max_latency_ms = latency;
+	}
+	g_event_stats.drained++;
+	return true;
+}
+
+/**
+ * @brief Printout of the ring counters
+ */
+void log_event_stats(void)
+{
+	MYLOG("EVQ", "ACC posted %lu, overflows %lu, coalesced %lu", (unsigned long)g_event_stats.posted[EVENT_SOURCE_ACC],
+		  (unsigned long)g_event_stats.overflows[EVENT_SOURCE_ACC], (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_ACC]);
+	MYLOG("EVQ", "Timers posted %lu, overflows %lu, coalesced %lu", (unsigned long)g_event_stats.posted[EVENT_SOURCE_TIMER],
+		  (unsigned long)g_event_stats.overflows[EVENT_SOURCE_TIMER], (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_TIMER]);
+	MYLOG("EVQ", "EPD posted %lu, overflows %lu, coalesced %lu", (unsigned long)g_event_stats.posted[EVENT_SOURCE_EPD],
+		  (unsigned long)g_event_stats.overflows[EVENT_SOURCE_EPD], (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_EPD]);
+	MYLOG("EVQ", "%lu records in %lu batches, largest %u, latency up to %lu ms", (unsigned long)g_event_stats.drained,
+		  (unsigned long)g_event_stats.batches, g_event_stats.max_batch, (unsigned long)g_event_stats.max_latency_ms);
+}
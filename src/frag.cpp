@@ -0,0 +1,271 @@
+/**
+ * @file frag.cpp
+ * @author agent (agent@local)
+ * @brief Reassembly of payloads that are sent in several downlinks.
+ *        A fragment is FRAG_DOWNLINK, session, index, count and a piece
+ *        of the payload. All fragments but the last one have the same
+ *        size, so every fragment goes straight to its place in the
+ *        buffer and a bitmap keeps track of what arrived. After a short
+ *        pause the missing fragments are requested with one uplink; the
+ *        network server answers it with exactly those fragments.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+enum e_frag_state
+{
+	FRAG_IDLE,
+	FRAG_RECEIVING,
+	FRAG_COMPLETE,
+};
+
+/** Reassembly buffer of the current session */
+static uint8_t frag_buffer[FRAG_BUFFER_SIZE];
+static e_frag_state frag_state = FRAG_IDLE;
+static uint8_t frag_session = 0;
+static uint8_t frag_count = 0;
+/** Payload size of every fragment but the last, 0 until one of them arrived */
+static uint16_t frag_size = 0;
+static uint16_t frag_last_len = 0;
+/** Bit n is set when fragment n arrived */
+static uint64_t frag_received = 0;
+static uint8_t frag_requests = 0;
+/** An acknowledge or request is due */
+static bool frag_request_pending = false;
+
+s_frag_stats g_frag_stats;
+
+static SoftwareTimer frag_timer;
+
+/**
+ * @brief Request delay or retry time is over
+ */
+static void frag_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, FRAG_EVENT);
+}
+
+/**
+ * @brief Bit mask of all fragments of the session
+ */
+static uint64_t frag_all(void)
+{
+	return (frag_count == 64) ? ~(uint64_t)0 : (((uint64_t)1 << frag_count) - 1);
+}
+
+/**
+ * @brief Create the timer for the fragment requests
+ */
+void init_frag(void)
+{
+	frag_timer.begin(FRAG_REQUEST_DELAY_MS, frag_timer_cb, NULL, false);
+}
+
+/**
+ * @brief Put a fragment downlink into the reassembly buffer
+ *
+ * @param data downlink starting with FRAG_DOWNLINK
+ * @param len size of data
+ * @return true if the fragment completed the payload, get it with frag_payload()
+ */
+bool frag_add(const uint8_t *data, uint16_t len)
+{
+	if (len < FRAG_HEADER_SIZE)
+	{
+		return false;
+	}
+	uint8_t session = data[1];
+	uint8_t index = data[2];
+	uint8_t count = data[3];
+	const uint8_t *piece = &data[FRAG_HEADER_SIZE];
+	uint16_t piece_len = len - FRAG_HEADER_SIZE;
+	g_frag_stats.fragments++;
+
+	if ((count == 0) || (count > FRAG_MAX_COUNT) || (index >= count))
+	{
+		MYLOG("FRAG", "Invalid fragment %d/%d", index, count);
+		return false;
+	}
+
+	if ((frag_state == FRAG_IDLE) || (session != frag_session))
+	{
+		// A new session replaces an unfinished one
+		if (frag_state == FRAG_RECEIVING)
+		{
+			MYLOG("FRAG", "Session %d dropped for session %d", frag_session, session);
+			g_frag_stats.dropped++;
+		}
+		frag_state = FRAG_RECEIVING;
+		frag_session = session;
+		frag_count = count;
+		frag_size = 0;
+		frag_last_len = 0;
+		frag_received = 0;
+		frag_requests = 0;
+		g_frag_stats.sessions++;
+	}
+	else if (count != frag_count)
+	{
+		MYLOG("FRAG", "Fragment count %d doesn't match session %d", count, session);
+		return false;
+	}
+
+	if ((frag_state == FRAG_COMPLETE) || (frag_received & ((uint64_t)1 << index)))
+	{
+		// The acknowledge got lost, send it again
+		g_frag_stats.duplicates++;
+		if (frag_state == FRAG_COMPLETE)
+		{
+			frag_request_pending = true;
+			frag_timer.stop();
+			frag_timer.setPeriod(FRAG_REQUEST_DELAY_MS);
+		}
+		return false;
+	}
+
+	bool last = (index == count - 1);
+	if (!last)
+	{
+		if (frag_size == 0)
+		{
+			if ((piece_len == 0) || ((uint32_t)piece_len * count > FRAG_BUFFER_SIZE))
+			{
+				MYLOG("FRAG", "Session %d doesn't fit into %d bytes", session, FRAG_BUFFER_SIZE);
+				frag_state = FRAG_IDLE;
+				g_frag_stats.dropped++;
+				return false;
+			}
+			frag_size = piece_len;
+		}
+		else if (piece_len != frag_size)
+		{
+			MYLOG("FRAG", "Fragment %d has %d bytes instead of %d", index, piece_len, frag_size);
+			return false;
+		}
+	}
+	else if ((count > 1) && ((frag_size == 0) || (piece_len > frag_size)))
+	{
+		// Its place is only known once another fragment arrived, it is requested again
+		MYLOG("FRAG", "Last fragment before its size is known");
+		frag_request_pending = true;
+		frag_timer.stop();
+		frag_timer.setPeriod(FRAG_REQUEST_DELAY_MS);
+		return false;
+	}
+	else
+	{
+		frag_last_len = piece_len;
+	}
+
+	memcpy(&frag_buffer[(uint32_t)index * frag_size], piece, piece_len);
+	frag_received |= (uint64_t)1 << index;
+	frag_requests = 0;
+
+	if (frag_received == frag_all())
+	{
+		MYLOG("FRAG", "Session %d complete, %d fragments", session, count);
+		frag_state = FRAG_COMPLETE;
+		g_frag_stats.completed++;
+	}
+
+	// Fragments of one burst are answered together
+	frag_request_pending = true;
+	frag_timer.stop();
+	frag_timer.setPeriod(FRAG_REQUEST_DELAY_MS);
+	return frag_state == FRAG_COMPLETE;
+}
+
+/**
+ * @brief Payload of the completed session
+ *
+ * @param len receives the payload size
+ * @return const uint8_t* payload, NULL if no session is complete
+ */
+const uint8_t *frag_payload(uint16_t *len)
+{
+	if (frag_state != FRAG_COMPLETE)
+	{
+		*len = 0;
+		return NULL;
+	}
+	*len = (frag_count - 1) * frag_size + frag_last_len;
+	return frag_buffer;
+}
+
+/**
+ * @brief Queue the request for the missing fragments or the acknowledge
+ *        of the complete payload. It goes out before the telemetry.
+ */
+void send_frag_request(void)
+{
+	if (!frag_request_pending || (frag_state == FRAG_IDLE))
+	{
+		return;
+	}
+	if ((frag_state == FRAG_RECEIVING) && (frag_requests >= FRAG_MAX_REQUESTS))
+	{
+		MYLOG("FRAG", "Session %d given up", frag_session);
+		frag_state = FRAG_IDLE;
+		frag_request_pending = false;
+		g_frag_stats.dropped++;
+		return;
+	}
+	queue_uplink(UPLINK_KIND_FRAG_REQUEST, UPLINK_PRIO_HIGH);
+
+	// Ask again if the answer doesn't come
+	frag_timer.stop();
+	frag_timer.setPeriod(FRAG_RETRY_MS);
+}
+
+/**
+ * @brief Build the missing fragments of the session as a bitmap,
+ *        an empty bitmap acknowledges the complete payload.
+ *        Packet is FRAG_REQUEST_UPLINK, session, count and one bit per
+ *        fragment, bit 0 of the first byte is fragment 0.
+ */
+uint8_t build_frag_request(uint8_t *frame, uint8_t max_size)
+{
+	uint8_t bitmap_len = (frag_count + 7) / 8;
+	if (!frag_request_pending || (frag_state == FRAG_IDLE) || ((3 + bitmap_len) > max_size))
+	{
+		return 0;
+	}
+	uint64_t missing = frag_all() & ~frag_received;
+	frame[0] = FRAG_REQUEST_UPLINK;
+	frame[1] = frag_session;
+	frame[2] = frag_count;
+	for (uint8_t idx = 0; idx < bitmap_len; idx++)
+	{
+		frame[3 + idx] = (missing >> (idx * 8)) & 0xFF;
+	}
+	return 3 + bitmap_len;
+}
+
+/**
+ * @brief The uplink queue is done with the request
+ *
+ * @param sent true if the LoRaMAC took it, otherwise the retry timer asks again
+ */
+void frag_request_done(bool sent)
+{
+	if (!sent)
+	{
+		MYLOG("FRAG", "Request of session %d not sent", frag_session);
+		return;
+	}
+	g_frag_stats.requests++;
+	if (frag_state == FRAG_COMPLETE)
+	{
+		MYLOG("FRAG", "Session %d acknowledged", frag_session);
+		frag_request_pending = false;
+		return;
+	}
+	MYLOG("FRAG", "Requested %d missing fragments of session %d",
+		  __builtin_popcountll(frag_all() & ~frag_received), frag_session);
+	frag_requests++;
+}
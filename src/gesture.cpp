@@ -0,0 +1,224 @@
+/**
+ * @file gesture.cpp
+ * @author agent (agent@local)
+ * @brief Gesture classifier. Taps and double taps come from the click
+ *        engine of the LIS3DH, shake and flip are found in the FIFO
+ *        samples with integer math only. A movement or a click opens a
+ *        session during which the FIFO watermark wakes up the MCU, so
+ *        the samples are only looked at while something is going on.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Shake: the acceleration swings past +/- GESTURE_SHAKE_MG in opposite directions */
+#define GESTURE_SHAKE_MG 700
+/** Number of swings for a shake, 3 back and forth movements */
+#define GESTURE_SHAKE_SWINGS 6
+/** Samples allowed between two swings of one shake, 400 ms */
+#define GESTURE_SHAKE_GAP (ACC_SAMPLE_RATE * 4 / 10)
+/** Gravity on Z beyond this means the badge lies face up or face down */
+#define GESTURE_FACE_MG 600
+/** Samples the badge has to stay face down after turning, 300 ms */
+#define GESTURE_FLIP_STABLE (ACC_SAMPLE_RATE * 3 / 10)
+/** Movement that keeps the session open */
+#define GESTURE_ACTIVE_MG 200
+/** A single tap waits this long for a second one, a shake also triggers the click engine */
+#define GESTURE_TAP_HOLD_MS 450
+/** The session ends after this time without movement */
+#define GESTURE_SESSION_MS 1500
+
+/** Gravity estimate in 1/16 mg, low pass over ~16 samples */
+static int32_t gravity[3] = {0, 0, 0};
+static bool gravity_valid = false;
+
+/** Shake detection per axis */
+static int8_t swing_sign[3] = {0, 0, 0};
+static uint8_t swing_num[3] = {0, 0, 0};
+static uint32_t swing_sample[3] = {0, 0, 0};
+static bool shake_reported = false;
+
+/** Orientation, 1 face up, -1 face down, 0 on the side or unknown */
+static int8_t face = 0;
+static int8_t face_candidate = 0;
+static uint16_t face_count = 0;
+
+static uint32_t sample_num = 0;
+static bool session = false;
+static bool moving = false;
+static uint32_t last_activity = 0;
+/** Click waiting to be confirmed, TAP_EVENT or DOUBLE_TAP_EVENT */
+static uint16_t tap_pending = 0;
+static uint32_t tap_time = 0;
+
+/**
+ * @brief Feed one sample to the shake and flip detection
+ *
+ * @param sample acceleration in mg
+ * @return uint16_t SHAKE_EVENT and/or FLIP_EVENT
+ */
+static uint16_t classify_sample(const s_acc_sample &sample)
+{
+	uint16_t events = 0;
+	int16_t axes[3] = {sample.x, sample.y, sample.z};
+
+	sample_num++;
+	moving = false;
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		if (!gravity_valid)
+		{
+			gravity[axis] = (int32_t)axes[axis] * 16;
+		}
+		int32_t dynamic = axes[axis] - gravity[axis] / 16;
+		gravity[axis] += (int32_t)axes[axis] - gravity[axis] / 16;
+
+		if ((dynamic > GESTURE_ACTIVE_MG) || (dynamic < -GESTURE_ACTIVE_MG))
+		{
+			moving = true;
+		}
+
+		int8_t sign = 0;
+		if (dynamic > GESTURE_SHAKE_MG)
+		{
+			sign = 1;
+		}
+		else if (dynamic < -GESTURE_SHAKE_MG)
+		{
+			sign = -1;
+		}
+
+		if ((sample_num - swing_sample[axis]) > GESTURE_SHAKE_GAP)
+		{
+			// Swinging stopped
+			swing_num[axis] = 0;
+			swing_sign[axis] = 0;
+		}
+		if ((sign != 0) && (sign != swing_sign[axis]))
+		{
+			swing_num[axis]++;
+			swing_sign[axis] = sign;
+			swing_sample[axis] = sample_num;
+			if (swing_num[axis] >= 2)
+			{
+				// A tap is one spike, swinging back and forth is a shake
+				tap_pending = 0;
+			}
+			if ((swing_num[axis] >= GESTURE_SHAKE_SWINGS) && !shake_reported)
+			{
+				events |= SHAKE_EVENT;
+				shake_reported = true;
+			}
+		}
+	}
+	gravity_valid = true;
+
+	if ((swing_num[0] == 0) && (swing_num[1] == 0) && (swing_num[2] == 0))
+	{
+		shake_reported = false;
+	}
+
+	int32_t gravity_z = gravity[2] / 16;
+	int8_t new_face = 0;
+	if (gravity_z > GESTURE_FACE_MG)
+	{
+		new_face = 1;
+	}
+	else if (gravity_z < -GESTURE_FACE_MG)
+	{
+		new_face = -1;
+	}
+	if (new_face != face_candidate)
+	{
+		face_candidate = new_face;
+		face_count = 0;
+	}
+	else if (face_count < GESTURE_FLIP_STABLE)
+	{
+		if (++face_count == GESTURE_FLIP_STABLE)
+		{
+			// Only turning the display away counts, turning it back is not a gesture
+			if ((face == 1) && (face_candidate == -1))
+			{
+				events |= FLIP_EVENT;
+			}
+			face = face_candidate;
+		}
+	}
+	return events;
+}
+
+/**
+ * @brief Check for a shake in progress
+ */
+static bool shaking(void)
+{
+	return (swing_num[0] >= 2) || (swing_num[1] >= 2) || (swing_num[2] >= 2);
+}
+
+/**
+ * @brief Classify the pending accelerometer data into gestures
+ *
+ * @param int_sources ACC_INT_xxx sources from clear_acc_int()
+ * @return uint16_t TAP_EVENT, DOUBLE_TAP_EVENT, SHAKE_EVENT and FLIP_EVENT
+ *         for the detected gestures
+ */
+uint16_t classify_gestures(uint8_t int_sources)
+{
+	uint16_t events = 0;
+	uint32_t now = millis();
+
+	if (int_sources != 0)
+	{
+		last_activity = now;
+	}
+	s_acc_sample sample;
+	while (acc_get_sample(&sample))
+	{
+		events |= classify_sample(sample);
+		if (moving)
+		{
+			last_activity = now;
+		}
+	}
+
+	if ((tap_pending != 0) && ((now - tap_time) > GESTURE_TAP_HOLD_MS))
+	{
+		events |= tap_pending;
+		tap_pending = 0;
+	}
+
+	if (!shaking())
+	{
+		if (int_sources & ACC_INT_DOUBLE_TAP)
+		{
+			// Replaces the single tap it started with
+			tap_pending = DOUBLE_TAP_EVENT;
+			tap_time = now;
+		}
+		else if (int_sources & ACC_INT_TAP)
+		{
+			// A new single tap outside the double tap window confirms the held one
+			events |= tap_pending;
+			tap_pending = TAP_EVENT;
+			tap_time = now;
+		}
+	}
+
+	// Keep reading batches until the gesture is over
+	bool active = (tap_pending != 0) || ((now - last_activity) < GESTURE_SESSION_MS) || (face_count < GESTURE_FLIP_STABLE);
+	if (active != session)
+	{
+		session = active;
+		set_acc_fifo_wakeup(session);
+		MYLOG("GEST", "Session %s", session ? "started" : "ended");
+	}
+	if (events != 0)
+	{
+		MYLOG("GEST", "Gestures 0x%04X", events);
+	}
+	return events;
+}
@@ -1,79 +1,53 @@
 /**
  * @file images.h
  * @author Johan Sebastian Macias (johan.macias@rakwireless.com)
- * @brief Logos and images for the EPD
+ * @brief Logos and images for the EPD, compressed by tools/imgconv.py
  * @version 0.1
  * @date 2022-01-26
  * 
  * @copyright Copyright (c) 2022
  */
+#include "epd_driver.h"
 
-const unsigned char rak_img[] = {
-	// 'RAK-logo, 150x56px
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff,
-	0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x07, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xf0, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x80, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
-	0xfc, 0x1f, 0x80, 0x00, 0x00, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x7f, 0xc0, 0x07, 0xf8, 0x01, 0xff,
-	0x80, 0x00, 0x03, 0xf8, 0xff, 0xc0, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x00, 0x7f, 0xc0, 0x07,
-	0xf8, 0x03, 0xff, 0x00, 0x00, 0x03, 0xf3, 0xff, 0xc0, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xf0, 0x00,
-	0xff, 0xe0, 0x07, 0xf8, 0x07, 0xfe, 0x00, 0x00, 0x07, 0xe7, 0xff, 0xc8, 0x00, 0x00, 0x1f, 0xff,
-	0xff, 0xf0, 0x00, 0xff, 0xe0, 0x07, 0xf8, 0x0f, 0xfc, 0x00, 0x00, 0x07, 0xcf, 0xff, 0xce, 0x00,
-	0x00, 0x1f, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xe0, 0x07, 0xf8, 0x1f, 0xf8, 0x00, 0x00, 0x00, 0x02,
-	0x00, 0x1f, 0x80, 0x00, 0x1f, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xf0, 0x07, 0xf8, 0x3f, 0xf8, 0x00,
-	0x00, 0x1c, 0x30, 0x1e, 0x1f, 0xc0, 0x00, 0x1f, 0xe0, 0x0f, 0xf8, 0x01, 0xff, 0xf0, 0x07, 0xf8,
-	0x7f, 0xf0, 0x00, 0x0f, 0x3e, 0x79, 0xff, 0xcf, 0xe0, 0x00, 0x1f, 0xe0, 0x07, 0xf8, 0x01, 0xff,
-	0xf0, 0x07, 0xf8, 0x7f, 0xe0, 0x00, 0x0f, 0x3e, 0x7d, 0xff, 0xc7, 0xf0, 0x00, 0x1f, 0xe0, 0x03,
-	0xfc, 0x03, 0xff, 0xf8, 0x07, 0xf8, 0xff, 0xc0, 0x00, 0x1f, 0x3e, 0xfd, 0xff, 0xc3, 0xf0, 0x00,
-	0x1f, 0xe0, 0x03, 0xf8, 0x03, 0xfb, 0xf8, 0x07, 0xf9, 0xff, 0x80, 0x00, 0x1f, 0x3e, 0xfd, 0xff,
-	0xc9, 0xf8, 0x00, 0x1f, 0xe0, 0x03, 0xf8, 0x07, 0xfb, 0xfc, 0x07, 0xfb, 0xff, 0x00, 0x00, 0x1f,
-	0x3e, 0xfd, 0xff, 0x99, 0xf8, 0x00, 0x1f, 0xe0, 0x07, 0xf8, 0x07, 0xfb, 0xfc, 0x07, 0xff, 0xfe,
-	0x00, 0x00, 0x1f, 0x3e, 0xfc, 0x00, 0x1c, 0xfc, 0x00, 0x1f, 0xe0, 0x0f, 0xf8, 0x07, 0xf1, 0xfc,
-	0x07, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xbe, 0xfc, 0x03, 0x9e, 0x7c, 0x00, 0x1f, 0xff, 0xff, 0xf0,
-	0x0f, 0xf1, 0xfe, 0x07, 0xff, 0xfe, 0x00, 0x00, 0x0f, 0x9e, 0x7c, 0x07, 0xde, 0x7e, 0x00, 0x1f,
-	0xff, 0xff, 0xf0, 0x0f, 0xf1, 0xfe, 0x07, 0xff, 0xff, 0x00, 0x00, 0x0f, 0x9e, 0x7c, 0x07, 0xcf,
-	0x7e, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x0f, 0xe0, 0xfe, 0x07, 0xff, 0xff, 0x00, 0x00, 0x0f, 0xde,
-	0x7c, 0x07, 0xcf, 0x3e, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x1f, 0xe0, 0xff, 0x07, 0xff, 0xff, 0x80,
-	0x00, 0x0f, 0xcf, 0x00, 0x07, 0xcf, 0x3e, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x1f, 0xe0, 0xff, 0x07,
-	0xff, 0xff, 0xc0, 0x00, 0x07, 0xe7, 0x00, 0x07, 0xcf, 0x3e, 0x00, 0x1f, 0xff, 0xff, 0xf0, 0x3f,
-	0xff, 0xff, 0x87, 0xff, 0x7f, 0xc0, 0x00, 0x07, 0xe6, 0x7f, 0xe7, 0xcf, 0x3e, 0x00, 0x1f, 0xe0,
-	0x1f, 0xf8, 0x3f, 0xff, 0xff, 0x87, 0xfe, 0x7f, 0xe0, 0x00, 0x03, 0xf2, 0x7f, 0xe7, 0xcf, 0x3e,
-	0x00, 0x1f, 0xe0, 0x0f, 0xf8, 0x3f, 0xff, 0xff, 0x87, 0xfc, 0x3f, 0xf0, 0x00, 0x01, 0xf8, 0xff,
-	0xe7, 0xcf, 0x3e, 0x00, 0x1f, 0xe0, 0x07, 0xf8, 0x7f, 0xff, 0xff, 0xc7, 0xf8, 0x1f, 0xf0, 0x00,
-	0x01, 0xfc, 0xff, 0xe7, 0xcf, 0x3e, 0x00, 0x1f, 0xe0, 0x07, 0xf8, 0x7f, 0xff, 0xff, 0xc7, 0xf8,
-	0x1f, 0xf8, 0x00, 0x00, 0xfe, 0x7f, 0xe7, 0x8f, 0x1c, 0x00, 0x1f, 0xe0, 0x03, 0xf8, 0x7f, 0xff,
-	0xff, 0xc7, 0xf8, 0x0f, 0xfc, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xe0, 0x03,
-	0xf8, 0xff, 0x00, 0x1f, 0xe7, 0xf8, 0x07, 0xfe, 0x00, 0x00, 0x3e, 0x00, 0x38, 0x30, 0x00, 0x00,
-	0x1f, 0xe0, 0x03, 0xf8, 0xff, 0x00, 0x1f, 0xe7, 0xf8, 0x07, 0xfe, 0x00, 0x00, 0x0e, 0x7f, 0xfc,
-	0xf8, 0x00, 0x00, 0x1f, 0xe0, 0x03, 0xf9, 0xfe, 0x00, 0x1f, 0xf7, 0xf8, 0x03, 0xff, 0x00, 0x00,
-	0x00, 0xff, 0xf9, 0xf8, 0x00, 0x00, 0x1f, 0xe0, 0x03, 0xfd, 0xfe, 0x00, 0x0f, 0xf7, 0xf8, 0x01,
-	0xff, 0x80, 0x00, 0x00, 0xff, 0xf3, 0xf0, 0x00, 0x00, 0x1f, 0xe0, 0x03, 0xfd, 0xfe, 0x00, 0x0f,
-	0xf7, 0xf8, 0x01, 0xff, 0x80, 0x00, 0x00, 0x7f, 0xc7, 0xf0, 0x00, 0x00, 0x1f, 0xe0, 0x03, 0xff,
-	0xfc, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x1f,
-	0xe0, 0x01, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xf8, 0x00, 0x7f, 0xe0, 0x00, 0x00, 0x00, 0x7f, 0xc0,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x3f, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x7f, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
\ No newline at end of file
+static const uint8_t rak_img_data[] = {
+	// 'RAK-logo', 150x56px, 617 bytes for 1050 raw
+	0xea, 0x00, 0x00, 0x1f, 0xfb, 0x00, 0x01, 0x60, 0xf0, 0xfb, 0x00, 0x00, 0x0c, 0xfb, 0x00, 0x00,
+	0x02, 0xfb, 0x00, 0x01, 0x01, 0x80, 0xfd, 0x00, 0x02, 0x7e, 0x00, 0x40, 0xfd, 0x00, 0x02, 0x01,
+	0xc0, 0x20, 0xfd, 0x00, 0x02, 0x7f, 0x30, 0x10, 0xfd, 0x00, 0x01, 0x80, 0xec, 0xfb, 0x00, 0x01,
+	0x12, 0x08, 0xfe, 0x00, 0x02, 0x06, 0x00, 0x0d, 0xfd, 0x00, 0x03, 0x18, 0x80, 0x02, 0x80, 0xfe,
+	0x00, 0x03, 0x20, 0x7f, 0xe6, 0x58, 0xfe, 0x00, 0x03, 0x40, 0x1f, 0x19, 0xa6, 0xfe, 0x00, 0x0e,
+	0x80, 0x60, 0xe6, 0x49, 0x1e, 0x00, 0x01, 0x02, 0x80, 0x00, 0x00, 0x20, 0x00, 0x02, 0x04, 0xfb,
+	0x00, 0x01, 0x0a, 0x80, 0xfd, 0x00, 0x02, 0x04, 0x14, 0x40, 0xfc, 0x00, 0x02, 0x29, 0x3f, 0xe0,
+	0xfe, 0x00, 0x02, 0x08, 0x01, 0x7c, 0xfc, 0x00, 0x00, 0x10, 0xfb, 0x00, 0x00, 0x40, 0xfe, 0x00,
+	0x00, 0x40, 0xfc, 0x00, 0x0e, 0x11, 0x00, 0x00, 0x10, 0x20, 0x80, 0x07, 0xc0, 0x82, 0x00, 0x00,
+	0x80, 0x00, 0x00, 0x02, 0xfc, 0x00, 0x02, 0xff, 0xd5, 0x04, 0xfe, 0x00, 0x0a, 0x01, 0x00, 0x0a,
+	0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x04, 0x08, 0xfc, 0x00, 0x1c, 0x08, 0x10, 0x00, 0x01, 0x20,
+	0x05, 0x00, 0x40, 0x20, 0x00, 0x0e, 0x1e, 0x78, 0xff, 0x90, 0x40, 0x00, 0x00, 0x01, 0x87, 0x80,
+	0x00, 0x80, 0x00, 0x00, 0x06, 0x48, 0x7f, 0xd3, 0xfe, 0x00, 0x03, 0x04, 0x2c, 0x00, 0x0c, 0xfd,
+	0x00, 0x00, 0x12, 0xfc, 0x00, 0x02, 0x02, 0x0d, 0x80, 0xfc, 0x00, 0x02, 0x02, 0x7f, 0xc0, 0xfe,
+	0x00, 0x02, 0x01, 0x01, 0xc0, 0xfc, 0x00, 0x02, 0x80, 0x3f, 0x80, 0xfd, 0x00, 0x02, 0x40, 0x00,
+	0x40, 0xfd, 0x00, 0x00, 0x30, 0xfb, 0x00, 0x00, 0x0c, 0xfb, 0x00, 0x02, 0x03, 0x00, 0x40, 0xfc,
+	0x00, 0x01, 0xff, 0x80, 0xb1, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0x80, 0xcd, 0x00, 0x03, 0xfe,
+	0x07, 0xff, 0x80, 0xcc, 0x00, 0x00, 0x04, 0xfc, 0x00, 0x01, 0x82, 0x02, 0xfc, 0x00, 0x02, 0x44,
+	0x01, 0x80, 0xfd, 0x00, 0x02, 0x38, 0x00, 0x7f, 0xfa, 0x00, 0x00, 0x80, 0xf8, 0x00, 0x00, 0x20,
+	0xf9, 0x00, 0x00, 0x20, 0xfd, 0x00, 0x02, 0x10, 0x00, 0x50, 0xfd, 0x00, 0x02, 0x0c, 0x01, 0x88,
+	0xfd, 0x00, 0x03, 0x03, 0xde, 0x07, 0xf8, 0xfd, 0x00, 0x02, 0x20, 0x00, 0x06, 0xfb, 0x00, 0x00,
+	0x0e, 0xfb, 0x00, 0x00, 0x30, 0xfc, 0x00, 0x01, 0x01, 0xc0, 0xfc, 0x00, 0x00, 0x0e, 0xfb, 0x00,
+	0x00, 0x30, 0xfc, 0x00, 0x01, 0x01, 0xc0, 0xfc, 0x00, 0x00, 0x0e, 0xfb, 0x00, 0x09, 0x30, 0x00,
+	0x01, 0x80, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x0e, 0xfe, 0x00, 0x03, 0x0e, 0x00, 0x00, 0x30, 0xfe,
+	0x00, 0x00, 0x30, 0xf2, 0x00, 0x00, 0x70, 0xfc, 0x00, 0x01, 0x03, 0x80, 0xfc, 0x00, 0x00, 0x1c,
+	0xfb, 0x00, 0x00, 0x1c, 0xfb, 0x00, 0x01, 0x03, 0x80, 0xfb, 0x00, 0x00, 0x70, 0xf6, 0x00, 0x00,
+	0x30, 0xfb, 0x00, 0x03, 0x0e, 0x00, 0x00, 0x38, 0xfe, 0x00, 0x03, 0x01, 0xc0, 0x00, 0x07, 0xfd,
+	0x00, 0x03, 0x30, 0x00, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x0e, 0xfb, 0x00, 0x01, 0x01, 0xc0, 0xfb,
+	0x00, 0x00, 0x30, 0xfb, 0x00, 0x00, 0x0e, 0xfb, 0x00, 0x01, 0x01, 0xc0, 0xfb, 0x00, 0x00, 0x30,
+	0xfb, 0x00, 0x00, 0x0e, 0xfe, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xfe, 0xcd, 0x00, 0x04, 0x3f, 0xf8,
+	0x01, 0xff, 0x80, 0xfe, 0x00, 0x01, 0x08, 0x02, 0xfc, 0x00, 0x01, 0x10, 0x04, 0xfc, 0x00, 0x01,
+	0x20, 0x08, 0xfc, 0x00, 0x01, 0xc0, 0x0c, 0xfd, 0x00, 0x02, 0x01, 0x00, 0x02, 0xfd, 0x00, 0x03,
+	0x02, 0x00, 0x01, 0x80, 0xfe, 0x00, 0x03, 0x04, 0x00, 0x00, 0x40, 0xfe, 0x00, 0x03, 0x08, 0x00,
+	0x00, 0x30, 0xfe, 0x00, 0x03, 0x10, 0x02, 0x00, 0x08, 0xfe, 0x00, 0x03, 0x20, 0x05, 0x00, 0x06,
+	0xfd, 0x00, 0x02, 0x08, 0xc0, 0x01, 0xfd, 0x00, 0x03, 0x10, 0x20, 0x00, 0x80, 0xfe, 0x00, 0x01,
+	0x20, 0x18, 0xfc, 0x00, 0x01, 0x40, 0x04, 0xfc, 0x00, 0x01, 0x80, 0x03, 0xfd, 0x00, 0x03, 0x03,
+	0x00, 0x00, 0x80, 0xfe, 0x00, 0x03, 0x04, 0x00, 0x00, 0x40, 0xfe, 0x00, 0x03, 0x08, 0x00, 0x00,
+	0x30, 0xfe, 0x00, 0x03, 0x10, 0x00, 0x00, 0x08, 0xfe, 0x00, 0x03, 0x20, 0x00, 0x00, 0x06, 0xfb,
+	0x00, 0x00, 0x01, 0xfa, 0x00, 0x00, 0x80, 0xf2, 0x00};
+static const s_epd_image rak_img = {150, 56, sizeof(rak_img_data), rak_img_data};
@@ -0,0 +1,255 @@
+/**
+ * @file link.cpp
+ * @author agent (agent@local)
+ * @brief Connection manager. Failed joins are repeated with an exponential
+ *        backoff and jitter. Unconfirmed uplinks are checked with a
+ *        confirmed one from time to time; unanswered confirmed uplinks
+ *        step the data rate down, and a link that stays dead at the
+ *        lowest data rate is joined again. Nothing of this resets the
+ *        device, the messages on the EPD stay as they are.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Counters of the connection */
+s_link_stats g_link_stats;
+
+/** Failed joins in a row */
+static uint8_t join_attempts = 0;
+static bool join_due = false;
+/** Data rate of the ladder, starts with the configured one after every join */
+static uint8_t link_dr = 0;
+/** Unanswered confirmed uplinks in a row */
+static uint8_t link_misses = 0;
+/** Unconfirmed uplinks since the last check */
+static uint8_t unchecked_uplinks = 0;
+/** Confirmed uplinks until one is answered */
+static bool link_escalated = false;
+/** The running uplink is confirmed, the configured setting is restored after it */
+static bool tx_confirmed = false;
+static bool confirm_override = false;
+static lmh_confirm configured_confirm = LMH_UNCONFIRMED_MSG;
+
+static SoftwareTimer link_timer;
+
+/**
+ * @brief Join backoff is over. All event bits are taken, the uplink
+ *        event handler does the connection work as well.
+ */
+static void link_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, UPLINK_EVENT);
+}
+
+/**
+ * @brief Create the timer of the join backoff
+ */
+void init_link(void)
+{
+	link_timer.begin(JOIN_BACKOFF_MIN_MS, link_timer_cb, NULL, false);
+	link_dr = g_lorawan_settings.data_rate;
+}
+
+/**
+ * @brief Start the next join after the backoff of the failed ones
+ */
+static void schedule_join(void)
+{
+	uint32_t backoff = JOIN_BACKOFF_MIN_MS;
+	for (uint8_t idx = 1; (idx < join_attempts) && (backoff < JOIN_BACKOFF_MAX_MS); idx++)
+	{
+		backoff *= 2;
+	}
+	if (backoff > JOIN_BACKOFF_MAX_MS)
+	{
+		backoff = JOIN_BACKOFF_MAX_MS;
+	}
+	// +-25% so badges that lost the network together don't join together
+	backoff = backoff - backoff / 4 + random(backoff / 2);
+	MYLOG("LINK", "Join again in %lu ms", (unsigned long)backoff);
+	join_due = true;
+	link_timer.stop();
+	link_timer.setPeriod(backoff);
+}
+
+/**
+ * @brief Handle the result of a join
+ *
+ * @param joined true if the network accepted the join
+ */
+void link_join_result(bool joined)
+{
+	if (!joined)
+	{
+		g_link_stats.join_fails++;
+		if (join_attempts < 0xFF)
+		{
+			join_attempts++;
+		}
+		schedule_join();
+		return;
+	}
+	g_link_stats.joins++;
+	join_attempts = 0;
+	join_due = false;
+	link_misses = 0;
+	unchecked_uplinks = 0;
+	link_escalated = false;
+	link_dr = g_lorawan_settings.data_rate;
+	// Whatever waited for the network goes out now
+	service_uplink_queue();
+}
+
+/**
+ * @brief Join when the backoff is over
+ */
+void handle_link_event(void)
+{
+	if (!join_due || g_lpwan_has_joined)
+	{
+		return;
+	}
+	join_due = false;
+	MYLOG("LINK", "Join attempt %d", join_attempts + 1);
+	lmh_join();
+}
+
+/**
+ * @brief Choose confirmed or unconfirmed for the next uplink
+ */
+void link_prepare_uplink(void)
+{
+	if (!confirm_override)
+	{
+		configured_confirm = g_lorawan_settings.confirmed_msg_enabled;
+	}
+	bool check = link_escalated || (unchecked_uplinks >= LINK_CHECK_UPLINKS);
+	if (check && (configured_confirm == LMH_UNCONFIRMED_MSG))
+	{
+		g_lorawan_settings.confirmed_msg_enabled = LMH_CONFIRMED_MSG;
+		confirm_override = true;
+	}
+	tx_confirmed = g_lorawan_settings.confirmed_msg_enabled == LMH_CONFIRMED_MSG;
+}
+
+/**
+ * @brief Put the configured confirmed setting back
+ */
+static void restore_confirm(void)
+{
+	if (confirm_override)
+	{
+		g_lorawan_settings.confirmed_msg_enabled = configured_confirm;
+		confirm_override = false;
+	}
+}
+
+/**
+ * @brief The LoRaMAC took the prepared uplink or refused it
+ *
+ * @param sent true if the TX cycle started
+ */
+void link_uplink_sent(bool sent)
+{
+	if (!sent)
+	{
+		restore_confirm();
+		return;
+	}
+	if (tx_confirmed)
+	{
+		g_link_stats.checks++;
+		unchecked_uplinks = 0;
+	}
+	else if (unchecked_uplinks < 0xFF)
+	{
+		unchecked_uplinks++;
+	}
+}
+
+/**
+ * @brief The network was not heard for too long, step the data rate
+ *        down or join again at the end of the ladder
+ */
+static void link_missed(void)
+{
+	g_link_stats.misses++;
+	link_escalated = true;
+	if (++link_misses < LINK_MISSES_PER_DR)
+	{
+		return;
+	}
+	link_misses = 0;
+	if (link_dr > LINK_MIN_DR)
+	{
+		link_dr--;
+		g_link_stats.dr_steps++;
+		MYLOG("LINK", "No answer, data rate down to DR%d", link_dr);
+		lmh_datarate_set(link_dr, g_lorawan_settings.adr_enabled);
+		return;
+	}
+
+	// Soft re-init of the MAC, the session is dropped and joined again
+	MYLOG("LINK", "No answer at DR%d, joining again", link_dr);
+	g_link_stats.rejoins++;
+	link_escalated = false;
+	lmh_datarate_set(g_lorawan_settings.data_rate, g_lorawan_settings.adr_enabled);
+	g_lpwan_has_joined = false;
+	join_attempts = 0;
+	lmh_join();
+}
+
+/**
+ * @brief Handle the end of a TX cycle
+ *
+ * @param ack result of the TX cycle, unconfirmed uplinks always succeed
+ */
+void link_tx_result(bool ack)
+{
+	bool confirmed = tx_confirmed;
+	tx_confirmed = false;
+	restore_confirm();
+	if (!confirmed)
+	{
+		return;
+	}
+	if (ack)
+	{
+		g_link_stats.acks++;
+		link_misses = 0;
+		link_escalated = false;
+		return;
+	}
+	// Increase fail send counter
+	if (send_fail < 0xFF)
+	{
+		send_fail++;
+	}
+	link_missed();
+}
+
+/**
+ * @brief A downlink shows the network hears the badge
+ */
+void link_downlink(void)
+{
+	link_misses = 0;
+	link_escalated = false;
+	unchecked_uplinks = 0;
+}
+
+/**
+ * @brief Printout of the connection counters
+ */
+void log_link_stats(void)
+{
+	MYLOG("LINK", "Joins %lu, failed %lu, rejoins %lu, checks %lu, acks %lu, misses %lu, DR steps %lu, DR%d",
+		  (unsigned long)g_link_stats.joins, (unsigned long)g_link_stats.join_fails,
+		  (unsigned long)g_link_stats.rejoins, (unsigned long)g_link_stats.checks, (unsigned long)g_link_stats.acks,
+		  (unsigned long)g_link_stats.misses, (unsigned long)g_link_stats.dr_steps, link_dr);
+}
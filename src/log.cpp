@@ -0,0 +1,400 @@
+/**
+ * @file log.cpp
+ * @author agent (agent@local)
+ * @brief Ring and task of the deferred debug output. A record takes one
+ *        or more consecutive slots of the ring. Writers claim the slots
+ *        with a compare-and-swap on the head and publish the record with
+ *        the sequence of its first slot (bounded MPMC queue of D. Vyukov,
+ *        with one reader), so the application task, the timer callbacks
+ *        and interrupts can write without a lock. A full ring drops the
+ *        record. The log task has the lowest priority, the text is only
+ *        formatted and sent to the serial port and BLE when nothing else
+ *        has to run.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Counters of the ring */
+s_log_stats g_log_stats;
+
+/** First slot of a record */
+struct s_log_header
+{
+	const s_log_site *site;
+	uint32_t time;
+	uint8_t len;
+};
+
+#define LOG_RECORD_MAX (sizeof(s_log_header) + LOG_MAX_ARGS)
+
+static uint8_t log_data[LOG_RING_SLOTS * LOG_SLOT_SIZE];
+/** Sequence of every slot minus its index, so the zero initialized ring is empty
+ *  and records written before init_log() are kept */
+static uint32_t log_seq[LOG_RING_SLOTS];
+/** Next position to claim, moved by the writers */
+static uint32_t log_head = 0;
+/** Next position to read, moved by the log task only */
+static uint32_t log_tail = 0;
+/** Dropped records that were reported already */
+static uint32_t log_dropped_reported = 0;
+
+static SemaphoreHandle_t log_sem = NULL;
+
+/**
+ * @brief Sequence of a free slot for the writer of position pos
+ */
+static inline uint32_t slot_free_seq(uint32_t pos)
+{
+	return pos & ~(uint32_t)(LOG_RING_SLOTS - 1);
+}
+
+/**
+ * @brief Copy bytes into the ring at a byte offset, wrapping around its end
+ */
+static void ring_copy_in(uint32_t offset, const uint8_t *data, uint32_t len)
+{
+	offset %= sizeof(log_data);
+	uint32_t first = (len < sizeof(log_data) - offset) ? len : sizeof(log_data) - offset;
+	memcpy(&log_data[offset], data, first);
+	memcpy(log_data, data + first, len - first);
+}
+
+/**
+ * @brief Copy bytes out of the ring at a byte offset, wrapping around its end
+ */
+static void ring_copy_out(uint32_t offset, uint8_t *data, uint32_t len)
+{
+	offset %= sizeof(log_data);
+	uint32_t first = (len < sizeof(log_data) - offset) ? len : sizeof(log_data) - offset;
+	memcpy(data, &log_data[offset], first);
+	memcpy(data + first, log_data, len - first);
+}
+
+/**
+ * @brief Put a record into the ring and wake up the log task. Can be
+ *        called from interrupts.
+ *
+ * @param site call site
+ * @param args packed arguments
+ * @param len size of the packed arguments
+ */
+void log_write(const s_log_site *site, const uint8_t *args, uint8_t len)
+{
+	s_log_header header = {site, millis(), len};
+	uint32_t slots = (sizeof(header) + len + LOG_SLOT_SIZE - 1) / LOG_SLOT_SIZE;
+	uint32_t pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+	for (;;)
+	{
+		// The reader frees the slots in order, if the last one is free all of them are
+		uint32_t last = pos + slots - 1;
+		int32_t diff = (int32_t)(__atomic_load_n(&log_seq[last & (LOG_RING_SLOTS - 1)], __ATOMIC_ACQUIRE) - slot_free_seq(last));
+		if (diff == 0)
+		{
+			if (__atomic_compare_exchange_n(&log_head, &pos, pos + slots, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			__atomic_fetch_add(&g_log_stats.dropped, 1, __ATOMIC_RELAXED);
+			return;
+		}
+		else
+		{
+			pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+		}
+	}
+
+	ring_copy_in(pos * LOG_SLOT_SIZE, (const uint8_t *)&header, sizeof(header));
+	if (len != 0)
+	{
+		ring_copy_in(pos * LOG_SLOT_SIZE + sizeof(header), args, len);
+	}
+	// The reader only looks at the sequence of the first slot
+	__atomic_store_n(&log_seq[pos & (LOG_RING_SLOTS - 1)], slot_free_seq(pos) + 1, __ATOMIC_RELEASE);
+	__atomic_fetch_add(&g_log_stats.written, 1, __ATOMIC_RELAXED);
+	if (log_sem != NULL)
+	{
+		xSemaphoreGiveFromISR(log_sem, pdFALSE);
+	}
+}
+
+/**
+ * @brief Bytes as hex digits, with a table instead of sprintf()
+ *
+ * @param out 3 * len characters with separator, 2 * len + 1 without
+ * @param data bytes
+ * @param len number of bytes
+ * @param separator character between two bytes, 0 for none
+ * @return uint16_t length of the string
+ */
+uint16_t hex_string(char *out, const uint8_t *data, uint16_t len, char separator)
+{
+	static const char digits[] = "0123456789ABCDEF";
+	char *pos = out;
+	for (uint16_t idx = 0; idx < len; idx++)
+	{
+		if ((separator != 0) && (idx != 0))
+		{
+			*pos++ = separator;
+		}
+		*pos++ = digits[data[idx] >> 4];
+		*pos++ = digits[data[idx] & 0x0F];
+	}
+	*pos = 0;
+	return pos - out;
+}
+
+/**
+ * @brief Take the next record out of the ring
+ *
+ * @param record buffer of LOG_RECORD_MAX bytes
+ * @return true if there was a complete record
+ */
+static bool log_read(uint8_t *record)
+{
+	uint32_t pos = log_tail;
+	if (__atomic_load_n(&log_seq[pos & (LOG_RING_SLOTS - 1)], __ATOMIC_ACQUIRE) != slot_free_seq(pos) + 1)
+	{
+		return false;
+	}
+	s_log_header *header = (s_log_header *)record;
+	ring_copy_out(pos * LOG_SLOT_SIZE, record, sizeof(s_log_header));
+	ring_copy_out(pos * LOG_SLOT_SIZE + sizeof(s_log_header), record + sizeof(s_log_header), header->len);
+	uint32_t slots = (sizeof(s_log_header) + header->len + LOG_SLOT_SIZE - 1) / LOG_SLOT_SIZE;
+	for (uint32_t idx = 0; idx < slots; idx++)
+	{
+		__atomic_store_n(&log_seq[(pos + idx) & (LOG_RING_SLOTS - 1)], slot_free_seq(pos + idx) + LOG_RING_SLOTS, __ATOMIC_RELEASE);
+	}
+	log_tail = pos + slots;
+	return true;
+}
+
+/**
+ * @brief Format one converted argument into the line
+ *
+ * @param line output
+ * @param size room left in the line
+ * @param spec conversion without length modifier, e.g. "%-4" and 'd'
+ * @param conversion conversion character
+ * @param arg packed argument, NULL if there is none left
+ * @return int characters written
+ */
+static int log_format_arg(char *line, size_t size, char *spec, char conversion, const uint8_t *arg)
+{
+	size_t spec_len = strlen(spec);
+	uint32_t value32;
+	uint64_t value64;
+	double value_double;
+	char text[LOG_MAX_ARGS];
+	switch ((arg != NULL) ? arg[0] : 0)
+	{
+	case LOG_ARG_INT32:
+		memcpy(&value32, &arg[1], 4);
+		switch (conversion)
+		{
+		case 'd':
+		case 'i':
+			strcpy(&spec[spec_len], "l?");
+			spec[spec_len + 1] = conversion;
+			return snprintf(line, size, spec, (long)(int32_t)value32);
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			strcpy(&spec[spec_len], "l?");
+			spec[spec_len + 1] = conversion;
+			return snprintf(line, size, spec, (unsigned long)value32);
+		case 'c':
+			strcpy(&spec[spec_len], "c");
+			return snprintf(line, size, spec, (int)value32);
+		case 'p':
+			return snprintf(line, size, "0x%lx", (unsigned long)value32);
+		}
+		break;
+	case LOG_ARG_INT64:
+		memcpy(&value64, &arg[1], 8);
+		switch (conversion)
+		{
+		case 'd':
+		case 'i':
+			strcpy(&spec[spec_len], "ll?");
+			spec[spec_len + 2] = conversion;
+			return snprintf(line, size, spec, (long long)value64);
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			strcpy(&spec[spec_len], "ll?");
+			spec[spec_len + 2] = conversion;
+			return snprintf(line, size, spec, (unsigned long long)value64);
+		case 'p':
+			return snprintf(line, size, "0x%llx", (unsigned long long)value64);
+		}
+		break;
+	case LOG_ARG_DOUBLE:
+		memcpy(&value_double, &arg[1], 8);
+		if (strchr("fFeEgG", conversion) != NULL)
+		{
+			spec[spec_len] = conversion;
+			spec[spec_len + 1] = 0;
+			return snprintf(line, size, spec, value_double);
+		}
+		break;
+	case LOG_ARG_STRING:
+		if (conversion == 's')
+		{
+			memcpy(text, &arg[2], arg[1]);
+			text[arg[1]] = 0;
+			strcpy(&spec[spec_len], "s");
+			return snprintf(line, size, spec, text);
+		}
+		break;
+	}
+	// Missing argument or one that doesn't fit the conversion
+	return snprintf(line, size, "?");
+}
+
+/**
+ * @brief Size of a packed argument with its type
+ */
+static uint8_t log_arg_size(const uint8_t *arg)
+{
+	switch (arg[0])
+	{
+	case LOG_ARG_INT32:
+		return 5;
+	case LOG_ARG_STRING:
+		return 2 + arg[1];
+	default:
+		return 9;
+	}
+}
+
+/**
+ * @brief Format a record like printf() would have done at the call site
+ *
+ * @param line output
+ * @param size size of the output
+ * @param format format of the call site
+ * @param args packed arguments
+ * @param len size of the packed arguments
+ */
+static void log_format(char *line, size_t size, const char *format, const uint8_t *args, uint8_t len)
+{
+	size_t out = 0;
+	uint8_t pos = 0;
+	while ((*format != 0) && (out + 1 < size))
+	{
+		if ((*format != '%') || (format[1] == '%'))
+		{
+			line[out++] = *format;
+			format += (*format == '%') ? 2 : 1;
+			continue;
+		}
+		// Flags, width and precision are kept, the length comes from the packed type
+		char spec[16];
+		uint8_t spec_len = 0;
+		format++;
+		spec[spec_len++] = '%';
+		while ((*format != 0) && (strchr("-+ #0123456789.", *format) != NULL))
+		{
+			if (spec_len < sizeof(spec) - 4)
+			{
+				spec[spec_len++] = *format;
+			}
+			format++;
+		}
+		while ((*format != 0) && (strchr("hlzjtL", *format) != NULL))
+		{
+			format++;
+		}
+		if (*format == 0)
+		{
+			break;
+		}
+		spec[spec_len] = 0;
+		const uint8_t *arg = (pos < len) ? &args[pos] : NULL;
+		int written = log_format_arg(&line[out], size - out, spec, *format++, arg);
+		if (arg != NULL)
+		{
+			pos += log_arg_size(arg);
+		}
+		if (written > 0)
+		{
+			out += ((size_t)written < size - out) ? written : size - out - 1;
+		}
+	}
+	line[out] = 0;
+}
+
+/**
+ * @brief Print all records in the ring. Runs in the log task.
+ */
+void log_drain(void)
+{
+	uint8_t record[LOG_RECORD_MAX];
+	s_log_header *header = (s_log_header *)record;
+	while (log_read(record))
+	{
+		const uint8_t *args = record + sizeof(s_log_header);
+#if LOG_BINARY > 0
+		// ~ id time args in hex, tools/logdecode.py turns it back into text
+		char line[1 + 2 * (8 + LOG_MAX_ARGS) + 1];
+		sprintf(line, "~%08lX%08lX", (unsigned long)header->site->id, (unsigned long)header->time);
+		for (uint8_t idx = 0; idx < header->len; idx++)
+		{
+			sprintf(&line[17 + 2 * idx], "%02X", args[idx]);
+		}
+		PRINTF("%s\n", line);
+#else
+		char line[256];
+		log_format(line, sizeof(line), header->site->format, args, header->len);
+		PRINTF("[%s] %s\n", header->site->tag, line);
+		if (g_ble_uart_is_connected)
+		{
+			g_ble_uart.printf("[%s] %s\n", header->site->tag, line);
+		}
+#endif
+	}
+	uint32_t dropped = __atomic_load_n(&g_log_stats.dropped, __ATOMIC_RELAXED);
+	if (dropped != log_dropped_reported)
+	{
+		PRINTF("[LOG] %lu records lost, the ring was full\n", (unsigned long)(dropped - log_dropped_reported));
+		log_dropped_reported = dropped;
+	}
+}
+
+/**
+ * @brief The log task, it runs when all other tasks wait
+ */
+static void log_task(void *unused)
+{
+	(void)unused;
+	for (;;)
+	{
+		if (xSemaphoreTake(log_sem, portMAX_DELAY) == pdTRUE)
+		{
+			log_drain();
+		}
+	}
+}
+
+/**
+ * @brief Start the log task
+ */
+void init_log(void)
+{
+#if MY_DEBUG > 0
+	log_sem = xSemaphoreCreateBinary();
+	// Same priority as the idle task, it never delays the application
+	xTaskCreate(log_task, "LOG", LOG_TASK_STACK, NULL, TASK_PRIO_LOWEST, NULL);
+	// Records written before the task exists
+	xSemaphoreGive(log_sem);
+#endif
+}
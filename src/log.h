@@ -0,0 +1,268 @@
+/**
+ * @file log.h
+ * @author agent (agent@local)
+ * @brief Deferred debug output. MYLOG packs the arguments into a lock-free
+ *        ring together with a pointer to the constant descriptor of its
+ *        call site, the low priority log task formats and prints them
+ *        later. The levels of the tags are checked at compile time, a call
+ *        site below its level leaves no code.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+
+/** Log levels */
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_DEBUG 2
+
+/** Level of the tags without an own level */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+/** Level per tag, e.g. -DLOG_LEVEL_ACC=2 for the debug output of the accelerometer */
+#ifndef LOG_LEVEL_ACC
+#define LOG_LEVEL_ACC LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_APP
+#define LOG_LEVEL_APP LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_AT
+#define LOG_LEVEL_AT LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_DELTA
+#define LOG_LEVEL_DELTA LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_EPD
+#define LOG_LEVEL_EPD LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_EVQ
+#define LOG_LEVEL_EVQ LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_FRAG
+#define LOG_LEVEL_FRAG LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_GEST
+#define LOG_LEVEL_GEST LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LINK
+#define LOG_LEVEL_LINK LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_UPQ
+#define LOG_LEVEL_UPQ LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_USER_FLASH_DATA
+#define LOG_LEVEL_USER_FLASH_DATA LOG_LEVEL
+#endif
+
+/** 1 prints the records as hex lines for tools/logdecode.py instead of text */
+#ifndef LOG_BINARY
+#define LOG_BINARY 0
+#endif
+/** Ring slots, a power of 2 */
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS 128
+#endif
+#define LOG_SLOT_SIZE 16
+/** Packed arguments of one record, longer strings are cut */
+#ifndef LOG_MAX_ARGS
+#define LOG_MAX_ARGS 96
+#endif
+/** Bytes per line of a hex dump */
+#define LOG_HEX_BYTES 16
+/** Stack of the log task in words */
+#ifndef LOG_TASK_STACK
+#define LOG_TASK_STACK 1024
+#endif
+
+/** Types of the packed arguments, the format string tells how they are printed */
+#define LOG_ARG_INT32 1
+#define LOG_ARG_INT64 2
+#define LOG_ARG_DOUBLE 3
+#define LOG_ARG_STRING 4
+
+/** Constant descriptor of a call site */
+struct s_log_site
+{
+	/** FNV-1a of tag, a 0 byte and the format, tools/logdecode.py finds the format with it */
+	uint32_t id;
+	const char *tag;
+	const char *format;
+};
+
+struct s_log_stats
+{
+	uint32_t written;
+	uint32_t dropped;
+};
+extern s_log_stats g_log_stats;
+
+void init_log(void);
+void log_drain(void);
+void log_write(const s_log_site *site, const uint8_t *args, uint8_t len);
+uint16_t hex_string(char *out, const uint8_t *data, uint16_t len, char separator);
+
+constexpr uint32_t log_fnv(const char *str, uint32_t hash)
+{
+	return (*str == 0) ? hash : log_fnv(str + 1, (uint32_t)((hash ^ (uint8_t)*str) * 16777619UL));
+}
+
+constexpr uint32_t log_id(const char *tag, const char *format)
+{
+	return log_fnv(format, (uint32_t)(log_fnv(tag, 2166136261UL) * 16777619UL));
+}
+
+constexpr bool log_tag_is(const char *tag, const char *name)
+{
+	return (*tag == *name) && ((*tag == 0) || log_tag_is(tag + 1, name + 1));
+}
+
+constexpr uint8_t log_tag_level(const char *tag)
+{
+	return log_tag_is(tag, "ACC") ? LOG_LEVEL_ACC
+		   : log_tag_is(tag, "APP") ? LOG_LEVEL_APP
+		   : log_tag_is(tag, "AT") ? LOG_LEVEL_AT
+		   : log_tag_is(tag, "DELTA") ? LOG_LEVEL_DELTA
+		   : log_tag_is(tag, "EPD") ? LOG_LEVEL_EPD
+		   : log_tag_is(tag, "EVQ") ? LOG_LEVEL_EVQ
+		   : log_tag_is(tag, "FRAG") ? LOG_LEVEL_FRAG
+		   : log_tag_is(tag, "GEST") ? LOG_LEVEL_GEST
+		   : log_tag_is(tag, "LINK") ? LOG_LEVEL_LINK
+		   : log_tag_is(tag, "UPQ") ? LOG_LEVEL_UPQ
+		   : log_tag_is(tag, "USER_FLASH_DATA") ? LOG_LEVEL_USER_FLASH_DATA
+		   : LOG_LEVEL;
+}
+
+/** Write position in the argument buffer of a call site */
+struct s_log_packer
+{
+	uint8_t *pos;
+	uint8_t *end;
+};
+
+inline void log_pack_int(s_log_packer &packer, uint64_t value, uint8_t size)
+{
+	if (packer.end - packer.pos < 1 + size)
+	{
+		// No room, the following arguments are left out as well
+		packer.end = packer.pos;
+		return;
+	}
+	*packer.pos++ = (size == 8) ? LOG_ARG_INT64 : LOG_ARG_INT32;
+	// Little endian on the nRF52 and on the host
+	memcpy(packer.pos, &value, size);
+	packer.pos += size;
+}
+
+inline void log_pack(s_log_packer &packer, bool value) { log_pack_int(packer, value, 4); }
+inline void log_pack(s_log_packer &packer, char value) { log_pack_int(packer, (int32_t)value, 4); }
+inline void log_pack(s_log_packer &packer, signed char value) { log_pack_int(packer, (int32_t)value, 4); }
+inline void log_pack(s_log_packer &packer, unsigned char value) { log_pack_int(packer, value, 4); }
+inline void log_pack(s_log_packer &packer, short value) { log_pack_int(packer, (int32_t)value, 4); }
+inline void log_pack(s_log_packer &packer, unsigned short value) { log_pack_int(packer, value, 4); }
+inline void log_pack(s_log_packer &packer, int value) { log_pack_int(packer, (uint32_t)value, 4); }
+inline void log_pack(s_log_packer &packer, unsigned int value) { log_pack_int(packer, value, 4); }
+inline void log_pack(s_log_packer &packer, long value) { log_pack_int(packer, (uint64_t)value, sizeof(value)); }
+inline void log_pack(s_log_packer &packer, unsigned long value) { log_pack_int(packer, value, sizeof(value)); }
+inline void log_pack(s_log_packer &packer, long long value) { log_pack_int(packer, (uint64_t)value, 8); }
+inline void log_pack(s_log_packer &packer, unsigned long long value) { log_pack_int(packer, value, 8); }
+inline void log_pack(s_log_packer &packer, const void *value) { log_pack_int(packer, (uintptr_t)value, 8); }
+
+inline void log_pack(s_log_packer &packer, double value)
+{
+	if (packer.end - packer.pos < 1 + (int)sizeof(value))
+	{
+		packer.end = packer.pos;
+		return;
+	}
+	*packer.pos++ = LOG_ARG_DOUBLE;
+	memcpy(packer.pos, &value, sizeof(value));
+	packer.pos += sizeof(value);
+}
+
+/**
+ * @brief Strings are copied, the caller's buffer may be gone when the
+ *        record is printed. A long string is cut, it leaves room for
+ *        the arguments after it.
+ *
+ * @param reserve room for the following arguments
+ */
+inline void log_pack(s_log_packer &packer, const char *value, size_t reserve = 0)
+{
+	if (packer.end - packer.pos < 2)
+	{
+		packer.end = packer.pos;
+		return;
+	}
+	size_t room = packer.end - packer.pos - 2;
+	room = (room > reserve) ? room - reserve : 0;
+	size_t len = 0;
+	while ((value != NULL) && (len < room) && (value[len] != 0))
+	{
+		len++;
+	}
+	*packer.pos++ = LOG_ARG_STRING;
+	*packer.pos++ = len;
+	if (len != 0)
+	{
+		memcpy(packer.pos, value, len);
+		packer.pos += len;
+	}
+}
+inline void log_pack(s_log_packer &packer, char *value, size_t reserve = 0) { log_pack(packer, (const char *)value, reserve); }
+
+/** Only strings use the room that is left for the following arguments */
+template <typename T>
+inline void log_pack_arg(s_log_packer &packer, T value, size_t reserve)
+{
+	(void)reserve;
+	log_pack(packer, value);
+}
+inline void log_pack_arg(s_log_packer &packer, const char *value, size_t reserve) { log_pack(packer, value, reserve); }
+inline void log_pack_arg(s_log_packer &packer, char *value, size_t reserve) { log_pack(packer, value, reserve); }
+
+inline void log_pack_args(s_log_packer &packer) { (void)packer; }
+
+template <typename T, typename... Args>
+inline void log_pack_args(s_log_packer &packer, T value, Args... args)
+{
+	// Numbers take up to 9 bytes
+	log_pack_arg(packer, value, 9 * sizeof...(args));
+	log_pack_args(packer, args...);
+}
+
+inline void log_record(const s_log_site *site) { log_write(site, NULL, 0); }
+
+template <typename... Args>
+inline void log_record(const s_log_site *site, Args... args)
+{
+	uint8_t buffer[LOG_MAX_ARGS];
+	s_log_packer packer = {buffer, buffer + sizeof(buffer)};
+	log_pack_args(packer, args...);
+	log_write(site, buffer, packer.pos - buffer);
+}
+
+/** Never called, lets the compiler check the arguments against the format */
+inline void log_check_format(const char *format, ...) __attribute__((format(printf, 1, 2)));
+inline void log_check_format(const char *format, ...) { (void)format; }
+
+#define LOG_AT(level, tag, format, ...)                                             \
+	do                                                                              \
+	{                                                                               \
+		if (log_tag_level(tag) >= (level))                                          \
+		{                                                                           \
+			static constexpr s_log_site log_site = {log_id(tag, format), tag, format}; \
+			if (false)                                                              \
+				log_check_format(format, ##__VA_ARGS__);                            \
+			log_record(&log_site, ##__VA_ARGS__);                                   \
+		}                                                                           \
+	} while (0)
+
+#endif
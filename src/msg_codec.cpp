@@ -0,0 +1,279 @@
+/**
+ * @file msg_codec.cpp
+ * @author agent (agent@local)
+ * @brief Packed 6 bit message codec. Lower case text, digits and common
+ *        punctuation take 6 bits per character, runs of padding spaces and
+ *        words of the static dictionary 12 bits. Typical messages shrink
+ *        to about half, so they fit into one downlink at low data rates.
+ *        tools/msgcodec.py encodes the same format on the host.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "msg_codec.h"
+#include "msg_codec_tables.h"
+
+#define CODE_SHIFT 60
+#define CODE_RUN 61
+#define CODE_DICT 62
+#define CODE_RAW 63
+#define RUN_MIN 3
+#define RUN_MAX (RUN_MIN + 63)
+
+static const char msg_charset[] = MSG_CODEC_CHARSET;
+#define CHARSET_NUM (sizeof(msg_charset) - 1)
+
+static const char *const msg_dictionary[] = {MSG_CODEC_DICTIONARY};
+#define DICTIONARY_NUM (sizeof(msg_dictionary) / sizeof(msg_dictionary[0]))
+
+/** Bit stream writer, stops at the end of the buffer */
+struct s_bit_writer
+{
+	uint8_t *dst;
+	uint16_t size;
+	uint16_t pos;
+	uint32_t acc;
+	uint8_t bits;
+	bool overflow;
+};
+
+static void put_bits(s_bit_writer &out, uint32_t value, uint8_t bits)
+{
+	out.acc = (out.acc << bits) | value;
+	out.bits += bits;
+	while (out.bits >= 8)
+	{
+		out.bits -= 8;
+		if (out.pos >= out.size)
+		{
+			out.overflow = true;
+			return;
+		}
+		out.dst[out.pos++] = (out.acc >> out.bits) & 0xFF;
+	}
+}
+
+/**
+ * @brief Code of a character in the charset
+ * @return int8_t 0 to 59, -1 if it is not in the charset
+ */
+static int8_t charset_code(char ch)
+{
+	if (ch == 0)
+	{
+		return -1;
+	}
+	const char *found = (const char *)memchr(msg_charset, ch, CHARSET_NUM);
+	return (found == NULL) ? -1 : found - msg_charset;
+}
+
+/**
+ * @brief Bits a character takes without the dictionary
+ */
+static uint8_t char_cost(char ch)
+{
+	if (charset_code(ch) >= 0)
+	{
+		return 6;
+	}
+	if ((ch >= 'A') && (ch <= 'Z'))
+	{
+		return 12;
+	}
+	return 14;
+}
+
+/**
+ * @brief Encode a message
+ *
+ * @param text message, does not need a terminator
+ * @param len length of text
+ * @param dst buffer for the stream, MSG_CODEC_MAX_SIZE(len) always fits
+ * @param dst_size size of dst
+ * @param use_dict true to use the static dictionary
+ * @return uint16_t stream size, 0 if dst is too small
+ */
+uint16_t msg_encode(const char *text, uint16_t len, uint8_t *dst, uint16_t dst_size, bool use_dict)
+{
+	s_bit_writer out = {dst, dst_size, 0, 0, 0, false};
+	put_bits(out, (MSG_CODEC_VERSION << 4) | (use_dict ? MSG_CODEC_FLAG_DICT : 0), 8);
+
+	uint16_t pos = 0;
+	while ((pos < len) && !out.overflow)
+	{
+		char ch = text[pos];
+		if (ch == ' ')
+		{
+			uint16_t run = 1;
+			while ((pos + run < len) && (text[pos + run] == ' ') && (run < RUN_MAX))
+			{
+				run++;
+			}
+			if (run >= RUN_MIN)
+			{
+				put_bits(out, CODE_RUN, 6);
+				put_bits(out, run - RUN_MIN, 6);
+				pos += run;
+				continue;
+			}
+		}
+
+		if (use_dict)
+		{
+			// Entry that saves the most bits at this position
+			int8_t best = -1;
+			int16_t best_saving = 0;
+			for (uint8_t idx = 0; idx < DICTIONARY_NUM; idx++)
+			{
+				uint16_t entry_len = strlen(msg_dictionary[idx]);
+				if ((entry_len > len - pos) || (memcmp(&text[pos], msg_dictionary[idx], entry_len) != 0))
+				{
+					continue;
+				}
+				int16_t saving = -12;
+				for (uint16_t chr = 0; chr < entry_len; chr++)
+				{
+					saving += char_cost(msg_dictionary[idx][chr]);
+				}
+				if (saving > best_saving)
+				{
+					best = idx;
+					best_saving = saving;
+				}
+			}
+			if (best >= 0)
+			{
+				put_bits(out, CODE_DICT, 6);
+				put_bits(out, best, 6);
+				pos += strlen(msg_dictionary[best]);
+				continue;
+			}
+		}
+
+		int8_t code = charset_code(ch);
+		if (code >= 0)
+		{
+			put_bits(out, code, 6);
+		}
+		else if ((ch >= 'A') && (ch <= 'Z'))
+		{
+			put_bits(out, CODE_SHIFT, 6);
+			put_bits(out, charset_code(ch + 0x20), 6);
+		}
+		else
+		{
+			put_bits(out, CODE_RAW, 6);
+			put_bits(out, (uint8_t)ch, 8);
+		}
+		pos++;
+	}
+
+	// Padding with ones reads as an incomplete raw byte
+	if (out.bits != 0)
+	{
+		put_bits(out, (1 << (8 - out.bits)) - 1, 8 - out.bits);
+	}
+	return out.overflow ? 0 : out.pos;
+}
+
+/**
+ * @brief Decode a message
+ *
+ * @param src stream including the header byte
+ * @param src_len size of src
+ * @param dst buffer for the text, it gets a terminator
+ * @param dst_size size of dst
+ * @return int16_t length of the text, -1 if the stream is damaged or too long
+ */
+int16_t msg_decode(const uint8_t *src, uint16_t src_len, char *dst, uint16_t dst_size)
+{
+	if ((src_len == 0) || (dst_size == 0) || ((src[0] >> 4) != MSG_CODEC_VERSION))
+	{
+		return -1;
+	}
+	bool use_dict = (src[0] & MSG_CODEC_FLAG_DICT) != 0;
+	uint32_t total_bits = (uint32_t)(src_len - 1) * 8;
+	uint32_t bit_pos = 0;
+	uint16_t out = 0;
+
+	// Reads MSB first from src[1]
+	auto take = [&](uint8_t bits, uint16_t &value) -> bool {
+		if (bit_pos + bits > total_bits)
+		{
+			return false;
+		}
+		value = 0;
+		for (uint8_t bit = 0; bit < bits; bit++, bit_pos++)
+		{
+			value = (value << 1) | ((src[1 + bit_pos / 8] >> (7 - bit_pos % 8)) & 0x01);
+		}
+		return true;
+	};
+
+	uint16_t code;
+	while (take(6, code))
+	{
+		const char *copy = NULL;
+		uint16_t copy_len = 1;
+		char single;
+		if (code < CHARSET_NUM)
+		{
+			single = msg_charset[code];
+			copy = &single;
+		}
+		else
+		{
+			uint16_t arg;
+			if (!take((code == CODE_RAW) ? 8 : 6, arg))
+			{
+				// Padding
+				break;
+			}
+			switch (code)
+			{
+			case CODE_SHIFT:
+				if ((arg < 1) || (arg > 26))
+				{
+					return -1;
+				}
+				single = msg_charset[arg] - 0x20;
+				copy = &single;
+				break;
+			case CODE_RUN:
+				copy = NULL;
+				copy_len = arg + RUN_MIN;
+				break;
+			case CODE_DICT:
+				if (!use_dict || (arg >= DICTIONARY_NUM))
+				{
+					return -1;
+				}
+				copy = msg_dictionary[arg];
+				copy_len = strlen(copy);
+				break;
+			default:
+				single = (char)arg;
+				copy = &single;
+				break;
+			}
+		}
+		// Keep room for the terminator
+		if (out + copy_len >= dst_size)
+		{
+			return -1;
+		}
+		if (copy == NULL)
+		{
+			memset(&dst[out], ' ', copy_len);
+		}
+		else
+		{
+			memcpy(&dst[out], copy, copy_len);
+		}
+		out += copy_len;
+	}
+	dst[out] = 0;
+	return out;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file msg_codec.h
+ * @author agent (agent@local)
+ * @brief Packed 6 bit message codec for downlinks and the user data log
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MSG_CODEC_H
+#define MSG_CODEC_H
+
+#include <Arduino.h>
+
+/**
+ * Stream is a header byte (version << 4 | flags) and a MSB first bit stream
+ * of 6 bit codes:
+ *   0..59  character of MSG_CODEC_CHARSET
+ *   60     next code is a lower case letter sent as upper case
+ *   61     next 6 bits are a run of 3 to 66 spaces
+ *   62     next 6 bits are an entry of MSG_CODEC_DICTIONARY
+ *   63     next 8 bits are a raw byte
+ * The last byte is padded with ones, an incomplete code ends the stream.
+ */
+#define MSG_CODEC_VERSION 1
+#define MSG_CODEC_FLAG_DICT 0x01
+
+/** First byte of a compressed message downlink, followed by the slot and the stream */
+#define MSG_CODEC_DOWNLINK 0xE0
+
+/** Worst case stream size of len bytes, 14 bits per raw byte */
+#define MSG_CODEC_MAX_SIZE(len) (1 + ((len) * 14 + 7) / 8)
+
+uint16_t msg_encode(const char *text, uint16_t len, uint8_t *dst, uint16_t dst_size, bool use_dict);
+int16_t msg_decode(const uint8_t *src, uint16_t src_len, char *dst, uint16_t dst_size);
+
+#endif
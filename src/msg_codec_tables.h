@@ -0,0 +1,88 @@
+/**
+ * @file msg_codec_tables.h
+ * @author agent (agent@local)
+ * @brief Tables of the message codec. tools/msgcodec.py reads them from
+ *        this file, both sides always use the same tables. Entries are
+ *        only appended, changing one needs a new MSG_CODEC_VERSION.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MSG_CODEC_TABLES_H
+#define MSG_CODEC_TABLES_H
+
+/** Characters of the 6 bit codes 0 to 59 */
+#define MSG_CODEC_CHARSET " abcdefghijklmnopqrstuvwxyz0123456789.,!?'\"-:;()/&*#+=<>{}@\n"
+
+/** Static dictionary, up to 64 entries of 2 or more characters. An entry
+ *  takes 12 bits, shorter ones only pay off with capitals, "I " is 18
+ *  bits as SHIFT, i and space */
+#define MSG_CODEC_DICTIONARY \
+	" you",                  \
+	" love",                 \
+	"I ",                    \
+	" the ",                 \
+	" and ",                 \
+	" am ",                  \
+	" thinking",             \
+	" about",                \
+	"ing ",                  \
+	"Love",                  \
+	" me",                   \
+	" my ",                  \
+	"Hello",                 \
+	" to ",                  \
+	" is ",                  \
+	" of ",                  \
+	" with",                 \
+	" when",                 \
+	"What",                  \
+	" miss",                 \
+	" always",               \
+	" forever",              \
+	" heart",                \
+	"Happy",                 \
+	" birthday",             \
+	" your",                 \
+	" smile",                \
+	" beautiful",            \
+	" today",                \
+	" are ",                 \
+	" will ",                \
+	" not ",                 \
+	"tion",                  \
+	" for ",                 \
+	" be ",                  \
+	" all ",                 \
+	" can ",                 \
+	" think",                \
+	" because",              \
+	" know",                 \
+	" have ",                \
+	"Good",                  \
+	" morning",              \
+	" night",                \
+	"While",                 \
+	" (true)",               \
+	"Even",                  \
+	" together",             \
+	" dream",                \
+	" we ",                  \
+	" world",                \
+	"IoT",                   \
+	"LoRa",                  \
+	"RAK",                   \
+	"WisBlock",              \
+	" Made Easy",            \
+	" kiss",                 \
+	" hug",                  \
+	" sweet",                \
+	" here",                 \
+	" what",                 \
+	"you",                   \
+	"love",                  \
+	" it "
+
+#endif
@@ -0,0 +1,479 @@
+/**
+ * @file msg_image.cpp
+ * @author agent (agent@local)
+ * @brief 1bpp images in the message slots, uploaded at runtime over LoRa
+ *        or with AT commands over BLE and serial. An image is stored as
+ *        made by tools/imgconv.py, compressed, in its own file of the
+ *        internal file system next to the user data log. A slot with an
+ *        image shows it instead of its text, a new text removes it.
+ *        The upload is written to USER_IMG_NEW piece by piece, only the
+ *        piece that arrived is in RAM. The file survives a reset, an
+ *        upload continues at the offset reported by the status. Once all
+ *        bytes are there the CRC32 is checked on what is in the flash and
+ *        the file replaces the image of the slot, also at boot if the
+ *        reset came right after the last piece.
+ *        The image is drawn straight from its file through IMG_READ_SIZE
+ *        bytes of buffer.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+#include "crc.h"
+#include "epd_panel.h"
+
+#include <Adafruit_LittleFS.h>
+#include <InternalFileSystem.h>
+using namespace Adafruit_LittleFS_Namespace;
+
+/** Upload in progress, it becomes USER_IMG_<slot> when it is complete */
+static const char image_new_name[] = "USER_IMG_NEW";
+
+/** Largest compressed image, a full frame that did not compress at all */
+#define IMG_MAX_SIZE RLE_MAX_SIZE(epd_panel::frame_size)
+static_assert(IMG_MAX_SIZE <= 0xFFFF, "Image size has to fit the 16 bit offsets of the upload");
+
+/** Header of an image file, followed by size bytes of the compressed image */
+struct __attribute__((packed)) s_image_header
+{
+	uint8_t mark_1;	 // 0xBA
+	uint8_t mark_2;	 // MY_APP_DATA_MARKER
+	uint8_t slot;	 // Message 1 to MSG_SLOTS
+	uint8_t reserved;
+	uint16_t width;
+	uint16_t height;
+	uint32_t size;
+	uint32_t crc;
+};
+
+/** Image of every slot, size 0 if the slot shows its text */
+static s_image_header slot_image[MSG_SLOTS];
+
+/** Upload that is written to USER_IMG_NEW */
+static s_image_header upload;
+static uint16_t upload_offset = 0;
+static uint8_t upload_state = IMG_STATE_IDLE;
+
+/** Image that is drawn, one at a time, and the upload */
+static File image_file(InternalFS);
+static File upload_file(InternalFS);
+
+/**
+ * @brief Name of the image file of a slot
+ */
+static void image_name(uint8_t slot, char *name, size_t name_size)
+{
+	snprintf(name, name_size, "USER_IMG_%d", slot);
+}
+
+/**
+ * @brief Check a header against the slots and the panel
+ *
+ * @param header read from a file or from an upload
+ * @return true if the image can be drawn
+ */
+static bool header_valid(const s_image_header &header)
+{
+	return (header.mark_1 == 0xBA) && (header.mark_2 == MY_APP_DATA_MARKER) &&
+		   (header.slot != 0) && (header.slot <= MSG_SLOTS) &&
+		   (header.width != 0) && (header.width <= epd_panel::width) &&
+		   (header.height != 0) && (header.height <= epd_panel::height) &&
+		   (header.size != 0) && (header.size <= IMG_MAX_SIZE);
+}
+
+/**
+ * @brief Read the header of an image file
+ *
+ * @param file opened file, positioned at the start
+ * @param header receives the header
+ * @return true if the header is valid
+ */
+static bool read_header(File &file, s_image_header *header)
+{
+	return (file.read(header, sizeof(*header)) == sizeof(*header)) && header_valid(*header);
+}
+
+/**
+ * @brief Check the CRC32 of the complete upload in the flash and make it
+ *        the image of its slot
+ *
+ * @return true if the image is stored
+ */
+static bool finish_upload(void)
+{
+	if (!upload_file.open(image_new_name, FILE_O_READ) || !upload_file.seek(sizeof(upload)))
+	{
+		return false;
+	}
+	uint8_t buf[IMG_READ_SIZE];
+	uint32_t crc = CRC32_INIT;
+	int read;
+	while ((read = upload_file.read(buf, sizeof(buf))) > 0)
+	{
+		crc = crc32_update(crc, buf, read);
+	}
+	upload_file.close();
+	if (crc != upload.crc)
+	{
+		MYLOG("IMG", "Upload for message %d has CRC %08lX instead of %08lX", upload.slot, (unsigned long)crc,
+			  (unsigned long)upload.crc);
+		InternalFS.remove(image_new_name);
+		return false;
+	}
+
+	char name[16];
+	image_name(upload.slot, name, sizeof(name));
+	InternalFS.remove(name);
+	if (!InternalFS.rename(image_new_name, name))
+	{
+		return false;
+	}
+	slot_image[upload.slot - 1] = upload;
+	epd_cache_invalidate(upload.slot);
+	MYLOG("IMG", "Message %d has a new %dx%d image", upload.slot, upload.width, upload.height);
+	return true;
+}
+
+/**
+ * @brief Find the stored images and an upload that was interrupted
+ */
+void init_message_images(void)
+{
+	char name[16];
+	memset(slot_image, 0, sizeof(slot_image));
+	for (uint8_t slot = 1; slot <= MSG_SLOTS; slot++)
+	{
+		image_name(slot, name, sizeof(name));
+		if (!image_file.open(name, FILE_O_READ))
+		{
+			continue;
+		}
+		s_image_header header;
+		if (read_header(image_file, &header) && (header.slot == slot) &&
+			(image_file.size() == sizeof(header) + header.size))
+		{
+			slot_image[slot - 1] = header;
+			MYLOG("IMG", "Message %d has a %dx%d image of %lu bytes", slot, header.width, header.height,
+				  (unsigned long)header.size);
+		}
+		else
+		{
+			MYLOG("IMG", "Image of message %d is damaged", slot);
+		}
+		image_file.close();
+	}
+
+	// What arrived before the reset is kept, the upload goes on from there
+	upload_state = IMG_STATE_IDLE;
+	if (upload_file.open(image_new_name, FILE_O_READ))
+	{
+		uint32_t file_size = upload_file.size();
+		bool valid = read_header(upload_file, &upload) && (file_size <= sizeof(upload) + upload.size);
+		upload_file.close();
+		if (valid)
+		{
+			upload_offset = file_size - sizeof(upload);
+			if (upload_offset == upload.size)
+			{
+				// The reset came between the last piece and the check
+				MYLOG("IMG", "Upload for message %d was complete", upload.slot);
+				upload_state = finish_upload() ? IMG_STATE_DONE : IMG_STATE_FAILED;
+			}
+			else
+			{
+				upload_state = IMG_STATE_RECEIVING;
+				MYLOG("IMG", "Upload for message %d continues at %d of %lu bytes", upload.slot, upload_offset,
+					  (unsigned long)upload.size);
+			}
+		}
+		else
+		{
+			InternalFS.remove(image_new_name);
+		}
+	}
+}
+
+/**
+ * @brief Check if a slot shows an image
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param width receives the width of the image, can be NULL
+ * @param height receives the height of the image, can be NULL
+ * @return true if the slot has an image
+ */
+bool message_image(uint8_t slot, uint16_t *width, uint16_t *height)
+{
+	if ((slot == 0) || (slot > MSG_SLOTS) || (slot_image[slot - 1].size == 0))
+	{
+		return false;
+	}
+	if (width != NULL)
+	{
+		*width = slot_image[slot - 1].width;
+	}
+	if (height != NULL)
+	{
+		*height = slot_image[slot - 1].height;
+	}
+	return true;
+}
+
+/**
+ * @brief Delete the image of a slot, it shows its text again
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @return true if the slot had an image
+ */
+bool remove_message_image(uint8_t slot)
+{
+	if (!message_image(slot, NULL, NULL))
+	{
+		return false;
+	}
+	char name[16];
+	image_name(slot, name, sizeof(name));
+	InternalFS.remove(name);
+	slot_image[slot - 1].size = 0;
+	epd_cache_invalidate(slot);
+	MYLOG("IMG", "Image of message %d removed", slot);
+	return true;
+}
+
+/**
+ * @brief Read the next piece of the opened image
+ */
+static uint16_t read_image_file(void *ctx, uint8_t *buf, uint16_t size)
+{
+	File *file = (File *)ctx;
+	int read = file->read(buf, size);
+	return (read > 0) ? read : 0;
+}
+
+/**
+ * @brief Open the image of a slot for drawing, close it afterwards with
+ *        close_message_image()
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param stream receives a decoder that reads the file
+ * @param buf buffer for the file data
+ * @param buf_size size of buf
+ * @return true if the image is open
+ */
+bool open_message_image(uint8_t slot, s_rle_stream *stream, uint8_t *buf, uint16_t buf_size)
+{
+	if (!message_image(slot, NULL, NULL))
+	{
+		return false;
+	}
+	char name[16];
+	image_name(slot, name, sizeof(name));
+	if (!image_file.open(name, FILE_O_READ))
+	{
+		return false;
+	}
+	if (!image_file.seek(sizeof(s_image_header)))
+	{
+		image_file.close();
+		return false;
+	}
+	rle_stream_begin_read(stream, read_image_file, &image_file, buf, buf_size);
+	return true;
+}
+
+/**
+ * @brief The image is drawn
+ */
+void close_message_image(void)
+{
+	image_file.close();
+}
+
+/**
+ * @brief Start an upload or continue the one with the same image
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param width width of the image, up to the panel width
+ * @param height height of the image, up to the panel height
+ * @param size size of the compressed image
+ * @param crc CRC32 of the compressed image
+ * @return true if the upload is ready for its pieces
+ */
+bool image_upload_begin(uint8_t slot, uint16_t width, uint16_t height, uint16_t size, uint32_t crc)
+{
+	s_image_header header = {0xBA, MY_APP_DATA_MARKER, slot, 0, width, height, size, crc};
+	if (!header_valid(header))
+	{
+		MYLOG("IMG", "Upload of a %dx%d image with %d bytes for message %d rejected", width, height, size, slot);
+		upload_state = IMG_STATE_FAILED;
+		return false;
+	}
+	if ((upload_state == IMG_STATE_RECEIVING) && (memcmp(&header, &upload, sizeof(header)) == 0))
+	{
+		MYLOG("IMG", "Upload for message %d resumed at %d of %d bytes", slot, upload_offset, size);
+		return true;
+	}
+	if (memcmp(&header, &slot_image[slot - 1], sizeof(header)) == 0)
+	{
+		// The status got lost after the upload was complete
+		MYLOG("IMG", "Message %d already has this image", slot);
+		upload = header;
+		upload_offset = size;
+		upload_state = IMG_STATE_DONE;
+		return true;
+	}
+
+	// A different image replaces the unfinished upload
+	InternalFS.remove(image_new_name);
+	upload = header;
+	upload_offset = 0;
+	upload_state = IMG_STATE_FAILED;
+	if (!upload_file.open(image_new_name, FILE_O_WRITE))
+	{
+		return false;
+	}
+	bool written = upload_file.write((uint8_t *)&upload, sizeof(upload)) == sizeof(upload);
+	upload_file.close();
+	if (!written)
+	{
+		InternalFS.remove(image_new_name);
+		return false;
+	}
+	upload_state = IMG_STATE_RECEIVING;
+	MYLOG("IMG", "Upload of a %dx%d image with %d bytes for message %d", width, height, size, slot);
+	return true;
+}
+
+/**
+ * @brief Add a piece to the upload. Pieces must come in order, a piece
+ *        that was already written is skipped and one behind a gap is
+ *        dropped, the status tells where the upload continues.
+ *
+ * @param offset position of the piece in the compressed image
+ * @param data bytes of the piece
+ * @param len size of data
+ * @return uint8_t IMG_STATE_xxx after the piece
+ */
+uint8_t image_upload_chunk(uint16_t offset, const uint8_t *data, uint16_t len)
+{
+	if (upload_state != IMG_STATE_RECEIVING)
+	{
+		return upload_state;
+	}
+	if (((uint32_t)offset + len) > upload.size)
+	{
+		MYLOG("IMG", "Piece at %d with %d bytes is behind the end", offset, len);
+		return upload_state;
+	}
+	if ((offset > upload_offset) || (((uint32_t)offset + len) <= upload_offset))
+	{
+		MYLOG("IMG", "Piece at %d, expected %d", offset, upload_offset);
+		return upload_state;
+	}
+
+	// Only the part that is new, a repeated piece may overlap
+	uint16_t skip = upload_offset - offset;
+	if (!upload_file.open(image_new_name, FILE_O_WRITE))
+	{
+		return upload_state;
+	}
+	uint16_t written = upload_file.write(&data[skip], len - skip);
+	upload_file.close();
+	if (written != (len - skip))
+	{
+		// Drop the partial piece, it comes again
+		if (upload_file.open(image_new_name, FILE_O_WRITE))
+		{
+			upload_file.truncate(sizeof(upload) + upload_offset);
+			upload_file.close();
+		}
+		return upload_state;
+	}
+	upload_offset += written;
+
+	if (upload_offset == upload.size)
+	{
+		upload_state = finish_upload() ? IMG_STATE_DONE : IMG_STATE_FAILED;
+	}
+	return upload_state;
+}
+
+/**
+ * @brief State of the upload
+ *
+ * @param slot receives the slot of the upload
+ * @param offset receives the offset the upload continues at
+ * @param size receives the size of the compressed image
+ * @return uint8_t IMG_STATE_xxx
+ */
+uint8_t image_upload_state(uint8_t *slot, uint16_t *offset, uint16_t *size)
+{
+	*slot = upload.slot;
+	*offset = upload_offset;
+	*size = upload.size;
+	return upload_state;
+}
+
+/**
+ * @brief Handle an upload downlink. Every one is answered with the status.
+ *
+ * @param data downlink starting with IMG_BEGIN_DOWNLINK or IMG_CHUNK_DOWNLINK
+ * @param len size of data
+ * @return uint8_t slot with the new image, 0 if no upload was finished
+ */
+uint8_t apply_image_downlink(const uint8_t *data, uint16_t len)
+{
+	uint8_t done = 0;
+	if ((data[0] == IMG_BEGIN_DOWNLINK) && (len == IMG_BEGIN_SIZE))
+	{
+		uint32_t crc = ((uint32_t)data[8] << 24) | ((uint32_t)data[9] << 16) | (data[10] << 8) | data[11];
+		image_upload_begin(data[1], (data[2] << 8) | data[3], (data[4] << 8) | data[5], (data[6] << 8) | data[7], crc);
+	}
+	else if ((data[0] == IMG_CHUNK_DOWNLINK) && (len > IMG_CHUNK_HEADER_SIZE))
+	{
+		uint8_t state = upload_state;
+		image_upload_chunk((data[1] << 8) | data[2], &data[IMG_CHUNK_HEADER_SIZE], len - IMG_CHUNK_HEADER_SIZE);
+		if ((state == IMG_STATE_RECEIVING) && (upload_state == IMG_STATE_DONE))
+		{
+			done = upload.slot;
+		}
+	}
+	else
+	{
+		MYLOG("IMG", "Invalid upload downlink");
+	}
+	queue_uplink(UPLINK_KIND_IMG_STATUS, UPLINK_PRIO_HIGH);
+	return done;
+}
+
+/**
+ * @brief Build the status of the upload. Packet is IMG_STATUS_UPLINK,
+ *        slot, state and the offset the upload continues at.
+ */
+uint8_t build_image_status(uint8_t *frame, uint8_t max_size)
+{
+	if (max_size < 5)
+	{
+		return 0;
+	}
+	frame[0] = IMG_STATUS_UPLINK;
+	frame[1] = upload.slot;
+	frame[2] = upload_state;
+	frame[3] = upload_offset >> 8;
+	frame[4] = upload_offset & 0xFF;
+	return 5;
+}
+
+/**
+ * @brief The uplink queue is done with the status
+ *
+ * @param sent true if the LoRaMAC took it, otherwise the next upload downlink asks again
+ */
+void image_status_done(bool sent)
+{
+	if (!sent)
+	{
+		MYLOG("IMG", "Status of the upload not sent");
+	}
+}
@@ -0,0 +1,225 @@
+/**
+ * @file rle.cpp
+ * @author agent (agent@local)
+ * @brief Byte oriented run length codec (PackBits). A frame of the 2.13" EPD
+ *        is mostly white, so a text screen shrinks from 4000 bytes to a few
+ *        hundred.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "rle.h"
+
+/**
+ * @brief Encode a buffer
+ *
+ * @param src data to encode
+ * @param len size of src
+ * @param dst buffer for the encoded data, NULL to only get the size
+ * @param dst_size size of dst
+ * @return uint32_t encoded size, 0 if dst is too small
+ */
+uint32_t rle_encode(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t dst_size)
+{
+	uint32_t out = 0;
+	uint32_t idx = 0;
+
+	while (idx < len)
+	{
+		// Length of the run starting at idx
+		uint32_t run = 1;
+		while ((idx + run < len) && (run < RLE_MAX_RUN) && (src[idx + run] == src[idx]))
+		{
+			run++;
+		}
+
+		if (run >= 3)
+		{
+			if (dst != NULL)
+			{
+				if (out + 2 > dst_size)
+				{
+					return 0;
+				}
+				dst[out] = (uint8_t)(257 - run);
+				dst[out + 1] = src[idx];
+			}
+			out += 2;
+			idx += run;
+			continue;
+		}
+
+		// Collect literals until the next run of 3 or more
+		uint32_t lit = 0;
+		while ((idx + lit < len) && (lit < RLE_MAX_RUN))
+		{
+			if ((idx + lit + 2 < len) && (src[idx + lit] == src[idx + lit + 1]) && (src[idx + lit] == src[idx + lit + 2]))
+			{
+				break;
+			}
+			lit++;
+		}
+		if (dst != NULL)
+		{
+			if (out + 1 + lit > dst_size)
+			{
+				return 0;
+			}
+			dst[out] = (uint8_t)(lit - 1);
+			memcpy(&dst[out + 1], &src[idx], lit);
+		}
+		out += 1 + lit;
+		idx += lit;
+	}
+	return out;
+}
+
+/**
+ * @brief Decode a buffer
+ *
+ * @param src encoded data
+ * @param src_len size of src
+ * @param dst buffer for the decoded data
+ * @param dst_len expected decoded size
+ * @return true if src decoded to exactly dst_len bytes
+ */
+bool rle_decode(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len)
+{
+	uint32_t in = 0;
+	uint32_t out = 0;
+
+	while (in < src_len)
+	{
+		uint8_t header = src[in++];
+		if (header < 0x80)
+		{
+			uint32_t lit = header + 1;
+			if ((in + lit > src_len) || (out + lit > dst_len))
+			{
+				return false;
+			}
+			memcpy(&dst[out], &src[in], lit);
+			in += lit;
+			out += lit;
+		}
+		else if (header > 0x80)
+		{
+			uint32_t run = 257 - header;
+			if ((in >= src_len) || (out + run > dst_len))
+			{
+				return false;
+			}
+			memset(&dst[out], src[in++], run);
+			out += run;
+		}
+	}
+	return out == dst_len;
+}
+
+/**
+ * @brief Start to decode a buffer byte by byte
+ *
+ * @param stream decoder state
+ * @param src encoded data
+ * @param len size of src
+ */
+void rle_stream_begin(s_rle_stream *stream, const uint8_t *src, uint32_t len)
+{
+	stream->src = src;
+	stream->len = len;
+	stream->in = 0;
+	stream->count = 0;
+	stream->literal = false;
+	stream->value = 0;
+	stream->read = NULL;
+	stream->ctx = NULL;
+	stream->buf = NULL;
+	stream->buf_size = 0;
+}
+
+/**
+ * @brief Start to decode data that is read piece by piece, e.g. from a
+ *        file, only buf_size bytes of it are in RAM at a time
+ *
+ * @param stream decoder state
+ * @param read fills buf with the next encoded bytes
+ * @param ctx passed to read
+ * @param buf buffer for the encoded bytes
+ * @param buf_size size of buf
+ */
+void rle_stream_begin_read(s_rle_stream *stream, rle_read_t read, void *ctx, uint8_t *buf, uint16_t buf_size)
+{
+	rle_stream_begin(stream, buf, 0);
+	stream->read = read;
+	stream->ctx = ctx;
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+}
+
+/**
+ * @brief Take the next encoded byte, refill the buffer if it is used up
+ *
+ * @param stream decoder state
+ * @param byte receives the byte
+ * @return true if there was one
+ */
+static bool stream_byte(s_rle_stream *stream, uint8_t *byte)
+{
+	if (stream->in >= stream->len)
+	{
+		if (stream->read == NULL)
+		{
+			return false;
+		}
+		stream->len = stream->read(stream->ctx, stream->buf, stream->buf_size);
+		stream->in = 0;
+		if (stream->len == 0)
+		{
+			stream->read = NULL;
+			return false;
+		}
+	}
+	*byte = stream->src[stream->in++];
+	return true;
+}
+
+/**
+ * @brief Decode the next byte
+ *
+ * @param stream decoder state
+ * @return uint8_t next byte, 0 behind the end of the data
+ */
+uint8_t rle_stream_next(s_rle_stream *stream)
+{
+	uint8_t byte;
+	while (stream->count == 0)
+	{
+		uint8_t header;
+		if (!stream_byte(stream, &header))
+		{
+			return 0;
+		}
+		if (header < 0x80)
+		{
+			stream->count = header + 1;
+			stream->literal = true;
+		}
+		else if (header > 0x80)
+		{
+			if (!stream_byte(stream, &stream->value))
+			{
+				return 0;
+			}
+			stream->count = 257 - header;
+			stream->literal = false;
+		}
+	}
+	stream->count--;
+	if (stream->literal)
+	{
+		return stream_byte(stream, &byte) ? byte : 0;
+	}
+	return stream->value;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file rle.h
+ * @author agent (agent@local)
+ * @brief Byte oriented run length codec (PackBits) for 1bpp frames and bitmaps
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef RLE_H
+#define RLE_H
+
+#include <Arduino.h>
+
+/**
+ * Encoded stream is a sequence of packets with a one byte header:
+ *   0x00..0x7F  header + 1 literal bytes follow
+ *   0x81..0xFF  the next byte is repeated 257 - header times
+ *   0x80        no operation
+ */
+#define RLE_MAX_RUN 128
+
+/** Worst case encoded size of len bytes */
+#define RLE_MAX_SIZE(len) ((len) + ((len) + RLE_MAX_RUN - 1) / RLE_MAX_RUN)
+
+/** Reads up to size bytes of encoded data into buf, returns how many, 0 at the end */
+typedef uint16_t (*rle_read_t)(void *ctx, uint8_t *buf, uint16_t size);
+
+/** State of a decoder that hands out one byte at a time */
+struct s_rle_stream
+{
+	const uint8_t *src;
+	uint32_t len;
+	uint32_t in;
+	/** Bytes left in the current packet */
+	uint8_t count;
+	bool literal;
+	uint8_t value;
+	/** Refills src once it is used up, NULL for data that is in memory as a whole */
+	rle_read_t read;
+	void *ctx;
+	uint8_t *buf;
+	uint16_t buf_size;
+};
+
+uint32_t rle_encode(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t dst_size);
+bool rle_decode(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len);
+void rle_stream_begin(s_rle_stream *stream, const uint8_t *src, uint32_t len);
+void rle_stream_begin_read(s_rle_stream *stream, rle_read_t read, void *ctx, uint8_t *buf, uint16_t buf_size);
+uint8_t rle_stream_next(s_rle_stream *stream);
+
+#endif
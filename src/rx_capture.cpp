@@ -0,0 +1,132 @@
+/**
+ * @file rx_capture.cpp
+ * @author agent (agent@local)
+ * @brief Capture of the received LoRa frames. When it is switched on
+ *        with AT+RXCAP=1 every frame is stored as it came from the radio,
+ *        with time, RSSI and SNR, in a ring in RAM. A full ring
+ *        overwrites the oldest frames. AT+RXCAP prints the frames and
+ *        empties the ring.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Capture is off after a reset */
+bool g_rx_capture_enabled = false;
+
+/** Counters of the capture */
+s_rx_capture_stats g_rx_capture_stats;
+
+struct s_rx_capture_header
+{
+	uint32_t time;
+	int16_t rssi;
+	int8_t snr;
+	uint8_t len;
+};
+
+static uint8_t capture_data[RX_CAPTURE_SIZE];
+/** Byte positions, they only grow, the index in the ring is position % RX_CAPTURE_SIZE */
+static uint32_t capture_head = 0;
+static uint32_t capture_tail = 0;
+static uint16_t capture_num = 0;
+
+/**
+ * @brief Copy bytes into the ring, wrapping around its end
+ */
+static void capture_copy_in(uint32_t pos, const uint8_t *data, uint16_t len)
+{
+	pos %= RX_CAPTURE_SIZE;
+	uint16_t first = (len < RX_CAPTURE_SIZE - pos) ? len : RX_CAPTURE_SIZE - pos;
+	memcpy(&capture_data[pos], data, first);
+	memcpy(capture_data, data + first, len - first);
+}
+
+/**
+ * @brief Copy bytes out of the ring, wrapping around its end
+ */
+static void capture_copy_out(uint32_t pos, uint8_t *data, uint16_t len)
+{
+	pos %= RX_CAPTURE_SIZE;
+	uint16_t first = (len < RX_CAPTURE_SIZE - pos) ? len : RX_CAPTURE_SIZE - pos;
+	memcpy(data, &capture_data[pos], first);
+	memcpy(data + first, capture_data, len - first);
+}
+
+/**
+ * @brief Store a received frame if the capture is on
+ *
+ * @param data frame as received
+ * @param len size of the frame
+ * @param rssi RSSI of the frame in dBm
+ * @param snr SNR of the frame in dB
+ */
+void rx_capture(const uint8_t *data, uint8_t len, int16_t rssi, int8_t snr)
+{
+	if (!g_rx_capture_enabled)
+	{
+		return;
+	}
+	s_rx_capture_header header = {millis(), rssi, snr, len};
+	uint16_t size = sizeof(header) + len;
+	// Make room, the newest frames are the interesting ones
+	while ((capture_head - capture_tail) + size > RX_CAPTURE_SIZE)
+	{
+		s_rx_capture_header oldest;
+		capture_copy_out(capture_tail, (uint8_t *)&oldest, sizeof(oldest));
+		capture_tail += sizeof(oldest) + oldest.len;
+		capture_num--;
+		g_rx_capture_stats.overwritten++;
+	}
+	capture_copy_in(capture_head, (const uint8_t *)&header, sizeof(header));
+	capture_copy_in(capture_head + sizeof(header), data, len);
+	capture_head += size;
+	capture_num++;
+	g_rx_capture_stats.frames++;
+}
+
+/**
+ * @brief Number of stored frames
+ *
+ * @param used set to the bytes in use
+ */
+uint16_t rx_capture_frames(uint16_t *used)
+{
+	*used = capture_head - capture_tail;
+	return capture_num;
+}
+
+/**
+ * @brief Print the stored frames on the AT console and empty the ring.
+ *        Every frame is one line "+RXCAP:time,rssi,snr,hex", the hex
+ *        digits are printed in pieces of RX_CAPTURE_LINE_BYTES.
+ */
+void rx_capture_offload(void)
+{
+	uint8_t bytes[RX_CAPTURE_LINE_BYTES];
+	char hex[2 * RX_CAPTURE_LINE_BYTES + 1];
+	while (capture_tail != capture_head)
+	{
+		s_rx_capture_header header;
+		capture_copy_out(capture_tail, (uint8_t *)&header, sizeof(header));
+		capture_tail += sizeof(header);
+		AT_PRINTF("+RXCAP:%lu,%d,%d,", (unsigned long)header.time, header.rssi, header.snr);
+		for (uint16_t pos = 0; pos < header.len; pos += RX_CAPTURE_LINE_BYTES)
+		{
+			uint16_t num = header.len - pos;
+			if (num > RX_CAPTURE_LINE_BYTES)
+			{
+				num = RX_CAPTURE_LINE_BYTES;
+			}
+			capture_copy_out(capture_tail + pos, bytes, num);
+			hex_string(hex, bytes, num, 0);
+			AT_PRINTF("%s", hex);
+		}
+		AT_PRINTF("\n");
+		capture_tail += header.len;
+	}
+	capture_num = 0;
+}
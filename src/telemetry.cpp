@@ -0,0 +1,228 @@
+/**
+ * @file telemetry.cpp
+ * @author agent (agent@local)
+ * @brief Telemetry uplink frame. Gestures between two uplinks are counted
+ *        and their times kept in a small ring, the frame carries the
+ *        counts, the shown message, the device status, the gesture times
+ *        as deltas and the message digests. Sections that don't fit the
+ *        payload of the current data rate are left out, the gesture times
+ *        only get the room the digests leave.
+ *
+ *        TELEMETRY_UPLINK, version << 4 | sections, reasons, message,
+ *        one count per gesture reason, then the sections in this order
+ *        - status: battery, flash records (2 bytes), failed sends
+ *        - events: number, per event type << 6 | age, newest first
+ *        - digests: first slot and the CRC16 up to the end of the frame
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Ages from 63 s on are continued in 7 bit groups */
+#define TELEMETRY_AGE_ESCAPE 63
+
+/** Gestures since the last uplink */
+static uint16_t gesture_count[UPLINK_REASON_NUM] = {0};
+
+/** Times of the last TELEMETRY_MAX_EVENTS gestures */
+struct s_telemetry_event
+{
+	uint32_t time;
+	uint8_t type;
+};
+static s_telemetry_event events[TELEMETRY_MAX_EVENTS];
+static uint8_t event_head = 0;
+static uint8_t event_num = 0;
+/** Newest events in the last built frame, the older ones wait for the next one */
+static uint8_t event_built = 0;
+
+/**
+ * @brief Count a gesture and keep its time for the next uplink
+ *
+ * @param reason UPLINK_REASON_xxx, the timer is not counted
+ */
+void telemetry_event(uint8_t reason)
+{
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (reason & (1 << idx))
+		{
+			if (gesture_count[idx] < 0xFFFF)
+			{
+				gesture_count[idx]++;
+			}
+			// The oldest time is overwritten, the counts stay complete
+			events[event_head].time = millis();
+			events[event_head].type = idx - 1;
+			event_head = (event_head + 1) % TELEMETRY_MAX_EVENTS;
+			if (event_num < TELEMETRY_MAX_EVENTS)
+			{
+				event_num++;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Check if more gestures would overwrite times that were not sent
+ */
+bool telemetry_events_full(void)
+{
+	return event_num == TELEMETRY_MAX_EVENTS;
+}
+
+/**
+ * @brief Length of an encoded event age
+ */
+static uint8_t age_size(uint32_t age)
+{
+	uint8_t size = 1;
+	if (age >= TELEMETRY_AGE_ESCAPE)
+	{
+		age -= TELEMETRY_AGE_ESCAPE;
+		do
+		{
+			size++;
+			age >>= 7;
+		} while (age != 0);
+	}
+	return size;
+}
+
+/**
+ * @brief Build the telemetry frame
+ *
+ * @param frame receives the frame
+ * @param max_size payload size allowed by the current data rate
+ * @param reasons UPLINK_REASON_xxx of the pending uplink
+ * @return uint8_t size of the frame, 0 if not even the counts fit
+ */
+uint8_t build_telemetry(uint8_t *frame, uint8_t max_size, uint8_t reasons)
+{
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (gesture_count[idx] != 0)
+		{
+			reasons |= 1 << idx;
+		}
+	}
+
+	uint8_t len = 4;
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (reasons & (1 << idx))
+		{
+			len++;
+		}
+	}
+	if (len > max_size)
+	{
+		return 0;
+	}
+	frame[0] = TELEMETRY_UPLINK;
+	frame[1] = TELEMETRY_VERSION << 4;
+	frame[2] = reasons;
+	frame[3] = g_shown_msg;
+	len = 4;
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (reasons & (1 << idx))
+		{
+			frame[len++] = gesture_count[idx] > 0xFF ? 0xFF : gesture_count[idx];
+		}
+	}
+
+	// Status in timer frames
+	if ((reasons & UPLINK_REASON_TIMER) && ((max_size - len) >= 4))
+	{
+		int32_t batt = ((int32_t)read_batt() - TELEMETRY_BATT_BASE_MV) / 10;
+		frame[1] |= TELEMETRY_HAS_STATUS;
+		frame[len++] = batt < 0 ? 0 : (batt > 0xFF ? 0xFF : batt);
+		frame[len++] = g_user_data_writes >> 8;
+		frame[len++] = g_user_data_writes & 0xFF;
+		frame[len++] = send_fail;
+	}
+
+	// Message digests in timer frames, as many as fit. They go last, the room is taken first.
+	uint8_t digests[1 + 2 * DIGEST_SLOTS_PER_UPLINK];
+	uint8_t digests_len = 0;
+	if (reasons & UPLINK_REASON_TIMER)
+	{
+		uint8_t room = max_size - len;
+		digests_len = add_message_digests(digests, room < sizeof(digests) ? room : sizeof(digests));
+	}
+	max_size -= digests_len;
+
+	// Gesture times, newest first, each one as seconds before the next newer one
+	event_built = 0;
+	if ((event_num != 0) && ((max_size - len) >= 2))
+	{
+		uint8_t num_pos = len++;
+		uint8_t num = 0;
+		uint32_t now = millis();
+		uint32_t newer_age = 0;
+		while (num < event_num)
+		{
+			s_telemetry_event *event = &events[(event_head + TELEMETRY_MAX_EVENTS - 1 - num) % TELEMETRY_MAX_EVENTS];
+			uint32_t event_age = (now - event->time) / 1000;
+			uint32_t age = event_age - newer_age;
+			if (age_size(age) > (max_size - len))
+			{
+				break;
+			}
+			newer_age = event_age;
+			if (age < TELEMETRY_AGE_ESCAPE)
+			{
+				frame[len++] = (event->type << 6) | age;
+			}
+			else
+			{
+				frame[len++] = (event->type << 6) | TELEMETRY_AGE_ESCAPE;
+				age -= TELEMETRY_AGE_ESCAPE;
+				while (age >= 0x80)
+				{
+					frame[len++] = (age & 0x7F) | 0x80;
+					age >>= 7;
+				}
+				frame[len++] = age;
+			}
+			num++;
+		}
+		if (num == 0)
+		{
+			// Not even the newest age fits, the count byte is given back
+			len = num_pos;
+		}
+		else
+		{
+			frame[1] |= TELEMETRY_HAS_EVENTS;
+			frame[num_pos] = num;
+			event_built = num;
+		}
+	}
+
+	if (digests_len != 0)
+	{
+		frame[1] |= TELEMETRY_HAS_DIGESTS;
+		memcpy(&frame[len], digests, digests_len);
+		len += digests_len;
+	}
+	return len;
+}
+
+/**
+ * @brief The frame went out, start collecting again. Events that did not
+ *        fit into it are older than the sent ones and stay for the next
+ *        frame. It is called right after build_telemetry(), no gesture
+ *        came in between.
+ */
+void telemetry_sent(void)
+{
+	memset(gesture_count, 0, sizeof(gesture_count));
+	event_head = (event_head + TELEMETRY_MAX_EVENTS - event_built) % TELEMETRY_MAX_EVENTS;
+	event_num -= event_built;
+	event_built = 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file uplink_queue.cpp
+ * @author agent (agent@local)
+ * @brief Uplink queue in front of the LoRaMAC handler. Every payload kind
+ *        is queued once with the highest priority it was asked for, a
+ *        request for a kind that is already waiting merges into it. The
+ *        payload is built when it goes out, so it has the newest data and
+ *        fits the data rate of that moment. A token bucket of time on air
+ *        keeps the uplinks within the airtime budget, a busy LoRaMAC is
+ *        tried again after its TX cycle.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app.h"
+
+/** Airtime budget, can be changed with AT+AIRTIME */
+uint32_t g_airtime_budget_ms = UPLINK_AIRTIME_BUDGET_MS;
+uint32_t g_airtime_burst_ms = UPLINK_AIRTIME_BURST_MS;
+
+/** Counters of the queue */
+s_uplink_stats g_uplink_stats;
+
+struct s_uplink_kind
+{
+	uint8_t (*build)(uint8_t *frame, uint8_t max_size);
+	void (*done)(bool sent);
+	const char *name;
+};
+
+static const s_uplink_kind uplink_kinds[UPLINK_KIND_NUM] = {
+	{build_telemetry_uplink, telemetry_uplink_done, "telemetry"},
+	{build_frag_request, frag_request_done, "fragment request"},
+	{build_image_status, image_status_done, "image status"},
+};
+
+/** Waiting kinds, their priority and the order they were queued in */
+static bool kind_queued[UPLINK_KIND_NUM] = {false};
+static uint8_t kind_priority[UPLINK_KIND_NUM];
+static uint32_t kind_order[UPLINK_KIND_NUM];
+static uint8_t kind_attempts[UPLINK_KIND_NUM];
+static uint32_t queue_order = 0;
+
+/** Token bucket in 1/3600 us of time on air, every ms adds g_airtime_budget_ms of them without rounding */
+#define TOKENS_PER_US 3600ULL
+#define TOKENS_PER_MS (TOKENS_PER_US * 1000)
+static uint64_t tokens = UPLINK_AIRTIME_BURST_MS * TOKENS_PER_MS;
+static uint32_t tokens_time = 0;
+
+static SoftwareTimer queue_timer;
+
+/**
+ * @brief Retry or refill time is over
+ */
+static void queue_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, UPLINK_EVENT);
+}
+
+/**
+ * @brief Create the timer for busy retries and the airtime budget
+ */
+void init_uplink_queue(void)
+{
+	queue_timer.begin(UPLINK_RETRY_MS, queue_timer_cb, NULL, false);
+	tokens_time = millis();
+}
+
+/**
+ * @brief Queue a payload kind. A kind that is already waiting keeps
+ *        its place and gets the higher of both priorities.
+ *
+ * @param kind UPLINK_KIND_xxx
+ * @param priority UPLINK_PRIO_xxx
+ */
+void queue_uplink(uint8_t kind, uint8_t priority)
+{
+	if (kind_queued[kind])
+	{
+		g_uplink_stats.merged++;
+		if (priority <= kind_priority[kind])
+		{
+			// The retry timer or the end of the TX cycle sends it
+			return;
+		}
+		kind_priority[kind] = priority;
+	}
+	else
+	{
+		g_uplink_stats.queued++;
+		kind_queued[kind] = true;
+		kind_priority[kind] = priority;
+		kind_order[kind] = queue_order++;
+		kind_attempts[kind] = 0;
+	}
+	service_uplink_queue();
+}
+
+/**
+ * @brief Check if a payload kind waits to be sent
+ */
+bool uplink_queued(uint8_t kind)
+{
+	return kind_queued[kind];
+}
+
+/**
+ * @brief Spreading factor and bandwidth in kHz of a data rate
+ *
+ * @return true for a LoRa data rate, false for FSK
+ */
+static bool data_rate_params(uint8_t dr, uint8_t *sf, uint16_t *bw)
+{
+	*bw = 125;
+	switch (g_lorawan_settings.lora_region)
+	{
+	case LORAMAC_REGION_US915:
+		*sf = (dr < 4) ? 10 - dr : 8;
+		*bw = (dr < 4) ? 125 : 500;
+		return true;
+	case LORAMAC_REGION_AU915:
+		*sf = (dr < 6) ? 12 - dr : 8;
+		*bw = (dr < 6) ? 125 : 500;
+		return true;
+	default:
+		if (dr == 7)
+		{
+			return false;
+		}
+		*sf = (dr < 6) ? 12 - dr : 7;
+		*bw = (dr < 6) ? 125 : 250;
+		return true;
+	}
+}
+
+/**
+ * @brief Current data rate of the LoRaMAC, it may differ from the setting with ADR
+ */
+static uint8_t current_data_rate(void)
+{
+	MibRequestConfirm_t mib;
+	mib.Type = MIB_CHANNELS_DATARATE;
+	if (LoRaMacMibGetRequestConfirm(&mib) != LORAMAC_STATUS_OK)
+	{
+		return g_lorawan_settings.data_rate;
+	}
+	return mib.Param.ChannelsDatarate;
+}
+
+/**
+ * @brief Time on air of an uplink with the current data rate
+ *        (Semtech AN1200.13, explicit header, CRC, coding rate 4/5,
+ *        8 symbol preamble and 13 bytes of LoRaWAN overhead)
+ *
+ * @param size application payload
+ * @return uint32_t time on air in us
+ */
+uint32_t uplink_time_on_air(uint8_t size)
+{
+	uint8_t sf;
+	uint16_t bw;
+	uint32_t phy_size = size + 13;
+	if (!data_rate_params(current_data_rate(), &sf, &bw))
+	{
+		// FSK 50 kbps, preamble, sync word, length, payload and CRC
+		return (5 + 3 + 1 + phy_size + 2) * 8 * 20;
+	}
+	uint8_t low_rate = ((sf >= 11) && (bw == 125)) ? 1 : 0;
+	int32_t num = 8 * phy_size - 4 * sf + 28 + 16;
+	int32_t den = 4 * (sf - 2 * low_rate);
+	int32_t payload_symbols = 8 + ((num > 0) ? ((num + den - 1) / den) * 5 : 0);
+	// Preamble is 12.25 symbols, counted in quarter symbols
+	uint32_t quarter_symbols = 49 + payload_symbols * 4;
+	return quarter_symbols * ((1000UL << sf) / bw) / 4;
+}
+
+/**
+ * @brief Refill the token bucket for the time since the last refill
+ */
+static void refill_tokens(void)
+{
+	uint32_t now = millis();
+	tokens += (uint64_t)(now - tokens_time) * g_airtime_budget_ms;
+	tokens_time = now;
+	if (tokens > g_airtime_burst_ms * TOKENS_PER_MS)
+	{
+		tokens = g_airtime_burst_ms * TOKENS_PER_MS;
+	}
+}
+
+/**
+ * @brief Airtime that can be used right now
+ *
+ * @return uint32_t tokens in ms
+ */
+uint32_t uplink_airtime_tokens(void)
+{
+	refill_tokens();
+	return tokens / TOKENS_PER_MS;
+}
+
+/**
+ * @brief Largest payload the LoRaMAC accepts with the current data rate
+ *        and the pending MAC commands
+ */
+static uint8_t max_uplink_size(void)
+{
+	LoRaMacTxInfo_t tx_info;
+	if (LoRaMacQueryTxPossible(0, &tx_info) != LORAMAC_STATUS_OK)
+	{
+		// Pending MAC commands fill the frame or the query failed, tx_info can't be trusted
+		return UPLINK_SAFE_SIZE;
+	}
+	return (tx_info.MaxPossiblePayload < TELEMETRY_MAX_SIZE) ? tx_info.MaxPossiblePayload : TELEMETRY_MAX_SIZE;
+}
+
+/**
+ * @brief Take a kind off the queue and tell its owner
+ */
+static void finish_kind(uint8_t kind, bool sent)
+{
+	kind_queued[kind] = false;
+	uplink_kinds[kind].done(sent);
+}
+
+/**
+ * @brief Send the waiting kind with the highest priority if the LoRaMAC
+ *        and the airtime budget allow it. Called when something was
+ *        queued, after a TX cycle and by the retry timer.
+ */
+void service_uplink_queue(void)
+{
+	int16_t kind = -1;
+	for (uint8_t idx = 0; idx < UPLINK_KIND_NUM; idx++)
+	{
+		if (kind_queued[idx] &&
+			((kind < 0) || (kind_priority[idx] > kind_priority[kind]) ||
+			 ((kind_priority[idx] == kind_priority[kind]) && ((int32_t)(kind_order[idx] - kind_order[kind]) < 0))))
+		{
+			kind = idx;
+		}
+	}
+	if (kind < 0)
+	{
+		return;
+	}
+	if (!g_lpwan_has_joined)
+	{
+		// The connection manager services the queue after the join
+		return;
+	}
+
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	uint8_t len = uplink_kinds[kind].build(frame, max_uplink_size());
+	if (len == 0)
+	{
+		MYLOG("UPQ", "No %s that fits the data rate", uplink_kinds[kind].name);
+		g_uplink_stats.dropped++;
+		finish_kind(kind, false);
+		return;
+	}
+
+	uint32_t air_us = uplink_time_on_air(len);
+	uint64_t burst = g_airtime_burst_ms * TOKENS_PER_MS;
+	if (air_us * TOKENS_PER_US > burst)
+	{
+		MYLOG("UPQ", "%s needs %lu ms, more than the burst", uplink_kinds[kind].name, (unsigned long)(air_us / 1000));
+		g_uplink_stats.dropped++;
+		finish_kind(kind, false);
+		return;
+	}
+
+	// Lower priorities leave a part of the burst to the higher ones, at
+	// most they wait for a full bucket
+	uint64_t needed = air_us * TOKENS_PER_US + burst * (UPLINK_PRIO_HIGH - kind_priority[kind]) / 4;
+	if (needed > burst)
+	{
+		needed = burst;
+	}
+	refill_tokens();
+	if (tokens < needed)
+	{
+		// Wait until the bucket has enough airtime
+		uint32_t wait_ms = (needed - tokens + g_airtime_budget_ms - 1) / g_airtime_budget_ms;
+		MYLOG("UPQ", "%s waits %lu ms for airtime", uplink_kinds[kind].name, (unsigned long)wait_ms);
+		g_uplink_stats.throttled++;
+		queue_timer.stop();
+		queue_timer.setPeriod(wait_ms);
+		return;
+	}
+
+	link_prepare_uplink();
+	lmh_error_status result = send_lora_packet(frame, len);
+	link_uplink_sent(result == LMH_SUCCESS);
+	switch (result)
+	{
+	case LMH_SUCCESS:
+		MYLOG("UPQ", "Sent %s, %d bytes, %lu us on air", uplink_kinds[kind].name, len, (unsigned long)air_us);
+		tokens -= air_us * TOKENS_PER_US;
+		g_uplink_stats.sent++;
+		g_uplink_stats.airtime_ms += (air_us + 500) / 1000;
+		finish_kind(kind, true);
+		break;
+	case LMH_BUSY:
+		g_uplink_stats.busy++;
+		if (++kind_attempts[kind] >= UPLINK_MAX_ATTEMPTS)
+		{
+			MYLOG("UPQ", "%s given up, LoRaMAC stays busy", uplink_kinds[kind].name);
+			g_uplink_stats.dropped++;
+			finish_kind(kind, false);
+			break;
+		}
+		// The end of the TX cycle or the timer tries again
+		queue_timer.stop();
+		queue_timer.setPeriod(UPLINK_RETRY_MS);
+		break;
+	case LMH_ERROR:
+		MYLOG("UPQ", "%s too big to send with current DR", uplink_kinds[kind].name);
+		g_uplink_stats.dropped++;
+		finish_kind(kind, false);
+		break;
+	}
+}
+
+/**
+ * @brief Printout of the queue counters
+ */
+void log_uplink_stats(void)
+{
+	MYLOG("UPQ", "Queued %lu, sent %lu, merged %lu, dropped %lu, busy %lu, throttled %lu",
+		  (unsigned long)g_uplink_stats.queued, (unsigned long)g_uplink_stats.sent, (unsigned long)g_uplink_stats.merged,
+		  (unsigned long)g_uplink_stats.dropped, (unsigned long)g_uplink_stats.busy,
+		  (unsigned long)g_uplink_stats.throttled);
+	MYLOG("UPQ", "Airtime %lu ms used, %lu ms available", (unsigned long)g_uplink_stats.airtime_ms,
+		  (unsigned long)uplink_airtime_tokens());
+}
@@ -16,52 +16,264 @@
 
 #include "app.h"
 
+/** Line buffer of the AT interpreter, ATCMD_SIZE in at_cmd.cpp of WisBlock-API 1.1.7 */
+#define AT_CMD_BUF_SIZE 160
+/** Longest text of AT+SETMSG, the command, a 3 digit slot and the terminator take the rest */
+#define AT_MSG_MAX_LEN (AT_CMD_BUF_SIZE - sizeof("AT+SETMSG=255:"))
+
 static int at_exec_msg(char *str)
 {
-	// Get MsgNum
+	// Get MsgNum, the rest after the first ':' is the message
+	char *text = strchr(str, ':');
+	if (text == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	*text++ = 0;
+	long MsgNum = strtol(str, NULL, 0);
+	if ((MsgNum <= 0) || (MsgNum > MSG_SLOTS) || (strlen(text) > AT_MSG_MAX_LEN))
+	{
+		return AT_ERRNO_PARA_VAL;
+	}
+
+	// Written to User Flash Data with the next commit
+	if (!set_message(MsgNum, text, strlen(text)))
+	{
+		return AT_ERRNO_EXEC_FAIL;
+	}
+	// Show the message
+	gMsgNum = MsgNum;
+	switch_epd_message();
+	return 0;
+}
+
+static int at_exec_flush(void)
+{
+	if (!save_user_flash_data())
+	{
+		return AT_ERRNO_EXEC_FAIL;
+	}
+	return 0;
+}
+
+static int at_exec_epd_bench(char *str)
+{
+	uint16_t rounds = strtol(str, NULL, 0);
+	if ((rounds == 0) || (rounds > 1000))
+	{
+		return AT_ERRNO_PARA_VAL;
+	}
+	benchmark_epd_message(rounds);
+	return 0;
+}
+
+static int at_query_quiet(void)
+{
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "%lu:%lu", (unsigned long)g_display_quiet_ms, (unsigned long)g_uplink_quiet_ms);
+	return 0;
+}
+
+static int at_exec_quiet(char *str)
+{
+	// Get display and uplink quiet window in ms
 	char *param;
 
 	param = strtok(str, ":");
-	uint8_t MsgNum = strtol(param, NULL, 0);
-	if ((MsgNum == 0) || (MsgNum > 4))
+	if (param == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	uint32_t display_ms = strtoul(param, NULL, 0);
+	param = strtok(NULL, ":");
+	if (param == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	uint32_t uplink_ms = strtoul(param, NULL, 0);
+	if ((display_ms == 0) || (display_ms > 10000) || (uplink_ms == 0) || (uplink_ms > 600000))
 	{
 		return AT_ERRNO_PARA_VAL;
 	}
+	g_display_quiet_ms = display_ms;
+	g_uplink_quiet_ms = uplink_ms;
+	return 0;
+}
+
+static int at_query_evstat(void)
+{
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "DISP:%lu/%lu UP:%lu/%lu/%lu/%lu/%lu SENT:%lu",
+			 (unsigned long)g_coalesce_stats.display_refreshes, (unsigned long)g_coalesce_stats.display_requests,
+			 (unsigned long)g_coalesce_stats.uplink_requests[0], (unsigned long)g_coalesce_stats.uplink_requests[1],
+			 (unsigned long)g_coalesce_stats.uplink_requests[2], (unsigned long)g_coalesce_stats.uplink_requests[3],
+			 (unsigned long)g_coalesce_stats.uplink_requests[4],
+			 (unsigned long)g_coalesce_stats.uplinks_sent);
+	return 0;
+}
+
+static int at_query_evq(void)
+{
+	// With counters of up to 8 digits the line fits ATQUERY_SIZE, the drained
+	// records are left to the log, they are the posted ones without the overflows
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "ACC:%lu/%lu/%lu TMR:%lu/%lu/%lu EPD:%lu/%lu/%lu BATCH:%lu/%u LAT:%lu",
+			 (unsigned long)g_event_stats.posted[EVENT_SOURCE_ACC], (unsigned long)g_event_stats.overflows[EVENT_SOURCE_ACC],
+			 (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_ACC], (unsigned long)g_event_stats.posted[EVENT_SOURCE_TIMER],
+			 (unsigned long)g_event_stats.overflows[EVENT_SOURCE_TIMER], (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_TIMER],
+			 (unsigned long)g_event_stats.posted[EVENT_SOURCE_EPD], (unsigned long)g_event_stats.overflows[EVENT_SOURCE_EPD],
+			 (unsigned long)g_event_stats.coalesced[EVENT_SOURCE_EPD], (unsigned long)g_event_stats.batches,
+			 g_event_stats.max_batch, (unsigned long)g_event_stats.max_latency_ms);
+	return 0;
+}
+
+static int at_query_upq(void)
+{
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "Q:%lu S:%lu M:%lu D:%lu B:%lu T:%lu AIR:%lums TOK:%lums",
+			 (unsigned long)g_uplink_stats.queued, (unsigned long)g_uplink_stats.sent,
+			 (unsigned long)g_uplink_stats.merged, (unsigned long)g_uplink_stats.dropped,
+			 (unsigned long)g_uplink_stats.busy, (unsigned long)g_uplink_stats.throttled,
+			 (unsigned long)g_uplink_stats.airtime_ms, (unsigned long)uplink_airtime_tokens());
+	return 0;
+}
+
+static int at_query_airtime(void)
+{
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "%lu:%lu", (unsigned long)g_airtime_budget_ms, (unsigned long)g_airtime_burst_ms);
+	return 0;
+}
+
+static int at_exec_airtime(char *str)
+{
+	// Get airtime budget per hour and burst in ms
+	char *param;
 
-	// Get message to set
+	param = strtok(str, ":");
+	if (param == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	uint32_t budget_ms = strtoul(param, NULL, 0);
 	param = strtok(NULL, ":");
-	int data_size = strlen(param);
-	if (data_size > 80)
+	if (param == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	uint32_t burst_ms = strtoul(param, NULL, 0);
+	// 10% duty cycle is the highest any sub-band allows
+	if ((budget_ms == 0) || (budget_ms > 360000) || (burst_ms < 500) || (burst_ms > budget_ms))
 	{
 		return AT_ERRNO_PARA_VAL;
 	}
+	// Airtime saved up so far is refilled with the old budget
+	uplink_airtime_tokens();
+	g_airtime_budget_ms = budget_ms;
+	g_airtime_burst_ms = burst_ms;
+	return 0;
+}
 
-	switch (MsgNum)
-	{
-		case 1:
-			memcpy(g_user_flash_data.epd_msg_1, param, 80);
-			break;
-		case 2:
-			memcpy(g_user_flash_data.epd_msg_2, param, 80);
-			break;
-		case 3:
-			memcpy(g_user_flash_data.epd_msg_3, param, 80);
-			break;
-		case 4:
-			memcpy(g_user_flash_data.epd_msg_4, param, 80);
-			break;
-		default:
-			break;
-	}
-	
-	// Save message to User Flash Data
-	save_user_flash_data();
-	// Show the message
-	gMsgNum = MsgNum;
-	switch_epd_message();
+static int at_query_rxcap(void)
+{
+	uint16_t used;
+	uint16_t frames = rx_capture_frames(&used);
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "%d FRAMES:%d BYTES:%d/%d LOST:%lu", g_rx_capture_enabled ? 1 : 0, frames, used,
+			 RX_CAPTURE_SIZE, (unsigned long)g_rx_capture_stats.overwritten);
+	return 0;
+}
+
+static int at_exec_rxcap(char *str)
+{
+	long enable = strtol(str, NULL, 0);
+	if ((enable != 0) && (enable != 1))
+	{
+		return AT_ERRNO_PARA_VAL;
+	}
+	g_rx_capture_enabled = enable == 1;
 	return 0;
 }
 
+static int at_exec_rxcap_offload(void)
+{
+	rx_capture_offload();
+	return 0;
+}
+
+/** Bytes of an image piece in one AT command, sent as hex */
+#define AT_IMG_CHUNK_MAX 64
+
+static int at_query_img(void)
+{
+	uint8_t slot;
+	uint16_t offset;
+	uint16_t size;
+	uint8_t state = image_upload_state(&slot, &offset, &size);
+	snprintf(g_at_query_buf, ATQUERY_SIZE, "%d:%d:%d/%d", slot, state, offset, size);
+	return 0;
+}
+
+static int at_exec_img(char *str)
+{
+	// Slot, width, height, size and CRC32 of the compressed image
+	uint32_t values[5];
+	char *param = strtok(str, ":");
+	for (uint8_t idx = 0; idx < 5; idx++)
+	{
+		if (param == NULL)
+		{
+			return AT_ERRNO_PARA_NUM;
+		}
+		values[idx] = strtoul(param, NULL, 0);
+		param = strtok(NULL, ":");
+	}
+	if ((values[0] == 0) || (values[0] > MSG_SLOTS) || (values[1] > 0xFFFF) || (values[2] > 0xFFFF) || (values[3] > 0xFFFF))
+	{
+		return AT_ERRNO_PARA_VAL;
+	}
+	if (!image_upload_begin(values[0], values[1], values[2], values[3], values[4]))
+	{
+		return AT_ERRNO_EXEC_FAIL;
+	}
+	return 0;
+}
+
+static int at_exec_img_data(char *str)
+{
+	// Offset, the rest after the first ':' are the bytes in hex
+	char *hex = strchr(str, ':');
+	if (hex == NULL)
+	{
+		return AT_ERRNO_PARA_NUM;
+	}
+	*hex++ = 0;
+	uint32_t offset = strtoul(str, NULL, 0);
+	size_t hex_len = strlen(hex);
+	if ((offset > 0xFFFF) || (hex_len == 0) || ((hex_len % 2) != 0) || (hex_len > 2 * AT_IMG_CHUNK_MAX))
+	{
+		return AT_ERRNO_PARA_VAL;
+	}
+	uint8_t data[AT_IMG_CHUNK_MAX];
+	for (uint16_t idx = 0; idx < hex_len / 2; idx++)
+	{
+		char byte[3] = {hex[2 * idx], hex[2 * idx + 1], 0};
+		char *end;
+		data[idx] = strtoul(byte, &end, 16);
+		if (*end != 0)
+		{
+			return AT_ERRNO_PARA_VAL;
+		}
+	}
+
+	uint8_t slot;
+	uint16_t next;
+	uint16_t size;
+	uint8_t before = image_upload_state(&slot, &next, &size);
+	uint8_t state = image_upload_chunk(offset, data, hex_len / 2);
+	if ((before == IMG_STATE_RECEIVING) && (state == IMG_STATE_DONE))
+	{
+		// Show the new image
+		gMsgNum = slot;
+		switch_epd_message();
+	}
+	return (state == IMG_STATE_FAILED) ? AT_ERRNO_EXEC_FAIL : 0;
+}
+
 /**
  * @brief List of all available commands with short help and pointer to functions
  * 
@@ -70,6 +282,16 @@ atcmd_t g_user_at_cmd_list[] = {
 	/*|    CMD    |     AT+CMD?      |    AT+CMD=?    |  AT+CMD=value |  AT+CMD  |*/
 	// GNSS commands
 	{"+SETMSG", "Set message", NULL, at_exec_msg, NULL},
+	{"+FLUSH", "Write changed messages to flash now", NULL, NULL, at_exec_flush},
+	{"+EPDBENCH", "Time cached against rendered EPD screens", NULL, at_exec_epd_bench, NULL},
+	{"+QUIET", "Get/Set quiet windows display:uplink in ms", at_query_quiet, at_exec_quiet, NULL},
+	{"+EVSTAT", "Get display refreshes/requests, uplink requests timer/tap/double/shake/flip, sent", at_query_evstat, NULL, NULL},
+	{"+EVQ", "Get event rings posted/overflows/coalesced per source, records/batches/largest batch, latency", at_query_evq, NULL, NULL},
+	{"+UPQ", "Get uplink queue queued/sent/merged/dropped/busy/throttled, airtime used and available", at_query_upq, NULL, NULL},
+	{"+AIRTIME", "Get/Set uplink airtime budget per hour:burst in ms", at_query_airtime, at_exec_airtime, NULL},
+	{"+IMG", "Get upload slot:state:offset/size, start an upload slot:width:height:size:crc32", at_query_img, at_exec_img, NULL},
+	{"+IMGD", "Add image bytes offset:hex", NULL, at_exec_img_data, NULL},
+	{"+RXCAP", "Get/Set capture of received frames 0/1, read out and clear without parameter", at_query_rxcap, at_exec_rxcap, at_exec_rxcap_offload},
 };
 
 /** Number of user defined AT commands */
@@ -2,138 +2,645 @@
  * @file user_flash_data.cpp
  * @author Johan Sebastian Macias (johan.macias@rakwireless.com)
  * @brief Initialize, read and write parameters from/to internal flash memory.
- * 		  The file used is a new one with the name user_flash_data_name. That 
- *        means there are two files in the nRF52 internal file system. The 
- *        first one is for the LoRaWAN/WisBlock-API settings and this one for
- *        user data specfic to the app.
- * 		  
+ * 		  The user data lives in its own file next to the LoRaWAN/WisBlock-API
+ *        settings. The file is an append-only log, every changed message is
+ *        written as one record with a sequence number and a CRC32. On boot
+ *        the newest valid record of each message wins, a record torn by a
+ *        power loss only loses that one change. The log is compacted in the
+ *        background once it grew beyond USER_DATA_COMPACT_SIZE.
+ *        Changes are written behind: a changed message only marks its slot,
+ *        the commit follows after a quiet time, on low battery, before a
+ *        reset or with AT+FLUSH. Several changes end up in one commit.
+ *        In RAM the MSG_SLOTS messages are packed into one pool with an
+ *        offset table, a message takes its length plus the terminator.
+ *        Records hold the message packed with msg_encode() when that is
+ *        shorter than the text.
+ *
  * @version 0.1
  * @date 2022-02-06
- * 
+ *
  * @copyright Copyright (c) 2022
- * 
- * Based on: 
+ *
+ * Based on:
  * https://github.com/beegee-tokyo/WisBlock-API/blob/main/src/flash-nrf52.cpp
  * By: Bernd Giesecke (bernd.giesecke@rakwireless.com)
  * Date: 2021-01-10
  */
 
 #include "app.h"
+#include "crc.h"
+#include "msg_codec.h"
 
 #include <Adafruit_LittleFS.h>
 #include <InternalFileSystem.h>
 using namespace Adafruit_LittleFS_Namespace;
 
+/** Former file with four 80 byte messages, imported once into the log */
 static const char user_flash_data_name[] = "USER_FLASH_DATA";
+/** Record log and the compacted copy while it is written */
+static const char user_data_log_name[] = "USER_DATA_LOG";
+static const char user_data_new_name[] = "USER_DATA_NEW";
+
+/** Layout of the former USER_FLASH_DATA file */
+struct s_user_flash_data_v1
+{
+	uint8_t valid_mark_1;
+	uint8_t valid_mark_2;
+	uint8_t epd_msg[4][80];
+};
+
+/** Messages until they are changed */
+static const char *const default_msgs[] = {
+	"  Hi! I am thinking about you. Love you",
+	"If I know what love is, it is because ofyou",
+	"   While (true) {         I love you       }",
+	"Even when I am not  with you, all I can think of is your    smile",
+};
+#define DEFAULT_MSGS_NUM (sizeof(default_msgs) / sizeof(default_msgs[0]))
+
+/** Record header, followed by len payload bytes and the CRC32 over header and payload */
+struct __attribute__((packed)) s_user_data_record
+{
+	uint8_t mark_1;	 // 0xBA
+	uint8_t mark_2;	 // MY_APP_DATA_MARKER
+	uint8_t slot;	 // Message 1 to MSG_SLOTS
+	uint8_t encoding; // USER_DATA_PLAIN or USER_DATA_PACKED
+	uint16_t len;
+	uint32_t seq;
+};
+
+/** Payload of a record is the text or a msg_encode() stream */
+#define USER_DATA_PLAIN 0
+#define USER_DATA_PACKED 1
+
+/** Header, payload and CRC32 */
+#define USER_DATA_RECORD_SIZE(len) (sizeof(s_user_data_record) + (len) + 4)
 
 File user_flash_data_file(InternalFS);
 
-s_user_flash_data g_user_flash_data;
+/** Texts of all messages, each one followed by its terminator */
+static char msg_pool[MSG_POOL_SIZE];
+/** Start of every message in msg_pool, the last entry is the used size */
+static uint16_t msg_offset[MSG_SLOTS + 1];
 
-s_user_flash_data g_user_flash_data_flash_content;
+/** Newest stored record of every slot, seq 0 if the slot still has its default */
+static uint32_t slot_seq[MSG_SLOTS];
+static uint32_t slot_offset[MSG_SLOTS];
+/** Payload size of the record */
+static uint16_t slot_size[MSG_SLOTS];
+/** CRC32 of the stored text, tells if the message in RAM changed */
+static uint32_t slot_crc[MSG_SLOTS];
+
+static uint32_t next_seq = 1;
+static uint32_t log_size = 0;
+
+/** Records appended or copied by a compaction since boot */
+uint16_t g_user_data_writes = 0;
+
+/** Slots changed in RAM but not yet written, bit 0 of the first byte is message 1 */
+static uint8_t dirty_slots[(MSG_SLOTS + 7) / 8];
+static uint16_t dirty_num = 0;
+static uint32_t first_dirty = 0;
+static bool compact_pending = false;
+
+/** Commit quiet time or compaction delay */
+static SoftwareTimer store_timer;
 
 /**
- * @brief Initialize access to the file USER_FLASH_DATA in 
- * 		  the nRF52 internal file system
+ * @brief Get the text of a message
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param len receives the length without terminator, can be NULL
+ * @return const char* terminated text, empty for an invalid slot
  */
-void init_user_flash_data(void) {
+const char *get_message(uint8_t slot, uint16_t *len)
+{
+	if ((slot == 0) || (slot > MSG_SLOTS))
+	{
+		if (len != NULL)
+		{
+			*len = 0;
+		}
+		return "";
+	}
+	if (len != NULL)
+	{
+		*len = msg_offset[slot] - msg_offset[slot - 1] - 1;
+	}
+	return &msg_pool[msg_offset[slot - 1]];
+}
+
+/**
+ * @brief Replace the text of a message in the pool
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param text new text, a terminator ends it early
+ * @param len length of text
+ * @return true if the text fits into the pool
+ */
+static bool store_message(uint8_t slot, const char *text, uint16_t len)
+{
+	if ((slot == 0) || (slot > MSG_SLOTS) || (len > MSG_MAX_LEN))
+	{
+		return false;
+	}
+	len = strnlen(text, len);
+	uint16_t old_len;
+	get_message(slot, &old_len);
+	uint16_t used = msg_offset[MSG_SLOTS];
+	if ((used - old_len + len) > MSG_POOL_SIZE)
+	{
+		return false;
+	}
 
-    // Check if the USER_FLASH_DATA file exists
-	user_flash_data_file.open(user_flash_data_name, FILE_O_READ);
-	if (!user_flash_data_file)
+	// Move the following messages to their new place
+	char *start = &msg_pool[msg_offset[slot - 1]];
+	memmove(start + len + 1, start + old_len + 1, used - msg_offset[slot]);
+	memcpy(start, text, len);
+	start[len] = 0;
+	for (uint16_t idx = slot; idx <= MSG_SLOTS; idx++)
 	{
-		MYLOG("USER_FLASH_DATA", "The User Flash Data File doesn't exist, it's being created now");
-		delay(100);
-        if (user_flash_data_file.open(user_flash_data_name, FILE_O_WRITE))
-        {
-            s_user_flash_data user_flash_data_file_default;
-            user_flash_data_file.write((uint8_t *)&user_flash_data_file_default, sizeof(s_user_flash_data));
-            user_flash_data_file.flush();
-            user_flash_data_file.close();
-        }
-		user_flash_data_file.open(user_flash_data_name, FILE_O_READ);
+		msg_offset[idx] = msg_offset[idx] + len - old_len;
 	}
+	return true;
+}
+
+/**
+ * @brief Commit quiet time or compaction delay is over
+ */
+static void store_timer_cb(TimerHandle_t unused)
+{
+	(void)unused;
+	post_event(EVENT_SOURCE_TIMER, STORE_EVENT);
+}
+
+/**
+ * @brief Check if a slot waits for the next commit
+ */
+static bool is_dirty(uint8_t slot)
+{
+	return dirty_slots[(slot - 1) / 8] & (1 << ((slot - 1) % 8));
+}
 
-	uint8_t markers[2] = {0};
-	user_flash_data_file.read(markers, 2);
-	if ((markers[0] == 0xBA) && (markers[1] == MY_APP_DATA_MARKER))
+/**
+ * @brief The slot was written or changed back to what is stored
+ */
+static void clear_dirty(uint8_t slot)
+{
+	if (is_dirty(slot))
 	{
-		MYLOG("USER_FLASH_DATA", "Data markers for User Flash Data found");
-        user_flash_data_file.close();
+		dirty_slots[(slot - 1) / 8] &= ~(1 << ((slot - 1) % 8));
+		dirty_num--;
+	}
+}
 
-        user_flash_data_file.open(user_flash_data_name, FILE_O_READ);
-		user_flash_data_file.read((uint8_t *)&g_user_flash_data, sizeof(s_user_flash_data));
-		user_flash_data_file.close();
-		
-        // Check if it is User Flash Data
-		if ((g_user_flash_data.valid_mark_1 != 0xBA) || (g_user_flash_data.valid_mark_2 != MY_APP_DATA_MARKER))
-		{
-			// User Flash Data is not valid
-			MYLOG("USER_FLASH_DATA", "The User Flash Data file needs review, it was not loaded correctly");
-		} 
-        else 
-        {
-            MYLOG("USER_FLASH_DATA", "The User Flash Data file is OK, the data was loaded correctly");
-        }
-	} else {
-        MYLOG("USER_FLASH_DATA", "Markers for User Flash Data not found");
-    }
-}
-
-/**
- * @brief Save changed User Flash Data if required
- * 
- * @return boolean 
- * 			result of saving
+/**
+ * @brief A message was changed. The slot is written with the next commit,
+ * 		  changes that follow within the quiet time go into the same commit.
+ *
+ * @param slot message 1 to MSG_SLOTS
  */
-boolean save_user_flash_data(void)
+static void mark_user_flash_data(uint8_t slot)
 {
-	bool result = true;
-	// Read saved content
-	user_flash_data_file.open(user_flash_data_name, FILE_O_READ);
-	if (!user_flash_data_file)
-	{
-		API_LOG("FLASH", "File doesn't exist, force format");
-		delay(100);
-		// End the funtion excecution with performing flash_reset() 
-		// to keep the info from the LPWAN settings file
-		result = false;
-		return result;
-	}
-	user_flash_data_file.read((uint8_t *)&g_user_flash_data_flash_content, sizeof(s_user_flash_data));
+	// The screen is rendered again right away, the flash can wait
+	epd_cache_invalidate(slot);
+	epd_layout_invalidate(slot);
+	if (dirty_num == 0)
+	{
+		first_dirty = millis();
+	}
+	if (!is_dirty(slot))
+	{
+		dirty_slots[(slot - 1) / 8] |= 1 << ((slot - 1) % 8);
+		dirty_num++;
+	}
+	if (read_batt() < USER_DATA_LOW_BATT_MV)
+	{
+		// The battery may give up before the quiet time is over
+		save_user_flash_data();
+		return;
+	}
+	if ((millis() - first_dirty) < USER_DATA_COMMIT_MAX_MS)
+	{
+		store_timer.stop();
+		store_timer.setPeriod(USER_DATA_COMMIT_QUIET_MS);
+	}
+}
+
+/**
+ * @brief Change the text of a message and write it with the next commit
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @param text new text, a terminator ends it early
+ * @param len length of text, up to MSG_MAX_LEN
+ * @return true if the message was changed or already had this text
+ * @return false if the slot is invalid or the text does not fit
+ */
+bool set_message(uint8_t slot, const char *text, uint16_t len)
+{
+	uint16_t old_len;
+	const char *old_text = get_message(slot, &old_len);
+	if ((slot != 0) && (slot <= MSG_SLOTS) && (len <= MSG_MAX_LEN) && (strnlen(text, len) == old_len) &&
+		(memcmp(text, old_text, old_len) == 0))
+	{
+		// A campaign may send what the badge already shows, nothing to render or write
+		MYLOG("USER_FLASH_DATA", "Message %d unchanged", slot);
+		// The text shows again if an image hid it
+		remove_message_image(slot);
+		return true;
+	}
+	if (!store_message(slot, text, len))
+	{
+		MYLOG("USER_FLASH_DATA", "Message %d with %d bytes doesn't fit, %d of %d bytes used", slot, len,
+			  msg_offset[MSG_SLOTS], MSG_POOL_SIZE);
+		return false;
+	}
+	// The slot shows the new text instead of its image
+	remove_message_image(slot);
+	mark_user_flash_data(slot);
+	return true;
+}
+
+/**
+ * @brief Read the log and apply the newest valid record of every slot
+ *
+ * @return true if the whole log is valid
+ * @return false if the log ends with a damaged record
+ */
+static bool scan_log(void)
+{
+	log_size = 0;
+	if (!user_flash_data_file.open(user_data_log_name, FILE_O_READ))
+	{
+		return true;
+	}
+	uint32_t file_size = user_flash_data_file.size();
+	uint16_t records = 0;
+	uint8_t payload[MSG_MAX_LEN];
+	char text[MSG_MAX_LEN + 1];
+	while (log_size < file_size)
+	{
+		s_user_data_record header;
+		uint32_t crc;
+		if ((user_flash_data_file.read(&header, sizeof(header)) != sizeof(header)) ||
+			(header.mark_1 != 0xBA) || (header.mark_2 != MY_APP_DATA_MARKER) ||
+			(header.slot == 0) || (header.len > MSG_MAX_LEN))
+		{
+			break;
+		}
+		if ((user_flash_data_file.read(payload, header.len) != header.len) ||
+			(user_flash_data_file.read(&crc, sizeof(crc)) != sizeof(crc)))
+		{
+			break;
+		}
+		if (crc32_update(crc32_update(CRC32_INIT, (uint8_t *)&header, sizeof(header)), payload, header.len) != crc)
+		{
+			break;
+		}
+
+		// Records of slots beyond MSG_SLOTS are from a build with more messages
+		uint8_t idx = header.slot - 1;
+		if ((header.slot <= MSG_SLOTS) && (header.seq > slot_seq[idx]))
+		{
+			int16_t text_len = -1;
+			if (header.encoding == USER_DATA_PLAIN)
+			{
+				memcpy(text, payload, header.len);
+				text_len = header.len;
+			}
+			else if (header.encoding == USER_DATA_PACKED)
+			{
+				text_len = msg_decode(payload, header.len, text, sizeof(text));
+			}
+
+			if (text_len < 0)
+			{
+				MYLOG("USER_FLASH_DATA", "Record %lu has an unknown encoding", (unsigned long)header.seq);
+			}
+			else if (store_message(header.slot, text, text_len))
+			{
+				slot_seq[idx] = header.seq;
+				slot_offset[idx] = log_size;
+				slot_size[idx] = header.len;
+				slot_crc[idx] = crc32_update(CRC32_INIT, (uint8_t *)text, text_len);
+			}
+			else
+			{
+				MYLOG("USER_FLASH_DATA", "No room for message %d", header.slot);
+			}
+		}
+		if (header.seq >= next_seq)
+		{
+			next_seq = header.seq + 1;
+		}
+		log_size += USER_DATA_RECORD_SIZE(header.len);
+		records++;
+	}
 	user_flash_data_file.close();
-	if (memcmp((void *)&g_user_flash_data_flash_content, (void *)&g_user_flash_data, sizeof(s_user_flash_data)) != 0)
+	MYLOG("USER_FLASH_DATA", "Log has %d valid records in %lu of %lu bytes", records, (unsigned long)log_size,
+		  (unsigned long)file_size);
+	return log_size == file_size;
+}
+
+/**
+ * @brief Append a record to the opened log
+ *
+ * @param slot 1 to MSG_SLOTS
+ * @return true if the record was written completely
+ */
+static bool append_record(uint8_t slot)
+{
+	uint16_t len;
+	const char *text = get_message(slot, &len);
+
+	// Packed only if that saves space
+	uint8_t packed[MSG_MAX_LEN];
+	uint16_t packed_len = (len > 1) ? msg_encode(text, len, packed, len - 1, true) : 0;
+	s_user_data_record header = {0xBA, MY_APP_DATA_MARKER, slot, USER_DATA_PLAIN, len, next_seq};
+	const uint8_t *payload = (const uint8_t *)text;
+	if (packed_len != 0)
+	{
+		header.encoding = USER_DATA_PACKED;
+		header.len = packed_len;
+		payload = packed;
+	}
+	uint32_t crc = crc32_update(crc32_update(CRC32_INIT, (uint8_t *)&header, sizeof(header)), payload, header.len);
+
+	if ((user_flash_data_file.write((uint8_t *)&header, sizeof(header)) != sizeof(header)) ||
+		(user_flash_data_file.write(payload, header.len) != header.len) ||
+		(user_flash_data_file.write((uint8_t *)&crc, sizeof(crc)) != sizeof(crc)))
 	{
-		API_LOG("FLASH", "Flash content changed, writing new data");
-		delay(100);
+		// Drop the partial record, the next one has to start at a record boundary
+		user_flash_data_file.truncate(log_size);
+		return false;
+	}
 
+	uint8_t idx = slot - 1;
+	slot_seq[idx] = next_seq++;
+	slot_offset[idx] = log_size;
+	slot_size[idx] = header.len;
+	slot_crc[idx] = crc32_update(CRC32_INIT, (const uint8_t *)text, len);
+	log_size += USER_DATA_RECORD_SIZE(header.len);
+	g_user_data_writes++;
+	return true;
+}
+
+/**
+ * @brief Take the messages from the former USER_FLASH_DATA file
+ */
+static void import_user_flash_file(void)
+{
+	s_user_flash_data_v1 old_data;
+	if (user_flash_data_file.open(user_flash_data_name, FILE_O_READ))
+	{
+		int read = user_flash_data_file.read((uint8_t *)&old_data, sizeof(old_data));
+		user_flash_data_file.close();
+		if ((read == sizeof(old_data)) && (old_data.valid_mark_1 == 0xBA) && (old_data.valid_mark_2 == MY_APP_DATA_MARKER))
+		{
+			MYLOG("USER_FLASH_DATA", "Importing the User Flash Data file into the log");
+			for (uint8_t slot = 1; (slot <= 4) && (slot <= MSG_SLOTS); slot++)
+			{
+				set_message(slot, (char *)old_data.epd_msg[slot - 1], sizeof(old_data.epd_msg[0]));
+			}
+		}
+		else
+		{
+			MYLOG("USER_FLASH_DATA", "Markers for User Flash Data not found");
+		}
+	}
+	if (save_user_flash_data())
+	{
 		InternalFS.remove(user_flash_data_name);
+	}
+}
+
+/**
+ * @brief Initialize access to the user data log in
+ * 		  the nRF52 internal file system and load the messages
+ */
+void init_user_flash_data(void) {
 
-		if (user_flash_data_file.open(user_flash_data_name, FILE_O_WRITE))
+	// A compaction that was interrupted left either a partial copy or no log
+	if (InternalFS.exists(user_data_new_name))
+	{
+		if (InternalFS.exists(user_data_log_name))
 		{
-			user_flash_data_file.write((uint8_t *)&g_user_flash_data, sizeof(s_user_flash_data));
-			user_flash_data_file.flush();
+			InternalFS.remove(user_data_new_name);
 		}
 		else
+		{
+			InternalFS.rename(user_data_new_name, user_data_log_name);
+		}
+	}
+
+	// Slots without a record keep their default message
+	msg_offset[0] = 0;
+	for (uint8_t slot = 1; slot <= MSG_SLOTS; slot++)
+	{
+		msg_pool[msg_offset[slot - 1]] = 0;
+		msg_offset[slot] = msg_offset[slot - 1] + 1;
+	}
+	for (uint8_t slot = 1; slot <= MSG_SLOTS; slot++)
+	{
+		if (slot <= DEFAULT_MSGS_NUM)
+		{
+			store_message(slot, default_msgs[slot - 1], strlen(default_msgs[slot - 1]));
+		}
+		uint16_t len;
+		const char *text = get_message(slot, &len);
+		slot_seq[slot - 1] = 0;
+		slot_crc[slot - 1] = crc32_update(CRC32_INIT, (const uint8_t *)text, len);
+	}
+
+	store_timer.begin(USER_DATA_COMMIT_QUIET_MS, store_timer_cb, NULL, false);
+
+	if (!scan_log())
+	{
+		// Nothing can be appended behind a damaged record
+		MYLOG("USER_FLASH_DATA", "The log ends with a damaged record, compacting it");
+		compact_user_flash_data();
+	}
+
+	if ((next_seq == 1) && InternalFS.exists(user_flash_data_name))
+	{
+		import_user_flash_file();
+	}
+}
+
+/**
+ * @brief Check for changes that are not written yet
+ */
+bool user_flash_data_dirty(void)
+{
+	return dirty_num != 0;
+}
+
+/**
+ * @brief Commit the changed messages. Only slots that differ from their
+ * 		  stored record are appended to the log.
+ *
+ * @return boolean
+ * 			result of saving
+ */
+boolean save_user_flash_data(void)
+{
+	bool result = true;
+	bool changed = false;
+	for (uint8_t slot = 1; (slot <= MSG_SLOTS) && (dirty_num != 0); slot++)
+	{
+		if (!is_dirty(slot))
+		{
+			continue;
+		}
+		uint16_t len;
+		const char *text = get_message(slot, &len);
+		if (crc32_update(CRC32_INIT, (const uint8_t *)text, len) == slot_crc[slot - 1])
+		{
+			// Changed back to what is stored
+			clear_dirty(slot);
+			continue;
+		}
+		if (!changed)
+		{
+			API_LOG("FLASH", "Flash content changed, appending new records");
+			if (!user_flash_data_file.open(user_data_log_name, FILE_O_WRITE))
+			{
+				API_LOG("FLASH", "Log can't be opened");
+				result = false;
+				break;
+			}
+			changed = true;
+		}
+		if (!append_record(slot))
 		{
 			result = false;
+			break;
 		}
+		clear_dirty(slot);
+	}
+	if (changed)
+	{
+		user_flash_data_file.flush();
 		user_flash_data_file.close();
+		log_user_flash_data();
+	}
+
+	if (dirty_num != 0)
+	{
+		// Try again after another quiet time
+		first_dirty = millis();
+		store_timer.stop();
+		store_timer.setPeriod(USER_DATA_COMMIT_QUIET_MS);
+	}
+	else if (log_size > USER_DATA_COMPACT_SIZE)
+	{
+		compact_pending = true;
+		store_timer.stop();
+		store_timer.setPeriod(USER_DATA_COMPACT_DELAY_MS);
+	}
+	else
+	{
+		store_timer.stop();
 	}
-	log_user_flash_data();
 	return result;
 }
 
+/**
+ * @brief Copy the newest record of every slot into a new log and replace
+ * 		  the old one. The old log stays valid until the copy is complete.
+ *
+ * @return true if the log was compacted or there was nothing to do
+ */
+bool compact_user_flash_data(void)
+{
+	compact_pending = false;
+
+	File old_log(InternalFS);
+	if (!old_log.open(user_data_log_name, FILE_O_READ))
+	{
+		return true;
+	}
+	uint32_t old_size = old_log.size();
+
+	InternalFS.remove(user_data_new_name);
+	if (!user_flash_data_file.open(user_data_new_name, FILE_O_WRITE))
+	{
+		old_log.close();
+		return false;
+	}
+
+	bool result = true;
+	uint8_t record[USER_DATA_RECORD_SIZE(MSG_MAX_LEN)];
+	uint32_t new_offset[MSG_SLOTS];
+	uint32_t new_size = 0;
+	for (uint8_t idx = 0; idx < MSG_SLOTS; idx++)
+	{
+		if (slot_seq[idx] == 0)
+		{
+			continue;
+		}
+		uint16_t record_size = USER_DATA_RECORD_SIZE(slot_size[idx]);
+		if (!old_log.seek(slot_offset[idx]) || (old_log.read(record, record_size) != record_size) ||
+			(user_flash_data_file.write(record, record_size) != record_size))
+		{
+			result = false;
+			break;
+		}
+		new_offset[idx] = new_size;
+		new_size += record_size;
+		g_user_data_writes++;
+	}
+	user_flash_data_file.flush();
+	user_flash_data_file.close();
+	old_log.close();
+
+	if (!result)
+	{
+		API_LOG("FLASH", "Log compaction failed");
+		InternalFS.remove(user_data_new_name);
+		return false;
+	}
+
+	InternalFS.remove(user_data_log_name);
+	InternalFS.rename(user_data_new_name, user_data_log_name);
+	for (uint8_t idx = 0; idx < MSG_SLOTS; idx++)
+	{
+		if (slot_seq[idx] != 0)
+		{
+			slot_offset[idx] = new_offset[idx];
+		}
+	}
+	log_size = new_size;
+	MYLOG("USER_FLASH_DATA", "Log compacted from %lu to %lu bytes", (unsigned long)old_size, (unsigned long)new_size);
+	return true;
+}
+
 /**
  * @brief Printout of all User Flash Data
- * 
+ *
  */
 void log_user_flash_data(void)
 {
 	MYLOG("USER_FLASH_DATA", "Saved User Flash Data:");
-	MYLOG("USER_FLASH_DATA", "000 Marks: %02X %02X", g_user_flash_data.valid_mark_1, g_user_flash_data.valid_mark_2);
-	MYLOG("USER_FLASH_DATA", "002 Message 1: %.80s", g_user_flash_data.epd_msg_1);
-	MYLOG("USER_FLASH_DATA", "082 Message 2: %.80s", g_user_flash_data.epd_msg_2);
-	MYLOG("USER_FLASH_DATA", "162 Message 3: %.80s", g_user_flash_data.epd_msg_3);
-	MYLOG("USER_FLASH_DATA", "242 Message 4: %.80s", g_user_flash_data.epd_msg_4);
-}
\ No newline at end of file
+	MYLOG("USER_FLASH_DATA", "Log %lu bytes, next sequence %lu, pool %d of %d bytes", (unsigned long)log_size,
+		  (unsigned long)next_seq, msg_offset[MSG_SLOTS], MSG_POOL_SIZE);
+	for (uint8_t slot = 1; slot <= MSG_SLOTS; slot++)
+	{
+		MYLOG("USER_FLASH_DATA", "Message %d (seq %lu): %s", slot, (unsigned long)slot_seq[slot - 1], get_message(slot, NULL));
+	}
+}
+
+/**
+ * @brief Commit quiet time or compaction delay is over
+ */
+void handle_store_event(void)
+{
+	if (dirty_num != 0)
+	{
+		save_user_flash_data();
+	}
+	else if (compact_pending)
+	{
+		compact_user_flash_data();
+	}
+}
@@ -0,0 +1,155 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Drawing in bands has to leave the same panel RAM as drawing into
+ *        the framebuffer. env:native draws the boot screen and every
+ *        message and rewrites the black/white and red RAM of the simulated
+ *        SSD1680 in the build directory on every run. The envs with
+ *        EPD_BAND_ROWS draw the same screens and compare them byte by
+ *        byte, so they run in the same invocation after env:native:
+ *
+ *        pio test -e native -e native_band1 -e native_band7 -e native_band16
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "app.h"
+#include "epd_driver.h"
+#include "sim.h"
+
+/** Build directory of PlatformIO, shared by all envs */
+#ifndef TEST_BUILD_DIR
+#define TEST_BUILD_DIR ".pio/build"
+#endif
+#define REFERENCE_FILE TEST_BUILD_DIR "/test_bands.bin"
+
+/** Longer than any refresh of the simulated panel */
+#define REFRESH_MS 5000
+
+/** Bytes of one RAM of the controller */
+#define RAM_SIZE (SSD1680_RAM_X_BYTES * SSD1680_RAM_Y)
+
+/** Boot screen, the messages and the RAK logo */
+#define SCREEN_NUM (1 + MSG_LOGO)
+
+/** Both RAMs of the controller after a screen was shown */
+struct s_screen_ram
+{
+	uint8_t bw[RAM_SIZE];
+	uint8_t red[RAM_SIZE];
+};
+static s_screen_ram screens[SCREEN_NUM];
+
+/**
+ * @brief Copy both RAMs of the simulated panel
+ */
+static void capture(s_screen_ram &screen)
+{
+	uint16_t row_bytes;
+	uint16_t rows;
+	memcpy(screen.bw, sim_ssd1680_bw_ram(&row_bytes, &rows), sizeof(screen.bw));
+	memcpy(screen.red, sim_ssd1680_red_ram(&row_bytes, &rows), sizeof(screen.red));
+}
+
+/**
+ * @brief Byte by byte comparison that names the first differing gate line
+ */
+static void compare(const uint8_t *expected, const uint8_t *actual, const char *what, uint8_t screen)
+{
+	for (uint32_t idx = 0; idx < RAM_SIZE; idx++)
+	{
+		if (expected[idx] != actual[idx])
+		{
+			char message[80];
+			snprintf(message, sizeof(message), "%s RAM of screen %d differs in gate line %lu", what, screen,
+					 (unsigned long)(idx / SSD1680_RAM_X_BYTES));
+			TEST_FAIL_MESSAGE(message);
+		}
+	}
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Show the boot screen, every message and the logo one after the
+ *        other, the sequence of full and partial refreshes is the same in
+ *        every env
+ */
+static void test_show_screens(void)
+{
+	sim_start();
+	sim_run(REFRESH_MS);
+	capture(screens[0]);
+	for (uint8_t msg_num = 1; msg_num <= MSG_LOGO; msg_num++)
+	{
+		uint32_t refreshes = g_sim.epd_full_refreshes + g_sim.epd_partial_refreshes;
+		gMsgNum = msg_num;
+		switch_epd_message();
+		sim_run(REFRESH_MS);
+		TEST_ASSERT_EQUAL_UINT32(refreshes + 1, g_sim.epd_full_refreshes + g_sim.epd_partial_refreshes);
+		capture(screens[msg_num]);
+	}
+}
+
+/**
+ * @brief Every screen leaves the red RAM equal to the black/white RAM,
+ *        it is the reference of the next partial refresh
+ */
+static void test_red_ram_follows(void)
+{
+	for (uint8_t screen = 0; screen < SCREEN_NUM; screen++)
+	{
+		compare(screens[screen].bw, screens[screen].red, "Red", screen);
+	}
+}
+
+/**
+ * @brief The RAMs are the same with and without bands
+ */
+static void test_same_as_framebuffer(void)
+{
+#if EPD_BAND_ROWS == 0
+	FILE *file = fopen(REFERENCE_FILE, "wb");
+	TEST_ASSERT_NOT_NULL(file);
+	TEST_ASSERT_EQUAL_UINT32(1, fwrite(screens, sizeof(screens), 1, file));
+	fclose(file);
+#else
+	static s_screen_ram reference[SCREEN_NUM];
+	FILE *file = fopen(REFERENCE_FILE, "rb");
+	if (file == NULL)
+	{
+		TEST_FAIL_MESSAGE("No reference, run env:native in the same pio test invocation before the band envs");
+	}
+	size_t read = fread(reference, sizeof(reference), 1, file);
+	fclose(file);
+	TEST_ASSERT_EQUAL_UINT32(1, read);
+	for (uint8_t screen = 0; screen < SCREEN_NUM; screen++)
+	{
+		compare(reference[screen].bw, screens[screen].bw, "Black/white", screen);
+		compare(reference[screen].red, screens[screen].red, "Red", screen);
+	}
+#endif
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	UNITY_BEGIN();
+	RUN_TEST(test_show_screens);
+	RUN_TEST(test_red_ram_follows);
+	RUN_TEST(test_same_as_framebuffer);
+	return UNITY_END();
+}
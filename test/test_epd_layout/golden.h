@@ -0,0 +1,685 @@
+/**
+ * @file golden.h
+ * @author agent (agent@local)
+ * @brief Golden layouts and frames of test_main.cpp, printed by it
+ *        with -DEPD_LAYOUT_GOLDEN_WRITE
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+static const s_epd_layout golden_classic[] = {
+	{3, 4, {{2, 8, 54, 13}, {11, 8, 54, 37}, {20, 10, 36, 61}, {31, 8, 54, 85}}},
+	{3, 4, {{0, 9, 45, 13}, {10, 13, 9, 37}, {24, 13, 9, 61}, {38, 5, 81, 85}}},
+	{3, 4, {{3, 12, 18, 13}, {16, 11, 27, 37}, {28, 8, 54, 61}, {43, 1, 117, 85}}},
+	{2, 4, {{0, 18, 18, 29}, {20, 19, 12, 45}, {40, 16, 30, 61}, {60, 5, 96, 77}}},
+	{3, 2, {{5, 13, 9, 37}, {22, 12, 18, 61}}},
+	{3, 4, {{0, 7, 63, 13}, {7, 12, 18, 37}, {20, 12, 18, 61}, {33, 12, 18, 85}}},
+	{1, 5, {{0, 40, 5, 41}, {40, 40, 5, 49}, {80, 40, 5, 57}, {120, 40, 5, 65}, {160, 23, 56, 73}}},
+	{1, 14, {{0, 1, 122, 5}, {2, 1, 122, 13}, {4, 1, 122, 21}, {6, 1, 122, 29}, {8, 1, 122, 37}, {10, 1, 122, 45}, {12, 1, 122, 53}, {14, 1, 122, 61}, {16, 1, 122, 69}, {18, 2, 119, 77}, {21, 2, 119, 85}, {24, 2, 119, 93}, {27, 2, 119, 101}, {30, 2, 119, 109}}},
+};
+
+static const s_epd_layout golden_gfx[] = {
+	{3, 3, {{2, 8, 69, 34}, {11, 14, 9, 70}, {26, 13, 29, 106}}},
+	{3, 3, {{0, 14, 14, 34}, {15, 14, 23, 70}, {30, 13, 21, 106}}},
+	{3, 2, {{3, 14, 18, 52}, {26, 18, 11, 88}}},
+	{2, 3, {{0, 18, 30, 43}, {20, 19, 31, 67}, {40, 25, 7, 91}}},
+	{3, 2, {{5, 13, 27, 52}, {22, 12, 36, 88}}},
+	{2, 3, {{0, 19, 23, 43}, {20, 17, 31, 67}, {37, 8, 79, 91}}},
+	{1, 5, {{0, 44, 4, 40}, {44, 43, 4, 52}, {87, 43, 4, 64}, {130, 44, 4, 76}, {174, 9, 100, 88}}},
+	{1, 9, {{0, 1, 122, 16}, {2, 1, 122, 28}, {4, 1, 123, 40}, {6, 1, 123, 52}, {8, 1, 122, 64}, {10, 1, 123, 76}, {12, 1, 122, 88}, {14, 1, 122, 100}, {16, 1, 123, 112}}},
+};
+
+static const uint8_t golden_frame_0[] = {
+	0x81, 0x00, 0x99, 0x00, 0x08, 0x07, 0x1C, 0x00, 0x00, 0x03, 0xF0, 0x00, 0x03, 0xF0, 0xEA, 0x00,
+	0x08, 0x07, 0x1C, 0x00, 0x00, 0x03, 0xF0, 0x00, 0x03, 0xF0, 0xEA, 0x00, 0x08, 0x07, 0x1C, 0x00,
+	0x00, 0x03, 0xF0, 0x00, 0x03, 0xF0, 0xE9, 0x00, 0x07, 0xFC, 0x00, 0x00, 0x03, 0x80, 0x00, 0x1C,
+	0x7E, 0xE9, 0x00, 0x07, 0xFC, 0x00, 0x00, 0x03, 0x80, 0x00, 0x1C, 0x7E, 0xE9, 0x00, 0x07, 0xFC,
+	0x00, 0x00, 0x03, 0x80, 0x00, 0x1C, 0x7E, 0xE9, 0x00, 0x07, 0xE0, 0x00, 0x00, 0x1F, 0x80, 0x00,
+	0x03, 0x8E, 0xE9, 0x00, 0x07, 0xE0, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0xE9, 0x00, 0x07,
+	0xE0, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0xEA, 0x00, 0x0E, 0x07, 0xE0, 0x0F, 0xC0, 0x1C,
+	0x70, 0x00, 0x1C, 0x70, 0x00, 0x03, 0x8E, 0x00, 0x1C, 0x70, 0xF0, 0x00, 0x0E, 0x07, 0xE0, 0x0F,
+	0xC0, 0x1C, 0x70, 0x00, 0x1C, 0x70, 0x00, 0x03, 0x8E, 0x00, 0x1C, 0x70, 0xF0, 0x00, 0x0E, 0x07,
+	0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0x00, 0x1C, 0x70, 0x00, 0x03, 0x8E, 0x00, 0x1C, 0x70, 0xF0, 0x00,
+	0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x1C, 0x70, 0x00, 0x1F, 0x8E, 0x00, 0x03, 0xF1, 0xC0, 0xE3, 0x80,
+	0xF0, 0x00, 0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x1C, 0x70, 0x00, 0x1F, 0x8E, 0x00, 0x03, 0xF1, 0xC0,
+	0xE3, 0x80, 0xF0, 0x00, 0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x1C, 0x70, 0x00, 0x1F, 0x8E, 0x00, 0x03,
+	0xF1, 0xC0, 0xE3, 0x80, 0xF0, 0x00, 0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x03, 0xF0, 0x00, 0x03, 0xF0,
+	0x00, 0x00, 0x7E, 0x00, 0xFC, 0x70, 0xF0, 0x00, 0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x03, 0xF0, 0x00,
+	0x03, 0xF0, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x70, 0xF0, 0x00, 0x0E, 0x07, 0x1C, 0x0E, 0x38, 0x03,
+	0xF0, 0x00, 0x03, 0xF0, 0x00, 0x00, 0x7E, 0x00, 0xFC, 0x70, 0xEF, 0x00, 0x0D, 0xFC, 0x01, 0xF8,
+	0x03, 0x80, 0x00, 0x1C, 0x7E, 0x00, 0x03, 0x8F, 0xC0, 0x1F, 0x80, 0xEF, 0x00, 0x0D, 0xFC, 0x01,
+	0xF8, 0x03, 0x80, 0x00, 0x1C, 0x7E, 0x00, 0x03, 0x8F, 0xC0, 0x1F, 0x80, 0xEF, 0x00, 0x0D, 0xFC,
+	0x01, 0xF8, 0x03, 0x80, 0x00, 0x1C, 0x7E, 0x00, 0x03, 0x8F, 0xC0, 0x1F, 0x80, 0xEF, 0x00, 0x0D,
+	0xE0, 0x01, 0xC0, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0x00, 0x00, 0x71, 0xC0, 0xE3, 0xF0, 0xEF, 0x00,
+	0x0D, 0xE0, 0x01, 0xC0, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0x00, 0x00, 0x71, 0xC0, 0xE3, 0xF0, 0xEF,
+	0x00, 0x0D, 0xE0, 0x01, 0xC0, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0x00, 0x00, 0x71, 0xC0, 0xE3, 0xF0,
+	0xF0, 0x00, 0x0E, 0x07, 0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0x00, 0x1C, 0x70, 0x00, 0x03, 0x8E, 0x00,
+	0x1C, 0x70, 0xF0, 0x00, 0x0E, 0x07, 0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0x00, 0x1C, 0x70, 0x00, 0x03,
+	0x8E, 0x00, 0x1C, 0x70, 0xF0, 0x00, 0x0E, 0x07, 0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0x00, 0x1C, 0x70,
+	0x00, 0x03, 0x8E, 0x00, 0x1C, 0x70, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xB7, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x01, 0xC7, 0xE0, 0x00, 0x3F, 0x1C, 0x0F, 0xC7, 0x03, 0x8E, 0x00, 0xFC, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x01, 0xC7, 0xE0, 0x00, 0x3F, 0x1C, 0x0F, 0xC7, 0x03, 0x8E, 0x00, 0xFC, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x01, 0xC7, 0xE0, 0x00, 0x3F, 0x1C, 0x0F, 0xC7, 0x03, 0x8E, 0x00, 0xFC, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x00, 0x38, 0xE0, 0x00, 0x07, 0xE0, 0x0F, 0xC7, 0x00, 0x7E, 0x00, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x00, 0x38, 0xE0, 0x00, 0x07, 0xE0, 0x0F, 0xC7, 0x00, 0x7E, 0x00, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xE3, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0x8E, 0x3F, 0x1C,
+	0x00, 0x38, 0xE0, 0x00, 0x07, 0xE0, 0x0F, 0xC7, 0x00, 0x7E, 0x00, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1F, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x7E, 0x3F, 0x1C,
+	0x01, 0xC7, 0x00, 0x00, 0x38, 0xFC, 0x0F, 0xC7, 0x00, 0x70, 0x07, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1F, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x7E, 0x3F, 0x1C,
+	0x01, 0xC7, 0x00, 0x00, 0x38, 0xFC, 0x0F, 0xC7, 0x00, 0x70, 0x07, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1F, 0x8F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x7E, 0x3F, 0x1C,
+	0x01, 0xC7, 0x00, 0x00, 0x38, 0xFC, 0x0F, 0xC7, 0x00, 0x70, 0x07, 0xE0, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1C, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x70, 0x3F, 0x1C,
+	0x01, 0xF8, 0xE0, 0x00, 0x07, 0x1C, 0x0F, 0xC7, 0x03, 0xF0, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1C, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x70, 0x3F, 0x1C,
+	0x01, 0xF8, 0xE0, 0x00, 0x07, 0x1C, 0x0F, 0xC7, 0x03, 0xF0, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x1C, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x00, 0x70, 0x3F, 0x1C,
+	0x01, 0xF8, 0xE0, 0x00, 0x07, 0x1C, 0x0F, 0xC7, 0x03, 0xF0, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xFE, 0x00,
+	0x1C, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC7, 0x00, 0x71, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x00, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC7, 0x03, 0x8E, 0x07, 0x1C, 0x71, 0xF8, 0xEF, 0x00,
+	0x02, 0x01, 0xC7, 0xE0, 0xE4, 0x00, 0x02, 0x01, 0xC7, 0xE0, 0xE4, 0x00, 0x02, 0x01, 0xC7, 0xE0,
+	0xE3, 0x00, 0x01, 0x38, 0xE0, 0xE3, 0x00, 0x01, 0x38, 0xE0, 0xE3, 0x00, 0x01, 0x38, 0xE0, 0xE4,
+	0x00, 0x01, 0x01, 0xC7, 0xE3, 0x00, 0x01, 0x01, 0xC7, 0xE3, 0x00, 0x01, 0x01, 0xC7, 0xEA, 0x00,
+	0x05, 0x07, 0x1F, 0x80, 0x07, 0x1F, 0x80, 0xE7, 0x00, 0x05, 0x07, 0x1F, 0x80, 0x07, 0x1F, 0x80,
+	0xE7, 0x00, 0x05, 0x07, 0x1F, 0x80, 0x07, 0x1F, 0x80, 0xE6, 0x00, 0x04, 0xE3, 0x80, 0x00, 0xE3,
+	0x80, 0xE6, 0x00, 0x04, 0xE3, 0x80, 0x00, 0xE3, 0x80, 0xE6, 0x00, 0x04, 0xE3, 0x80, 0x00, 0xE3,
+	0x80, 0xE7, 0x00, 0x04, 0x07, 0x1C, 0x00, 0x07, 0x1C, 0xE6, 0x00, 0x04, 0x07, 0x1C, 0x00, 0x07,
+	0x1C, 0xE6, 0x00, 0x04, 0x07, 0x1C, 0x00, 0x07, 0x1C, 0xEB, 0x00, 0x17, 0xE3, 0xF0, 0x38, 0xE0,
+	0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE3, 0x81, 0xC7, 0x03, 0xF0, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x7E,
+	0x07, 0x1C, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0xE3, 0xF0, 0x38, 0xE0, 0x71, 0xC7, 0xE3, 0x80, 0x07,
+	0xE3, 0x81, 0xC7, 0x03, 0xF0, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x7E, 0x07, 0x1C, 0x0E, 0x38, 0xF9,
+	0x00, 0x17, 0xE3, 0xF0, 0x38, 0xE0, 0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE3, 0x81, 0xC7, 0x03, 0xF0,
+	0x07, 0x1F, 0x80, 0x00, 0x1C, 0x7E, 0x07, 0x1C, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0x1C, 0x70, 0x38,
+	0xE0, 0x0F, 0xC0, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xC7, 0x1C, 0x7E, 0x07, 0x1F, 0x80, 0x00, 0x03,
+	0x8E, 0x07, 0x1C, 0x01, 0xF8, 0xF9, 0x00, 0x17, 0x1C, 0x70, 0x38, 0xE0, 0x0F, 0xC0, 0xFC, 0x00,
+	0x00, 0xFC, 0x01, 0xC7, 0x1C, 0x7E, 0x07, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0x07, 0x1C, 0x01, 0xF8,
+	0xF9, 0x00, 0x17, 0x1C, 0x70, 0x38, 0xE0, 0x0F, 0xC0, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xC7, 0x1C,
+	0x7E, 0x07, 0x1F, 0x80, 0x00, 0x03, 0x8E, 0x07, 0x1C, 0x01, 0xF8, 0xF9, 0x00, 0x17, 0xE3, 0x80,
+	0x07, 0xE0, 0x0E, 0x07, 0x1F, 0x80, 0x07, 0x1F, 0x80, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0x00,
+	0x1C, 0x70, 0x00, 0xFC, 0x01, 0xC0, 0xF9, 0x00, 0x17, 0xE3, 0x80, 0x07, 0xE0, 0x0E, 0x07, 0x1F,
+	0x80, 0x07, 0x1F, 0x80, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x70, 0x00, 0xFC, 0x01,
+	0xC0, 0xF9, 0x00, 0x17, 0xE3, 0x80, 0x07, 0xE0, 0x0E, 0x07, 0x1F, 0x80, 0x07, 0x1F, 0x80, 0x3F,
+	0x03, 0x8E, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x70, 0x00, 0xFC, 0x01, 0xC0, 0xF9, 0x00, 0x17, 0xFC,
+	0x70, 0x07, 0x00, 0x7E, 0x00, 0xE3, 0x80, 0x00, 0xE3, 0x80, 0x38, 0x1C, 0x70, 0x07, 0x1F, 0x80,
+	0x00, 0x1F, 0x8E, 0x00, 0xE0, 0x0F, 0xC0, 0xF9, 0x00, 0x17, 0xFC, 0x70, 0x07, 0x00, 0x7E, 0x00,
+	0xE3, 0x80, 0x00, 0xE3, 0x80, 0x38, 0x1C, 0x70, 0x07, 0x1F, 0x80, 0x00, 0x1F, 0x8E, 0x00, 0xE0,
+	0x0F, 0xC0, 0xF9, 0x00, 0x17, 0xFC, 0x70, 0x07, 0x00, 0x7E, 0x00, 0xE3, 0x80, 0x00, 0xE3, 0x80,
+	0x38, 0x1C, 0x70, 0x07, 0x1F, 0x80, 0x00, 0x1F, 0x8E, 0x00, 0xE0, 0x0F, 0xC0, 0xF9, 0x00, 0x17,
+	0x1F, 0x80, 0x3F, 0x00, 0x71, 0xC7, 0x1C, 0x00, 0x07, 0x1C, 0x01, 0xF8, 0x1F, 0x8E, 0x07, 0x1F,
+	0x80, 0x00, 0x03, 0xF0, 0x07, 0xE0, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0x1F, 0x80, 0x3F, 0x00, 0x71,
+	0xC7, 0x1C, 0x00, 0x07, 0x1C, 0x01, 0xF8, 0x1F, 0x8E, 0x07, 0x1F, 0x80, 0x00, 0x03, 0xF0, 0x07,
+	0xE0, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0x1F, 0x80, 0x3F, 0x00, 0x71, 0xC7, 0x1C, 0x00, 0x07, 0x1C,
+	0x01, 0xF8, 0x1F, 0x8E, 0x07, 0x1F, 0x80, 0x00, 0x03, 0xF0, 0x07, 0xE0, 0x0E, 0x38, 0xF9, 0x00,
+	0x17, 0xE3, 0xF0, 0x38, 0xE0, 0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE3, 0x81, 0xC7, 0x03, 0xF0, 0x07,
+	0x1F, 0x80, 0x00, 0x1C, 0x7E, 0x07, 0x1C, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0xE3, 0xF0, 0x38, 0xE0,
+	0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE3, 0x81, 0xC7, 0x03, 0xF0, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x7E,
+	0x07, 0x1C, 0x0E, 0x38, 0xF9, 0x00, 0x17, 0xE3, 0xF0, 0x38, 0xE0, 0x71, 0xC7, 0xE3, 0x80, 0x07,
+	0xE3, 0x81, 0xC7, 0x03, 0xF0, 0x07, 0x1F, 0x80, 0x00, 0x1C, 0x7E, 0x07, 0x1C, 0x0E, 0x38, 0xF9,
+	0x00, 0x01, 0x1C, 0x70, 0xF1, 0x00, 0x01, 0x03, 0x8E, 0xF5, 0x00, 0x01, 0x1C, 0x70, 0xF1, 0x00,
+	0x01, 0x03, 0x8E, 0xF5, 0x00, 0x01, 0x1C, 0x70, 0xF1, 0x00, 0x01, 0x03, 0x8E, 0xF5, 0x00, 0x01,
+	0xE3, 0x80, 0xF1, 0x00, 0x01, 0x1C, 0x70, 0xF5, 0x00, 0x01, 0xE3, 0x80, 0xF1, 0x00, 0x01, 0x1C,
+	0x70, 0xF5, 0x00, 0x01, 0xE3, 0x80, 0xF1, 0x00, 0x01, 0x1C, 0x70, 0xF5, 0x00, 0x01, 0xFC, 0x70,
+	0xF1, 0x00, 0x01, 0x1F, 0x8E, 0xF5, 0x00, 0x01, 0xFC, 0x70, 0xF1, 0x00, 0x01, 0x1F, 0x8E, 0xF5,
+	0x00, 0x01, 0xFC, 0x70, 0xF1, 0x00, 0x01, 0x1F, 0x8E, 0x81, 0x00, 0x99, 0x00,
+};
+
+static const uint8_t golden_frame_1[] = {
+	0x81, 0x00, 0x9F, 0x00, 0x01, 0x0F, 0xC0, 0xFE, 0x00, 0x01, 0x1F, 0x80, 0xE8, 0x00, 0x01, 0x0F,
+	0xC0, 0xFE, 0x00, 0x01, 0x1F, 0x80, 0xE8, 0x00, 0x01, 0x0F, 0xC0, 0xFE, 0x00, 0x01, 0x1F, 0x80,
+	0xE8, 0x00, 0x01, 0x71, 0xF8, 0xFE, 0x00, 0x01, 0xE3, 0xF0, 0xE8, 0x00, 0x01, 0x71, 0xF8, 0xFE,
+	0x00, 0x01, 0xE3, 0xF0, 0xE8, 0x00, 0x01, 0x71, 0xF8, 0xFE, 0x00, 0x01, 0xE3, 0xF0, 0xE8, 0x00,
+	0x01, 0x0E, 0x38, 0xFE, 0x00, 0x01, 0x1C, 0x70, 0xE8, 0x00, 0x01, 0x0E, 0x38, 0xFE, 0x00, 0x01,
+	0x1C, 0x70, 0xE8, 0x00, 0x01, 0x0E, 0x38, 0xFE, 0x00, 0x01, 0x1C, 0x70, 0xE8, 0x00, 0x1B, 0x71,
+	0xC0, 0xE3, 0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F,
+	0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71, 0xC0,
+	0xE3, 0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00,
+	0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71, 0xC0, 0xE3,
+	0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00,
+	0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x7E, 0x38, 0x1F, 0x80,
+	0x00, 0xFC, 0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38,
+	0xFC, 0x0E, 0x3F, 0x03, 0xF1, 0xC7, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x7E, 0x38, 0x1F, 0x80, 0x00,
+	0xFC, 0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC,
+	0x0E, 0x3F, 0x03, 0xF1, 0xC7, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x7E, 0x38, 0x1F, 0x80, 0x00, 0xFC,
+	0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E,
+	0x3F, 0x03, 0xF1, 0xC7, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x0F, 0xC0, 0x1C, 0x00, 0x00, 0x1F, 0x80,
+	0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F,
+	0x00, 0x7E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x0F, 0xC0, 0x1C, 0x00, 0x00, 0x1F, 0x80, 0x00,
+	0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x00,
+	0x7E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x0F, 0xC0, 0x1C, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x1C,
+	0x71, 0xC7, 0xE3, 0x80, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x7E,
+	0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71, 0xF8, 0xFC, 0x00, 0x00, 0xE3, 0xF0, 0x00, 0x1C, 0x71,
+	0xC7, 0xE3, 0x80, 0x07, 0x00, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8F, 0xC7,
+	0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71, 0xF8, 0xFC, 0x00, 0x00, 0xE3, 0xF0, 0x00, 0x1C, 0x71, 0xC7,
+	0xE3, 0x80, 0x07, 0x00, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8F, 0xC7, 0x1F,
+	0x80, 0xFD, 0x00, 0x1B, 0x71, 0xF8, 0xFC, 0x00, 0x00, 0xE3, 0xF0, 0x00, 0x1C, 0x71, 0xC7, 0xE3,
+	0x80, 0x07, 0x00, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8F, 0xC7, 0x1F, 0x80,
+	0xFD, 0x00, 0x1B, 0x0E, 0x38, 0xE3, 0x80, 0x00, 0x1C, 0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80,
+	0x3F, 0x00, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x71, 0xC7, 0x1F, 0x80, 0xFD,
+	0x00, 0x1B, 0x0E, 0x38, 0xE3, 0x80, 0x00, 0x1C, 0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x3F,
+	0x00, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x71, 0xC7, 0x1F, 0x80, 0xFD, 0x00,
+	0x1B, 0x0E, 0x38, 0xE3, 0x80, 0x00, 0x1C, 0x70, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x3F, 0x00,
+	0x0E, 0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x71, 0xC7, 0x1F, 0x80, 0xFD, 0x00, 0x1B,
+	0x71, 0xC0, 0xE3, 0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E,
+	0x3F, 0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71,
+	0xC0, 0xE3, 0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F,
+	0x00, 0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0xFD, 0x00, 0x1B, 0x71, 0xC0,
+	0xE3, 0x80, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0x71, 0xC7, 0xE3, 0x80, 0x38, 0xE0, 0x0E, 0x3F, 0x00,
+	0x00, 0x38, 0xFC, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0x81, 0x00, 0x81, 0x00, 0xCF, 0x00,
+	0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01,
+	0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C,
+	0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xE3, 0x00, 0x01, 0x1C, 0x7E, 0xF0, 0x00, 0x19, 0x3F, 0x03,
+	0x8E, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x03, 0xF0,
+	0x38, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xF8, 0xE0, 0xFB, 0x00, 0x19, 0x3F, 0x03, 0x8E, 0x07, 0xE0,
+	0x0E, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x03, 0xF0, 0x38, 0xFC, 0x00,
+	0x00, 0xFC, 0x01, 0xF8, 0xE0, 0xFB, 0x00, 0x19, 0x3F, 0x03, 0x8E, 0x07, 0xE0, 0x0E, 0x3F, 0x00,
+	0x00, 0x3F, 0x00, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x03, 0xF0, 0x38, 0xFC, 0x00, 0x00, 0xFC, 0x01,
+	0xF8, 0xE0, 0xFB, 0x00, 0x18, 0x38, 0x03, 0x8E, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xE0,
+	0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x03, 0x8E, 0x38, 0xFC, 0x00, 0x00, 0xE3, 0x80, 0x3F, 0xFA, 0x00,
+	0x18, 0x38, 0x03, 0x8E, 0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC0, 0x1C, 0x7E,
+	0x00, 0x03, 0x8E, 0x38, 0xFC, 0x00, 0x00, 0xE3, 0x80, 0x3F, 0xFA, 0x00, 0x18, 0x38, 0x03, 0x8E,
+	0x38, 0xFC, 0x0E, 0x3F, 0x00, 0x00, 0x38, 0xE0, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x03, 0x8E, 0x38,
+	0xFC, 0x00, 0x00, 0xE3, 0x80, 0x3F, 0xFB, 0x00, 0x1A, 0x01, 0xF8, 0x00, 0x7E, 0x07, 0x1C, 0x0E,
+	0x3F, 0x00, 0x00, 0x38, 0xE0, 0x71, 0xF8, 0x1C, 0x7E, 0x00, 0x03, 0x8E, 0x38, 0xFC, 0x00, 0x00,
+	0xE3, 0x81, 0xC7, 0xE0, 0xFC, 0x00, 0x1A, 0x01, 0xF8, 0x00, 0x7E, 0x07, 0x1C, 0x0E, 0x3F, 0x00,
+	0x00, 0x38, 0xE0, 0x71, 0xF8, 0x1C, 0x7E, 0x00, 0x03, 0x8E, 0x38, 0xFC, 0x00, 0x00, 0xE3, 0x81,
+	0xC7, 0xE0, 0xFC, 0x00, 0x1A, 0x01, 0xF8, 0x00, 0x7E, 0x07, 0x1C, 0x0E, 0x3F, 0x00, 0x00, 0x38,
+	0xE0, 0x71, 0xF8, 0x1C, 0x7E, 0x00, 0x03, 0x8E, 0x38, 0xFC, 0x00, 0x00, 0xE3, 0x81, 0xC7, 0xE0,
+	0xFC, 0x00, 0x1A, 0x01, 0xC7, 0x00, 0x70, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x07, 0xE0, 0x0E,
+	0x38, 0x1C, 0x7E, 0x00, 0x00, 0x7E, 0x38, 0xFC, 0x00, 0x00, 0x1F, 0x80, 0x38, 0xE0, 0xFC, 0x00,
+	0x1A, 0x01, 0xC7, 0x00, 0x70, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x07, 0xE0, 0x0E, 0x38, 0x1C,
+	0x7E, 0x00, 0x00, 0x7E, 0x38, 0xFC, 0x00, 0x00, 0x1F, 0x80, 0x38, 0xE0, 0xFC, 0x00, 0x1A, 0x01,
+	0xC7, 0x00, 0x70, 0x38, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x07, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00,
+	0x00, 0x7E, 0x38, 0xFC, 0x00, 0x00, 0x1F, 0x80, 0x38, 0xE0, 0xFC, 0x00, 0x19, 0x01, 0xC7, 0x03,
+	0xF0, 0x3F, 0x1C, 0x0E, 0x3F, 0x00, 0x00, 0x07, 0x00, 0x71, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x70,
+	0x38, 0xFC, 0x00, 0x00, 0x1C, 0x01, 0xC7, 0xFB, 0x00, 0x19, 0x01, 0xC7, 0x03, 0xF0, 0x3F, 0x1C,
+	0x0E, 0x3F, 0x00, 0x00, 0x07, 0x00, 0x71, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x70, 0x38, 0xFC, 0x00,
+	0x00, 0x1C, 0x01, 0xC7, 0xFB, 0x00, 0x19, 0x01, 0xC7, 0x03, 0xF0, 0x3F, 0x1C, 0x0E, 0x3F, 0x00,
+	0x00, 0x07, 0x00, 0x71, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x70, 0x38, 0xFC, 0x00, 0x00, 0x1C, 0x01,
+	0xC7, 0xFA, 0x00, 0x19, 0x3F, 0x03, 0x8E, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x7E,
+	0x38, 0x1C, 0x7E, 0x00, 0x03, 0xF0, 0x38, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xF8, 0xE0, 0xFB, 0x00,
+	0x19, 0x3F, 0x03, 0x8E, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x7E, 0x38, 0x1C, 0x7E,
+	0x00, 0x03, 0xF0, 0x38, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xF8, 0xE0, 0xFB, 0x00, 0x19, 0x3F, 0x03,
+	0x8E, 0x07, 0xE0, 0x0E, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x03, 0xF0,
+	0x38, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xF8, 0xE0, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00,
+	0xBB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x81, 0xF8, 0xE0,
+	0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70, 0xFB, 0x00, 0x19,
+	0xFC, 0x70, 0x38, 0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x81, 0xF8, 0xE0, 0x71, 0xF8, 0x00,
+	0x01, 0xC7, 0x1C, 0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38,
+	0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x81, 0xF8, 0xE0, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C,
+	0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xF8,
+	0x03, 0xF1, 0xC0, 0x1F, 0x80, 0x3F, 0x00, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x03, 0xF0, 0x07, 0x1C,
+	0x0E, 0x38, 0x03, 0xF0, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xF8, 0x03, 0xF1, 0xC0,
+	0x1F, 0x80, 0x3F, 0x00, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x03, 0xF0, 0x07, 0x1C, 0x0E, 0x38, 0x03,
+	0xF0, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xF8, 0x03, 0xF1, 0xC0, 0x1F, 0x80, 0x3F,
+	0x00, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x03, 0xF0, 0x07, 0x1C, 0x0E, 0x38, 0x03, 0xF0, 0xFB, 0x00,
+	0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xC7, 0x00, 0x7E, 0x00, 0x1C, 0x01, 0xC7, 0xE0, 0x71, 0xF8,
+	0x00, 0x00, 0x3F, 0x03, 0x80, 0x38, 0xE0, 0x01, 0xF8, 0x03, 0x80, 0xFB, 0x00, 0x19, 0xFC, 0x70,
+	0x38, 0xFC, 0x01, 0xC7, 0x00, 0x7E, 0x00, 0x1C, 0x01, 0xC7, 0xE0, 0x71, 0xF8, 0x00, 0x00, 0x3F,
+	0x03, 0x80, 0x38, 0xE0, 0x01, 0xF8, 0x03, 0x80, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01,
+	0xC7, 0x00, 0x7E, 0x00, 0x1C, 0x01, 0xC7, 0xE0, 0x71, 0xF8, 0x00, 0x00, 0x3F, 0x03, 0x80, 0x38,
+	0xE0, 0x01, 0xF8, 0x03, 0x80, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xC7, 0x03, 0x8F,
+	0xC0, 0xFC, 0x00, 0x38, 0xE0, 0x71, 0xF8, 0x00, 0x00, 0x38, 0x1F, 0x80, 0x3F, 0x1C, 0x01, 0xC0,
+	0x1F, 0x80, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xC7, 0x03, 0x8F, 0xC0, 0xFC, 0x00,
+	0x38, 0xE0, 0x71, 0xF8, 0x00, 0x00, 0x38, 0x1F, 0x80, 0x3F, 0x1C, 0x01, 0xC0, 0x1F, 0x80, 0xFB,
+	0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x01, 0xC7, 0x03, 0x8F, 0xC0, 0xFC, 0x00, 0x38, 0xE0, 0x71,
+	0xF8, 0x00, 0x00, 0x38, 0x1F, 0x80, 0x3F, 0x1C, 0x01, 0xC0, 0x1F, 0x80, 0xFB, 0x00, 0x19, 0xFC,
+	0x70, 0x38, 0xFC, 0x00, 0x3F, 0x00, 0x71, 0xC0, 0xE3, 0x81, 0xC7, 0x00, 0x71, 0xF8, 0x00, 0x01,
+	0xF8, 0x1C, 0x70, 0x07, 0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC,
+	0x00, 0x3F, 0x00, 0x71, 0xC0, 0xE3, 0x81, 0xC7, 0x00, 0x71, 0xF8, 0x00, 0x01, 0xF8, 0x1C, 0x70,
+	0x07, 0xE0, 0x0F, 0xC0, 0x1C, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x00, 0x3F, 0x00,
+	0x71, 0xC0, 0xE3, 0x81, 0xC7, 0x00, 0x71, 0xF8, 0x00, 0x01, 0xF8, 0x1C, 0x70, 0x07, 0xE0, 0x0F,
+	0xC0, 0x1C, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3,
+	0x81, 0xF8, 0xE0, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70,
+	0xFB, 0x00, 0x19, 0xFC, 0x70, 0x38, 0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x81, 0xF8, 0xE0,
+	0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70, 0xFB, 0x00, 0x19,
+	0xFC, 0x70, 0x38, 0xFC, 0x00, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x81, 0xF8, 0xE0, 0x71, 0xF8, 0x00,
+	0x01, 0xC7, 0x1C, 0x70, 0x38, 0xFC, 0x0E, 0x38, 0x1C, 0x70, 0xE7, 0x00, 0x01, 0x07, 0x1C, 0xE3,
+	0x00, 0x01, 0x07, 0x1C, 0xE3, 0x00, 0x01, 0x07, 0x1C, 0xE3, 0x00, 0x01, 0x38, 0xE0, 0xE3, 0x00,
+	0x01, 0x38, 0xE0, 0xE3, 0x00, 0x01, 0x38, 0xE0, 0xE3, 0x00, 0x01, 0x3F, 0x1C, 0xE3, 0x00, 0x01,
+	0x3F, 0x1C, 0xE3, 0x00, 0x01, 0x3F, 0x1C, 0x81, 0x00, 0x9A, 0x00,
+};
+
+static const uint8_t golden_frame_2[] = {
+	0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xDF, 0x00, 0x01, 0x07,
+	0x1C, 0xF8, 0x00, 0x01, 0x0F, 0xC7, 0xF8, 0x00, 0x04, 0xE3, 0xF0, 0x00, 0x00, 0x7E, 0xFC, 0x00,
+	0x01, 0x07, 0x1C, 0xF8, 0x00, 0x01, 0x0F, 0xC7, 0xF8, 0x00, 0x04, 0xE3, 0xF0, 0x00, 0x00, 0x7E,
+	0xFC, 0x00, 0x01, 0x07, 0x1C, 0xF8, 0x00, 0x01, 0x0F, 0xC7, 0xF8, 0x00, 0x04, 0xE3, 0xF0, 0x00,
+	0x00, 0x7E, 0xFB, 0x00, 0x00, 0xFC, 0xF8, 0x00, 0x01, 0x01, 0xF8, 0xF8, 0x00, 0x04, 0xE3, 0xF0,
+	0x00, 0x00, 0x70, 0xFB, 0x00, 0x00, 0xFC, 0xF8, 0x00, 0x01, 0x01, 0xF8, 0xF8, 0x00, 0x04, 0xE3,
+	0xF0, 0x00, 0x00, 0x70, 0xFB, 0x00, 0x00, 0xFC, 0xF8, 0x00, 0x01, 0x01, 0xF8, 0xF8, 0x00, 0x04,
+	0xE3, 0xF0, 0x00, 0x00, 0x70, 0xFB, 0x00, 0x00, 0xE0, 0xF8, 0x00, 0x01, 0x0E, 0x3F, 0xF8, 0x00,
+	0x04, 0xE3, 0xF0, 0x00, 0x03, 0xF0, 0xFB, 0x00, 0x00, 0xE0, 0xF8, 0x00, 0x01, 0x0E, 0x3F, 0xF8,
+	0x00, 0x04, 0xE3, 0xF0, 0x00, 0x03, 0xF0, 0xFB, 0x00, 0x00, 0xE0, 0xF8, 0x00, 0x01, 0x0E, 0x3F,
+	0xF8, 0x00, 0x04, 0xE3, 0xF0, 0x00, 0x03, 0xF0, 0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03,
+	0xF0, 0x07, 0xE0, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E,
+	0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E, 0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03, 0xF0, 0x07,
+	0xE0, 0x71, 0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3,
+	0xF0, 0x00, 0x03, 0x8E, 0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03, 0xF0, 0x07, 0xE0, 0x71,
+	0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00,
+	0x03, 0x8E, 0xFC, 0x00, 0x1A, 0x07, 0x1C, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x00, 0x71, 0xF8, 0x00,
+	0x0E, 0x38, 0x1C, 0x7E, 0x07, 0xE0, 0x01, 0xF8, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E,
+	0xFC, 0x00, 0x1A, 0x07, 0x1C, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x00, 0x71, 0xF8, 0x00, 0x0E, 0x38,
+	0x1C, 0x7E, 0x07, 0xE0, 0x01, 0xF8, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E, 0xFC, 0x00,
+	0x1A, 0x07, 0x1C, 0x0E, 0x3F, 0x03, 0x8E, 0x07, 0x00, 0x71, 0xF8, 0x00, 0x0E, 0x38, 0x1C, 0x7E,
+	0x07, 0xE0, 0x01, 0xF8, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E, 0xFC, 0x00, 0x1A, 0x07,
+	0x1C, 0x0E, 0x3F, 0x03, 0x8E, 0x3F, 0x00, 0x71, 0xF8, 0x00, 0x0F, 0xC7, 0x1C, 0x7E, 0x07, 0x1C,
+	0x01, 0xC0, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x00, 0x7E, 0xFC, 0x00, 0x1A, 0x07, 0x1C, 0x0E,
+	0x3F, 0x03, 0x8E, 0x3F, 0x00, 0x71, 0xF8, 0x00, 0x0F, 0xC7, 0x1C, 0x7E, 0x07, 0x1C, 0x01, 0xC0,
+	0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x00, 0x7E, 0xFC, 0x00, 0x1A, 0x07, 0x1C, 0x0E, 0x3F, 0x03,
+	0x8E, 0x3F, 0x00, 0x71, 0xF8, 0x00, 0x0F, 0xC7, 0x1C, 0x7E, 0x07, 0x1C, 0x01, 0xC0, 0x1C, 0x7E,
+	0x00, 0xE3, 0xF0, 0x00, 0x00, 0x7E, 0xFB, 0x00, 0x19, 0xFC, 0x0E, 0x3F, 0x00, 0x7E, 0x38, 0xE0,
+	0x71, 0xF8, 0x00, 0x01, 0xF8, 0x1C, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0xE3, 0xF0,
+	0x00, 0x00, 0x70, 0xFB, 0x00, 0x19, 0xFC, 0x0E, 0x3F, 0x00, 0x7E, 0x38, 0xE0, 0x71, 0xF8, 0x00,
+	0x01, 0xF8, 0x1C, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x00, 0x70,
+	0xFB, 0x00, 0x19, 0xFC, 0x0E, 0x3F, 0x00, 0x7E, 0x38, 0xE0, 0x71, 0xF8, 0x00, 0x01, 0xF8, 0x1C,
+	0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x00, 0x70, 0xFB, 0x00, 0x19,
+	0xE0, 0x0E, 0x3F, 0x00, 0x70, 0x38, 0xE0, 0x71, 0xF8, 0x00, 0x0E, 0x3F, 0x1C, 0x7E, 0x00, 0xFC,
+	0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0xF0, 0xFB, 0x00, 0x19, 0xE0, 0x0E, 0x3F,
+	0x00, 0x70, 0x38, 0xE0, 0x71, 0xF8, 0x00, 0x0E, 0x3F, 0x1C, 0x7E, 0x00, 0xFC, 0x0E, 0x38, 0x1C,
+	0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0xF0, 0xFB, 0x00, 0x19, 0xE0, 0x0E, 0x3F, 0x00, 0x70, 0x38,
+	0xE0, 0x71, 0xF8, 0x00, 0x0E, 0x3F, 0x1C, 0x7E, 0x00, 0xFC, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3,
+	0xF0, 0x00, 0x03, 0xF0, 0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03, 0xF0, 0x07, 0xE0, 0x71,
+	0xF8, 0x00, 0x01, 0xC7, 0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00,
+	0x03, 0x8E, 0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03, 0xF0, 0x07, 0xE0, 0x71, 0xF8, 0x00,
+	0x01, 0xC7, 0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E,
+	0xFC, 0x00, 0x1A, 0x07, 0xE0, 0x0E, 0x3F, 0x03, 0xF0, 0x07, 0xE0, 0x71, 0xF8, 0x00, 0x01, 0xC7,
+	0x1C, 0x7E, 0x00, 0xE0, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0xE3, 0xF0, 0x00, 0x03, 0x8E, 0x81, 0x00,
+	0x81, 0x00, 0xDC, 0x00, 0x00, 0x7E, 0xE8, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x00, 0x7E, 0xE8,
+	0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x00, 0x7E, 0xE8, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x02,
+	0x03, 0x8F, 0xC0, 0xE9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xE9, 0x00,
+	0x01, 0xFC, 0x70, 0xFE, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xE9, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00,
+	0x01, 0x71, 0xC0, 0xE9, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x01, 0x71, 0xC0, 0xE9, 0x00, 0x01,
+	0xFC, 0x70, 0xFD, 0x00, 0x01, 0x71, 0xC0, 0xE9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03,
+	0x8E, 0x00, 0x00, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xF8, 0x1C, 0x70,
+	0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0x8E, 0x00, 0x00, 0x7E, 0x07,
+	0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xF8, 0x1C, 0x70, 0x38, 0xE0, 0xF9, 0x00, 0x01,
+	0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0x8E, 0x00, 0x00, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E,
+	0x00, 0x00, 0x71, 0xF8, 0x1C, 0x70, 0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12,
+	0x03, 0xF1, 0xC0, 0x00, 0x70, 0x07, 0x1C, 0x71, 0xF8, 0x1C, 0x7E, 0x00, 0x00, 0x0E, 0x38, 0x1C,
+	0x70, 0x07, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0xF1, 0xC0, 0x00, 0x70,
+	0x07, 0x1C, 0x71, 0xF8, 0x1C, 0x7E, 0x00, 0x00, 0x0E, 0x38, 0x1C, 0x70, 0x07, 0xE0, 0xF9, 0x00,
+	0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0xF1, 0xC0, 0x00, 0x70, 0x07, 0x1C, 0x71, 0xF8, 0x1C,
+	0x7E, 0x00, 0x00, 0x0E, 0x38, 0x1C, 0x70, 0x07, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00,
+	0x10, 0x7E, 0x00, 0x03, 0xF0, 0x00, 0xFC, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xC0, 0x03,
+	0xF0, 0x07, 0xF8, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x10, 0x7E, 0x00, 0x03, 0xF0, 0x00, 0xFC,
+	0x0E, 0x38, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xC0, 0x03, 0xF0, 0x07, 0xF8, 0x00, 0x01, 0xFC, 0x70,
+	0xFD, 0x00, 0x10, 0x7E, 0x00, 0x03, 0xF0, 0x00, 0xFC, 0x0E, 0x38, 0x1C, 0x7E, 0x00, 0x00, 0x71,
+	0xC0, 0x03, 0xF0, 0x07, 0xF8, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x11, 0x03, 0x8F, 0xC0, 0x03,
+	0x8E, 0x00, 0xE0, 0x71, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x7E, 0x38, 0x03, 0x80, 0x3F, 0xF8, 0x00,
+	0x01, 0xFC, 0x70, 0xFE, 0x00, 0x11, 0x03, 0x8F, 0xC0, 0x03, 0x8E, 0x00, 0xE0, 0x71, 0xC0, 0x1C,
+	0x7E, 0x00, 0x00, 0x7E, 0x38, 0x03, 0x80, 0x3F, 0xF8, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x11,
+	0x03, 0x8F, 0xC0, 0x03, 0x8E, 0x00, 0xE0, 0x71, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x7E, 0x38, 0x03,
+	0x80, 0x3F, 0xF8, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x11, 0x71, 0xC0, 0x03, 0x8E, 0x07, 0xE0,
+	0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x00, 0x0F, 0xC0, 0x1F, 0x80, 0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC,
+	0x70, 0xFD, 0x00, 0x11, 0x71, 0xC0, 0x03, 0x8E, 0x07, 0xE0, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x00,
+	0x0F, 0xC0, 0x1F, 0x80, 0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFD, 0x00, 0x11, 0x71, 0xC0,
+	0x03, 0x8E, 0x07, 0xE0, 0x7E, 0x38, 0x1C, 0x7E, 0x00, 0x00, 0x0F, 0xC0, 0x1F, 0x80, 0x38, 0xE0,
+	0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0x8E, 0x00, 0x00, 0x7E, 0x07, 0x1C, 0x0F,
+	0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xF8, 0x1C, 0x70, 0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70,
+	0xFE, 0x00, 0x12, 0x03, 0x8E, 0x00, 0x00, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x00,
+	0x71, 0xF8, 0x1C, 0x70, 0x38, 0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xFE, 0x00, 0x12, 0x03, 0x8E,
+	0x00, 0x00, 0x7E, 0x07, 0x1C, 0x0F, 0xC0, 0x1C, 0x7E, 0x00, 0x00, 0x71, 0xF8, 0x1C, 0x70, 0x38,
+	0xE0, 0xF9, 0x00, 0x01, 0xFC, 0x70, 0xF1, 0x00, 0x01, 0x0E, 0x38, 0xE3, 0x00, 0x01, 0x0E, 0x38,
+	0xE3, 0x00, 0x01, 0x0E, 0x38, 0xE3, 0x00, 0x01, 0x71, 0xC0, 0xE3, 0x00, 0x01, 0x71, 0xC0, 0xE3,
+	0x00, 0x01, 0x71, 0xC0, 0xE3, 0x00, 0x01, 0x7E, 0x38, 0xE3, 0x00, 0x01, 0x7E, 0x38, 0xE3, 0x00,
+	0x01, 0x7E, 0x38, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xD1,
+	0x00,
+};
+
+static const uint8_t golden_frame_3[] = {
+	0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xDD, 0x00, 0x00, 0x30,
+	0xF4, 0x00, 0x00, 0xF0, 0xF0, 0x00, 0x00, 0x30, 0xF4, 0x00, 0x00, 0xF0, 0xF0, 0x00, 0x00, 0xF0,
+	0xF5, 0x00, 0x01, 0x03, 0x3C, 0xF0, 0x00, 0x00, 0xF0, 0xF5, 0x00, 0x01, 0x03, 0x3C, 0xF0, 0x00,
+	0x00, 0xCC, 0xF4, 0x00, 0x00, 0xCC, 0xF0, 0x00, 0x00, 0xCC, 0xF4, 0x00, 0x00, 0xCC, 0xF0, 0x00,
+	0x17, 0xCC, 0x3C, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0x30,
+	0x00, 0xCC, 0x03, 0x30, 0x0F, 0x30, 0x33, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0xCC, 0x3C, 0x0C, 0xF0,
+	0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0x30, 0x00, 0xCC, 0x03, 0x30, 0x0F,
+	0x30, 0x33, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0x3C, 0xCF, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33,
+	0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0xCC, 0x00, 0xF3, 0x0C, 0xC0, 0x0F, 0x30, 0x33, 0x33, 0xC0, 0xF9,
+	0x00, 0x17, 0x3C, 0xCF, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03,
+	0xCC, 0x00, 0xF3, 0x0C, 0xC0, 0x0F, 0x30, 0x33, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0x30, 0x33, 0x0C,
+	0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x00, 0xF0, 0x00, 0x3C, 0x0F, 0x30,
+	0x0F, 0x30, 0x0F, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0x30, 0x33, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C,
+	0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x00, 0xF0, 0x00, 0x3C, 0x0F, 0x30, 0x0F, 0x30, 0x0F, 0x33, 0xC0,
+	0xF9, 0x00, 0x17, 0xF0, 0xCC, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0,
+	0x03, 0x3C, 0x00, 0xCF, 0x03, 0xC0, 0x0F, 0x30, 0x0C, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0xF0, 0xCC,
+	0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0x3C, 0x00, 0xCF, 0x03,
+	0xC0, 0x0F, 0x30, 0x0C, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0xCC, 0xF3, 0x0C, 0xF0, 0xF3, 0x00, 0x03,
+	0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x00, 0xCC, 0x00, 0x33, 0x0C, 0xF0, 0x0F, 0x30, 0x3C, 0x33,
+	0xC0, 0xF9, 0x00, 0x17, 0xCC, 0xF3, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C,
+	0xC0, 0x00, 0xCC, 0x00, 0x33, 0x0C, 0xF0, 0x0F, 0x30, 0x3C, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0xCC,
+	0x3C, 0x0C, 0xF0, 0xF3, 0x00, 0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0x30, 0x00, 0xCC,
+	0x03, 0x30, 0x0F, 0x30, 0x33, 0x33, 0xC0, 0xF9, 0x00, 0x17, 0xCC, 0x3C, 0x0C, 0xF0, 0xF3, 0x00,
+	0x03, 0x3C, 0x33, 0xC3, 0x3C, 0x3C, 0xC0, 0x03, 0x30, 0x00, 0xCC, 0x03, 0x30, 0x0F, 0x30, 0x33,
+	0x33, 0xC0, 0x81, 0x00, 0xAF, 0x00, 0x01, 0x01, 0x9E, 0xFC, 0x00, 0x01, 0x07, 0x80, 0xEA, 0x00,
+	0x01, 0x01, 0x9E, 0xFC, 0x00, 0x01, 0x07, 0x80, 0xEA, 0x00, 0x01, 0x01, 0x9E, 0xFC, 0x00, 0x01,
+	0x19, 0xE0, 0xEA, 0x00, 0x01, 0x01, 0x9E, 0xFC, 0x00, 0x01, 0x19, 0xE0, 0xEA, 0x00, 0x01, 0x01,
+	0x9E, 0xFC, 0x00, 0x01, 0x06, 0x60, 0xEA, 0x00, 0x01, 0x01, 0x9E, 0xFC, 0x00, 0x01, 0x06, 0x60,
+	0xF4, 0x00, 0x17, 0x19, 0xE1, 0xE1, 0x9E, 0x06, 0x78, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x9E, 0x00,
+	0x66, 0x07, 0x87, 0x80, 0x19, 0x80, 0x01, 0x81, 0x98, 0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE1,
+	0xE1, 0x9E, 0x06, 0x78, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x9E, 0x00, 0x66, 0x07, 0x87, 0x80, 0x19,
+	0x80, 0x01, 0x81, 0x98, 0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE1, 0x99, 0x9E, 0x06, 0x78, 0x00,
+	0x66, 0x19, 0x81, 0xE1, 0x9E, 0x00, 0x79, 0x86, 0x06, 0x00, 0x1E, 0x60, 0x07, 0x81, 0xE6, 0x79,
+	0x80, 0xF9, 0x00, 0x17, 0x19, 0xE1, 0x99, 0x9E, 0x06, 0x78, 0x00, 0x66, 0x19, 0x81, 0xE1, 0x9E,
+	0x00, 0x79, 0x86, 0x06, 0x00, 0x1E, 0x60, 0x07, 0x81, 0xE6, 0x79, 0x80, 0xF9, 0x00, 0x0C, 0x19,
+	0xE1, 0x99, 0x9E, 0x06, 0x78, 0x01, 0x98, 0x07, 0x81, 0x81, 0x9E, 0x00, 0xFE, 0x1E, 0x07, 0x00,
+	0x07, 0x80, 0x06, 0x60, 0x78, 0x79, 0x80, 0xF9, 0x00, 0x0C, 0x19, 0xE1, 0x99, 0x9E, 0x06, 0x78,
+	0x01, 0x98, 0x07, 0x81, 0x81, 0x9E, 0x00, 0xFE, 0x1E, 0x07, 0x00, 0x07, 0x80, 0x06, 0x60, 0x78,
+	0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE0, 0x79, 0x9E, 0x06, 0x78, 0x01, 0xE6, 0x06, 0x07, 0x81,
+	0x9E, 0x00, 0x67, 0x99, 0x99, 0x80, 0x19, 0xE0, 0x06, 0x61, 0x9E, 0x79, 0x80, 0xF9, 0x00, 0x17,
+	0x19, 0xE0, 0x79, 0x9E, 0x06, 0x78, 0x01, 0xE6, 0x06, 0x07, 0x81, 0x9E, 0x00, 0x67, 0x99, 0x99,
+	0x80, 0x19, 0xE0, 0x06, 0x61, 0x9E, 0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE0, 0x61, 0x9E, 0x06,
+	0x78, 0x00, 0x78, 0x1E, 0x06, 0x61, 0x9E, 0x00, 0x19, 0x99, 0x99, 0x80, 0x06, 0x60, 0x01, 0xE0,
+	0x66, 0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE0, 0x61, 0x9E, 0x06, 0x78, 0x00, 0x78, 0x1E, 0x06,
+	0x61, 0x9E, 0x00, 0x19, 0x99, 0x99, 0x80, 0x06, 0x60, 0x01, 0xE0, 0x66, 0x79, 0x80, 0xF9, 0x00,
+	0x17, 0x19, 0xE1, 0xE1, 0x9E, 0x06, 0x78, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x9E, 0x00, 0x66, 0x07,
+	0x87, 0x80, 0x19, 0x80, 0x01, 0x81, 0x98, 0x79, 0x80, 0xF9, 0x00, 0x17, 0x19, 0xE1, 0xE1, 0x9E,
+	0x06, 0x78, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x9E, 0x00, 0x66, 0x07, 0x87, 0x80, 0x19, 0x80, 0x01,
+	0x81, 0x98, 0x79, 0x80, 0xF2, 0x00, 0x00, 0x66, 0xE2, 0x00, 0x00, 0x66, 0xE3, 0x00, 0x01, 0x01,
+	0x98, 0xE3, 0x00, 0x01, 0x01, 0x98, 0xE3, 0x00, 0x01, 0x01, 0xE6, 0xE3, 0x00, 0x01, 0x01, 0xE6,
+	0x81, 0x00, 0xAD, 0x00, 0x54, 0x01, 0x9E, 0x06, 0x78, 0x78, 0x79, 0x81, 0x99, 0x80, 0x19, 0x99,
+	0x80, 0x1E, 0x07, 0x98, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x80, 0x00, 0x00, 0x01, 0xE6, 0x06, 0x61,
+	0xE0, 0x78, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x78, 0x79, 0x81, 0x99, 0x80, 0x19, 0x99,
+	0x80, 0x1E, 0x07, 0x98, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x80, 0x00, 0x00, 0x01, 0xE6, 0x06, 0x61,
+	0xE0, 0x78, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x66, 0x79, 0x81, 0x99, 0x80, 0x19, 0x87,
+	0x80, 0x19, 0x81, 0xE0, 0x00, 0x66, 0x19, 0x81, 0xE7, 0x80, 0xFE, 0x00, 0x1C, 0x78, 0x19, 0x81,
+	0x98, 0x60, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x66, 0x79, 0x81, 0x99, 0x80, 0x19, 0x87,
+	0x80, 0x19, 0x81, 0xE0, 0x00, 0x66, 0x19, 0x81, 0xE7, 0x80, 0xFE, 0x00, 0x5C, 0x78, 0x19, 0x81,
+	0x98, 0x60, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x66, 0x79, 0x81, 0x99, 0x80, 0x07, 0x86,
+	0x00, 0x19, 0x86, 0x78, 0x01, 0x98, 0x07, 0x81, 0x86, 0x60, 0x00, 0x00, 0x01, 0x9E, 0x1E, 0x61,
+	0x99, 0xE0, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x66, 0x79, 0x81, 0x99, 0x80, 0x07, 0x86,
+	0x00, 0x19, 0x86, 0x78, 0x01, 0x98, 0x07, 0x81, 0x86, 0x60, 0x00, 0x00, 0x01, 0x9E, 0x1E, 0x61,
+	0x99, 0xE0, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x1E, 0x79, 0x81, 0x99, 0x80, 0x06, 0x1E,
+	0x00, 0x07, 0x81, 0x98, 0x01, 0xE6, 0x06, 0x07, 0x86, 0x60, 0xFE, 0x00, 0x1C, 0x66, 0x07, 0x80,
+	0x79, 0x98, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x1E, 0x79, 0x81, 0x99, 0x80, 0x06, 0x1E,
+	0x00, 0x07, 0x81, 0x98, 0x01, 0xE6, 0x06, 0x07, 0x86, 0x60, 0xFE, 0x00, 0x7F, 0x66, 0x07, 0x80,
+	0x79, 0x98, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x18, 0x79, 0x81, 0x99, 0x80, 0x1E, 0x19,
+	0x80, 0x06, 0x06, 0x60, 0x00, 0x78, 0x1E, 0x06, 0x61, 0xE0, 0x00, 0x00, 0x01, 0x98, 0x19, 0xE0,
+	0x61, 0x98, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x18, 0x79, 0x81, 0x99, 0x80, 0x1E, 0x19,
+	0x80, 0x06, 0x06, 0x60, 0x00, 0x78, 0x1E, 0x06, 0x61, 0xE0, 0x00, 0x00, 0x01, 0x98, 0x19, 0xE0,
+	0x61, 0x98, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x78, 0x79, 0x81, 0x99, 0x80, 0x19, 0x99,
+	0x80, 0x1E, 0x07, 0x98, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x80, 0x00, 0x00, 0x01, 0xE6, 0x06, 0x61,
+	0xE0, 0x78, 0x67, 0x80, 0x00, 0x01, 0x9E, 0x06, 0x78, 0x78, 0x79, 0x81, 0x99, 0x80, 0x19, 0x99,
+	0x80, 0x1E, 0x07, 0x98, 0x01, 0x9E, 0x19, 0x86, 0x61, 0x80, 0x00, 0x00, 0x01, 0x06, 0xE6, 0x06,
+	0x61, 0xE0, 0x78, 0x67, 0x80, 0xF0, 0x00, 0x00, 0x66, 0xE2, 0x00, 0x00, 0x66, 0xE3, 0x00, 0x01,
+	0x01, 0x98, 0xE3, 0x00, 0x01, 0x01, 0x98, 0xE3, 0x00, 0x01, 0x01, 0xE6, 0xE3, 0x00, 0x01, 0x01,
+	0xE6, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xD2, 0x00,
+};
+
+static const uint8_t golden_frame_4[] = {
+	0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xDE, 0x00, 0x02, 0x03,
+	0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01,
+	0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02,
+	0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00,
+	0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00,
+	0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED,
+	0x00, 0x01, 0x38, 0xFC, 0xFA, 0x00, 0x02, 0x03, 0x8F, 0xC0, 0xED, 0x00, 0x01, 0x38, 0xFC, 0xFA,
+	0x00, 0x08, 0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38, 0xE3, 0xF1, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70,
+	0x07, 0xE0, 0x01, 0xF8, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F,
+	0xC0, 0x1C, 0x70, 0x38, 0xE3, 0xF1, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0xE0, 0x01, 0xF8,
+	0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38,
+	0xE3, 0xF1, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0xE0, 0x01, 0xF8, 0x03, 0x8F, 0xC7, 0x1F,
+	0x80, 0x38, 0xFC, 0xFA, 0x00, 0x07, 0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38, 0xE0, 0x7E, 0xFD, 0x00,
+	0x0C, 0xFC, 0x70, 0x07, 0x1C, 0x0E, 0x3F, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00,
+	0x07, 0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38, 0xE0, 0x7E, 0xFD, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0x1C,
+	0x0E, 0x3F, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x07, 0x03, 0x8F, 0xC0, 0x1C,
+	0x70, 0x38, 0xE0, 0x7E, 0xFD, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0x1C, 0x0E, 0x3F, 0x03, 0x8F, 0xC7,
+	0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x03, 0xF0, 0x07, 0xE3, 0x8F, 0xC0,
+	0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0x1C, 0x01, 0xC7, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC,
+	0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x03, 0xF0, 0x07, 0xE3, 0x8F, 0xC0, 0xFE, 0x00, 0x0C, 0xFC,
+	0x70, 0x07, 0x1C, 0x01, 0xC7, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03,
+	0x8F, 0xC0, 0x03, 0xF0, 0x07, 0xE3, 0x8F, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0x1C, 0x01,
+	0xC7, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x03, 0x80,
+	0x07, 0x00, 0x71, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x00, 0xFC, 0x0E, 0x38, 0x03, 0x8F, 0xC7,
+	0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x71, 0xC0,
+	0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x00, 0xFC, 0x0E, 0x38, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC,
+	0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x71, 0xC0, 0xFE, 0x00, 0x0C, 0xFC,
+	0x70, 0x00, 0xFC, 0x0E, 0x38, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x07, 0x03,
+	0x8F, 0xC0, 0x1F, 0x80, 0x3F, 0x03, 0x8E, 0xFD, 0x00, 0x0C, 0xFC, 0x70, 0x00, 0xE0, 0x0F, 0xC7,
+	0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x07, 0x03, 0x8F, 0xC0, 0x1F, 0x80, 0x3F,
+	0x03, 0x8E, 0xFD, 0x00, 0x0C, 0xFC, 0x70, 0x00, 0xE0, 0x0F, 0xC7, 0x03, 0x8F, 0xC7, 0x1F, 0x80,
+	0x38, 0xFC, 0xFA, 0x00, 0x07, 0x03, 0x8F, 0xC0, 0x1F, 0x80, 0x3F, 0x03, 0x8E, 0xFD, 0x00, 0x0C,
+	0xFC, 0x70, 0x00, 0xE0, 0x0F, 0xC7, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08,
+	0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38, 0xE3, 0xF1, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0xE0,
+	0x01, 0xF8, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x1C,
+	0x70, 0x38, 0xE3, 0xF1, 0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0xE0, 0x01, 0xF8, 0x03, 0x8F,
+	0xC7, 0x1F, 0x80, 0x38, 0xFC, 0xFA, 0x00, 0x08, 0x03, 0x8F, 0xC0, 0x1C, 0x70, 0x38, 0xE3, 0xF1,
+	0xC0, 0xFE, 0x00, 0x0C, 0xFC, 0x70, 0x07, 0xE0, 0x01, 0xF8, 0x03, 0x8F, 0xC7, 0x1F, 0x80, 0x38,
+	0xFC, 0xEA, 0x00, 0x01, 0x0E, 0x3F, 0xE3, 0x00, 0x01, 0x0E, 0x3F, 0xE3, 0x00, 0x01, 0x0E, 0x3F,
+	0xE3, 0x00, 0x01, 0x01, 0xC7, 0xE3, 0x00, 0x01, 0x01, 0xC7, 0xE3, 0x00, 0x01, 0x01, 0xC7, 0xE3,
+	0x00, 0x01, 0x0E, 0x38, 0xE3, 0x00, 0x01, 0x0E, 0x38, 0xE3, 0x00, 0x01, 0x0E, 0x38, 0x81, 0x00,
+	0x81, 0x00, 0xD2, 0x00, 0x0A, 0x01, 0xF8, 0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E, 0x38,
+	0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0x1F, 0x81, 0xF8, 0xF8, 0x00, 0x0A, 0x01, 0xF8,
+	0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E, 0x38, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F,
+	0xC0, 0x1F, 0x81, 0xF8, 0xF8, 0x00, 0x0A, 0x01, 0xF8, 0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38, 0xFC,
+	0x0E, 0x38, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0x1F, 0x81, 0xF8, 0xF7, 0x00, 0x09,
+	0x3F, 0x00, 0x70, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0F, 0xC7, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03,
+	0x8F, 0xC0, 0x1C, 0x01, 0xC0, 0xF7, 0x00, 0x09, 0x3F, 0x00, 0x70, 0x07, 0x1F, 0x80, 0x38, 0xFC,
+	0x0F, 0xC7, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0x1C, 0x01, 0xC0, 0xF7, 0x00, 0x09,
+	0x3F, 0x00, 0x70, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0F, 0xC7, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03,
+	0x8F, 0xC0, 0x1C, 0x01, 0xC0, 0xF8, 0x00, 0x0A, 0x01, 0xC7, 0xE3, 0xF0, 0x07, 0x1F, 0x80, 0x38,
+	0xFC, 0x01, 0xF8, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0, 0xF8, 0x00,
+	0x0A, 0x01, 0xC7, 0xE3, 0xF0, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x01, 0xF8, 0xFD, 0x00, 0x07, 0x0E,
+	0x3F, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0, 0xF8, 0x00, 0x0A, 0x01, 0xC7, 0xE3, 0xF0, 0x07, 0x1F,
+	0x80, 0x38, 0xFC, 0x01, 0xF8, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0,
+	0xF7, 0x00, 0x09, 0x38, 0xE3, 0x8E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E, 0x3F, 0xFD, 0x00, 0x07,
+	0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xE3, 0x8E, 0x38, 0xF7, 0x00, 0x09, 0x38, 0xE3, 0x8E, 0x07, 0x1F,
+	0x80, 0x38, 0xFC, 0x0E, 0x3F, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xE3, 0x8E, 0x38,
+	0xF7, 0x00, 0x09, 0x38, 0xE3, 0x8E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E, 0x3F, 0xFD, 0x00, 0x07,
+	0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xE3, 0x8E, 0x38, 0xF8, 0x00, 0x0A, 0x01, 0xC7, 0x03, 0x8E, 0x07,
+	0x1F, 0x80, 0x38, 0xFC, 0x01, 0xC7, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xE3, 0x8E,
+	0x38, 0xF8, 0x00, 0x0A, 0x01, 0xC7, 0x03, 0x8E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x01, 0xC7, 0xFD,
+	0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0xE3, 0x8E, 0x38, 0xF8, 0x00, 0x0A, 0x01, 0xC7, 0x03,
+	0x8E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x01, 0xC7, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0,
+	0xE3, 0x8E, 0x38, 0xF8, 0x00, 0x0A, 0x01, 0xF8, 0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E,
+	0x38, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0x1F, 0x81, 0xF8, 0xF8, 0x00, 0x0A, 0x01,
+	0xF8, 0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38, 0xFC, 0x0E, 0x38, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03,
+	0x8F, 0xC0, 0x1F, 0x81, 0xF8, 0xF8, 0x00, 0x0A, 0x01, 0xF8, 0xE0, 0x7E, 0x07, 0x1F, 0x80, 0x38,
+	0xFC, 0x0E, 0x38, 0xFD, 0x00, 0x07, 0x0E, 0x3F, 0x03, 0x8F, 0xC0, 0x1F, 0x81, 0xF8, 0xEF, 0x00,
+	0x01, 0x0F, 0xC7, 0xE3, 0x00, 0x01, 0x0F, 0xC7, 0xE3, 0x00, 0x01, 0x0F, 0xC7, 0xE3, 0x00, 0x01,
+	0x01, 0xF8, 0xE3, 0x00, 0x01, 0x01, 0xF8, 0xE3, 0x00, 0x01, 0x01, 0xF8, 0xE3, 0x00, 0x01, 0x0E,
+	0x3F, 0xE3, 0x00, 0x01, 0x0E, 0x3F, 0xE3, 0x00, 0x01, 0x0E, 0x3F, 0x81, 0x00, 0x81, 0x00, 0x81,
+	0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xD0, 0x00,
+};
+
+static const uint8_t golden_frame_5[] = {
+	0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xDE, 0x00, 0x01, 0x79,
+	0x80, 0xE3, 0x00, 0x01, 0x79, 0x80, 0xE3, 0x00, 0x01, 0x79, 0x80, 0xE3, 0x00, 0x01, 0x79, 0x80,
+	0xE3, 0x00, 0x01, 0x79, 0x80, 0xE3, 0x00, 0x01, 0x79, 0x80, 0xE3, 0x00, 0x19, 0x79, 0x80, 0x01,
+	0x9E, 0x19, 0xE0, 0x78, 0x78, 0x00, 0x79, 0x86, 0x78, 0x1E, 0x61, 0x9E, 0x06, 0x07, 0x81, 0x9E,
+	0x1E, 0x60, 0x06, 0x61, 0xE6, 0x1E, 0x60, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE0,
+	0x78, 0x78, 0x00, 0x79, 0x86, 0x78, 0x1E, 0x61, 0x9E, 0x06, 0x07, 0x81, 0x9E, 0x1E, 0x60, 0x06,
+	0x61, 0xE6, 0x1E, 0x60, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE0, 0x60, 0x60, 0x00,
+	0x1E, 0x06, 0x78, 0x07, 0x81, 0x9E, 0x1E, 0x19, 0xE1, 0x9E, 0x07, 0x80, 0x07, 0x99, 0xE6, 0x07,
+	0x80, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE0, 0x60, 0x60, 0x00, 0x1E, 0x06, 0x78,
+	0x07, 0x81, 0x9E, 0x1E, 0x19, 0xE1, 0x9E, 0x07, 0x80, 0x07, 0x99, 0xE6, 0x07, 0x80, 0xFB, 0x00,
+	0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE1, 0xE1, 0xE0, 0x78, 0x67, 0x86, 0x78, 0x19, 0xE1, 0x9E,
+	0x19, 0x86, 0x61, 0x9E, 0x19, 0xE0, 0x01, 0xE1, 0xE6, 0x19, 0xE0, 0xFB, 0x00, 0x19, 0x79, 0x80,
+	0x01, 0x9E, 0x19, 0xE1, 0xE1, 0xE0, 0x78, 0x67, 0x86, 0x78, 0x19, 0xE1, 0x9E, 0x19, 0x86, 0x61,
+	0x9E, 0x19, 0xE0, 0x01, 0xE1, 0xE6, 0x19, 0xE0, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19,
+	0xE1, 0x99, 0x98, 0x00, 0x19, 0x86, 0x78, 0x06, 0x61, 0x9E, 0x19, 0x99, 0x81, 0x9E, 0x06, 0x60,
+	0x06, 0x79, 0xE6, 0x06, 0x60, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE1, 0x99, 0x98,
+	0x00, 0x19, 0x86, 0x78, 0x06, 0x61, 0x9E, 0x19, 0x99, 0x81, 0x9E, 0x06, 0x60, 0x06, 0x79, 0xE6,
+	0x06, 0x60, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE1, 0x99, 0x98, 0x00, 0x66, 0x06,
+	0x78, 0x19, 0x81, 0x9E, 0x07, 0x9E, 0x61, 0x9E, 0x19, 0x80, 0x01, 0x99, 0xE6, 0x19, 0x80, 0xFB,
+	0x00, 0x19, 0x79, 0x80, 0x01, 0x9E, 0x19, 0xE1, 0x99, 0x98, 0x00, 0x66, 0x06, 0x78, 0x19, 0x81,
+	0x9E, 0x07, 0x9E, 0x61, 0x9E, 0x19, 0x80, 0x01, 0x99, 0xE6, 0x19, 0x80, 0xFB, 0x00, 0x19, 0x79,
+	0x80, 0x01, 0x9E, 0x19, 0xE0, 0x78, 0x78, 0x00, 0x79, 0x86, 0x78, 0x1E, 0x61, 0x9E, 0x06, 0x07,
+	0x81, 0x9E, 0x1E, 0x60, 0x06, 0x61, 0xE6, 0x1E, 0x60, 0xFB, 0x00, 0x19, 0x79, 0x80, 0x01, 0x9E,
+	0x19, 0xE0, 0x78, 0x78, 0x00, 0x79, 0x86, 0x78, 0x1E, 0x61, 0x9E, 0x06, 0x07, 0x81, 0x9E, 0x1E,
+	0x60, 0x06, 0x61, 0xE6, 0x1E, 0x60, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xFA, 0x00, 0x15, 0x78,
+	0x66, 0x79, 0x80, 0x78, 0x00, 0x06, 0x60, 0x19, 0xE1, 0x98, 0x1E, 0x19, 0xE0, 0x67, 0x87, 0x98,
+	0x00, 0x78, 0x19, 0xE1, 0x9E, 0xF7, 0x00, 0x15, 0x78, 0x66, 0x79, 0x80, 0x78, 0x00, 0x06, 0x60,
+	0x19, 0xE1, 0x98, 0x1E, 0x19, 0xE0, 0x67, 0x87, 0x98, 0x00, 0x78, 0x19, 0xE1, 0x9E, 0xF7, 0x00,
+	0x15, 0x60, 0x66, 0x79, 0x81, 0x9E, 0x00, 0x07, 0x98, 0x19, 0xE1, 0xE6, 0x19, 0x99, 0xE0, 0x67,
+	0x81, 0xE0, 0x01, 0x9E, 0x19, 0xE1, 0x9E, 0xF7, 0x00, 0x15, 0x60, 0x66, 0x79, 0x81, 0x9E, 0x00,
+	0x07, 0x98, 0x19, 0xE1, 0xE6, 0x19, 0x99, 0xE0, 0x67, 0x81, 0xE0, 0x01, 0x9E, 0x19, 0xE1, 0x9E,
+	0xF8, 0x00, 0x18, 0x01, 0xE0, 0x1E, 0x79, 0x80, 0x66, 0x1E, 0x01, 0xE0, 0x19, 0xE0, 0x78, 0x19,
+	0x99, 0xE0, 0x67, 0x86, 0x78, 0x00, 0x66, 0x19, 0xE1, 0x9E, 0x07, 0x80, 0xFA, 0x00, 0x18, 0x01,
+	0xE0, 0x1E, 0x79, 0x80, 0x66, 0x1E, 0x01, 0xE0, 0x19, 0xE0, 0x78, 0x19, 0x99, 0xE0, 0x67, 0x86,
+	0x78, 0x00, 0x66, 0x19, 0xE1, 0x9E, 0x07, 0x80, 0xFA, 0x00, 0x16, 0x01, 0x98, 0x18, 0x79, 0x81,
+	0x98, 0x00, 0x06, 0x78, 0x19, 0xE1, 0x9E, 0x07, 0x99, 0xE0, 0x67, 0x81, 0x98, 0x01, 0x98, 0x19,
+	0xE1, 0x9E, 0xF8, 0x00, 0x16, 0x01, 0x98, 0x18, 0x79, 0x81, 0x98, 0x00, 0x06, 0x78, 0x19, 0xE1,
+	0x9E, 0x07, 0x99, 0xE0, 0x67, 0x81, 0x98, 0x01, 0x98, 0x19, 0xE1, 0x9E, 0xF8, 0x00, 0x16, 0x01,
+	0x98, 0x78, 0x79, 0x81, 0xE6, 0x00, 0x01, 0x98, 0x19, 0xE0, 0x66, 0x06, 0x19, 0xE0, 0x67, 0x86,
+	0x60, 0x01, 0xE6, 0x19, 0xE1, 0x9E, 0xF8, 0x00, 0x16, 0x01, 0x98, 0x78, 0x79, 0x81, 0xE6, 0x00,
+	0x01, 0x98, 0x19, 0xE0, 0x66, 0x06, 0x19, 0xE0, 0x67, 0x86, 0x60, 0x01, 0xE6, 0x19, 0xE1, 0x9E,
+	0xF7, 0x00, 0x15, 0x78, 0x66, 0x79, 0x80, 0x78, 0x00, 0x06, 0x60, 0x19, 0xE1, 0x98, 0x1E, 0x19,
+	0xE0, 0x67, 0x87, 0x98, 0x00, 0x78, 0x19, 0xE1, 0x9E, 0xF7, 0x00, 0x15, 0x78, 0x66, 0x79, 0x80,
+	0x78, 0x00, 0x06, 0x60, 0x19, 0xE1, 0x98, 0x1E, 0x19, 0xE0, 0x67, 0x87, 0x98, 0x00, 0x78, 0x19,
+	0xE1, 0x9E, 0xF4, 0x00, 0x01, 0x01, 0x9E, 0xF5, 0x00, 0x01, 0x01, 0x9E, 0xF1, 0x00, 0x01, 0x01,
+	0x9E, 0xF5, 0x00, 0x01, 0x01, 0x9E, 0xF0, 0x00, 0x00, 0x66, 0xF4, 0x00, 0x00, 0x66, 0xF0, 0x00,
+	0x00, 0x66, 0xF4, 0x00, 0x00, 0x66, 0xF1, 0x00, 0x01, 0x01, 0x98, 0xF5, 0x00, 0x01, 0x01, 0x98,
+	0xF1, 0x00, 0x01, 0x01, 0x98, 0xF5, 0x00, 0x01, 0x01, 0x98, 0x81, 0x00, 0xAF, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x60, 0x78, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0x80, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x60, 0x78, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0x80, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x61, 0x9E, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x87, 0x80, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x61, 0x9E, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x87, 0x80, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x01, 0xE0, 0x66, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x86, 0x60, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x01, 0xE0, 0x66, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x86, 0x60, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x01, 0x81, 0x98, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x86, 0x60, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x01, 0x81, 0x98, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x86, 0x60, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x07, 0x81, 0xE6, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0xE0, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x07, 0x81, 0xE6, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0xE0, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x60, 0x78, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0x80, 0xEE, 0x00, 0x0C, 0x01,
+	0x9E, 0x06, 0x60, 0x78, 0x19, 0xE1, 0x9E, 0x06, 0x78, 0x67, 0x81, 0x80, 0xEB, 0x00, 0x01, 0x01,
+	0x9E, 0xE3, 0x00, 0x01, 0x01, 0x9E, 0xE2, 0x00, 0x00, 0x66, 0xE2, 0x00, 0x00, 0x66, 0xE3, 0x00,
+	0x01, 0x01, 0x98, 0xE3, 0x00, 0x01, 0x01, 0x98, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00,
+	0x81, 0x00, 0x81, 0x00, 0xCF, 0x00,
+};
+
+static const uint8_t golden_frame_6[] = {
+	0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0xA1, 0x00,
+	0x00, 0x0B, 0xE2, 0x00, 0x00, 0x05, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x7F, 0x0D, 0x2A, 0x8A,
+	0x69, 0x56, 0x2C, 0x29, 0x42, 0x2C, 0xA6, 0x96, 0x32, 0x84, 0x59, 0x46, 0x28, 0xCB, 0x14, 0xA9,
+	0x14, 0xD1, 0x8A, 0x65, 0x8C, 0xA3, 0x4A, 0x68, 0xAD, 0x23, 0x0A, 0x58, 0x00, 0x06, 0x2B, 0x4D,
+	0x31, 0x56, 0x2C, 0x51, 0xA6, 0x2C, 0xA3, 0x16, 0x23, 0x4C, 0x59, 0x4B, 0x34, 0x8B, 0x14, 0xAB,
+	0x1A, 0xD1, 0x4A, 0x45, 0x8A, 0xD1, 0x8D, 0x68, 0xA6, 0x62, 0x94, 0x58, 0x00, 0x0B, 0x19, 0x86,
+	0x58, 0xD6, 0x2C, 0x68, 0xC5, 0x2C, 0x65, 0x96, 0x61, 0x8A, 0x58, 0xC5, 0x19, 0x8B, 0x0C, 0xAA,
+	0x8C, 0xD1, 0x46, 0xC5, 0x8A, 0x62, 0xC6, 0x68, 0x6B, 0x52, 0x9A, 0x58, 0x00, 0x05, 0x12, 0xCB,
+	0x28, 0x96, 0x2C, 0x31, 0x65, 0x2C, 0x42, 0x96, 0x52, 0xCA, 0x58, 0x8A, 0x2D, 0x4B, 0x08, 0xAA,
+	0x96, 0xD0, 0xC4, 0xA5, 0x86, 0xB1, 0x4B, 0x68, 0x45, 0x51, 0x8C, 0x58, 0x00, 0x42, 0x0A, 0x31,
+	0x45, 0x51, 0x96, 0x2C, 0x58, 0xA3, 0x2C, 0xC5, 0x16, 0x51, 0x46, 0x59, 0x8D, 0x15, 0x4B, 0x18,
+	0xA9, 0x8A, 0xD0, 0x8C, 0xA5, 0x84, 0x52, 0x85, 0x68, 0xCA, 0x31, 0x16, 0x58, 0x00, 0x0D, 0x2A,
+	0x8A, 0x69, 0x56, 0x2C, 0x29, 0x42, 0x2C, 0xA6, 0x96, 0x32, 0x84, 0x59, 0x46, 0x28, 0xCB, 0x14,
+	0xA9, 0x14, 0xD1, 0x8A, 0x65, 0x8C, 0xA3, 0x4A, 0x68, 0xAD, 0x23, 0x0A, 0x58, 0x00, 0x00, 0x03,
+	0x40, 0xF6, 0x00, 0x00, 0x0B, 0xF8, 0x00, 0x00, 0xD0, 0xF9, 0x00, 0x01, 0x01, 0x80, 0xF6, 0x00,
+	0x00, 0x05, 0xF8, 0x00, 0x00, 0x60, 0xF9, 0x00, 0x01, 0x02, 0xC0, 0xF6, 0x00, 0x00, 0x0A, 0xF8,
+	0x00, 0x00, 0xB0, 0x9A, 0x00, 0x7F, 0x05, 0xA8, 0xAB, 0x11, 0x85, 0x14, 0xA5, 0x8A, 0x69, 0x8D,
+	0x45, 0x98, 0xA5, 0x4A, 0x22, 0x8D, 0x28, 0xA5, 0x8C, 0xCB, 0x14, 0xA9, 0x4B, 0x14, 0x54, 0xB0,
+	0x8B, 0x2C, 0x52, 0xCD, 0x14, 0x00, 0x02, 0xB4, 0xAB, 0x31, 0x4A, 0x28, 0xD5, 0x8A, 0x31, 0x49,
+	0xA5, 0x94, 0xA5, 0x4D, 0x63, 0x4D, 0x29, 0x45, 0x88, 0xAB, 0x14, 0xA9, 0xAB, 0x1A, 0x54, 0xB1,
+	0x8B, 0x14, 0xA2, 0xCD, 0x14, 0x00, 0x05, 0x18, 0x6B, 0x29, 0x4D, 0x34, 0x65, 0x86, 0x59, 0x58,
+	0xC5, 0x94, 0x65, 0x46, 0x51, 0x8D, 0x19, 0xA5, 0x98, 0xAB, 0x0C, 0xA8, 0xCB, 0x0C, 0x54, 0xB1,
+	0x4B, 0x28, 0xD2, 0xCD, 0x0C, 0x00, 0x06, 0xAC, 0x4B, 0x28, 0xC6, 0x18, 0xB5, 0x84, 0x28, 0xD5,
+	0x65, 0x8C, 0x45, 0x4B, 0x52, 0xCD, 0x10, 0xC5, 0x94, 0x6B, 0x08, 0xA9, 0x6B, 0x16, 0x54, 0xB1,
+	0x4B, 0x34, 0x62, 0xCD, 0x08, 0x00, 0x41, 0x03, 0x14, 0xCB, 0x18, 0x8B, 0x2C, 0x55, 0x8C, 0x50,
+	0x94, 0xA5, 0x88, 0xC5, 0x45, 0x31, 0x4D, 0x31, 0x65, 0x94, 0x4B, 0x18, 0xA8, 0xAB, 0x0A, 0x54,
+	0xB0, 0xCB, 0x18, 0xB2, 0xCD, 0x18, 0x00, 0x05, 0xA8, 0xAB, 0x11, 0x85, 0x14, 0xA5, 0x8A, 0x69,
+	0x8D, 0x45, 0x98, 0xA5, 0x4A, 0x22, 0x8D, 0x28, 0xA5, 0x8C, 0xCB, 0x14, 0xA9, 0x4B, 0x14, 0x54,
+	0xB0, 0x8B, 0x2C, 0x52, 0xCD, 0x14, 0x00, 0x02, 0xB4, 0xFA, 0x00, 0x01, 0x01, 0xA0, 0xF1, 0x00,
+	0x00, 0x14, 0xFD, 0x00, 0x01, 0x05, 0x18, 0xF9, 0x00, 0x00, 0xC0, 0xF1, 0x00, 0x00, 0x28, 0xFD,
+	0x00, 0x01, 0x06, 0xAC, 0xFA, 0x00, 0x01, 0x01, 0x60, 0xF1, 0x00, 0x00, 0x34, 0x9D, 0x00, 0x7F,
+	0x05, 0x4C, 0x22, 0xCC, 0xB2, 0x8C, 0x54, 0xA6, 0x9A, 0x5A, 0x8B, 0x2A, 0x8B, 0x29, 0x65, 0x8A,
+	0xA2, 0xC4, 0x63, 0x56, 0x2C, 0x45, 0x19, 0x62, 0xAB, 0x11, 0x65, 0x68, 0xAA, 0x58, 0xB0, 0x00,
+	0x05, 0x4A, 0x62, 0xC8, 0xB3, 0x4A, 0x54, 0xA3, 0x0C, 0x2B, 0x4B, 0x2B, 0x4B, 0x35, 0x65, 0x8A,
+	0xD2, 0xCC, 0x51, 0x96, 0x2C, 0xC6, 0x91, 0x62, 0xAB, 0x30, 0xA5, 0x68, 0xAD, 0x58, 0xB0, 0x00,
+	0x05, 0x4A, 0x52, 0xD8, 0xB1, 0x8A, 0x54, 0x65, 0x96, 0x51, 0x8B, 0x19, 0x8B, 0x19, 0x65, 0x86,
+	0x62, 0xCA, 0x52, 0xD6, 0x2C, 0xA3, 0x31, 0x62, 0xAB, 0x29, 0x43, 0x68, 0x66, 0x58, 0xB0, 0x00,
+	0x05, 0x46, 0x52, 0xD4, 0xB2, 0xC6, 0x54, 0x42, 0x8A, 0x6A, 0xCB, 0x12, 0xCB, 0x2D, 0x65, 0x84,
+	0xB2, 0xCA, 0x31, 0x56, 0x2C, 0xA5, 0xA9, 0x62, 0xAB, 0x29, 0xA2, 0x68, 0x4B, 0x58, 0xB0, 0x00,
+	0x3E, 0x05, 0x44, 0x32, 0xD4, 0xB1, 0x44, 0x54, 0xC5, 0x14, 0x31, 0x4B, 0x31, 0x4B, 0x15, 0x65,
+	0x8C, 0x52, 0xC6, 0x22, 0x96, 0x2C, 0x62, 0xA9, 0x62, 0xAB, 0x18, 0xC6, 0x68, 0xC5, 0x58, 0xB0,
+	0x00, 0x05, 0x4C, 0x22, 0xCC, 0xB2, 0x8C, 0x54, 0xA6, 0x9A, 0x5A, 0x8B, 0x2A, 0x8B, 0x29, 0x65,
+	0x8A, 0xA2, 0xC4, 0x63, 0x56, 0x2C, 0x45, 0x19, 0x62, 0xAB, 0x11, 0x65, 0x68, 0xAA, 0x58, 0xB0,
+	0xFC, 0x00, 0x01, 0x03, 0x40, 0xFE, 0x00, 0x03, 0x2B, 0x40, 0x03, 0x40, 0xFE, 0x00, 0x00, 0xD0,
+	0xF8, 0x00, 0x02, 0xA0, 0x00, 0x0D, 0xFA, 0x00, 0x01, 0x01, 0x80, 0xFE, 0x00, 0x03, 0x51, 0x80,
+	0x01, 0x80, 0xFE, 0x00, 0x00, 0x60, 0xF9, 0x00, 0x03, 0x01, 0x40, 0x00, 0x06, 0xFA, 0x00, 0x01,
+	0x02, 0xC0, 0xFE, 0x00, 0x03, 0x6A, 0xC0, 0x02, 0xC0, 0xFE, 0x00, 0x00, 0xB0, 0xF9, 0x00, 0x03,
+	0x01, 0xA0, 0x00, 0x0B, 0x9E, 0x00, 0x7F, 0x05, 0x4B, 0x28, 0xB2, 0x8C, 0xCC, 0x52, 0xA6, 0x18,
+	0xA9, 0x95, 0x45, 0x8C, 0xB1, 0x8A, 0x65, 0x0C, 0x53, 0x14, 0xD3, 0x11, 0x46, 0x29, 0xA5, 0x28,
+	0xB2, 0xCB, 0x11, 0x43, 0x14, 0xD0, 0x00, 0x05, 0x4B, 0x34, 0xB3, 0x48, 0x8A, 0x52, 0xA5, 0x2C,
+	0xA9, 0x15, 0xA5, 0x88, 0xB1, 0x4A, 0x46, 0x96, 0x52, 0x94, 0x62, 0xB1, 0xA5, 0x29, 0xA6, 0xB4,
+	0xB2, 0xCB, 0x31, 0xA5, 0x9A, 0xD0, 0x00, 0x05, 0x4B, 0x18, 0xB1, 0x99, 0x8A, 0x32, 0xA5, 0x14,
+	0xAB, 0x0C, 0xC5, 0x98, 0xB1, 0x46, 0xC3, 0x0A, 0x32, 0x8C, 0xB2, 0xA8, 0xC5, 0x19, 0xA3, 0x18,
+	0xB2, 0xCB, 0x28, 0xC2, 0x8C, 0xD0, 0x00, 0x05, 0x4B, 0x2C, 0xB2, 0xD5, 0x46, 0x22, 0xA3, 0x28,
+	0xAA, 0x89, 0x65, 0x94, 0xB0, 0xC4, 0xA5, 0x94, 0x21, 0x88, 0x51, 0xA9, 0x63, 0x11, 0xA5, 0xAC,
+	0xB2, 0xCB, 0x29, 0x65, 0x16, 0xD0, 0x00, 0x3E, 0x05, 0x4B, 0x14, 0xB1, 0x55, 0x44, 0x62, 0xA2,
+	0x34, 0xAA, 0x98, 0xA5, 0x94, 0xB0, 0x8C, 0xA2, 0x9A, 0x61, 0x18, 0xA1, 0x18, 0xA2, 0x31, 0xA2,
+	0x94, 0xB2, 0xCB, 0x18, 0xA6, 0x8A, 0xD0, 0x00, 0x05, 0x4B, 0x28, 0xB2, 0x8C, 0xCC, 0x52, 0xA6,
+	0x18, 0xA9, 0x95, 0x45, 0x8C, 0xB1, 0x8A, 0x65, 0x0C, 0x53, 0x14, 0xD3, 0x11, 0x46, 0x29, 0xA5,
+	0x28, 0xB2, 0xCB, 0x11, 0x43, 0x14, 0xD0, 0xFE, 0x00, 0x00, 0x34, 0xFC, 0x00, 0x03, 0x2C, 0x00,
+	0x01, 0xA0, 0xFD, 0x00, 0x00, 0x16, 0xFA, 0x00, 0x00, 0x34, 0xFE, 0x00, 0x01, 0x05, 0x80, 0xFD,
+	0x00, 0x00, 0x18, 0xFC, 0x00, 0x03, 0x14, 0x00, 0x00, 0xC0, 0xFD, 0x00, 0x00, 0x0A, 0xFA, 0x00,
+	0x00, 0x18, 0xFE, 0x00, 0x01, 0x02, 0x80, 0xFD, 0x00, 0x00, 0x2C, 0xFC, 0x00, 0x03, 0x28, 0x00,
+	0x01, 0x60, 0xFD, 0x00, 0x00, 0x14, 0xFA, 0x00, 0x00, 0x2C, 0xFE, 0x00, 0x00, 0x05, 0x92, 0x00,
+	0x06, 0x05, 0x52, 0xC5, 0x88, 0xB1, 0x8A, 0xD0, 0xE8, 0x00, 0x06, 0x05, 0x6A, 0xC5, 0x98, 0x52,
+	0xCA, 0xD0, 0xE8, 0x00, 0x06, 0x03, 0x32, 0xC5, 0x94, 0xA1, 0x46, 0xD0, 0xE8, 0x00, 0x06, 0x02,
+	0x5A, 0xC5, 0x94, 0xD2, 0x84, 0xD0, 0xE8, 0x00, 0x06, 0x06, 0x2A, 0xC5, 0x8C, 0x63, 0x4C, 0xD0,
+	0xE8, 0x00, 0x06, 0x05, 0x52, 0xC5, 0x88, 0xB1, 0x8A, 0xD0, 0xE7, 0x00, 0x04, 0x68, 0x00, 0x00,
+	0x52, 0xC0, 0xE6, 0x00, 0x04, 0x30, 0x00, 0x00, 0xA1, 0x40, 0xE6, 0x00, 0x04, 0x58, 0x00, 0x00,
+	0xD2, 0x80, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00,
+	0x93, 0x00,
+};
+
+static const uint8_t golden_frame_7[] = {
+	0x81, 0x00, 0x92, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00, 0x00, 0x1A, 0xE2, 0x00,
+	0x00, 0x0C, 0xE2, 0x00, 0x00, 0x16, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00,
+	0x00, 0x1A, 0xE2, 0x00, 0x00, 0x0C, 0x82, 0x00, 0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0xE2, 0x00,
+	0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0xE2, 0x00,
+	0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0xE2, 0x00, 0x00, 0x34, 0x82, 0x00, 0x00, 0x0A, 0xE2, 0x00,
+	0x00, 0x0A, 0xE2, 0x00, 0x00, 0x06, 0xE2, 0x00, 0x00, 0x04, 0xE2, 0x00, 0x00, 0x0C, 0xE2, 0x00,
+	0x00, 0x0A, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x06, 0xE2, 0x00, 0x00, 0x04, 0x82, 0x00,
+	0x00, 0x14, 0xE2, 0x00, 0x00, 0x1A, 0xE2, 0x00, 0x00, 0x0C, 0xE2, 0x00, 0x00, 0x16, 0xE2, 0x00,
+	0x00, 0x0A, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00, 0x00, 0x1A, 0xE2, 0x00, 0x00, 0x0C, 0xE2, 0x00,
+	0x00, 0x16, 0x82, 0x00, 0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0xE2, 0x00,
+	0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0xE2, 0x00,
+	0x00, 0x0D, 0xE2, 0x00, 0x00, 0x0D, 0x82, 0x00, 0x00, 0x08, 0xE2, 0x00, 0x00, 0x18, 0xE2, 0x00,
+	0x00, 0x14, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00, 0x00, 0x0C, 0xE2, 0x00, 0x00, 0x08, 0xE2, 0x00,
+	0x00, 0x18, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00, 0x00, 0x14, 0x82, 0x00, 0x00, 0x1A, 0xE2, 0x00,
+	0x00, 0x0C, 0xE2, 0x00, 0x00, 0x16, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x14, 0xE2, 0x00,
+	0x00, 0x1A, 0xE2, 0x00, 0x00, 0x0C, 0xE2, 0x00, 0x00, 0x16, 0xE2, 0x00, 0x00, 0x0A, 0x82, 0x00,
+	0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00,
+	0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00, 0x00, 0x2C, 0xE2, 0x00,
+	0x00, 0x2C, 0x82, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x06, 0xE2, 0x00, 0x00, 0x04, 0xE2, 0x00,
+	0x00, 0x0C, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x0A, 0xE2, 0x00, 0x00, 0x06, 0xE2, 0x00,
+	0x00, 0x04, 0xE2, 0x00, 0x00, 0x0C, 0x81, 0x00, 0x81, 0x00, 0xB1, 0x00,
+};
+
+static const struct
+{
+	const uint8_t *data;
+	uint32_t size;
+} golden_frames[] = {
+	{golden_frame_0, sizeof(golden_frame_0)},
+	{golden_frame_1, sizeof(golden_frame_1)},
+	{golden_frame_2, sizeof(golden_frame_2)},
+	{golden_frame_3, sizeof(golden_frame_3)},
+	{golden_frame_4, sizeof(golden_frame_4)},
+	{golden_frame_5, sizeof(golden_frame_5)},
+	{golden_frame_6, sizeof(golden_frame_6)},
+	{golden_frame_7, sizeof(golden_frame_7)},
+};
+
+#endif
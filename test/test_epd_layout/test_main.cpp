@@ -0,0 +1,392 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Golden layouts of the default messages and of texts that need
+ *        trimming, a break after a hyphen, a cut word or more lines than
+ *        the panel has. The classic 6x8 font and a proportional GFX font
+ *        of this test are laid out, the frames drawn with the GFX font
+ *        are compared pixel by pixel with the frames in golden.h.
+ *
+ *        After an intended change of the layout, print a new golden.h with
+ *        -DEPD_LAYOUT_GOLDEN_WRITE and check the frames before committing.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "app.h"
+#include "epd_layout.h"
+#include "epd_panel.h"
+#include "rle.h"
+#include "sim.h"
+
+/** Texts laid out by the test, the first four are the default messages of the slots */
+static const char *const layout_texts[] = {
+	"  Hi! I am thinking about you. Love you",
+	"If I know what love is, it is because ofyou",
+	"   While (true) {         I love you       }",
+	"Even when I am not  with you, all I can think of is your    smile",
+	// Trim: spaces and line breaks around the text, runs of spaces inside
+	" \n   Good   night,\n   sleep   well \n\n  ",
+	// Hyphen: the line breaks behind a hyphen
+	"A well-deserved and long-awaited get-together",
+	// Cut word: longer than a line at every size
+	"Lopadotemachoselachogaleokranioleipsanodrimhypotrimmatosilphiokarabomelitokatakechymenokichlepikossyphophattoperisteralektryonoptekephalliokigklopeleiolagoiosiraiobaphetraganopterygon",
+	// Overflow: more lines than the panel has at size 1
+	"1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n11\n12\n13\n14\n15\n16\n17\n18\n19\n20",
+};
+#define LAYOUT_TEXT_NUM (sizeof(layout_texts) / sizeof(layout_texts[0]))
+#define DEFAULT_MSG_NUM 4
+
+/** Bytes of a frame of GFXcanvas1, rows padded to full bytes */
+#define FRAME_SIZE (((epd_panel::width + 7) / 8) * epd_panel::height)
+
+/**
+ * Proportional font of the test, built in main(). Capitals and digits are
+ * 9 rows high, small letters 6, and g, j, p, q and y reach 3 rows below
+ * the baseline. Widths, offsets and bitmaps differ from glyph to glyph.
+ */
+#define TEST_FONT_FIRST 0x20
+#define TEST_FONT_LAST 0x7E
+#define TEST_FONT_GLYPHS (TEST_FONT_LAST - TEST_FONT_FIRST + 1)
+static uint8_t test_font_bitmap[TEST_FONT_GLYPHS * 7];
+static GFXglyph test_font_glyphs[TEST_FONT_GLYPHS];
+static GFXfont test_font = {test_font_bitmap, test_font_glyphs, TEST_FONT_FIRST, TEST_FONT_LAST, 12};
+
+#ifndef EPD_LAYOUT_GOLDEN_WRITE
+#include "golden.h"
+#endif
+
+/**
+ * @brief Build the glyphs of the test font
+ */
+static void build_test_font(void)
+{
+	uint16_t offset = 0;
+	for (uint16_t c = TEST_FONT_FIRST; c <= TEST_FONT_LAST; c++)
+	{
+		GFXglyph *glyph = &test_font_glyphs[c - TEST_FONT_FIRST];
+		glyph->bitmapOffset = offset;
+		if (c == ' ')
+		{
+			glyph->width = 0;
+			glyph->height = 0;
+			glyph->xAdvance = 3;
+			glyph->xOffset = 0;
+			glyph->yOffset = 0;
+			continue;
+		}
+		glyph->width = 3 + (c % 3);
+		glyph->xOffset = c % 2;
+		glyph->xAdvance = glyph->xOffset + glyph->width + 1;
+		if (c == '-')
+		{
+			glyph->height = 1;
+			glyph->yOffset = -4;
+		}
+		else if (strchr("gjpqy", c) != NULL)
+		{
+			glyph->height = 9;
+			glyph->yOffset = -6;
+		}
+		else if ((c >= 'a') && (c <= 'z'))
+		{
+			glyph->height = 6;
+			glyph->yOffset = -6;
+		}
+		else
+		{
+			glyph->height = 9;
+			glyph->yOffset = -9;
+		}
+
+		uint16_t bits = glyph->width * glyph->height;
+		memset(&test_font_bitmap[offset], 0, (bits + 7) / 8);
+		for (uint16_t bit = 0; bit < bits; bit++)
+		{
+			if (((c * 31 + bit * 17) % 5) < 3)
+			{
+				test_font_bitmap[offset + bit / 8] |= 0x80 >> (bit & 7);
+			}
+		}
+		offset += (bits + 7) / 8;
+	}
+}
+
+/**
+ * @brief Draw a text as laid out on a canvas of the panel size
+ */
+static void draw_frame(GFXcanvas1 &canvas, const char *text, const GFXfont *font, const s_epd_layout &layout)
+{
+	canvas.fillScreen(0);
+	epd_layout_draw(canvas, text, font, layout, 1);
+}
+
+#ifdef EPD_LAYOUT_GOLDEN_WRITE
+/**
+ * @brief Print the layouts of all texts in one font as a table of golden.h
+ */
+static void print_layouts(const char *name, const GFXfont *font)
+{
+	printf("static const s_epd_layout %s[] = {\n", name);
+	for (uint8_t idx = 0; idx < LAYOUT_TEXT_NUM; idx++)
+	{
+		s_epd_layout layout;
+		epd_layout_text(layout_texts[idx], strlen(layout_texts[idx]), font, epd_panel::width, epd_panel::height, &layout);
+		printf("\t{%d, %d, {", layout.size, layout.line_num);
+		for (uint8_t line = 0; line < layout.line_num; line++)
+		{
+			printf("%s{%d, %d, %d, %d}", (line == 0) ? "" : ", ", layout.lines[line].start, layout.lines[line].len,
+				   layout.lines[line].x, layout.lines[line].y);
+		}
+		printf("}},\n");
+	}
+	printf("};\n\n");
+}
+
+/**
+ * @brief Print golden.h, the frames of the GFX font are run length encoded
+ */
+static void print_golden(void)
+{
+	static uint8_t packed[RLE_MAX_SIZE(FRAME_SIZE)];
+	GFXcanvas1 canvas(epd_panel::width, epd_panel::height);
+
+	printf("/**\n * @file golden.h\n * @author agent (agent@local)\n");
+	printf(" * @brief Golden layouts and frames of test_main.cpp, printed by it\n");
+	printf(" *        with -DEPD_LAYOUT_GOLDEN_WRITE\n * @version 0.1\n * @date 2026-10-16\n *\n");
+	printf(" * @copyright Copyright (c) 2026\n *\n */\n");
+	printf("#ifndef GOLDEN_H\n#define GOLDEN_H\n\n");
+	print_layouts("golden_classic", NULL);
+	print_layouts("golden_gfx", &test_font);
+	for (uint8_t idx = 0; idx < LAYOUT_TEXT_NUM; idx++)
+	{
+		s_epd_layout layout;
+		epd_layout_text(layout_texts[idx], strlen(layout_texts[idx]), &test_font, epd_panel::width, epd_panel::height, &layout);
+		draw_frame(canvas, layout_texts[idx], &test_font, layout);
+		uint32_t size = rle_encode(canvas.getBuffer(), FRAME_SIZE, packed, sizeof(packed));
+		printf("static const uint8_t golden_frame_%d[] = {", idx);
+		for (uint32_t pos = 0; pos < size; pos++)
+		{
+			printf("%s0x%02X,", (pos % 16 == 0) ? "\n\t" : " ", packed[pos]);
+		}
+		printf("\n};\n\n");
+	}
+	printf("static const struct\n{\n\tconst uint8_t *data;\n\tuint32_t size;\n} golden_frames[] = {\n");
+	for (uint8_t idx = 0; idx < LAYOUT_TEXT_NUM; idx++)
+	{
+		printf("\t{golden_frame_%d, sizeof(golden_frame_%d)},\n", idx, idx);
+	}
+	printf("};\n\n#endif\n");
+}
+#else
+/**
+ * @brief Compare a layout with its golden layout, naming the text and the line
+ */
+static void check_layout(const s_epd_layout &expected, const s_epd_layout &actual, uint8_t text_idx)
+{
+	char message[48];
+	snprintf(message, sizeof(message), "Text %d", text_idx);
+	TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected.size, actual.size, message);
+	TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected.line_num, actual.line_num, message);
+	for (uint8_t line = 0; line < expected.line_num; line++)
+	{
+		snprintf(message, sizeof(message), "Text %d, line %d", text_idx, line);
+		TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected.lines[line].start, actual.lines[line].start, message);
+		TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected.lines[line].len, actual.lines[line].len, message);
+		TEST_ASSERT_EQUAL_INT16_MESSAGE(expected.lines[line].x, actual.lines[line].x, message);
+		TEST_ASSERT_EQUAL_INT16_MESSAGE(expected.lines[line].y, actual.lines[line].y, message);
+	}
+}
+
+/**
+ * @brief Every pixel that is set lies inside the margins and in the box of
+ *        one of the lines
+ */
+static void check_ink(const GFXcanvas1 &canvas, const s_epd_layout &layout, int16_t ascent, int16_t descent,
+					  int16_t advance, uint8_t text_idx)
+{
+	char message[48];
+	for (int16_t y = 0; y < epd_panel::height; y++)
+	{
+		for (int16_t x = 0; x < epd_panel::width; x++)
+		{
+			if (!canvas.getPixel(x, y))
+			{
+				continue;
+			}
+			bool in_line = false;
+			for (uint8_t line = 0; line < layout.line_num; line++)
+			{
+				const s_epd_line &box = layout.lines[line];
+				if ((x >= box.x) && (x < box.x + box.len * advance * layout.size) &&
+					(y >= box.y - ascent * layout.size) && (y < box.y + descent * layout.size))
+				{
+					in_line = true;
+				}
+			}
+			snprintf(message, sizeof(message), "Text %d, pixel %d,%d", text_idx, x, y);
+			TEST_ASSERT_TRUE_MESSAGE(in_line, message);
+			TEST_ASSERT_TRUE_MESSAGE((x >= EPD_TEXT_MARGIN) && (x < epd_panel::width - EPD_TEXT_MARGIN) &&
+										 (y >= EPD_TEXT_MARGIN) && (y < epd_panel::height - EPD_TEXT_MARGIN),
+									 message);
+		}
+	}
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Layouts in the classic 6x8 font, the glyphs stay in their 6x8 cells
+ */
+static void test_classic_font(void)
+{
+	GFXcanvas1 canvas(epd_panel::width, epd_panel::height);
+	for (uint8_t idx = 0; idx < LAYOUT_TEXT_NUM; idx++)
+	{
+		s_epd_layout layout;
+		epd_layout_text(layout_texts[idx], strlen(layout_texts[idx]), NULL, epd_panel::width, epd_panel::height, &layout);
+		check_layout(golden_classic[idx], layout, idx);
+		draw_frame(canvas, layout_texts[idx], NULL, layout);
+		check_ink(canvas, layout, 0, 8, 6, idx);
+	}
+}
+
+/**
+ * @brief Layouts and frames in the proportional font of the test
+ */
+static void test_gfx_font(void)
+{
+	static uint8_t expected[FRAME_SIZE];
+	GFXcanvas1 canvas(epd_panel::width, epd_panel::height);
+	for (uint8_t idx = 0; idx < LAYOUT_TEXT_NUM; idx++)
+	{
+		s_epd_layout layout;
+		epd_layout_text(layout_texts[idx], strlen(layout_texts[idx]), &test_font, epd_panel::width, epd_panel::height, &layout);
+		check_layout(golden_gfx[idx], layout, idx);
+		draw_frame(canvas, layout_texts[idx], &test_font, layout);
+		check_ink(canvas, layout, 9, 3, 7, idx);
+
+		TEST_ASSERT_TRUE(rle_decode(golden_frames[idx].data, golden_frames[idx].size, expected, sizeof(expected)));
+		for (int16_t y = 0; y < epd_panel::height; y++)
+		{
+			char message[48];
+			snprintf(message, sizeof(message), "Text %d, row %d", idx, y);
+			uint16_t row_bytes = (epd_panel::width + 7) / 8;
+			TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(&expected[y * row_bytes], &canvas.getBuffer()[y * row_bytes], row_bytes, message);
+		}
+	}
+}
+
+/**
+ * @brief True if a line of the hyphen text ends behind a hyphen
+ */
+static bool ends_with_hyphen(const s_epd_layout &layout)
+{
+	for (uint8_t line = 0; line < layout.line_num; line++)
+	{
+		const s_epd_line &box = layout.lines[line];
+		if (layout_texts[5][box.start + box.len - 1] == '-')
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief The cases the golden layouts are about, so a regenerated golden.h
+ *        cannot quietly lose them
+ */
+static void test_cases(void)
+{
+	// Trim: no line starts or ends with a space, the paragraphs stay apart
+	const s_epd_layout &trim = golden_classic[4];
+	for (uint8_t line = 0; line < trim.line_num; line++)
+	{
+		const char *text = &layout_texts[4][trim.lines[line].start];
+		TEST_ASSERT_NOT_EQUAL(' ', text[0]);
+		TEST_ASSERT_NOT_EQUAL(' ', text[trim.lines[line].len - 1]);
+	}
+	TEST_ASSERT_EQUAL_UINT8(2, trim.line_num);
+
+	// Hyphen: a line ends behind one in both fonts
+	TEST_ASSERT_TRUE(ends_with_hyphen(golden_classic[5]));
+	TEST_ASSERT_TRUE(ends_with_hyphen(golden_gfx[5]));
+
+	// Cut word: the lines are back to back in both fonts
+	const s_epd_layout *cuts[] = {&golden_classic[6], &golden_gfx[6]};
+	for (uint8_t font = 0; font < 2; font++)
+	{
+		const s_epd_layout &cut = *cuts[font];
+		TEST_ASSERT_GREATER_THAN(1, cut.line_num);
+		for (uint8_t line = 1; line < cut.line_num; line++)
+		{
+			TEST_ASSERT_EQUAL_UINT8(cut.lines[line - 1].start + cut.lines[line - 1].len, cut.lines[line].start);
+		}
+	}
+
+	// Overflow: size 1, the lines that fit, the rest is left out
+	TEST_ASSERT_EQUAL_UINT8(1, golden_classic[7].size);
+	TEST_ASSERT_LESS_THAN(20, golden_classic[7].line_num);
+	TEST_ASSERT_EQUAL_UINT8(1, golden_gfx[7].size);
+	TEST_ASSERT_LESS_THAN(20, golden_gfx[7].line_num);
+}
+
+/**
+ * @brief The slots start with the default messages, their layout is kept
+ *        until set_message() changes the slot
+ */
+static void test_message_cache(void)
+{
+	for (uint8_t slot = 1; slot <= DEFAULT_MSG_NUM; slot++)
+	{
+		uint16_t len;
+		const char *text = get_message(slot, &len);
+		TEST_ASSERT_EQUAL_UINT16(strlen(layout_texts[slot - 1]), len);
+		TEST_ASSERT_EQUAL_MEMORY(layout_texts[slot - 1], text, len);
+
+		const s_epd_layout *layout = epd_layout_message(slot, NULL, epd_panel::width, epd_panel::height);
+		TEST_ASSERT_NOT_NULL(layout);
+		check_layout(golden_classic[slot - 1], *layout, slot - 1);
+		TEST_ASSERT_EQUAL_PTR(layout, epd_layout_message(slot, NULL, epd_panel::width, epd_panel::height));
+	}
+
+	TEST_ASSERT_TRUE(set_message(1, layout_texts[6], strlen(layout_texts[6])));
+	check_layout(golden_classic[6], *epd_layout_message(1, NULL, epd_panel::width, epd_panel::height), 6);
+	TEST_ASSERT_NULL(epd_layout_message(0, NULL, epd_panel::width, epd_panel::height));
+	TEST_ASSERT_NULL(epd_layout_message(MSG_SLOTS + 1, NULL, epd_panel::width, epd_panel::height));
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	build_test_font();
+#ifdef EPD_LAYOUT_GOLDEN_WRITE
+	print_golden();
+	return 0;
+#else
+	// The message slots need the user data, the loop of the firmware is not run
+	sim_start();
+
+	UNITY_BEGIN();
+	RUN_TEST(test_classic_font);
+	RUN_TEST(test_gfx_font);
+	RUN_TEST(test_cases);
+	RUN_TEST(test_message_cache);
+	return UNITY_END();
+#endif
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Geometry of every supported panel, not only the one selected
+ *        with EPD_PANEL: the frame layout, the limits of the SSD1680 and
+ *        the screens drawn at the anchors staying on the panel.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include "epd_panel.h"
+#include "images.h"
+
+/** Text of the boot screen, classic font at size 2 */
+#define BOOT_TEXT_LEN 17
+#define BOOT_TEXT_WIDTH (BOOT_TEXT_LEN * 6 * 2)
+#define BOOT_TEXT_HEIGHT (8 * 2)
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Points on the edges of the panel
+ */
+template <typename PANEL>
+static void check_contains(void)
+{
+	TEST_ASSERT_TRUE(PANEL::contains(0, 0));
+	TEST_ASSERT_TRUE(PANEL::contains(PANEL::width - 1, PANEL::height - 1));
+	TEST_ASSERT_FALSE(PANEL::contains(-1, 0));
+	TEST_ASSERT_FALSE(PANEL::contains(0, -1));
+	TEST_ASSERT_FALSE(PANEL::contains(PANEL::width, 0));
+	TEST_ASSERT_FALSE(PANEL::contains(0, PANEL::height));
+}
+
+/**
+ * @brief The boot screen and the logo screen are completely on the panel,
+ *        the logo of the boot screen stays above its text
+ */
+template <typename PANEL>
+static void check_screens(void)
+{
+	TEST_ASSERT_TRUE(PANEL::valid());
+
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::width, PANEL::position1_x + rak_img.width);
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::position3_y, PANEL::position1_y + rak_img.height);
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::width, PANEL::position3_x + BOOT_TEXT_WIDTH);
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::height, PANEL::position3_y + BOOT_TEXT_HEIGHT);
+
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::width, PANEL::position2_x + rak_img.width);
+	TEST_ASSERT_LESS_OR_EQUAL(PANEL::height, PANEL::position2_y + rak_img.height);
+}
+
+/**
+ * @brief DEPG0213BNS800F41HP, 250 x 122
+ */
+static void test_f41hp(void)
+{
+	TEST_ASSERT_EQUAL_UINT16(250, DEPG0213BNS800F41HP::rows);
+	TEST_ASSERT_EQUAL_UINT8(16, DEPG0213BNS800F41HP::row_bytes);
+	TEST_ASSERT_EQUAL_UINT32(4000, DEPG0213BNS800F41HP::frame_size);
+	check_contains<DEPG0213BNS800F41HP>();
+	check_screens<DEPG0213BNS800F41HP>();
+}
+
+/**
+ * @brief DEPG0213BNS800F42HP, 212 x 104
+ */
+static void test_f42hp(void)
+{
+	TEST_ASSERT_EQUAL_UINT16(212, DEPG0213BNS800F42HP::rows);
+	TEST_ASSERT_EQUAL_UINT8(13, DEPG0213BNS800F42HP::row_bytes);
+	TEST_ASSERT_EQUAL_UINT32(2756, DEPG0213BNS800F42HP::frame_size);
+	check_contains<DEPG0213BNS800F42HP>();
+	check_screens<DEPG0213BNS800F42HP>();
+}
+
+/**
+ * @brief Sizes beyond the SSD1680 and anchors off the panel are rejected
+ */
+static void test_invalid(void)
+{
+	TEST_ASSERT_TRUE((s_epd_panel<EPD_MAX_GATES, EPD_MAX_SOURCES, 0, 0, 0, 0, 0, 0>::valid()));
+	TEST_ASSERT_FALSE((s_epd_panel<EPD_MAX_GATES + 1, 122, 0, 0, 0, 0, 0, 0>::valid()));
+	TEST_ASSERT_FALSE((s_epd_panel<250, EPD_MAX_SOURCES + 1, 0, 0, 0, 0, 0, 0>::valid()));
+	TEST_ASSERT_FALSE((s_epd_panel<250, 122, 250, 0, 0, 0, 0, 0>::valid()));
+	TEST_ASSERT_FALSE((s_epd_panel<250, 122, 0, 0, 0, 122, 0, 0>::valid()));
+	TEST_ASSERT_FALSE((s_epd_panel<250, 122, 0, 0, 0, 0, -1, 0>::valid()));
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	UNITY_BEGIN();
+	RUN_TEST(test_f41hp);
+	RUN_TEST(test_f42hp);
+	RUN_TEST(test_invalid);
+	return UNITY_END();
+}
@@ -0,0 +1,128 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Bytes on the SPI bus of the simulated SSD1680 for a full refresh
+ *        and for a message where one character changed. The change has to
+ *        go out as a single RAM window of a few gate lines.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include "app.h"
+#include "epd_driver.h"
+#include "epd_panel.h"
+#include "sim.h"
+
+extern EPD_SSD1680 display;
+
+/** Longer than any refresh of the simulated panel */
+#define REFRESH_MS 5000
+
+/** Bus traffic of one screen */
+struct s_traffic
+{
+	uint32_t spi_bytes;
+	uint32_t ram_bytes;
+	uint32_t full_refreshes;
+	uint32_t partial_refreshes;
+};
+
+/**
+ * @brief Show a message and wait until its refresh is done
+ *
+ * @param slot message slot
+ * @param text new text of the slot
+ * @return s_traffic what the refresh sent, both RAMs
+ */
+static s_traffic show(uint8_t slot, const char *text)
+{
+	set_message(slot, text, strlen(text));
+	s_sim_counters before = g_sim;
+	gMsgNum = slot;
+	switch_epd_message();
+	sim_run(REFRESH_MS);
+
+	s_traffic traffic;
+	traffic.spi_bytes = (g_sim.spi_bytes - before.spi_bytes) + (g_sim.spi_dma_bytes - before.spi_dma_bytes);
+	traffic.ram_bytes = g_sim.epd_ram_bytes - before.epd_ram_bytes;
+	traffic.full_refreshes = g_sim.epd_full_refreshes - before.epd_full_refreshes;
+	traffic.partial_refreshes = g_sim.epd_partial_refreshes - before.epd_partial_refreshes;
+	return traffic;
+}
+
+void setUp(void)
+{
+	display.set_full_refresh_interval(EPD_FULL_REFRESH_EVERY);
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief A full refresh sends the whole frame to both RAMs
+ */
+static void test_full_refresh(void)
+{
+	display.set_full_refresh_interval(0);
+	s_traffic full = show(1, "Hello world");
+
+	TEST_ASSERT_EQUAL_UINT32(1, full.full_refreshes);
+	TEST_ASSERT_EQUAL_UINT32(0, full.partial_refreshes);
+	TEST_ASSERT_EQUAL_UINT8(0, display.last_rect_num());
+	TEST_ASSERT_EQUAL_UINT32(2 * display.frame_size(), full.ram_bytes);
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(full.ram_bytes, full.spi_bytes);
+}
+
+/**
+ * @brief One changed character is one window of whole gate lines, sent
+ *        to the black/white RAM and after the refresh to the red RAM
+ */
+static void test_one_character(void)
+{
+	display.set_full_refresh_interval(0);
+	s_traffic full = show(1, "Hello world");
+	display.set_full_refresh_interval(EPD_FULL_REFRESH_EVERY);
+	s_traffic partial = show(1, "Hello World");
+
+	TEST_ASSERT_EQUAL_UINT32(0, partial.full_refreshes);
+	TEST_ASSERT_EQUAL_UINT32(1, partial.partial_refreshes);
+	TEST_ASSERT_EQUAL_UINT8(1, display.last_rect_num());
+
+	// The window covers the gate lines of one glyph, at most 6 columns of the biggest text size
+	uint32_t line_bytes = display.frame_size() / epd_panel::width;
+	TEST_ASSERT_EQUAL_UINT32(0, partial.ram_bytes % (2 * line_bytes));
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * line_bytes * 6 * 8, partial.ram_bytes);
+	TEST_ASSERT_LESS_THAN_UINT32(full.spi_bytes / 4, partial.spi_bytes);
+}
+
+/**
+ * @brief The same text again needs no refresh at all
+ */
+static void test_unchanged(void)
+{
+	show(1, "Hello world");
+	s_traffic same = show(1, "Hello world");
+
+	TEST_ASSERT_EQUAL_UINT32(0, same.full_refreshes);
+	TEST_ASSERT_EQUAL_UINT32(0, same.partial_refreshes);
+	TEST_ASSERT_EQUAL_UINT32(0, same.ram_bytes);
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	sim_start();
+	sim_run(REFRESH_MS);
+
+	UNITY_BEGIN();
+	RUN_TEST(test_full_refresh);
+	RUN_TEST(test_one_character);
+	RUN_TEST(test_unchanged);
+	return UNITY_END();
+}
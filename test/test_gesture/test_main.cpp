@@ -0,0 +1,161 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Labelled accelerometer traces replayed through the simulated
+ *        LIS3DH and the whole firmware. Each gesture has to come out of
+ *        the telemetry uplinks exactly once and as what it is, and the
+ *        refreshes and uplinks outside of the labels stay below a
+ *        maximum false wake rate. The traces are in traces/, one
+ *        "t_ms,x_mg,y_mg,z_mg[,label]" line per sample.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include "app.h"
+#include "sim.h"
+
+/** Project directory of PlatformIO, the traces are read from there */
+#ifndef TEST_PROJECT_DIR
+#define TEST_PROJECT_DIR "."
+#endif
+#define TRACE_DIR TEST_PROJECT_DIR "/test/test_gesture/traces/"
+
+/** Join of the fake LoRaMAC, gestures are ignored before */
+#define JOIN_MS 10000
+/** Longest trace plus the uplink quiet windows, capped at 4 of them */
+#define REPLAY_MS (60000 + 4 * 30000 + 10000)
+/** The uplink of a gesture waits for its quiet window, it is still expected */
+#define LABEL_SLACK_MS (4 * 30000 + 10000)
+/** Refreshes or uplinks nobody asked for, per hour of replay */
+#define MAX_FALSE_WAKES_PER_HOUR 2
+
+/** Gestures reported by the telemetry uplinks, per UPLINK_REASON_xxx bit */
+static uint32_t gestures[UPLINK_REASON_NUM];
+
+/** Start of the replays and the false wakes before them */
+static uint32_t replay_start_ms = 0;
+static uint32_t false_wakes_before = 0;
+
+/**
+ * @brief Add up the gesture counts of every telemetry frame on air
+ */
+static void count_uplink(const uint8_t *data, uint8_t size)
+{
+	if ((size < 4) || (data[0] != TELEMETRY_UPLINK))
+	{
+		return;
+	}
+	uint8_t reasons = data[2];
+	uint8_t pos = 4;
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if ((reasons & (1 << idx)) && (pos < size))
+		{
+			gestures[idx] += data[pos++];
+		}
+	}
+}
+
+/**
+ * @brief Replay a trace until its uplinks are out
+ *
+ * @param name file in traces/ without .csv
+ */
+static void replay(const char *name)
+{
+	char path[256];
+	snprintf(path, sizeof(path), TRACE_DIR "%s.csv", name);
+	memset(gestures, 0, sizeof(gestures));
+	TEST_ASSERT_TRUE_MESSAGE(sim_lis3dh_load_trace(path), path);
+	sim_run(REPLAY_MS);
+}
+
+/**
+ * @brief The trace shows exactly one gesture and it is the expected one
+ *
+ * @param name file in traces/ without .csv
+ * @param reason UPLINK_REASON_xxx of the gesture
+ */
+static void check_gesture(const char *name, uint8_t reason)
+{
+	replay(name);
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		char message[64];
+		snprintf(message, sizeof(message), "%s: gestures of reason 0x%02X", name, 1 << idx);
+		TEST_ASSERT_EQUAL_UINT32_MESSAGE(((1 << idx) == reason) ? 1 : 0, gestures[idx], message);
+	}
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_tap(void)
+{
+	check_gesture("tap", UPLINK_REASON_TAP);
+}
+
+static void test_double_tap(void)
+{
+	check_gesture("double_tap", UPLINK_REASON_DOUBLE_TAP);
+}
+
+static void test_shake(void)
+{
+	check_gesture("shake", UPLINK_REASON_SHAKE);
+}
+
+static void test_flip(void)
+{
+	check_gesture("flip", UPLINK_REASON_FLIP);
+}
+
+/**
+ * @brief Footsteps and bumps in a pocket are no gesture
+ */
+static void test_pocket_noise(void)
+{
+	check_gesture("pocket", 0);
+}
+
+/**
+ * @brief Refreshes and uplinks outside of the labelled gestures, over all
+ *        replays
+ */
+static void test_false_wake_rate(void)
+{
+	uint32_t replay_ms = millis() - replay_start_ms;
+	uint32_t false_wakes = sim_false_wakes() - false_wakes_before;
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32((uint64_t)MAX_FALSE_WAKES_PER_HOUR * replay_ms / 3600000, false_wakes);
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	sim_lis3dh_attach();
+	sim_lorawan_set_uplink_hook(count_uplink);
+	sim_label_slack(LABEL_SLACK_MS);
+	sim_start();
+	sim_run(JOIN_MS);
+	replay_start_ms = millis();
+	false_wakes_before = sim_false_wakes();
+
+	UNITY_BEGIN();
+	RUN_TEST(test_tap);
+	RUN_TEST(test_double_tap);
+	RUN_TEST(test_shake);
+	RUN_TEST(test_flip);
+	RUN_TEST(test_pocket_noise);
+	RUN_TEST(test_false_wake_rate);
+	return UNITY_END();
+}
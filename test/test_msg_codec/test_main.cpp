@@ -0,0 +1,198 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Round trips of the packed message codec, its padding, the
+ *        dictionary flag and the stream sizes of the default messages.
+ *        The expected streams are those of tools/msgcodec.py.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include "msg_codec.h"
+
+/** Longest message, MSG_MAX_LEN of app.h */
+#define TEXT_MAX 255
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Encode and decode a text, the decoded text has to be the same
+ */
+static void round_trip(const char *text, uint16_t len, bool use_dict)
+{
+	uint8_t stream[MSG_CODEC_MAX_SIZE(TEXT_MAX)];
+	char decoded[TEXT_MAX + 1];
+
+	uint16_t size = msg_encode(text, len, stream, sizeof(stream), use_dict);
+	TEST_ASSERT_GREATER_THAN(0, size);
+	TEST_ASSERT_LESS_OR_EQUAL(MSG_CODEC_MAX_SIZE(len), size);
+	TEST_ASSERT_EQUAL_INT16(len, msg_decode(stream, size, decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_MEMORY(text, decoded, len);
+	TEST_ASSERT_EQUAL_UINT8(0, decoded[len]);
+}
+
+/**
+ * @brief Every byte value, also the ones that need a raw code
+ */
+static void test_all_bytes(void)
+{
+	char text[TEXT_MAX];
+	for (uint16_t offset = 0; offset < 256; offset += TEXT_MAX)
+	{
+		uint16_t len = (256 - offset < TEXT_MAX) ? 256 - offset : TEXT_MAX;
+		for (uint16_t idx = 0; idx < len; idx++)
+		{
+			text[idx] = (char)(offset + idx);
+		}
+		round_trip(text, len, false);
+		round_trip(text, len, true);
+	}
+}
+
+/**
+ * @brief Every length, with space runs and dictionary words in the text
+ */
+static void test_all_lengths(void)
+{
+	static const char pattern[] = "I love you    and The Moon!     ~\x01 Hello Hello";
+	char text[TEXT_MAX];
+	for (uint16_t idx = 0; idx < TEXT_MAX; idx++)
+	{
+		text[idx] = pattern[idx % (sizeof(pattern) - 1)];
+	}
+	for (uint16_t len = 0; len <= TEXT_MAX; len++)
+	{
+		round_trip(text, len, false);
+		round_trip(text, len, true);
+	}
+}
+
+/**
+ * @brief The last byte is padded with ones. 2 bits cannot start a code,
+ *        6 bits read as a raw code without its byte, both end the stream.
+ */
+static void test_padding(void)
+{
+	uint8_t stream[8];
+	char decoded[8];
+
+	// One code, 2 bits of padding
+	static const uint8_t one[] = {0x10, 0x07};
+	TEST_ASSERT_EQUAL_UINT16(sizeof(one), msg_encode("a", 1, stream, sizeof(stream), false));
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(one, stream, sizeof(one));
+	TEST_ASSERT_EQUAL_INT16(1, msg_decode(stream, sizeof(one), decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_STRING("a", decoded);
+
+	// Three codes, 6 bits of padding
+	static const uint8_t three[] = {0x10, 0x04, 0x20, 0xFF};
+	TEST_ASSERT_EQUAL_UINT16(sizeof(three), msg_encode("abc", 3, stream, sizeof(stream), false));
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(three, stream, sizeof(three));
+	TEST_ASSERT_EQUAL_INT16(3, msg_decode(stream, sizeof(three), decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_STRING("abc", decoded);
+
+	// Four codes fill the bytes, no padding
+	static const uint8_t four[] = {0x10, 0x04, 0x20, 0xC4};
+	TEST_ASSERT_EQUAL_UINT16(sizeof(four), msg_encode("abcd", 4, stream, sizeof(stream), false));
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(four, stream, sizeof(four));
+	TEST_ASSERT_EQUAL_INT16(4, msg_decode(stream, sizeof(four), decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_STRING("abcd", decoded);
+}
+
+/**
+ * @brief Dictionary codes are only valid with the flag in the header
+ */
+static void test_dictionary_flag(void)
+{
+	uint8_t stream[32];
+	char decoded[32];
+
+	uint16_t size = msg_encode("Hello you", 9, stream, sizeof(stream), true);
+	TEST_ASSERT_EQUAL_UINT16(4, size);
+	TEST_ASSERT_EQUAL_INT16(9, msg_decode(stream, size, decoded, sizeof(decoded)));
+
+	stream[0] &= ~MSG_CODEC_FLAG_DICT;
+	TEST_ASSERT_EQUAL_INT16(-1, msg_decode(stream, size, decoded, sizeof(decoded)));
+
+	// A stream without dictionary codes decodes either way
+	size = msg_encode("hello", 5, stream, sizeof(stream), false);
+	stream[0] |= MSG_CODEC_FLAG_DICT;
+	TEST_ASSERT_EQUAL_INT16(5, msg_decode(stream, size, decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_STRING("hello", decoded);
+}
+
+/**
+ * @brief Damaged streams and buffers that are too small
+ */
+static void test_limits(void)
+{
+	uint8_t stream[32];
+	char decoded[32];
+
+	static const uint8_t version[] = {0x20, 0x07};
+	TEST_ASSERT_EQUAL_INT16(-1, msg_decode(version, sizeof(version), decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_INT16(-1, msg_decode(stream, 0, decoded, sizeof(decoded)));
+
+	TEST_ASSERT_EQUAL_UINT16(0, msg_encode("hello you", 9, stream, 3, false));
+	uint16_t size = msg_encode("hello you", 9, stream, sizeof(stream), false);
+	TEST_ASSERT_EQUAL_INT16(-1, msg_decode(stream, size, decoded, 9));
+	TEST_ASSERT_EQUAL_INT16(9, msg_decode(stream, size, decoded, 10));
+}
+
+/**
+ * @brief Sizes of the default messages and the example of the README,
+ *        with and without the dictionary
+ */
+static void test_sample_sizes(void)
+{
+	static const struct
+	{
+		const char *text;
+		uint16_t dict_size;
+		uint16_t plain_size;
+	} samples[] = {
+		{"  Hi! I am thinking about you. Love you", 19, 33},
+		{"If I know what love is, it is because ofyou", 23, 35},
+		{"   While (true) {         I love you       }", 16, 26},
+		{"Even when I am not  with you, all I can think of is your    smile", 30, 51},
+		{"Happy birthday! Can't wait to see you tonight", 25, 37},
+	};
+	uint8_t stream[MSG_CODEC_MAX_SIZE(TEXT_MAX)];
+
+	for (uint8_t idx = 0; idx < sizeof(samples) / sizeof(samples[0]); idx++)
+	{
+		uint16_t len = strlen(samples[idx].text);
+		TEST_ASSERT_EQUAL_UINT16(samples[idx].dict_size, msg_encode(samples[idx].text, len, stream, sizeof(stream), true));
+		TEST_ASSERT_EQUAL_UINT16(samples[idx].plain_size, msg_encode(samples[idx].text, len, stream, sizeof(stream), false));
+		round_trip(samples[idx].text, len, true);
+	}
+
+	// Same stream as tools/msgcodec.py
+	static const uint8_t first[] = {0x11, 0x00, 0x0F, 0x08, 0x26, 0x70, 0x3E, 0x08, 0x13, 0x7E,
+									0x1B, 0xE1, 0xFE, 0x02, 0x50, 0x3E, 0x27, 0xE0, 0x3F};
+	msg_encode(samples[0].text, strlen(samples[0].text), stream, sizeof(stream), true);
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(first, stream, sizeof(first));
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	UNITY_BEGIN();
+	RUN_TEST(test_all_bytes);
+	RUN_TEST(test_all_lengths);
+	RUN_TEST(test_padding);
+	RUN_TEST(test_dictionary_flag);
+	RUN_TEST(test_limits);
+	RUN_TEST(test_sample_sizes);
+	return UNITY_END();
+}
@@ -0,0 +1,288 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Upload of a message image through the downlinks: a gap, a repeated
+ *        piece, a reset in the middle of the upload, the offset it resumes
+ *        at, a reset after the last piece and an image with a wrong CRC. The slot with the finished image
+ *        is shown and the panel RAM is compared pixel by pixel.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "app.h"
+#include "crc.h"
+#include "epd_panel.h"
+#include "sim.h"
+
+#include <Adafruit_LittleFS.h>
+#include <InternalFileSystem.h>
+
+using namespace Adafruit_LittleFS_Namespace;
+
+/** Longer than any refresh of the simulated panel */
+#define REFRESH_MS 5000
+
+/** Image of the test, the top edge is not on a byte boundary of the panel */
+#define IMG_WIDTH 40
+#define IMG_HEIGHT 24
+#define IMG_COL_BYTES ((IMG_HEIGHT + 7) / 8)
+#define IMG_SLOT 2
+
+/** Pieces of the upload */
+#define PIECE_SIZE 16
+
+static uint8_t image[RLE_MAX_SIZE(IMG_WIDTH * IMG_COL_BYTES)];
+static uint16_t image_size;
+static uint32_t image_crc;
+
+/**
+ * @brief Pixels of the image, no symmetry so a flipped image does not match
+ */
+static bool image_pixel(uint16_t x, uint16_t y)
+{
+	return (x == 0) || (y == 0) || (((x * 3 + y * 5) % 7) < 3);
+}
+
+/**
+ * @brief Encode the image as tools/imgconv.py does: columns of bytes, each
+ *        one XOR the column before, run length encoded
+ */
+static void make_image(void)
+{
+	uint8_t raw[IMG_WIDTH * IMG_COL_BYTES] = {0};
+	uint8_t previous[IMG_COL_BYTES] = {0};
+	for (uint16_t x = 0; x < IMG_WIDTH; x++)
+	{
+		uint8_t column[IMG_COL_BYTES] = {0};
+		for (uint16_t y = 0; y < IMG_HEIGHT; y++)
+		{
+			if (image_pixel(x, y))
+			{
+				column[y / 8] |= 0x80 >> (y % 8);
+			}
+		}
+		for (uint8_t idx = 0; idx < IMG_COL_BYTES; idx++)
+		{
+			raw[x * IMG_COL_BYTES + idx] = column[idx] ^ previous[idx];
+			previous[idx] = column[idx];
+		}
+	}
+	image_size = rle_encode(raw, sizeof(raw), image, sizeof(image));
+	image_crc = crc32_update(CRC32_INIT, image, image_size);
+}
+
+/**
+ * @brief Send the downlink that starts an upload
+ */
+static uint8_t send_begin(uint8_t slot, uint32_t crc)
+{
+	uint8_t data[IMG_BEGIN_SIZE] = {IMG_BEGIN_DOWNLINK, slot, IMG_WIDTH >> 8, IMG_WIDTH & 0xFF,
+									IMG_HEIGHT >> 8, IMG_HEIGHT & 0xFF, (uint8_t)(image_size >> 8),
+									(uint8_t)(image_size & 0xFF), (uint8_t)(crc >> 24), (uint8_t)(crc >> 16),
+									(uint8_t)(crc >> 8), (uint8_t)crc};
+	return apply_image_downlink(data, sizeof(data));
+}
+
+/**
+ * @brief Send a piece of the image
+ *
+ * @return uint8_t slot with the new image, 0 if the upload did not finish
+ */
+static uint8_t send_piece(uint16_t offset, uint16_t len)
+{
+	uint8_t data[IMG_CHUNK_HEADER_SIZE + PIECE_SIZE * 2];
+	data[0] = IMG_CHUNK_DOWNLINK;
+	data[1] = offset >> 8;
+	data[2] = offset & 0xFF;
+	memcpy(&data[IMG_CHUNK_HEADER_SIZE], &image[offset], len);
+	return apply_image_downlink(data, IMG_CHUNK_HEADER_SIZE + len);
+}
+
+/**
+ * @brief Send the rest of the image from an offset
+ */
+static uint8_t send_rest(uint16_t offset)
+{
+	uint8_t done = 0;
+	while (offset < image_size)
+	{
+		uint16_t len = (image_size - offset < PIECE_SIZE) ? image_size - offset : PIECE_SIZE;
+		done = send_piece(offset, len);
+		offset += len;
+	}
+	return done;
+}
+
+/**
+ * @brief Offset the upload continues at, checked against the status uplink
+ */
+static uint16_t resume_offset(uint8_t expected_state)
+{
+	uint8_t slot;
+	uint16_t offset;
+	uint16_t size;
+	TEST_ASSERT_EQUAL_UINT8(expected_state, image_upload_state(&slot, &offset, &size));
+	TEST_ASSERT_EQUAL_UINT16(image_size, size);
+
+	uint8_t frame[8];
+	TEST_ASSERT_EQUAL_UINT8(5, build_image_status(frame, sizeof(frame)));
+	TEST_ASSERT_EQUAL_HEX8(IMG_STATUS_UPLINK, frame[0]);
+	TEST_ASSERT_EQUAL_UINT8(slot, frame[1]);
+	TEST_ASSERT_EQUAL_UINT8(expected_state, frame[2]);
+	TEST_ASSERT_EQUAL_UINT16(offset, (frame[3] << 8) | frame[4]);
+	return offset;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Pieces behind a gap are dropped, repeated ones only add what is
+ *        new, and the upload survives a reset
+ */
+static void test_upload(void)
+{
+	TEST_ASSERT_GREATER_THAN(3 * PIECE_SIZE, image_size);
+	TEST_ASSERT_FALSE(message_image(IMG_SLOT, NULL, NULL));
+
+	send_begin(IMG_SLOT, image_crc);
+	TEST_ASSERT_EQUAL_UINT16(0, resume_offset(IMG_STATE_RECEIVING));
+	TEST_ASSERT_EQUAL_UINT8(0, send_piece(0, PIECE_SIZE));
+	TEST_ASSERT_EQUAL_UINT16(PIECE_SIZE, resume_offset(IMG_STATE_RECEIVING));
+
+	// Gap, the piece is dropped
+	send_piece(2 * PIECE_SIZE, PIECE_SIZE);
+	TEST_ASSERT_EQUAL_UINT16(PIECE_SIZE, resume_offset(IMG_STATE_RECEIVING));
+
+	// The same piece again changes nothing, one that overlaps adds its new part
+	send_piece(0, PIECE_SIZE);
+	TEST_ASSERT_EQUAL_UINT16(PIECE_SIZE, resume_offset(IMG_STATE_RECEIVING));
+	send_piece(PIECE_SIZE / 2, PIECE_SIZE);
+	TEST_ASSERT_EQUAL_UINT16(PIECE_SIZE + PIECE_SIZE / 2, resume_offset(IMG_STATE_RECEIVING));
+
+	// Reset, the upload continues where the file ends
+	init_message_images();
+	uint16_t offset = resume_offset(IMG_STATE_RECEIVING);
+	TEST_ASSERT_EQUAL_UINT16(PIECE_SIZE + PIECE_SIZE / 2, offset);
+	send_begin(IMG_SLOT, image_crc);
+	TEST_ASSERT_EQUAL_UINT16(offset, resume_offset(IMG_STATE_RECEIVING));
+
+	TEST_ASSERT_EQUAL_UINT8(IMG_SLOT, send_rest(offset));
+	TEST_ASSERT_EQUAL_UINT16(image_size, resume_offset(IMG_STATE_DONE));
+
+	uint16_t width;
+	uint16_t height;
+	TEST_ASSERT_TRUE(message_image(IMG_SLOT, &width, &height));
+	TEST_ASSERT_EQUAL_UINT16(IMG_WIDTH, width);
+	TEST_ASSERT_EQUAL_UINT16(IMG_HEIGHT, height);
+
+	// The image is still there after a reset
+	init_message_images();
+	TEST_ASSERT_TRUE(message_image(IMG_SLOT, NULL, NULL));
+}
+
+/**
+ * @brief All bytes arrived but the CRC does not match, the slot keeps its text
+ */
+static void test_crc_failure(void)
+{
+	send_begin(IMG_SLOT + 1, image_crc ^ 1);
+	TEST_ASSERT_EQUAL_UINT8(0, send_rest(0));
+	resume_offset(IMG_STATE_FAILED);
+	TEST_ASSERT_FALSE(message_image(IMG_SLOT + 1, NULL, NULL));
+
+	// More pieces do not restart it, and nothing is left to resume after a reset
+	TEST_ASSERT_EQUAL_UINT8(0, send_piece(0, PIECE_SIZE));
+	resume_offset(IMG_STATE_FAILED);
+	init_message_images();
+	uint8_t slot;
+	uint16_t offset;
+	uint16_t size;
+	TEST_ASSERT_EQUAL_UINT8(IMG_STATE_IDLE, image_upload_state(&slot, &offset, &size));
+	TEST_ASSERT_FALSE(message_image(IMG_SLOT + 1, NULL, NULL));
+	TEST_ASSERT_TRUE(message_image(IMG_SLOT, NULL, NULL));
+}
+
+/**
+ * @brief The reset came after the last piece was written but before its
+ *        CRC was checked, the boot finishes the upload
+ */
+static void test_complete_at_reset(void)
+{
+	uint8_t slot = IMG_SLOT + 2;
+	uint16_t last = ((image_size - 1) / PIECE_SIZE) * PIECE_SIZE;
+	send_begin(slot, image_crc);
+	while (resume_offset(IMG_STATE_RECEIVING) < last)
+	{
+		send_piece(resume_offset(IMG_STATE_RECEIVING), PIECE_SIZE);
+	}
+
+	// The last piece as image_upload_chunk() writes it, then the reset
+	File file(InternalFS);
+	TEST_ASSERT_TRUE(file.open("USER_IMG_NEW", FILE_O_WRITE));
+	TEST_ASSERT_EQUAL_UINT32(image_size - last, file.write(&image[last], image_size - last));
+	file.close();
+	init_message_images();
+
+	TEST_ASSERT_EQUAL_UINT16(image_size, resume_offset(IMG_STATE_DONE));
+	TEST_ASSERT_TRUE(message_image(slot, NULL, NULL));
+	TEST_ASSERT_FALSE(InternalFS.exists("USER_IMG_NEW"));
+}
+
+/**
+ * @brief The slot shows the image centered on an otherwise white panel.
+ *        The gate lines run along the panel width from its right edge, a
+ *        source byte holds 8 rows behind one byte the panel does not use.
+ */
+static void test_show_image(void)
+{
+	gMsgNum = IMG_SLOT;
+	switch_epd_message();
+	sim_run(REFRESH_MS);
+
+	uint16_t row_bytes;
+	uint16_t rows;
+	const uint8_t *ram = sim_ssd1680_bw_ram(&row_bytes, &rows);
+	int16_t left = (epd_panel::width - IMG_WIDTH) / 2;
+	int16_t top = (epd_panel::height - IMG_HEIGHT) / 2;
+	for (int16_t x = 0; x < epd_panel::width; x++)
+	{
+		const uint8_t *gate_line = &ram[(epd_panel::width - 1 - x) * row_bytes];
+		for (int16_t y = 0; y < epd_panel::height; y++)
+		{
+			bool black = (x >= left) && (x < left + IMG_WIDTH) && (y >= top) && (y < top + IMG_HEIGHT) &&
+						 image_pixel(x - left, y - top);
+			bool white = gate_line[1 + y / 8] & (0x80 >> (y & 7));
+			char message[32];
+			snprintf(message, sizeof(message), "Pixel %d,%d", x, y);
+			TEST_ASSERT_TRUE_MESSAGE(black != white, message);
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	make_image();
+	sim_start();
+	sim_run(REFRESH_MS);
+
+	UNITY_BEGIN();
+	RUN_TEST(test_upload);
+	RUN_TEST(test_crc_failure);
+	RUN_TEST(test_complete_at_reset);
+	RUN_TEST(test_show_image);
+	return UNITY_END();
+}
@@ -0,0 +1,306 @@
+/**
+ * @file test_main.cpp
+ * @author agent (agent@local)
+ * @brief Telemetry frames for the payload size of every data rate. The
+ *        frames are parsed back section by section, the gesture times that
+ *        do not fit stay for the next frame.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+
+#include "app.h"
+#include "sim.h"
+
+/** Largest payload per data rate, as the fake LoRaMAC of the simulation */
+static const uint8_t eu868_payload[] = {51, 51, 51, 115, 222, 222, 222, 222};
+static const uint8_t us915_payload[] = {11, 53, 125, 242, 242};
+
+/** A frame parsed back */
+struct s_parsed
+{
+	uint8_t flags;
+	uint8_t reasons;
+	uint8_t counts;
+	uint8_t event_num;
+	/** Age of the oldest event in the frame in s */
+	uint32_t oldest_age;
+	uint8_t digests_len;
+};
+
+/**
+ * @brief Split a frame into its sections, every byte has to belong to one
+ *
+ * @return true if the frame is complete
+ */
+static bool parse(const uint8_t *frame, uint8_t len, s_parsed &parsed)
+{
+	memset(&parsed, 0, sizeof(parsed));
+	if ((len < 4) || (frame[0] != TELEMETRY_UPLINK) || ((frame[1] >> 4) != TELEMETRY_VERSION))
+	{
+		return false;
+	}
+	parsed.flags = frame[1] & 0x0F;
+	parsed.reasons = frame[2];
+	uint8_t pos = 4;
+	for (uint8_t idx = 1; idx < UPLINK_REASON_NUM; idx++)
+	{
+		if (parsed.reasons & (1 << idx))
+		{
+			pos++;
+			parsed.counts++;
+		}
+	}
+	if (parsed.flags & TELEMETRY_HAS_STATUS)
+	{
+		pos += 4;
+	}
+	if (parsed.flags & TELEMETRY_HAS_EVENTS)
+	{
+		if (pos >= len)
+		{
+			return false;
+		}
+		parsed.event_num = frame[pos++];
+		if (parsed.event_num == 0)
+		{
+			return false;
+		}
+		for (uint8_t event = 0; event < parsed.event_num; event++)
+		{
+			if (pos >= len)
+			{
+				return false;
+			}
+			uint32_t age = frame[pos] & 0x3F;
+			if (age == 0x3F)
+			{
+				uint8_t shift = 0;
+				do
+				{
+					pos++;
+					if (pos >= len)
+					{
+						return false;
+					}
+					age += (uint32_t)(frame[pos] & 0x7F) << shift;
+					shift += 7;
+				} while (frame[pos] & 0x80);
+			}
+			pos++;
+			parsed.oldest_age += age;
+		}
+	}
+	if (parsed.flags & TELEMETRY_HAS_DIGESTS)
+	{
+		parsed.digests_len = len - pos;
+		if ((parsed.digests_len < 3) || ((parsed.digests_len & 1) == 0))
+		{
+			return false;
+		}
+		pos = len;
+	}
+	return pos == len;
+}
+
+/**
+ * @brief A gesture at a point of simulated time
+ */
+static void gesture(uint8_t reason, uint32_t at_ms)
+{
+	sim_advance_to((uint64_t)at_ms * 1000);
+	telemetry_event(reason);
+}
+
+/**
+ * @brief Send frames until no gesture time is left
+ */
+static void drain(void)
+{
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	s_parsed parsed;
+	do
+	{
+		TEST_ASSERT_TRUE(parse(frame, build_telemetry(frame, TELEMETRY_MAX_SIZE, 0), parsed));
+		telemetry_sent();
+	} while (parsed.event_num != 0);
+}
+
+/**
+ * @brief TELEMETRY_MAX_EVENTS gestures, some of them minutes apart so
+ *        their ages take more than one byte
+ */
+static void fill_events(void)
+{
+	uint32_t now = millis();
+	for (uint8_t idx = 0; idx < TELEMETRY_MAX_EVENTS; idx++)
+	{
+		now += (idx % 4 == 0) ? 200000 : 5000;
+		gesture(UPLINK_REASON_TAP << (idx % 4), now);
+	}
+	sim_advance_to((uint64_t)(now + 1000) * 1000);
+}
+
+void setUp(void)
+{
+	drain();
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Check the frame of a timer uplink with all gestures for one payload size
+ */
+static void check_payload(uint8_t max_payload)
+{
+	uint8_t max_size = (max_payload < TELEMETRY_MAX_SIZE) ? max_payload : TELEMETRY_MAX_SIZE;
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	s_parsed parsed;
+
+	fill_events();
+	uint8_t len = build_telemetry(frame, max_size, UPLINK_REASON_TIMER);
+	TEST_ASSERT_GREATER_THAN(0, len);
+	TEST_ASSERT_LESS_OR_EQUAL(max_size, len);
+	TEST_ASSERT_TRUE(parse(frame, len, parsed));
+	TEST_ASSERT_EQUAL_UINT8(4, parsed.counts);
+	if (max_size >= TELEMETRY_MAX_SIZE)
+	{
+		// Everything fits into the largest frame
+		TEST_ASSERT_EQUAL_HEX8(TELEMETRY_HAS_STATUS | TELEMETRY_HAS_EVENTS | TELEMETRY_HAS_DIGESTS, parsed.flags);
+		TEST_ASSERT_EQUAL_UINT8(TELEMETRY_MAX_EVENTS, parsed.event_num);
+	}
+}
+
+/**
+ * @brief Payload sizes of EU868
+ */
+static void test_payload_eu868(void)
+{
+	for (uint8_t dr = 0; dr < sizeof(eu868_payload); dr++)
+	{
+		check_payload(eu868_payload[dr]);
+		drain();
+	}
+}
+
+/**
+ * @brief Payload sizes of US915, DR0 leaves no room for the gesture times
+ */
+static void test_payload_us915(void)
+{
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	s_parsed parsed;
+
+	for (uint8_t dr = 0; dr < sizeof(us915_payload); dr++)
+	{
+		check_payload(us915_payload[dr]);
+		drain();
+	}
+
+	// 4 bytes header, 4 counts and the first digest fill the 11 bytes
+	fill_events();
+	uint8_t len = build_telemetry(frame, us915_payload[0], UPLINK_REASON_TIMER);
+	TEST_ASSERT_EQUAL_UINT8(us915_payload[0], len);
+	TEST_ASSERT_TRUE(parse(frame, len, parsed));
+	TEST_ASSERT_EQUAL_HEX8(TELEMETRY_HAS_DIGESTS, parsed.flags);
+}
+
+/**
+ * @brief Room for the count byte but not for the newest age leaves the
+ *        events section out
+ */
+static void test_no_room_for_an_age(void)
+{
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	s_parsed parsed;
+
+	// 300 s old, 3 bytes of age
+	gesture(UPLINK_REASON_TAP, millis());
+	sim_advance_to(sim_now_us() + 300000000ULL);
+
+	// Header and one count, then 2 bytes
+	uint8_t len = build_telemetry(frame, 7, 0);
+	TEST_ASSERT_EQUAL_UINT8(5, len);
+	TEST_ASSERT_TRUE(parse(frame, len, parsed));
+	TEST_ASSERT_EQUAL_HEX8(0, parsed.flags);
+
+	// The time was not sent and is still there
+	telemetry_sent();
+	len = build_telemetry(frame, TELEMETRY_MAX_SIZE, 0);
+	TEST_ASSERT_TRUE(parse(frame, len, parsed));
+	TEST_ASSERT_EQUAL_UINT8(1, parsed.event_num);
+	TEST_ASSERT_EQUAL_UINT32(300, parsed.oldest_age);
+}
+
+/**
+ * @brief The newest times go first, the older ones follow in the next frame
+ */
+static void test_unsent_events_kept(void)
+{
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+	s_parsed first;
+	s_parsed second;
+
+	fill_events();
+	uint8_t len = build_telemetry(frame, 16, 0);
+	TEST_ASSERT_TRUE(parse(frame, len, first));
+	TEST_ASSERT_GREATER_THAN(0, first.event_num);
+	TEST_ASSERT_LESS_THAN(TELEMETRY_MAX_EVENTS, first.event_num);
+	telemetry_sent();
+	TEST_ASSERT_FALSE(telemetry_events_full());
+
+	len = build_telemetry(frame, TELEMETRY_MAX_SIZE, 0);
+	TEST_ASSERT_TRUE(parse(frame, len, second));
+	TEST_ASSERT_EQUAL_UINT8(TELEMETRY_MAX_EVENTS - first.event_num, second.event_num);
+	TEST_ASSERT_GREATER_THAN(first.oldest_age, second.oldest_age);
+	// The counts went out with the first frame
+	TEST_ASSERT_EQUAL_UINT8(0, second.counts);
+
+	telemetry_sent();
+	len = build_telemetry(frame, TELEMETRY_MAX_SIZE, 0);
+	TEST_ASSERT_TRUE(parse(frame, len, second));
+	TEST_ASSERT_EQUAL_UINT8(0, second.event_num);
+}
+
+/**
+ * @brief The frame reports the screen on the panel, also the logo after
+ *        which gMsgNum starts over
+ */
+static void test_shown_message(void)
+{
+	uint8_t frame[TELEMETRY_MAX_SIZE];
+
+	gMsgNum = 1;
+	switch_epd_message();
+	sim_run(5000);
+	TEST_ASSERT_GREATER_THAN(3, build_telemetry(frame, TELEMETRY_MAX_SIZE, 0));
+	TEST_ASSERT_EQUAL_UINT8(1, frame[3]);
+
+	gMsgNum = MSG_LOGO;
+	switch_epd_message();
+	sim_run(5000);
+	TEST_ASSERT_EQUAL_UINT8(0, gMsgNum);
+	TEST_ASSERT_GREATER_THAN(3, build_telemetry(frame, TELEMETRY_MAX_SIZE, 0));
+	TEST_ASSERT_EQUAL_UINT8(MSG_LOGO, frame[3]);
+}
+
+int main(int argc, char **argv)
+{
+	(void)argc;
+	(void)argv;
+	// Message digests need the user data, the loop of the firmware is not run
+	sim_start();
+
+	UNITY_BEGIN();
+	RUN_TEST(test_payload_eu868);
+	RUN_TEST(test_payload_us915);
+	RUN_TEST(test_no_room_for_an_age);
+	RUN_TEST(test_unsent_events_kept);
+	RUN_TEST(test_shown_message);
+	return UNITY_END();
+}
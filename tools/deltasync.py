@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+"""Network server side of the WisBlock-Heart delta sync (see src/delta.cpp).
+
+The telemetry uplink of a badge ends with the first slot and a CRC16 per
+message. The server keeps them and sends a change only to badges whose
+digest differs from the wanted text, as the smallest of
+
+    E2 <slot> <crc16> (<offset> <deleted> <inserted> <bytes>)...   patch
+    E3 <dst> <src> <crc16 of src>                                  copy
+    E0 <slot> <packed text>                                        full text
+
+    tools/deltasync.py digest "text"                      CRC16 of a message
+    tools/deltasync.py uplink 12150103...                 digests of a telemetry uplink
+    tools/deltasync.py patch 2 "old text" "new text"      downlink for one badge
+    tools/deltasync.py fleet --badges 1000 --dr 2         airtime of campaigns
+"""
+import argparse
+import binascii
+import difflib
+import math
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import fragment  # noqa: E402
+import msgcodec  # noqa: E402
+import telemetry  # noqa: E402
+
+MSG_PATCH_DOWNLINK = 0xE2
+MSG_COPY_DOWNLINK = 0xE3
+MSG_SLOTS = 4
+DIGEST_SLOTS_PER_UPLINK = 8
+DIGEST_REFRESH_UPLINKS = 24
+FRAG_HEADER_SIZE = 4
+# Equal bytes between two ranges up to this size are cheaper to resend than a range header
+PATCH_MERGE_GAP = 3
+
+# LoRaWAN MHDR, FHDR without options, FPort and MIC
+LORAWAN_OVERHEAD = 13
+# EU868 spreading factor and maximum application payload per data rate, 125 kHz
+EU868 = {0: (12, 51), 1: (11, 51), 2: (10, 51), 3: (9, 115), 4: (8, 222), 5: (7, 222)}
+
+
+def digest(text):
+    """CRC16 CCITT-FALSE of a message, as message_digest() on the badge."""
+    return binascii.crc_hqx(text, 0xFFFF)
+
+
+def parse_uplink(uplink):
+    """Slot to digest map of a telemetry uplink, empty without digests."""
+    digests = telemetry.decode(uplink).get("digests", {})
+    return {slot: int(value, 16) for slot, value in digests.items()}
+
+
+def patch_ranges(old, new):
+    """(offset, deleted, inserted bytes) of the changed ranges, ascending."""
+    ranges = []
+    matcher = difflib.SequenceMatcher(None, old, new, autojunk=False)
+    for tag, i1, i2, j1, j2 in matcher.get_opcodes():
+        if tag == "equal":
+            continue
+        if ranges:
+            offset, deleted, inserted = ranges[-1]
+            gap = i1 - offset - deleted
+            if gap <= PATCH_MERGE_GAP:
+                ranges[-1] = (offset, i2 - offset, inserted + old[offset + deleted:i1] + new[j1:j2])
+                continue
+        ranges.append((i1, i2 - i1, new[j1:j2]))
+    return ranges
+
+
+def patch(slot, old, new):
+    out = bytearray([MSG_PATCH_DOWNLINK, slot]) + digest(old).to_bytes(2, "big")
+    for offset, deleted, inserted in patch_ranges(old, new):
+        out += bytes([offset, deleted, len(inserted)]) + inserted
+    return bytes(out)
+
+
+def copy(dst, src, text):
+    return bytes([MSG_COPY_DOWNLINK, dst, src]) + digest(text).to_bytes(2, "big")
+
+
+def best_downlink(slot, badge, new):
+    """Smallest downlink that turns message slot of badge (list of texts) into new, None if it is up to date."""
+    old = badge[slot - 1]
+    if old == new:
+        return None
+    choices = [msgcodec.downlink(slot, new), patch(slot, old, new)]
+    for src, text in enumerate(badge, 1):
+        if src != slot and text == new:
+            choices.append(copy(slot, src, text))
+    return min(choices, key=len)
+
+
+def apply(badge, downlink):
+    """Change badge like apply_message_delta() and handle_downlink() do, for checking the tool."""
+    kind, slot = downlink[0], downlink[1]
+    if kind == msgcodec.MSG_CODEC_DOWNLINK:
+        badge[slot - 1] = msgcodec.decode(downlink[2:])
+    elif kind == MSG_COPY_DOWNLINK:
+        src = downlink[2]
+        if digest(badge[src - 1]) == int.from_bytes(downlink[3:5], "big"):
+            badge[slot - 1] = badge[src - 1]
+    elif kind == MSG_PATCH_DOWNLINK:
+        old = badge[slot - 1]
+        if digest(old) != int.from_bytes(downlink[2:4], "big"):
+            return
+        out, copied, pos = b"", 0, 4
+        while pos < len(downlink):
+            offset, deleted, inserted = downlink[pos:pos + 3]
+            out += old[copied:offset] + downlink[pos + 3:pos + 3 + inserted]
+            copied = offset + deleted
+            pos += 3 + inserted
+        badge[slot - 1] = out + old[copied:]
+
+
+def time_on_air(payload, sf, bw=125000, preamble=8, cr=1):
+    """Seconds on air of a LoRa frame with explicit header and CRC (Semtech AN1200.13)."""
+    t_sym = (2 ** sf) / bw
+    low_rate = 1 if t_sym > 0.016 else 0
+    length = payload + LORAWAN_OVERHEAD
+    symbols = 8 + max(math.ceil((8 * length - 4 * sf + 28 + 16) / (4 * (sf - 2 * low_rate))) * (cr + 4), 0)
+    return (preamble + 4.25) * t_sym + symbols * t_sym
+
+
+def downlink_airtime(payload, dr):
+    """Airtime of a downlink, fragmented when it doesn't fit one frame."""
+    sf, max_payload = EU868[dr]
+    if len(payload) <= max_payload:
+        return time_on_air(len(payload), sf), 1
+    frames = fragment.split(payload, max_payload - FRAG_HEADER_SIZE, 1)
+    return sum(time_on_air(len(frame), sf) for frame in frames), len(frames)
+
+
+def campaign_change(rng, text):
+    """A typical change of a campaign: a new time, room or word, or a new message."""
+    words = text.split(b" ")
+    roll = rng.random()
+    if roll < 0.4:
+        idx = rng.randrange(len(words))
+        words[idx] = rng.choice([b"10:30", b"11:00", b"room", b"hall", b"B", b"C", b"today", b"love"])
+        return b" ".join(words)[:msgcodec.MSG_MAX_LEN]
+    if roll < 0.7:
+        return (text + b" " + rng.choice([b"See you!", b"Day 2", b"NEW", b"Bring your badge"]))[:80]
+    return rng.choice(msgcodec.DEFAULT_MESSAGES).encode("latin-1")
+
+
+def fleet(args):
+    rng = random.Random(args.seed)
+    initial = [text.encode("latin-1") for text in msgcodec.DEFAULT_MESSAGES[:MSG_SLOTS]]
+    wanted = list(initial)
+    badges = [list(initial) for _ in range(args.badges)]
+    legacy = [list(initial) for _ in range(args.badges)]
+    sf = EU868[args.dr][0]
+    airtime = {"plain": 0.0, "packed": 0.0, "delta": 0.0}
+    frames = {"plain": 0, "packed": 0, "delta": 0}
+    kinds = {MSG_PATCH_DOWNLINK: 0, MSG_COPY_DOWNLINK: 0, msgcodec.MSG_CODEC_DOWNLINK: 0}
+    bad = 0
+    # The first timer uplink after boot has the digests
+    digest_uplinks = args.badges
+
+    for _ in range(args.campaigns):
+        changed = rng.sample(range(1, MSG_SLOTS + 1), rng.randint(1, 2))
+        for slot in changed:
+            if rng.random() < 0.2:
+                # Rotate an existing message into another slot
+                wanted[slot - 1] = rng.choice(wanted)
+            else:
+                wanted[slot - 1] = campaign_change(rng, wanted[slot - 1])
+        for idx in range(args.badges):
+            online = rng.random() >= args.offline
+            # Without digests every changed slot goes to every badge, padded to 80 bytes or packed
+            for slot in changed:
+                text = wanted[slot - 1]
+                plain = "{}:".format(slot).encode() + text.ljust(80, b" ")
+                for key, payload in (("plain", plain), ("packed", msgcodec.downlink(slot, text))):
+                    seconds, count = downlink_airtime(payload, args.dr)
+                    airtime[key] += seconds
+                    frames[key] += count
+                if online:
+                    legacy[idx][slot - 1] = text
+            # With digests only out of date slots of badges that reported them
+            if not online:
+                continue
+            updated = False
+            for slot in range(1, MSG_SLOTS + 1):
+                payload = best_downlink(slot, badges[idx], wanted[slot - 1])
+                if payload is None:
+                    continue
+                seconds, count = downlink_airtime(payload, args.dr)
+                airtime["delta"] += seconds
+                frames["delta"] += count
+                kinds[payload[0]] += 1
+                apply(badges[idx], payload)
+                updated = True
+                if badges[idx][slot - 1] != wanted[slot - 1]:
+                    bad += 1
+
+            # The next timer uplink confirms the change
+            digest_uplinks += updated
+
+    # Unchanged digests are repeated every DIGEST_REFRESH_UPLINKS timer uplinks
+    digest_uplinks += args.badges * args.campaigns * args.uplinks // (DIGEST_REFRESH_UPLINKS + 1)
+    slots = min(MSG_SLOTS, DIGEST_SLOTS_PER_UPLINK)
+    # Timer frame with status, then the digests section
+    timer_frame = 8
+    extra = digest_uplinks * (time_on_air(timer_frame + 1 + 2 * slots, sf) - time_on_air(timer_frame, sf))
+    stale_legacy = sum(badge != wanted for badge in legacy)
+    stale_delta = sum(badge != wanted for badge in badges)
+
+    print("{} badges, {} campaigns, {:.0f}% offline per campaign, DR{} (SF{})".format(
+        args.badges, args.campaigns, 100 * args.offline, args.dr, sf))
+    for key, label in (("plain", "full padded text"), ("packed", "full packed text"), ("delta", "delta sync")):
+        print("  {:18s} {:6d} downlinks {:9.1f} s".format(label, frames[key], airtime[key]))
+    print("  delta downlinks: {} patches, {} copies, {} full".format(
+        kinds[MSG_PATCH_DOWNLINK], kinds[MSG_COPY_DOWNLINK], kinds[msgcodec.MSG_CODEC_DOWNLINK]))
+    for key in ("plain", "packed"):
+        saved = airtime[key] - airtime["delta"]
+        print("  saved against {:6s} {:9.1f} s downlink ({:.0f}%)".format(
+            key, saved, 100 * saved / airtime[key] if airtime[key] else 0))
+    print("  digest cost        {:9.1f} s uplink in {} uplinks with digests".format(extra, digest_uplinks))
+    print("  out of date at the end: {} badges without digests, {} with".format(stale_legacy, stale_delta))
+    return bad
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    dig = sub.add_parser("digest", help="CRC16 of a message")
+    dig.add_argument("text")
+    upl = sub.add_parser("uplink", help="digests of a telemetry uplink in hex")
+    upl.add_argument("hex")
+    pat = sub.add_parser("patch", help="smallest downlink from old to new text")
+    pat.add_argument("slot", type=int)
+    pat.add_argument("old")
+    pat.add_argument("new")
+    flt = sub.add_parser("fleet", help="simulate campaigns over a fleet")
+    flt.add_argument("--badges", type=int, default=1000)
+    flt.add_argument("--campaigns", type=int, default=20)
+    flt.add_argument("--offline", type=float, default=0.2, help="share of badges missing a campaign")
+    flt.add_argument("--uplinks", type=int, default=24, help="timer uplinks between two campaigns")
+    flt.add_argument("--dr", type=int, default=2, choices=sorted(EU868))
+    flt.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.cmd == "digest":
+        print("{:04X}".format(digest(args.text.encode("latin-1"))))
+    elif args.cmd == "uplink":
+        for slot, value in sorted(parse_uplink(bytes.fromhex(args.hex)).items()):
+            print("slot {} {:04X}".format(slot, value))
+    elif args.cmd == "patch":
+        payload = best_downlink(args.slot, [b""] * (args.slot - 1) + [args.old.encode("latin-1")],
+                                args.new.encode("latin-1"))
+        print(payload.hex().upper() if payload else "# up to date")
+    else:
+        sys.exit(1 if fleet(args) else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Split a downlink payload into WisBlock-Heart fragments and answer the
+missing fragment requests of the badge (see src/frag.cpp).
+
+    tools/fragment.py split <payload hex> --size 47 [--session 7]
+    tools/fragment.py answer <payload hex> <request uplink hex> --size 47
+
+A fragment is E1, session, index, count and up to --size payload bytes.
+The request uplink is 11, session, count and a bitmap of the missing
+fragments, bit 0 of the first byte is fragment 0. An empty bitmap
+acknowledges the complete payload.
+"""
+import argparse
+import sys
+
+FRAG_DOWNLINK = 0xE1
+FRAG_REQUEST_UPLINK = 0x11
+FRAG_MAX_COUNT = 64
+FRAG_BUFFER_SIZE = 4096
+
+
+def split(payload, size, session):
+    """List of fragment downlinks for payload."""
+    count = max(1, (len(payload) + size - 1) // size)
+    if count > FRAG_MAX_COUNT or len(payload) > FRAG_BUFFER_SIZE:
+        raise ValueError("payload needs {} fragments, {} bytes".format(count, len(payload)))
+    return [bytes([FRAG_DOWNLINK, session, idx, count]) + payload[idx * size:(idx + 1) * size]
+            for idx in range(count)]
+
+
+def missing(request):
+    """Session and missing fragment indexes of a request uplink."""
+    if len(request) < 3 or request[0] != FRAG_REQUEST_UPLINK:
+        raise ValueError("not a fragment request")
+    session, count = request[1], request[2]
+    bitmap = int.from_bytes(request[3:3 + (count + 7) // 8], "little")
+    return session, [idx for idx in range(count) if bitmap & (1 << idx)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    spl = sub.add_parser("split", help="fragments of a payload, one hex downlink per line")
+    spl.add_argument("payload")
+    ans = sub.add_parser("answer", help="fragments requested by an uplink")
+    ans.add_argument("payload")
+    ans.add_argument("request")
+    for cmd in (spl, ans):
+        cmd.add_argument("--size", type=int, default=47, help="payload bytes per fragment, frame size minus 4")
+        cmd.add_argument("--session", type=int, default=1)
+    args = parser.parse_args()
+
+    fragments = split(bytes.fromhex(args.payload), args.size, args.session)
+    if args.cmd == "split":
+        wanted = range(len(fragments))
+    else:
+        session, wanted = missing(bytes.fromhex(args.request))
+        if session != args.session:
+            sys.exit("request is for session {}".format(session))
+        if not wanted:
+            print("# complete", file=sys.stderr)
+    for idx in wanted:
+        print(fragments[idx].hex().upper())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""Turn an image into a compressed 1bpp asset for the WisBlock-Heart EPD (see src/images.h).
+
+The asset is stored the way the SSD1680 framebuffer is laid out: column by
+column, each column top to bottom with 8 pixels per byte, MSB first, a set
+bit is ink. A column lands in one gate line of the framebuffer, so the
+firmware decodes it byte by byte straight into the frame. Every column is
+XORed with the one before it, which turns the similar neighbour columns of
+a logo into zeros, and the bytes are compressed with the PackBits codec of
+src/rle.cpp. Images are up to 176 pixels high, the sources of the SSD1680.
+
+PNG (any bit depth and color type, not interlaced) and binary PBM (P4)
+are read with the standard library. A pixel is ink if it is darker than
+the threshold and not transparent.
+
+    tools/imgconv.py logo.png --name rak_img              C code of the asset for src/images.h
+    tools/imgconv.py logo.png --name rak_img --check      sizes only
+"""
+import argparse
+import struct
+import sys
+import zlib
+
+RLE_MAX_RUN = 128
+MAX_HEIGHT = 176
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def rle_encode(data):
+    """Same as rle_encode() in src/rle.cpp."""
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        run = 1
+        while idx + run < len(data) and run < RLE_MAX_RUN and data[idx + run] == data[idx]:
+            run += 1
+        if run >= 3:
+            out += bytes((257 - run, data[idx]))
+            idx += run
+            continue
+        lit = 0
+        while idx + lit < len(data) and lit < RLE_MAX_RUN:
+            if idx + lit + 2 < len(data) and data[idx + lit] == data[idx + lit + 1] == data[idx + lit + 2]:
+                break
+            lit += 1
+        out.append(lit - 1)
+        out += data[idx:idx + lit]
+        idx += lit
+    return bytes(out)
+
+
+def rle_decode(data):
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        header = data[idx]
+        idx += 1
+        if header < 0x80:
+            out += data[idx:idx + header + 1]
+            idx += header + 1
+        elif header > 0x80:
+            out += bytes([data[idx]]) * (257 - header)
+            idx += 1
+    return bytes(out)
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(blob, threshold):
+    """Ink pixels of a PNG as rows of booleans."""
+    pos = len(PNG_SIGNATURE)
+    idat = bytearray()
+    palette = []
+    alpha = b""
+    while pos < len(blob):
+        size, kind = struct.unpack(">I4s", blob[pos:pos + 8])
+        chunk = blob[pos + 8:pos + 8 + size]
+        pos += 12 + size
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            alpha = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+    if interlace:
+        sys.exit("interlaced PNG is not supported")
+
+    raw = zlib.decompress(bytes(idat))
+    channels = CHANNELS[color]
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    step = max(1, bits // 8)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            left = line[i - step] if i >= step else 0
+            up = prev[i]
+            corner = prev[i - step] if i >= step else 0
+            line[i] = (line[i] + (0, left, up, (left + up) // 2, paeth(left, up, corner))[kind]) & 0xFF
+        prev = line
+        rows.append(line)
+
+    top = (1 << depth) - 1
+    ink = []
+    for line in rows:
+        samples = []
+        if depth < 8:
+            for i in range(width):
+                shift = 8 - depth - (i * depth) % 8
+                samples.append((line[i * depth // 8] >> shift) & top)
+        else:
+            size = depth // 8
+            samples = [int.from_bytes(line[i:i + size], "big") for i in range(0, len(line), size)]
+        out = []
+        for x in range(width):
+            pixel = samples[x * channels:(x + 1) * channels]
+            opaque = True
+            if color == 3:
+                index = pixel[0]
+                red, green, blue = palette[index]
+                gray = (red * 299 + green * 587 + blue * 114) // 1000
+                opaque = index >= len(alpha) or alpha[index] >= 128
+            else:
+                scaled = [value * 255 // top for value in pixel]
+                if color in (0, 4):
+                    gray = scaled[0]
+                else:
+                    gray = (scaled[0] * 299 + scaled[1] * 587 + scaled[2] * 114) // 1000
+                if color in (4, 6):
+                    opaque = scaled[-1] >= 128
+            out.append(opaque and gray < threshold)
+        ink.append(out)
+    return width, height, ink
+
+
+def read_pbm(blob):
+    """Ink pixels of a binary PBM as rows of booleans."""
+    fields = []
+    pos = 2
+    while len(fields) < 2:
+        while blob[pos:pos + 1].isspace():
+            pos += 1
+        if blob[pos:pos + 1] == b"#":
+            pos = blob.index(b"\n", pos)
+            continue
+        start = pos
+        while not blob[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(int(blob[start:pos]))
+    width, height = fields
+    pos += 1
+    stride = (width + 7) // 8
+    ink = []
+    for y in range(height):
+        line = blob[pos + y * stride:pos + (y + 1) * stride]
+        ink.append([bool(line[x // 8] & (0x80 >> (x % 8))) for x in range(width)])
+    return width, height, ink
+
+
+def columns(width, height, ink):
+    """Column major 1bpp bytes, each column XOR the previous one, as decoded by EPD_SSD1680::draw_image()."""
+    out = bytearray()
+    prev = bytes((height + 7) // 8)
+    for x in range(width):
+        column = bytearray()
+        for byte in range((height + 7) // 8):
+            value = 0
+            for bit in range(8):
+                y = byte * 8 + bit
+                if y < height and ink[y][x]:
+                    value |= 0x80 >> bit
+            column.append(value)
+        out += bytes(new ^ old for new, old in zip(column, prev))
+        prev = column
+    return bytes(out)
+
+
+def header(name, width, height, data, source):
+    lines = [
+        "\t// '{}', {}x{}px, {} bytes for {} raw".format(source, width, height, len(data), width * ((height + 7) // 8)),
+    ]
+    for pos in range(0, len(data), 16):
+        lines.append("\t" + " ".join("0x{:02x},".format(byte) for byte in data[pos:pos + 16]))
+    lines[-1] = lines[-1][:-1]
+    return "static const uint8_t {}_data[] = {{\n{}}};\nstatic const s_epd_image {} = {{{}, {}, sizeof({}_data), {}_data}};\n".format(
+        name, "\n".join(lines), name, width, height, name, name)
+
+
+def convert(path, threshold=128, invert=False):
+    """Width, height and compressed data of an image file, raw size for the statistics."""
+    with open(path, "rb") as file:
+        blob = file.read()
+    if blob.startswith(PNG_SIGNATURE):
+        width, height, ink = read_png(blob, threshold)
+    elif blob.startswith(b"P4"):
+        width, height, ink = read_pbm(blob)
+    else:
+        sys.exit("{}: neither PNG nor binary PBM".format(path))
+    if height > MAX_HEIGHT:
+        sys.exit("{}: higher than {} pixels".format(path, MAX_HEIGHT))
+    if invert:
+        ink = [[not pixel for pixel in row] for row in ink]
+
+    raw = columns(width, height, ink)
+    data = rle_encode(raw)
+    if rle_decode(data) != raw:
+        sys.exit("round trip failed")
+    return width, height, data, len(raw)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", help="PNG or binary PBM")
+    parser.add_argument("--name", required=True, help="name of the asset in the firmware")
+    parser.add_argument("--threshold", type=int, default=128, help="gray level below which a pixel is ink")
+    parser.add_argument("--invert", action="store_true", help="light pixels are ink")
+    parser.add_argument("--check", action="store_true", help="only print the sizes")
+    args = parser.parse_args()
+
+    width, height, data, raw_size = convert(args.image, args.threshold, args.invert)
+    print("{}: {}x{}, {} bytes raw, {} compressed".format(args.name, width, height, raw_size, len(data)), file=sys.stderr)
+    if not args.check:
+        sys.stdout.write(header(args.name, width, height, data, args.image.split("/")[-1]))
+
+
+if __name__ == "__main__":
+    main()
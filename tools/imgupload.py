@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Upload an image into a message slot of a WisBlock-Heart badge (see src/msg_image.cpp).
+
+The image is converted like tools/imgconv.py does and sent in pieces:
+
+    E4 <slot> <width:2> <height:2> <size:2> <crc32:4>     start or resume the upload
+    E5 <offset:2> <bytes>                                 piece of the compressed image
+
+Numbers are big endian. The badge answers every one of them with the
+status uplink 13 <slot> <state> <offset:2>, the state is 0 idle, 1
+receiving, 2 done or 3 failed. An upload that was cut off, also by a reset
+of the badge, continues at the offset of the status once the same E4 is
+sent again. Pieces may also go out as fragments of tools/fragment.py.
+Over BLE or serial the same is AT+IMG=<slot>:<width>:<height>:<size>:<crc32>
+and AT+IMGD=<offset>:<hex>, AT+IMG? gives <slot>:<state>:<offset>/<size>.
+
+    tools/imgupload.py downlinks heart.png --slot 2                       all downlinks, one hex per line
+    tools/imgupload.py downlinks heart.png --slot 2 --status 1302010060   what is left after a status uplink
+    tools/imgupload.py at heart.png --slot 2                              AT commands
+    tools/imgupload.py at heart.png --slot 2 --script 5000                as script of the native simulation
+"""
+import argparse
+import binascii
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import imgconv  # noqa: E402
+
+IMG_BEGIN_DOWNLINK = 0xE4
+IMG_CHUNK_DOWNLINK = 0xE5
+IMG_STATUS_UPLINK = 0x13
+STATES = ("idle", "receiving", "done", "failed")
+# Bytes of a piece in one AT command, AT_IMG_CHUNK_MAX of src/user_at.cpp
+AT_CHUNK_MAX = 64
+
+
+def status(frame):
+    """Slot, state and offset of a status uplink."""
+    if len(frame) < 5 or frame[0] != IMG_STATUS_UPLINK:
+        raise ValueError("not an image status")
+    return frame[1], frame[2], int.from_bytes(frame[3:5], "big")
+
+
+def begin_downlink(slot, width, height, data):
+    return (bytes([IMG_BEGIN_DOWNLINK, slot]) + width.to_bytes(2, "big") + height.to_bytes(2, "big") +
+            len(data).to_bytes(2, "big") + binascii.crc32(data).to_bytes(4, "big"))
+
+
+def chunk_downlinks(data, offset, size):
+    return [bytes([IMG_CHUNK_DOWNLINK]) + pos.to_bytes(2, "big") + data[pos:pos + size]
+            for pos in range(offset, len(data), size)]
+
+
+def at_commands(slot, width, height, data, offset, size):
+    lines = ["AT+IMG={}:{}:{}:{}:0x{:08X}".format(slot, width, height, len(data), binascii.crc32(data))]
+    for pos in range(offset, len(data), size):
+        lines.append("AT+IMGD={}:{}".format(pos, data[pos:pos + size].hex().upper()))
+    lines.append("AT+IMG?")
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("cmd", choices=("downlinks", "at"))
+    parser.add_argument("image", help="PNG or binary PBM")
+    parser.add_argument("--slot", type=int, required=True, help="message slot")
+    parser.add_argument("--size", type=int, help="bytes per piece, default 48 for downlinks and {} for AT".format(AT_CHUNK_MAX))
+    parser.add_argument("--status", help="hex of the last status uplink, only the missing pieces are sent")
+    parser.add_argument("--threshold", type=int, default=128, help="gray level below which a pixel is ink")
+    parser.add_argument("--invert", action="store_true", help="light pixels are ink")
+    parser.add_argument("--script", type=int, metavar="T_MS", help="lines of a simulation script from this time on")
+    parser.add_argument("--step", type=int, default=1000, help="ms between the script lines")
+    args = parser.parse_args()
+
+    width, height, data, raw_size = imgconv.convert(args.image, args.threshold, args.invert)
+    print("{}x{}, {} bytes raw, {} compressed".format(width, height, raw_size, len(data)), file=sys.stderr)
+    offset = 0
+    if args.status:
+        slot, state, offset = status(bytes.fromhex(args.status))
+        print("# slot {} {} at {}".format(slot, STATES[state] if state < len(STATES) else state, offset), file=sys.stderr)
+        if slot == args.slot and state == 2:
+            return
+        if slot != args.slot or state != 1:
+            offset = 0
+
+    if args.cmd == "at":
+        size = args.size or AT_CHUNK_MAX
+        if size > AT_CHUNK_MAX:
+            sys.exit("an AT command takes up to {} bytes".format(AT_CHUNK_MAX))
+        lines = at_commands(args.slot, width, height, data, offset, size)
+        kind = "at"
+    else:
+        frames = [begin_downlink(args.slot, width, height, data)] + chunk_downlinks(data, offset, args.size or 48)
+        lines = [frame.hex().upper() for frame in frames]
+        kind = "downlink"
+    for idx, line in enumerate(lines):
+        if args.script is None:
+            print(line)
+        else:
+            print("{} {} {}".format(args.script + idx * args.step, kind, line))
+
+
+if __name__ == "__main__":
+    main()
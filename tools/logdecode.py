@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Turn the binary debug output of WisBlock-Heart back into text (see src/log.cpp).
+
+Built with -DLOG_BINARY=1 the log task prints every record as one line
+
+    ~<id><time><args>            all in hex, id and time as 8 digits
+
+id is the FNV-1a hash of the tag, a 0 byte and the format of the MYLOG call
+site, the tool finds the call sites in the sources. The arguments are packed
+with their type: 01 int32, 02 int64, 03 double (little endian), 04 string
+with a length byte. Lines without ~ are passed through unchanged.
+
+    tools/logdecode.py decode < serial.txt      text of a captured log
+    tools/logdecode.py ids                      id, tag and format of all call sites
+"""
+import argparse
+import glob
+import os
+import re
+import struct
+import sys
+
+LOG_ARG_INT32 = 1
+LOG_ARG_INT64 = 2
+LOG_ARG_DOUBLE = 3
+LOG_ARG_STRING = 4
+
+SRC = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+CALL = re.compile(r'\bMYLOG(?:_DEBUG)?\(\s*"([^"]*)"\s*,\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d*)?)(?:hh|h|ll|l|z|j|t|L)?([diouxXcsfFeEgGp%])")
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", '"': '"', "'": "'", "0": "\0"}
+
+
+def fnv(data, value=0x811C9DC5):
+    for byte in data:
+        value = ((value ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return value
+
+
+def log_id(tag, fmt):
+    """Same as log_id() in src/log.h."""
+    return fnv(fmt.encode("latin-1"), fnv(tag.encode("latin-1") + b"\0"))
+
+
+def unescape(text):
+    return re.sub(r"\\(.)", lambda match: ESCAPES.get(match.group(1), match.group(1)), text)
+
+
+def call_sites(src):
+    """id to (tag, format) of all MYLOG call sites."""
+    sites = {}
+    for path in sorted(glob.glob(os.path.join(src, "*.cpp")) + glob.glob(os.path.join(src, "*.h"))):
+        with open(path, encoding="latin-1") as file:
+            code = file.read()
+        for match in CALL.finditer(code):
+            tag = match.group(1)
+            fmt = unescape("".join(LITERAL.findall(match.group(2))))
+            ident = log_id(tag, fmt)
+            if ident in sites and sites[ident] != (tag, fmt):
+                print("# id {:08X} of {} {!r} collides with {!r}".format(ident, tag, fmt, sites[ident][1]), file=sys.stderr)
+            sites[ident] = (tag, fmt)
+    return sites
+
+
+def unpack(args):
+    """Packed arguments as (type, value)."""
+    out = []
+    pos = 0
+    while pos < len(args):
+        kind = args[pos]
+        if kind == LOG_ARG_INT32:
+            out.append((kind, int.from_bytes(args[pos + 1:pos + 5], "little")))
+            pos += 5
+        elif kind == LOG_ARG_INT64:
+            out.append((kind, int.from_bytes(args[pos + 1:pos + 9], "little")))
+            pos += 9
+        elif kind == LOG_ARG_DOUBLE:
+            out.append((kind, struct.unpack("<d", args[pos + 1:pos + 9])[0]))
+            pos += 9
+        elif kind == LOG_ARG_STRING:
+            size = args[pos + 1]
+            out.append((kind, args[pos + 2:pos + 2 + size].decode("latin-1")))
+            pos += 2 + size
+        else:
+            break
+    return out
+
+
+def render(fmt, args):
+    """Format like log_format() on the badge: the type comes from the record, the conversion from the format."""
+    args = iter(args)
+
+    def convert(match):
+        flags, conversion = match.group(1), match.group(2)
+        if conversion == "%":
+            return "%"
+        kind, value = next(args, (None, None))
+        bits = 32 if kind == LOG_ARG_INT32 else 64
+        if kind in (LOG_ARG_INT32, LOG_ARG_INT64):
+            if conversion in "di":
+                if value >= 1 << (bits - 1):
+                    value -= 1 << bits
+                return ("%" + flags + "d") % value
+            if conversion in "uoxX":
+                return ("%" + flags + conversion.replace("u", "d")) % value
+            if conversion == "c":
+                return ("%" + flags + "c") % (value & 0xFF)
+            if conversion == "p":
+                return "0x{:x}".format(value)
+        if kind == LOG_ARG_DOUBLE and conversion in "fFeEgG":
+            return ("%" + flags + conversion) % value
+        if kind == LOG_ARG_STRING and conversion == "s":
+            return ("%" + flags + "s") % value
+        return "?"
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode_line(line, sites):
+    if not line.startswith("~") or len(line) < 17:
+        return line
+    try:
+        record = bytes.fromhex(line[1:])
+    except ValueError:
+        return line
+    ident = int.from_bytes(record[0:4], "big")
+    time = int.from_bytes(record[4:8], "big")
+    args = unpack(record[8:])
+    if ident not in sites:
+        return "{:10.3f} [?] unknown id {:08X} {}".format(time / 1000, ident, [value for _, value in args])
+    tag, fmt = sites[ident]
+    return "{:10.3f} [{}] {}".format(time / 1000, tag, render(fmt, args))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--src", default=SRC, help="directory of the firmware sources")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    dec = sub.add_parser("decode", help="decode a captured log")
+    dec.add_argument("file", nargs="?", help="default is stdin")
+    sub.add_parser("ids", help="list the call sites")
+    args = parser.parse_args()
+
+    sites = call_sites(args.src)
+    if args.cmd == "ids":
+        for ident, (tag, fmt) in sorted(sites.items(), key=lambda item: item[1]):
+            print("{:08X} {:16s} {!r}".format(ident, tag, fmt))
+        return
+    source = open(args.file, encoding="latin-1") if args.file else sys.stdin
+    with source:
+        for line in source:
+            print(decode_line(line.rstrip("\r\n"), sites))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""Host side of the WisBlock-Heart message codec.
+
+Encodes badge messages into the packed 6 bit format of src/msg_codec.cpp
+and builds the compressed message downlink. The charset and the dictionary
+are read from src/msg_codec_tables.h, so the tool always matches the
+firmware it was checked out with.
+
+    tools/msgcodec.py encode "Hello you" --slot 2     downlink payload in hex
+    tools/msgcodec.py decode E0020A1B...              text of a downlink or stream
+    tools/msgcodec.py check ["message" ...]           round trip and sizes
+"""
+import argparse
+import ast
+import os
+import re
+import sys
+
+TABLES = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "msg_codec_tables.h")
+
+MSG_CODEC_VERSION = 1
+MSG_CODEC_FLAG_DICT = 0x01
+MSG_CODEC_DOWNLINK = 0xE0
+MSG_MAX_LEN = 255
+
+CODE_SHIFT = 60
+CODE_RUN = 61
+CODE_DICT = 62
+CODE_RAW = 63
+RUN_MIN = 3
+RUN_MAX = RUN_MIN + 63
+
+
+def load_tables(path=TABLES):
+    """Read the charset and the dictionary from the C header."""
+    with open(path) as header:
+        source = header.read()
+    charset = ast.literal_eval(re.search(r'#define MSG_CODEC_CHARSET (".*")', source).group(1))
+    block = re.search(r"#define MSG_CODEC_DICTIONARY(.*?)\n\n", source, re.S).group(1)
+    dictionary = [ast.literal_eval(entry) for entry in re.findall(r'"(?:[^"\\]|\\.)*"', block)]
+    return charset.encode("latin-1"), [entry.encode("latin-1") for entry in dictionary]
+
+
+CHARSET, DICTIONARY = load_tables()
+
+
+class BitWriter:
+    def __init__(self):
+        self.data = bytearray()
+        self.acc = 0
+        self.bits = 0
+
+    def put(self, value, bits):
+        self.acc = (self.acc << bits) | value
+        self.bits += bits
+        while self.bits >= 8:
+            self.bits -= 8
+            self.data.append((self.acc >> self.bits) & 0xFF)
+        self.acc &= (1 << self.bits) - 1
+
+    def finish(self):
+        # Padding with ones reads as an incomplete RAW code
+        if self.bits:
+            self.put((1 << (8 - self.bits)) - 1, 8 - self.bits)
+        return bytes(self.data)
+
+
+def char_cost(ch):
+    if ch in CHARSET:
+        return 6
+    if 0x41 <= ch <= 0x5A:
+        return 12
+    return 14
+
+
+def encode(text, use_dict=True):
+    """Encode bytes into a codec stream, header byte included."""
+    out = BitWriter()
+    out.put((MSG_CODEC_VERSION << 4) | (MSG_CODEC_FLAG_DICT if use_dict else 0), 8)
+    pos = 0
+    while pos < len(text):
+        ch = text[pos]
+        if ch == 0x20:
+            run = 1
+            while pos + run < len(text) and text[pos + run] == 0x20 and run < RUN_MAX:
+                run += 1
+            if run >= RUN_MIN:
+                out.put(CODE_RUN, 6)
+                out.put(run - RUN_MIN, 6)
+                pos += run
+                continue
+        if use_dict:
+            best, best_saving = -1, 0
+            for idx, entry in enumerate(DICTIONARY):
+                if text.startswith(entry, pos):
+                    saving = sum(char_cost(c) for c in entry) - 12
+                    if saving > best_saving:
+                        best, best_saving = idx, saving
+            if best >= 0:
+                out.put(CODE_DICT, 6)
+                out.put(best, 6)
+                pos += len(DICTIONARY[best])
+                continue
+        if ch in CHARSET:
+            out.put(CHARSET.index(ch), 6)
+        elif 0x41 <= ch <= 0x5A:
+            out.put(CODE_SHIFT, 6)
+            out.put(CHARSET.index(ch + 0x20), 6)
+        else:
+            out.put(CODE_RAW, 6)
+            out.put(ch, 8)
+        pos += 1
+    return out.finish()
+
+
+def decode(stream):
+    """Decode a codec stream, raises ValueError if it is damaged."""
+    if not stream or (stream[0] >> 4) != MSG_CODEC_VERSION:
+        raise ValueError("unknown codec version")
+    use_dict = bool(stream[0] & MSG_CODEC_FLAG_DICT)
+    bits = "".join("{:08b}".format(byte) for byte in stream[1:])
+    pos = 0
+    out = bytearray()
+
+    def take(count):
+        nonlocal pos
+        if pos + count > len(bits):
+            return None
+        value = int(bits[pos:pos + count], 2)
+        pos += count
+        return value
+
+    while True:
+        code = take(6)
+        if code is None:
+            break
+        if code < len(CHARSET):
+            out.append(CHARSET[code])
+            continue
+        arg = take(8 if code == CODE_RAW else 6)
+        if arg is None:
+            break
+        if code == CODE_SHIFT:
+            if not 1 <= arg <= 26:
+                raise ValueError("shift without a letter")
+            out.append(CHARSET[arg] - 0x20)
+        elif code == CODE_RUN:
+            out.extend(b" " * (arg + RUN_MIN))
+        elif code == CODE_DICT:
+            if not use_dict or arg >= len(DICTIONARY):
+                raise ValueError("unknown dictionary entry")
+            out.extend(DICTIONARY[arg])
+        else:
+            out.append(arg)
+    if len(out) > MSG_MAX_LEN:
+        raise ValueError("message too long")
+    return bytes(out)
+
+
+def downlink(slot, text, use_dict=True):
+    return bytes([MSG_CODEC_DOWNLINK, slot]) + encode(text, use_dict)
+
+
+DEFAULT_MESSAGES = [
+    "  Hi! I am thinking about you. Love you",
+    "If I know what love is, it is because ofyou",
+    "   While (true) {         I love you       }",
+    "Even when I am not  with you, all I can think of is your    smile",
+    "Happy birthday! Can't wait to see you tonight",
+    "Good morning sunshine, have a great day at work",
+    "Meeting at 10:30 in room B, bring the LoRa gateway",
+]
+
+
+def check(messages):
+    """Round trip every message and report the sizes against the plain downlink."""
+    failed = 0
+    total_plain = total_packed = 0
+    for text in messages:
+        raw = text.encode("latin-1")
+        for use_dict in (False, True):
+            packed = encode(raw, use_dict)
+            if decode(packed) != raw:
+                print("FAIL round trip:", repr(text), "dictionary" if use_dict else "")
+                failed += 1
+        # Plain downlink "<slot>:<text>", the old format padded the text to 80 bytes
+        plain = len(raw) + 2
+        padded = 82
+        packed = len(downlink(1, raw))
+        total_plain += plain
+        total_packed += packed
+        print("{:3d} -> {:3d} bytes ({:3.0f}% of the text, {:3.0f}% of the padded downlink)  {!r}".format(
+            plain, packed, 100.0 * packed / plain, 100.0 * packed / padded, text))
+    if total_plain:
+        print("total {} -> {} bytes, {:.0f}% saved".format(total_plain, total_packed,
+                                                          100.0 - 100.0 * total_packed / total_plain))
+    for length in range(0, MSG_MAX_LEN + 1, 17):
+        raw = bytes((idx * 37) & 0xFF for idx in range(length))
+        if decode(encode(raw)) != raw:
+            print("FAIL round trip of binary data, length", length)
+            failed += 1
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    enc = sub.add_parser("encode", help="encode a message")
+    enc.add_argument("text")
+    enc.add_argument("--slot", type=int, help="build the downlink for this message slot")
+    enc.add_argument("--no-dict", action="store_true", help="don't use the static dictionary")
+    dec = sub.add_parser("decode", help="decode a downlink or a codec stream in hex")
+    dec.add_argument("hex")
+    chk = sub.add_parser("check", help="round trip and compression ratio")
+    chk.add_argument("text", nargs="*")
+    args = parser.parse_args()
+
+    if args.cmd == "encode":
+        raw = args.text.encode("latin-1")
+        if len(raw) > MSG_MAX_LEN:
+            sys.exit("message longer than {} characters".format(MSG_MAX_LEN))
+        if args.slot is not None:
+            print(downlink(args.slot, raw, not args.no_dict).hex().upper())
+        else:
+            print(encode(raw, not args.no_dict).hex().upper())
+    elif args.cmd == "decode":
+        data = bytes.fromhex(args.hex)
+        if data and data[0] == MSG_CODEC_DOWNLINK:
+            print("slot", data[1])
+            data = data[2:]
+        print(repr(decode(data).decode("latin-1")))
+    else:
+        sys.exit(1 if check(args.text or DEFAULT_MESSAGES) else 0)
+
+
+if __name__ == "__main__":
+    main()
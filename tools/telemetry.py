@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Decode the WisBlock-Heart telemetry uplink (see src/telemetry.cpp) and
+check the frame against the payload sizes of the LoRaWAN data rates.
+
+    tools/telemetry.py decode 12170102010A0E...    fields of a frame in hex
+    tools/telemetry.py check                       frame sizes per region and DR
+
+check builds the largest frame the badge can have and trims it like
+build_telemetry() does. It fails if the counts don't fit a data rate,
+the badge would then get LMH_ERROR for every uplink. With a full set of
+pending MAC commands the counts may not fit the smallest data rates, they
+then stay on the badge for the next frame.
+"""
+import argparse
+import sys
+
+TELEMETRY_UPLINK = 0x12
+TELEMETRY_VERSION = 1
+TELEMETRY_HAS_STATUS = 0x01
+TELEMETRY_HAS_EVENTS = 0x02
+TELEMETRY_HAS_DIGESTS = 0x04
+TELEMETRY_MAX_EVENTS = 16
+TELEMETRY_MAX_SIZE = 64
+TELEMETRY_BATT_BASE_MV = 2500
+TELEMETRY_AGE_ESCAPE = 63
+DIGEST_SLOTS_PER_UPLINK = 8
+
+REASONS = ["timer", "tap", "double_tap", "shake", "flip"]
+
+# Largest application payload per data rate without MAC commands
+MAX_PAYLOAD = {
+    "EU868": [51, 51, 51, 115, 222, 222, 222, 222],
+    "US915": [11, 53, 125, 242, 242],
+    "AU915": [51, 51, 51, 115, 242, 242, 242],
+    "AS923": [51, 51, 51, 115, 242, 242, 242, 242],
+    "KR920": [51, 51, 51, 115, 242, 242],
+    "IN865": [51, 51, 51, 115, 242, 242, 242, 242],
+}
+# MAC commands in FOpts take up to 15 bytes of the payload
+FOPTS_MAX = 15
+
+
+def encode_age(kind, age):
+    if age < TELEMETRY_AGE_ESCAPE:
+        return bytes([(kind << 6) | age])
+    out = bytearray([(kind << 6) | TELEMETRY_AGE_ESCAPE])
+    age -= TELEMETRY_AGE_ESCAPE
+    while age >= 0x80:
+        out.append((age & 0x7F) | 0x80)
+        age >>= 7
+    out.append(age)
+    return bytes(out)
+
+
+def build(max_size, counts, status, events, digests):
+    """Frame like build_telemetry(): counts {reason index: n}, status (mV, writes, fails),
+    events [(kind, age)] newest first, digests (first slot, [crc16])."""
+    reasons = 0x01 if status else 0
+    for idx in counts:
+        reasons |= 1 << idx
+    frame = bytearray([TELEMETRY_UPLINK, TELEMETRY_VERSION << 4, reasons, 1])
+    frame += bytes(min(counts[idx], 0xFF) for idx in sorted(counts))
+    if len(frame) > max_size:
+        return None
+    if status and max_size - len(frame) >= 4:
+        frame[1] |= TELEMETRY_HAS_STATUS
+        millivolt, writes, fails = status
+        frame += bytes([max(0, min(0xFF, (millivolt - TELEMETRY_BATT_BASE_MV) // 10)), writes >> 8, writes & 0xFF, fails])
+    tail = b""
+    if status and digests:
+        first, values = digests
+        num = min(len(values), DIGEST_SLOTS_PER_UPLINK, (max_size - len(frame) - 1) // 2)
+        if num > 0:
+            frame[1] |= TELEMETRY_HAS_DIGESTS
+            tail = bytes([first]) + b"".join(value.to_bytes(2, "big") for value in values[:num])
+    max_size -= len(tail)
+    if events and max_size - len(frame) >= 2:
+        frame[1] |= TELEMETRY_HAS_EVENTS
+        section = bytearray()
+        num = 0
+        for kind, age in events:
+            coded = encode_age(kind, age)
+            if len(coded) > max_size - len(frame) - 1 - len(section):
+                break
+            section += coded
+            num += 1
+        frame += bytes([num]) + section
+    return bytes(frame + tail)
+
+
+def decode(frame):
+    """Fields of a telemetry frame as a dict."""
+    if len(frame) < 4 or frame[0] != TELEMETRY_UPLINK:
+        raise ValueError("not a telemetry frame")
+    version, sections = frame[1] >> 4, frame[1] & 0x0F
+    if version != TELEMETRY_VERSION:
+        raise ValueError("unknown version {}".format(version))
+    reasons = frame[2]
+    out = {"reasons": [name for idx, name in enumerate(REASONS) if reasons & (1 << idx)], "message": frame[3]}
+    pos = 4
+    out["counts"] = {}
+    for idx in range(1, len(REASONS)):
+        if reasons & (1 << idx):
+            out["counts"][REASONS[idx]] = frame[pos]
+            pos += 1
+    if sections & TELEMETRY_HAS_STATUS:
+        out["battery_mv"] = TELEMETRY_BATT_BASE_MV + 10 * frame[pos]
+        out["flash_writes"] = int.from_bytes(frame[pos + 1:pos + 3], "big")
+        out["send_fails"] = frame[pos + 3]
+        pos += 4
+    if sections & TELEMETRY_HAS_EVENTS:
+        num = frame[pos]
+        pos += 1
+        events = []
+        seconds = 0
+        for _ in range(num):
+            kind, age = frame[pos] >> 6, frame[pos] & 0x3F
+            pos += 1
+            if age == TELEMETRY_AGE_ESCAPE:
+                shift = 0
+                while True:
+                    age += (frame[pos] & 0x7F) << shift
+                    shift += 7
+                    pos += 1
+                    if not frame[pos - 1] & 0x80:
+                        break
+            seconds += age
+            events.append((REASONS[kind + 1], seconds))
+        out["events"] = events
+    if sections & TELEMETRY_HAS_DIGESTS:
+        first = frame[pos]
+        out["digests"] = {first + idx: "{:04X}".format(int.from_bytes(frame[pos + 1 + 2 * idx:pos + 3 + 2 * idx], "big"))
+                          for idx in range((len(frame) - pos - 1) // 2)}
+    return out
+
+
+def check():
+    """Build the worst case frame for every data rate, with and without pending MAC commands."""
+    counts = {idx: 300 for idx in range(1, len(REASONS))}
+    status = (4200, 0xFFFF, 10)
+    events = [(idx % 4, 1000 * idx) for idx in range(TELEMETRY_MAX_EVENTS)]
+    digests = (1, [0xFFFF] * DIGEST_SLOTS_PER_UPLINK)
+    failed = 0
+    for region, sizes in MAX_PAYLOAD.items():
+        for dr, size in enumerate(sizes):
+            for fopts in (0, FOPTS_MAX):
+                max_size = min(size - fopts, TELEMETRY_MAX_SIZE) if size > fopts else 0
+                frame = build(max_size, counts, status, events, digests)
+                if frame is None and fopts != 0:
+                    print("{} DR{}: counts wait for the next frame while {} bytes of MAC commands are pending".format(
+                        region, dr, fopts))
+                    continue
+                if frame is None or len(frame) > max_size:
+                    print("FAIL {} DR{}: counts don't fit {} bytes".format(region, dr, max_size))
+                    failed += 1
+                    continue
+                fields = decode(frame)
+                if fopts == 0:
+                    print("{} DR{}: {:3d} of {:3d} bytes, status {}, {:2d} events, {} digests".format(
+                        region, dr, len(frame), size, "yes" if "battery_mv" in fields else "no ",
+                        len(fields.get("events", [])), len(fields.get("digests", {}))))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    dec = sub.add_parser("decode", help="decode a telemetry frame in hex")
+    dec.add_argument("hex")
+    sub.add_parser("check", help="frame sizes per region and data rate")
+    args = parser.parse_args()
+
+    if args.cmd == "decode":
+        for key, value in decode(bytes.fromhex(args.hex)).items():
+            print("{}: {}".format(key, value))
+    else:
+        sys.exit(1 if check() else 0)
+
+
+if __name__ == "__main__":
+    main()